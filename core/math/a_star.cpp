@@ -34,9 +34,9 @@
 #include "core/object/script_language.h"
 
 int64_t AStar3D::get_available_point_id() const {
-	if (points.has(last_free_id)) {
+	if (point_indices.has(last_free_id)) {
 		int64_t cur_new_id = last_free_id + 1;
-		while (points.has(cur_new_id)) {
+		while (point_indices.has(cur_new_id)) {
 			cur_new_id++;
 		}
 		const_cast<int64_t &>(last_free_id) = cur_new_id;
@@ -49,129 +49,201 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 	ERR_FAIL_COND_MSG(p_id < 0, vformat("Can't add a point with negative id: %d.", p_id));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't add a point with weight scale less than 0.0: %f.", p_weight_scale));
 
-	Point *found_pt;
-	bool p_exists = points.lookup(p_id, found_pt);
+	uint32_t index;
+	bool p_exists = point_indices.lookup(p_id, index);
 
 	if (!p_exists) {
-		Point *pt = memnew(Point);
-		pt->id = p_id;
-		pt->pos = p_pos;
-		pt->weight_scale = p_weight_scale;
-		pt->prev_point = nullptr;
-		pt->open_pass = 0;
-		pt->closed_pass = 0;
-		pt->enabled = true;
-		points.set(p_id, pt);
+		if (free_points.is_empty()) {
+			index = points.size();
+			points.resize(index + 1);
+		} else {
+			index = free_points[free_points.size() - 1];
+			free_points.remove_at(free_points.size() - 1);
+		}
+
+		Point &pt = points[index];
+		pt.id = p_id;
+		pt.pos = p_pos;
+		pt.weight_scale = p_weight_scale;
+		pt.enabled = true;
+		pt.valid = true;
+		point_indices.set(p_id, index);
 	} else {
-		found_pt->pos = p_pos;
-		found_pt->weight_scale = p_weight_scale;
+		Point &found_pt = points[index];
+		if (found_pt.pos != p_pos) {
+			_reset_incremental_search();
+		} else if (found_pt.weight_scale != p_weight_scale) {
+			_mark_incremental_predecessors_dirty(index);
+		}
+		found_pt.pos = p_pos;
+		found_pt.weight_scale = p_weight_scale;
 	}
 }
 
 Vector3 AStar3D::get_point_position(int64_t p_id) const {
-	Point *p;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t index;
+	bool p_exists = point_indices.lookup(p_id, index);
 	ERR_FAIL_COND_V_MSG(!p_exists, Vector3(), vformat("Can't get point's position. Point with id: %d doesn't exist.", p_id));
 
-	return p->pos;
+	return points[index].pos;
 }
 
 void AStar3D::set_point_position(int64_t p_id, const Vector3 &p_pos) {
-	Point *p;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t index;
+	bool p_exists = point_indices.lookup(p_id, index);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set point's position. Point with id: %d doesn't exist.", p_id));
 
-	p->pos = p_pos;
+	if (points[index].pos != p_pos) {
+		// Moving a point changes the estimates the incremental search is ordered by.
+		_reset_incremental_search();
+		points[index].pos = p_pos;
+	}
 }
 
 real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
-	Point *p;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t index;
+	bool p_exists = point_indices.lookup(p_id, index);
 	ERR_FAIL_COND_V_MSG(!p_exists, 0, vformat("Can't get point's weight scale. Point with id: %d doesn't exist.", p_id));
 
-	return p->weight_scale;
+	return points[index].weight_scale;
 }
 
 void AStar3D::set_point_weight_scale(int64_t p_id, real_t p_weight_scale) {
-	Point *p;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t index;
+	bool p_exists = point_indices.lookup(p_id, index);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set point's weight scale. Point with id: %d doesn't exist.", p_id));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
 
-	p->weight_scale = p_weight_scale;
+	if (points[index].weight_scale != p_weight_scale) {
+		points[index].weight_scale = p_weight_scale;
+		_mark_incremental_predecessors_dirty(index);
+	}
 }
 
 void AStar3D::remove_point(int64_t p_id) {
-	Point *p;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t index;
+	bool p_exists = point_indices.lookup(p_id, index);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't remove point. Point with id: %d doesn't exist.", p_id));
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-		Segment s(p_id, (*it.key));
-		segments.erase(s);
+	if (index == incremental_begin || index == incremental_end) {
+		_reset_incremental_search();
+	}
+
+	Point &p = points[index];
 
-		(*it.value)->neighbors.remove(p->id);
-		(*it.value)->unlinked_neighbours.remove(p->id);
+	while (!p.neighbors.is_empty()) {
+		const uint32_t to = p.neighbors[p.neighbors.size() - 1];
+		segments.erase(Segment(p_id, points[to].id));
+		_remove_edge(index, to);
 	}
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = p->unlinked_neighbours.iter(); it.valid; it = p->unlinked_neighbours.next_iter(it)) {
-		Segment s(p_id, (*it.key));
-		segments.erase(s);
+	while (!p.incoming.is_empty()) {
+		const uint32_t from = p.incoming[p.incoming.size() - 1];
+		segments.erase(Segment(p_id, points[from].id));
+		_remove_edge(from, index);
+	}
 
-		(*it.value)->neighbors.remove(p->id);
-		(*it.value)->unlinked_neighbours.remove(p->id);
+	p.neighbors.reset();
+	p.incoming.reset();
+	p.enabled = false;
+	p.valid = false;
+
+	if (index < incremental_states.size()) {
+		// Keep the open version, so entries left in the open list can't be taken for the ones of a new point stored here.
+		IncrementalState &state = incremental_states[index];
+		state.g_score = INFINITY;
+		state.rhs_score = INFINITY;
+		if (state.open) {
+			state.open = false;
+			incremental_open_count--;
+		}
 	}
 
-	memdelete(p);
-	points.remove(p_id);
+	point_indices.remove(p_id);
+	free_points.push_back(index);
 	last_free_id = p_id;
 }
 
+void AStar3D::_add_edge(uint32_t p_from, uint32_t p_to) {
+	points[p_from].neighbors.push_back(p_to);
+	points[p_to].incoming.push_back(p_from);
+	_mark_incremental_dirty(p_from);
+}
+
+void AStar3D::_remove_edge(uint32_t p_from, uint32_t p_to) {
+	LocalVector<uint32_t> &neighbors = points[p_from].neighbors;
+	int64_t idx = neighbors.find(p_to);
+	if (idx >= 0) {
+		neighbors.remove_at_unordered(idx);
+	}
+
+	LocalVector<uint32_t> &incoming = points[p_to].incoming;
+	idx = incoming.find(p_from);
+	if (idx >= 0) {
+		incoming.remove_at_unordered(idx);
+	}
+
+	_mark_incremental_dirty(p_from);
+}
+
+void AStar3D::_update_segment(uint32_t p_first, uint32_t p_second, unsigned char p_old_direction, unsigned char p_new_direction) {
+	// Directions are relative to the segment's key, which stores the lowest id first.
+	const unsigned char added = p_new_direction & ~p_old_direction;
+	const unsigned char removed = p_old_direction & ~p_new_direction;
+
+	if (added & Segment::FORWARD) {
+		_add_edge(p_first, p_second);
+	} else if (removed & Segment::FORWARD) {
+		_remove_edge(p_first, p_second);
+	}
+
+	if (added & Segment::BACKWARD) {
+		_add_edge(p_second, p_first);
+	} else if (removed & Segment::BACKWARD) {
+		_remove_edge(p_second, p_first);
+	}
+}
+
 void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
 	ERR_FAIL_COND_MSG(p_id == p_with_id, vformat("Can't connect point with id: %d to itself.", p_id));
 
-	Point *a;
-	bool from_exists = points.lookup(p_id, a);
+	uint32_t a;
+	bool from_exists = point_indices.lookup(p_id, a);
 	ERR_FAIL_COND_MSG(!from_exists, vformat("Can't connect points. Point with id: %d doesn't exist.", p_id));
 
-	Point *b;
-	bool to_exists = points.lookup(p_with_id, b);
+	uint32_t b;
+	bool to_exists = point_indices.lookup(p_with_id, b);
 	ERR_FAIL_COND_MSG(!to_exists, vformat("Can't connect points. Point with id: %d doesn't exist.", p_with_id));
 
-	a->neighbors.set(b->id, b);
-
-	if (bidirectional) {
-		b->neighbors.set(a->id, a);
-	} else {
-		b->unlinked_neighbours.set(a->id, a);
-	}
-
 	Segment s(p_id, p_with_id);
 	if (bidirectional) {
 		s.direction = Segment::BIDIRECTIONAL;
 	}
 
+	unsigned char old_direction = Segment::NONE;
 	HashSet<Segment, Segment>::Iterator element = segments.find(s);
 	if (element) {
-		s.direction |= element->direction;
-		if (s.direction == Segment::BIDIRECTIONAL) {
-			// Both are neighbors of each other now
-			a->unlinked_neighbours.remove(b->id);
-			b->unlinked_neighbours.remove(a->id);
-		}
+		old_direction = element->direction;
+		s.direction |= old_direction;
 		segments.remove(element);
 	}
 
 	segments.insert(s);
+
+	if (p_id < p_with_id) {
+		_update_segment(a, b, old_direction, s.direction);
+	} else {
+		_update_segment(b, a, old_direction, s.direction);
+	}
 }
 
 void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
-	Point *a;
-	bool a_exists = points.lookup(p_id, a);
+	uint32_t a;
+	bool a_exists = point_indices.lookup(p_id, a);
 	ERR_FAIL_COND_MSG(!a_exists, vformat("Can't disconnect points. Point with id: %d doesn't exist.", p_id));
 
-	Point *b;
-	bool b_exists = points.lookup(p_with_id, b);
+	uint32_t b;
+	bool b_exists = point_indices.lookup(p_with_id, b);
 	ERR_FAIL_COND_MSG(!b_exists, vformat("Can't disconnect points. Point with id: %d doesn't exist.", p_with_id));
 
 	Segment s(p_id, p_with_id);
@@ -181,53 +253,50 @@ void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectio
 	if (element) {
 		// s is the new segment
 		// Erase the directions to be removed
-		s.direction = (element->direction & ~remove_direction);
-
-		a->neighbors.remove(b->id);
-		if (bidirectional) {
-			b->neighbors.remove(a->id);
-			if (element->direction != Segment::BIDIRECTIONAL) {
-				a->unlinked_neighbours.remove(b->id);
-				b->unlinked_neighbours.remove(a->id);
-			}
-		} else {
-			if (s.direction == Segment::NONE) {
-				b->unlinked_neighbours.remove(a->id);
-			} else {
-				a->unlinked_neighbours.set(b->id, b);
-			}
-		}
+		const unsigned char old_direction = element->direction;
+		s.direction = (old_direction & ~remove_direction);
 
 		segments.remove(element);
 		if (s.direction != Segment::NONE) {
 			segments.insert(s);
 		}
+
+		if (p_id < p_with_id) {
+			_update_segment(a, b, old_direction, s.direction);
+		} else {
+			_update_segment(b, a, old_direction, s.direction);
+		}
 	}
 }
 
 bool AStar3D::has_point(int64_t p_id) const {
-	return points.has(p_id);
+	return point_indices.has(p_id);
 }
 
 PackedInt64Array AStar3D::get_point_ids() {
 	PackedInt64Array point_list;
+	point_list.resize(point_indices.get_num_elements());
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
-		point_list.push_back(*(it.key));
+	int64_t *w = point_list.ptrw();
+	int64_t idx = 0;
+	for (const Point &p : points) {
+		if (p.valid) {
+			w[idx++] = p.id;
+		}
 	}
 
 	return point_list;
 }
 
 Vector<int64_t> AStar3D::get_point_connections(int64_t p_id) {
-	Point *p;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t index;
+	bool p_exists = point_indices.lookup(p_id, index);
 	ERR_FAIL_COND_V_MSG(!p_exists, Vector<int64_t>(), vformat("Can't get point's connections. Point with id: %d doesn't exist.", p_id));
 
 	Vector<int64_t> point_list;
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-		point_list.push_back((*it.key));
+	for (uint32_t to : points[index].neighbors) {
+		point_list.push_back(points[to].id);
 	}
 
 	return point_list;
@@ -243,40 +312,58 @@ bool AStar3D::are_points_connected(int64_t p_id, int64_t p_with_id, bool bidirec
 
 void AStar3D::clear() {
 	last_free_id = 0;
-	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
-		memdelete(*(it.value));
-	}
-	segments.clear();
 	points.clear();
+	free_points.clear();
+	point_indices.clear();
+	segments.clear();
+	point_states.clear();
+	open_list.clear();
+	pass = 0;
+	_reset_incremental_search();
 }
 
 int64_t AStar3D::get_point_count() const {
-	return points.get_num_elements();
+	return point_indices.get_num_elements();
 }
 
 int64_t AStar3D::get_point_capacity() const {
-	return points.get_capacity();
+	return point_indices.get_capacity();
 }
 
 void AStar3D::reserve_space(int64_t p_num_nodes) {
 	ERR_FAIL_COND_MSG(p_num_nodes <= 0, vformat("New capacity must be greater than 0, new was: %d.", p_num_nodes));
-	ERR_FAIL_COND_MSG((uint32_t)p_num_nodes < points.get_capacity(), vformat("New capacity must be greater than current capacity: %d, new was: %d.", points.get_capacity(), p_num_nodes));
+	ERR_FAIL_COND_MSG((uint32_t)p_num_nodes < point_indices.get_capacity(), vformat("New capacity must be greater than current capacity: %d, new was: %d.", point_indices.get_capacity(), p_num_nodes));
+	point_indices.reserve(p_num_nodes);
 	points.reserve(p_num_nodes);
 }
 
+void AStar3D::set_incremental_search_enabled(bool p_enabled) {
+	incremental_search_enabled = p_enabled;
+	if (!incremental_search_enabled) {
+		_reset_incremental_search();
+		incremental_states.reset();
+		incremental_open_list.reset();
+		incremental_dirty_points.reset();
+	}
+}
+
+bool AStar3D::is_incremental_search_enabled() const {
+	return incremental_search_enabled;
+}
+
 int64_t AStar3D::get_closest_point(const Vector3 &p_point, bool p_include_disabled) const {
 	int64_t closest_id = -1;
 	real_t closest_dist = 1e20;
 
-	for (OAHashMap<int64_t, Point *>::Iterator it = points.iter(); it.valid; it = points.next_iter(it)) {
-		if (!p_include_disabled && !(*it.value)->enabled) {
+	for (const Point &p : points) {
+		if (!p.valid || (!p_include_disabled && !p.enabled)) {
 			continue; // Disabled points should not be considered.
 		}
 
 		// Keep the closest point's ID, and in case of multiple closest IDs,
 		// the smallest one (makes it deterministic).
-		real_t d = p_point.distance_squared_to((*it.value)->pos);
-		int64_t id = *(it.key);
+		real_t d = p_point.distance_squared_to(p.pos);
+		int64_t id = p.id;
 		if (d <= closest_dist) {
 			if (d == closest_dist && id > closest_id) { // Keep lowest ID.
 				continue;
@@ -294,17 +381,19 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 	Vector3 closest_point;
 
 	for (const Segment &E : segments) {
-		Point *from_point = nullptr, *to_point = nullptr;
-		points.lookup(E.key.first, from_point);
-		points.lookup(E.key.second, to_point);
+		uint32_t from_index = 0, to_index = 0;
+		point_indices.lookup(E.key.first, from_index);
+		point_indices.lookup(E.key.second, to_index);
+		const Point &from_point = points[from_index];
+		const Point &to_point = points[to_index];
 
-		if (!(from_point->enabled && to_point->enabled)) {
+		if (!(from_point.enabled && to_point.enabled)) {
 			continue;
 		}
 
 		Vector3 segment[2] = {
-			from_point->pos,
-			to_point->pos,
+			from_point.pos,
+			to_point.pos,
 		};
 
 		Vector3 p = Geometry3D::get_closest_point_to_segment(p_point, segment);
@@ -318,66 +407,435 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 	return closest_point;
 }
 
-bool AStar3D::_solve(Point *begin_point, Point *end_point) {
+void AStar3D::_begin_pass() {
+	if (point_states.size() < points.size()) {
+		point_states.resize(points.size());
+	}
+
 	pass++;
+	if (pass == 0) {
+		// The pass counter wrapped around, old passes could be taken for the current one.
+		for (PointState &state : point_states) {
+			state.open_pass = 0;
+			state.closed_pass = 0;
+		}
+		pass = 1;
+	}
+}
 
-	if (!end_point->enabled) {
+template <class T>
+bool AStar3D::_solve(T *p_owner, uint32_t p_begin_point, uint32_t p_end_point) {
+	_begin_pass();
+
+	const int64_t end_id = points[p_end_point].id;
+	if (!points[p_end_point].enabled) {
 		return false;
 	}
 
-	bool found_route = false;
+	SortArray<OpenPoint, SortOpenPoints> sorter;
+
+	PointState &begin_state = point_states[p_begin_point];
+	begin_state.g_score = 0;
+	begin_state.open_pass = pass;
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	OpenPoint begin;
+	begin.f_score = p_owner->_estimate_cost(points[p_begin_point].id, end_id);
+	begin.index = p_begin_point;
 
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
+	open_list.clear();
+	open_list.push_back(begin);
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		const OpenPoint current = open_list[0]; // The currently processed point.
+		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
+		open_list.remove_at(open_list.size() - 1);
 
-		if (p == end_point) {
-			found_route = true;
-			break;
+		PointState &p = point_states[current.index];
+		if (p.closed_pass == pass || current.g_score > p.g_score) {
+			continue; // The point was reached again with a better score after being added to the open list.
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		if (current.index == p_end_point) {
+			return true;
+		}
+
+		p.closed_pass = pass; // Mark the point as closed.
+
+		const Point &point = points[current.index];
+		for (uint32_t e : point.neighbors) {
+			const Point &e_point = points[e]; // The neighbor point.
+			PointState &e_state = point_states[e];
 
-		for (OAHashMap<int64_t, Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-			Point *e = *(it.value); // The neighbor point.
+			if (!e_point.enabled || e_state.closed_pass == pass) {
+				continue;
+			}
 
-			if (!e->enabled || e->closed_pass == pass) {
+			real_t tentative_g_score = p.g_score + p_owner->_compute_cost(point.id, e_point.id) * e_point.weight_scale;
+
+			if (e_state.open_pass == pass && tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
+			e_state.open_pass = pass;
+			e_state.prev_point = current.index;
+			e_state.g_score = tentative_g_score;
+
+			OpenPoint next;
+			next.g_score = tentative_g_score;
+			next.f_score = tentative_g_score + p_owner->_estimate_cost(e_point.id, end_id);
+			next.index = e;
+
+			// Points already in the open list are added again rather than moved, the worse entry is skipped when reached.
+			open_list.push_back(next);
+			sorter.push_heap(0, open_list.size() - 1, 0, next, open_list.ptr());
+		}
+	}
+
+	return false;
+}
+
+void AStar3D::_get_solved_path(uint32_t p_begin_point, uint32_t p_end_point, LocalVector<uint32_t> &r_path) const {
+	uint32_t p = p_end_point;
+	uint32_t pc = 1; // Begin point
+	while (p != p_begin_point) {
+		pc++;
+		p = point_states[p].prev_point;
+	}
+
+	r_path.resize(pc);
+
+	p = p_end_point;
+	uint32_t idx = pc - 1;
+	while (p != p_begin_point) {
+		r_path[idx--] = p;
+		p = point_states[p].prev_point;
+	}
+
+	r_path[0] = p; // Assign first
+}
+
+void AStar3D::_reset_incremental_search() {
+	incremental_states.clear();
+	incremental_open_list.clear();
+	incremental_dirty_points.clear();
+	incremental_open_count = 0;
+	incremental_begin = INVALID_POINT;
+	incremental_end = INVALID_POINT;
+	incremental_key_modifier = 0;
+}
+
+void AStar3D::_mark_incremental_dirty(uint32_t p_index) {
+	if (incremental_end == INVALID_POINT) {
+		return; // There is no search to update.
+	}
+
+	if (p_index >= incremental_states.size()) {
+		incremental_states.resize(points.size());
+	}
+
+	IncrementalState &state = incremental_states[p_index];
+	if (!state.dirty) {
+		state.dirty = true;
+		incremental_dirty_points.push_back(p_index);
+	}
+}
+
+void AStar3D::_mark_incremental_predecessors_dirty(uint32_t p_index) {
+	if (incremental_end == INVALID_POINT) {
+		return;
+	}
 
-			bool new_point = false;
+	// The costs of moving into the point changed, which only affects the points it can be reached from.
+	for (uint32_t from : points[p_index].incoming) {
+		_mark_incremental_dirty(from);
+	}
+}
+
+void AStar3D::_push_incremental(uint32_t p_index, real_t p_key_first, real_t p_key_second) {
+	IncrementalState &state = incremental_states[p_index];
+	if (!state.open) {
+		state.open = true;
+		incremental_open_count++;
+	}
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+	// Entries with an older version are skipped once they reach the top of the open list.
+	state.open_version++;
+	state.key_first = p_key_first;
+	state.key_second = p_key_second;
+
+	IncrementalOpenPoint entry;
+	entry.key_first = p_key_first;
+	entry.key_second = p_key_second;
+	entry.index = p_index;
+	entry.version = state.open_version;
+
+	SortArray<IncrementalOpenPoint, SortIncrementalOpenPoints> sorter;
+	incremental_open_list.push_back(entry);
+	sorter.push_heap(0, incremental_open_list.size() - 1, 0, entry, incremental_open_list.ptr());
+}
+
+bool AStar3D::_get_incremental_top(IncrementalOpenPoint &r_top) {
+	SortArray<IncrementalOpenPoint, SortIncrementalOpenPoints> sorter;
+
+	while (!incremental_open_list.is_empty()) {
+		const IncrementalOpenPoint &top = incremental_open_list[0];
+		const IncrementalState &state = incremental_states[top.index];
+		if (state.open && state.open_version == top.version) {
+			r_top = top;
+			return true;
+		}
+
+		sorter.pop_heap(0, incremental_open_list.size(), incremental_open_list.ptr());
+		incremental_open_list.remove_at(incremental_open_list.size() - 1);
+	}
+
+	return false;
+}
+
+void AStar3D::_compact_incremental_open_list() {
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < incremental_open_list.size(); i++) {
+		const IncrementalOpenPoint entry = incremental_open_list[i];
+		const IncrementalState &state = incremental_states[entry.index];
+		if (state.open && state.open_version == entry.version) {
+			incremental_open_list[count++] = entry;
+		}
+	}
+	incremental_open_list.resize(count);
+
+	SortArray<IncrementalOpenPoint, SortIncrementalOpenPoints> sorter;
+	for (uint32_t i = 1; i < count; i++) {
+		sorter.push_heap(0, i, 0, incremental_open_list[i], incremental_open_list.ptr());
+	}
+}
+
+template <class T>
+real_t AStar3D::_get_incremental_edge_cost(T *p_owner, uint32_t p_from, uint32_t p_to) {
+	const Point &to_point = points[p_to];
+	if (!to_point.enabled) {
+		return INFINITY;
+	}
+	return p_owner->_compute_cost(points[p_from].id, to_point.id) * to_point.weight_scale;
+}
+
+template <class T>
+void AStar3D::_get_incremental_key(T *p_owner, uint32_t p_index, real_t &r_key_first, real_t &r_key_second) {
+	const IncrementalState &state = incremental_states[p_index];
+	r_key_second = MIN(state.g_score, state.rhs_score);
+	r_key_first = r_key_second + p_owner->_estimate_cost(points[incremental_begin].id, points[p_index].id) + incremental_key_modifier;
+}
+
+template <class T>
+void AStar3D::_queue_incremental_point(T *p_owner, uint32_t p_index) {
+	IncrementalState &state = incremental_states[p_index];
+	if (state.g_score != state.rhs_score) {
+		real_t key_first, key_second;
+		_get_incremental_key(p_owner, p_index, key_first, key_second);
+		_push_incremental(p_index, key_first, key_second);
+	} else if (state.open) {
+		state.open = false;
+		incremental_open_count--;
+	}
+}
+
+template <class T>
+void AStar3D::_update_incremental_point(T *p_owner, uint32_t p_index) {
+	if (p_index != incremental_end) {
+		real_t rhs_score = INFINITY;
+		for (uint32_t to : points[p_index].neighbors) {
+			const real_t g_score = incremental_states[to].g_score;
+			if (g_score == INFINITY) {
 				continue;
 			}
+			rhs_score = MIN(rhs_score, _get_incremental_edge_cost(p_owner, p_index, to) + g_score);
+		}
+		incremental_states[p_index].rhs_score = rhs_score;
+	}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
+	_queue_incremental_point(p_owner, p_index);
+}
+
+template <class T>
+bool AStar3D::_solve_incremental(T *p_owner, uint32_t p_begin_point, uint32_t p_end_point, LocalVector<uint32_t> &r_path) {
+	if (!points[p_end_point].enabled) {
+		return false;
+	}
 
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+	if (p_end_point != incremental_end) {
+		// Nothing can be reused when searching towards another point.
+		_reset_incremental_search();
+		incremental_states.resize(points.size());
+		incremental_begin = p_begin_point;
+		incremental_end = p_end_point;
+		incremental_states[p_end_point].rhs_score = 0;
+		_queue_incremental_point(p_owner, p_end_point);
+	} else {
+		if (incremental_states.size() < points.size()) {
+			incremental_states.resize(points.size());
+		}
+
+		if (p_begin_point != incremental_begin) {
+			// Keys computed for the previous begin point stay lower bounds of the current ones once this is added to them.
+			incremental_key_modifier += p_owner->_estimate_cost(points[incremental_begin].id, points[p_begin_point].id);
+			incremental_begin = p_begin_point;
+		}
+
+		for (uint32_t index : incremental_dirty_points) {
+			incremental_states[index].dirty = false;
+			if (points[index].valid) {
+				_update_incremental_point(p_owner, index);
+			}
+		}
+		incremental_dirty_points.clear();
+
+		if (incremental_open_list.size() > incremental_open_count * 4 + 64) {
+			_compact_incremental_open_list();
+		}
+	}
+
+	SortIncrementalOpenPoints compare;
+	IncrementalOpenPoint top;
+
+	while (_get_incremental_top(top)) {
+		const IncrementalState &begin_state = incremental_states[p_begin_point];
+
+		// The estimate from the begin point to itself is zero.
+		IncrementalOpenPoint begin;
+		begin.key_second = MIN(begin_state.g_score, begin_state.rhs_score);
+		begin.key_first = begin.key_second + incremental_key_modifier;
+		if (!compare(begin, top) && begin_state.g_score == begin_state.rhs_score) {
+			break; // The begin point is consistent and no other point can lower its score.
+		}
+
+		const uint32_t u = top.index;
+		IncrementalState &state = incremental_states[u];
+
+		IncrementalOpenPoint current;
+		_get_incremental_key(p_owner, u, current.key_first, current.key_second);
+
+		if (compare(current, top)) {
+			_push_incremental(u, current.key_first, current.key_second); // The key was computed for an older begin point.
+		} else if (state.g_score > state.rhs_score) {
+			state.g_score = state.rhs_score;
+			state.open = false;
+			incremental_open_count--;
+
+			for (uint32_t from : points[u].incoming) {
+				if (from == p_end_point) {
+					continue;
+				}
+
+				IncrementalState &from_state = incremental_states[from];
+				const real_t rhs_score = _get_incremental_edge_cost(p_owner, from, u) + state.g_score;
+				if (rhs_score < from_state.rhs_score) {
+					from_state.rhs_score = rhs_score;
+					_queue_incremental_point(p_owner, from);
+				}
+			}
+		} else {
+			state.g_score = INFINITY;
+			_update_incremental_point(p_owner, u);
+			for (uint32_t from : points[u].incoming) {
+				_update_incremental_point(p_owner, from);
 			}
 		}
 	}
 
-	return found_route;
+	if (incremental_states[p_begin_point].g_score == INFINITY) {
+		return false;
+	}
+
+	// Follow the lowest scores from the begin point to the end point.
+	r_path.clear();
+	r_path.push_back(p_begin_point);
+
+	uint32_t current = p_begin_point;
+	while (current != p_end_point) {
+		uint32_t next = INVALID_POINT;
+		real_t next_score = INFINITY;
+
+		for (uint32_t to : points[current].neighbors) {
+			const real_t g_score = incremental_states[to].g_score;
+			if (g_score == INFINITY) {
+				continue;
+			}
+
+			const real_t score = _get_incremental_edge_cost(p_owner, current, to) + g_score;
+			if (score < next_score) {
+				next = to;
+				next_score = score;
+			}
+		}
+
+		if (next == INVALID_POINT || r_path.size() > points.size()) {
+			// Estimates that are not consistent with the costs can leave the scores without a path to follow.
+			r_path.clear();
+			if (!_solve(p_owner, p_begin_point, p_end_point)) {
+				return false;
+			}
+			_get_solved_path(p_begin_point, p_end_point, r_path);
+			return true;
+		}
+
+		current = next;
+		r_path.push_back(current);
+	}
+
+	return true;
+}
+
+template <class T>
+bool AStar3D::_find_path(T *p_owner, uint32_t p_begin_point, uint32_t p_end_point, LocalVector<uint32_t> &r_path) {
+	r_path.clear();
+
+	if (p_begin_point == p_end_point) {
+		r_path.push_back(p_begin_point);
+		return true;
+	}
+
+	if (incremental_search_enabled) {
+		return _solve_incremental(p_owner, p_begin_point, p_end_point, r_path);
+	}
+
+	if (!_solve(p_owner, p_begin_point, p_end_point)) {
+		return false;
+	}
+
+	_get_solved_path(p_begin_point, p_end_point, r_path);
+	return true;
+}
+
+template <class T>
+TypedArray<PackedInt64Array> AStar3D::_get_id_paths(T *p_owner, const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids) {
+	ERR_FAIL_COND_V_MSG(p_from_ids.size() != p_to_ids.size(), TypedArray<PackedInt64Array>(), vformat("Can't get id paths. The number of begin points (%d) doesn't match the number of end points (%d).", p_from_ids.size(), p_to_ids.size()));
+
+	TypedArray<PackedInt64Array> paths;
+	LocalVector<uint32_t> route;
+
+	for (int i = 0; i < p_from_ids.size(); i++) {
+		PackedInt64Array path;
+
+		uint32_t a;
+		bool from_exists = point_indices.lookup(p_from_ids[i], a);
+		uint32_t b;
+		bool to_exists = point_indices.lookup(p_to_ids[i], b);
+
+		if (!from_exists) {
+			ERR_PRINT(vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_ids[i]));
+		} else if (!to_exists) {
+			ERR_PRINT(vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_ids[i]));
+		} else if (_find_path(p_owner, a, b, route)) {
+			path.resize(route.size());
+			int64_t *w = path.ptrw();
+			for (uint32_t j = 0; j < route.size(); j++) {
+				w[j] = points[route[j]].id;
+			}
+		}
+
+		paths.push_back(path);
+	}
+
+	return paths;
 }
 
 real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_to_id) {
@@ -386,15 +844,15 @@ real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_to_id) {
 		return scost;
 	}
 
-	Point *from_point;
-	bool from_exists = points.lookup(p_from_id, from_point);
+	uint32_t from_index;
+	bool from_exists = point_indices.lookup(p_from_id, from_index);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
 
-	Point *to_point;
-	bool to_exists = points.lookup(p_to_id, to_point);
+	uint32_t to_index;
+	bool to_exists = point_indices.lookup(p_to_id, to_index);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_to_id));
 
-	return from_point->pos.distance_to(to_point->pos);
+	return points[from_index].pos.distance_to(points[to_index].pos);
 }
 
 real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
@@ -403,129 +861,88 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 		return scost;
 	}
 
-	Point *from_point;
-	bool from_exists = points.lookup(p_from_id, from_point);
+	uint32_t from_index;
+	bool from_exists = point_indices.lookup(p_from_id, from_index);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
 
-	Point *to_point;
-	bool to_exists = points.lookup(p_to_id, to_point);
+	uint32_t to_index;
+	bool to_exists = point_indices.lookup(p_to_id, to_index);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_to_id));
 
-	return from_point->pos.distance_to(to_point->pos);
+	return points[from_index].pos.distance_to(points[to_index].pos);
 }
 
 Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id) {
-	Point *a;
-	bool from_exists = points.lookup(p_from_id, a);
+	uint32_t a;
+	bool from_exists = point_indices.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
 
-	Point *b;
-	bool to_exists = points.lookup(p_to_id, b);
+	uint32_t b;
+	bool to_exists = point_indices.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Vector<Vector3> ret;
-		ret.push_back(a->pos);
-		return ret;
-	}
-
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
+	LocalVector<uint32_t> route;
+	if (!_find_path(this, a, b, route)) {
 		return Vector<Vector3>();
 	}
 
-	Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<Vector3> path;
-	path.resize(pc);
+	path.resize(route.size());
 
-	{
-		Vector3 *w = path.ptrw();
-
-		Point *p2 = end_point;
-		int64_t idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = p2->pos;
-			p2 = p2->prev_point;
-		}
-
-		w[0] = p2->pos; // Assign first
+	Vector3 *w = path.ptrw();
+	for (uint32_t i = 0; i < route.size(); i++) {
+		w[i] = points[route[i]].pos;
 	}
 
 	return path;
 }
 
 Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id) {
-	Point *a;
-	bool from_exists = points.lookup(p_from_id, a);
+	uint32_t a;
+	bool from_exists = point_indices.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
 
-	Point *b;
-	bool to_exists = points.lookup(p_to_id, b);
+	uint32_t b;
+	bool to_exists = point_indices.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Vector<int64_t> ret;
-		ret.push_back(a->id);
-		return ret;
-	}
-
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
+	LocalVector<uint32_t> route;
+	if (!_find_path(this, a, b, route)) {
 		return Vector<int64_t>();
 	}
 
-	Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<int64_t> path;
-	path.resize(pc);
-
-	{
-		int64_t *w = path.ptrw();
-
-		p = end_point;
-		int64_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
-		}
+	path.resize(route.size());
 
-		w[0] = p->id; // Assign first
+	int64_t *w = path.ptrw();
+	for (uint32_t i = 0; i < route.size(); i++) {
+		w[i] = points[route[i]].id;
 	}
 
 	return path;
 }
 
+TypedArray<PackedInt64Array> AStar3D::get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids) {
+	return _get_id_paths(this, p_from_ids, p_to_ids);
+}
+
 void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
-	Point *p;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t index;
+	bool p_exists = point_indices.lookup(p_id, index);
 	ERR_FAIL_COND_MSG(!p_exists, vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
 
-	p->enabled = !p_disabled;
+	if (points[index].enabled == p_disabled) {
+		points[index].enabled = !p_disabled;
+		_mark_incremental_predecessors_dirty(index);
+	}
 }
 
 bool AStar3D::is_point_disabled(int64_t p_id) const {
-	Point *p;
-	bool p_exists = points.lookup(p_id, p);
+	uint32_t index;
+	bool p_exists = point_indices.lookup(p_id, index);
 	ERR_FAIL_COND_V_MSG(!p_exists, false, vformat("Can't get if point is disabled. Point with id: %d doesn't exist.", p_id));
 
-	return !p->enabled;
+	return !points[index].enabled;
 }
 
 void AStar3D::_bind_methods() {
@@ -552,11 +969,17 @@ void AStar3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("reserve_space", "num_nodes"), &AStar3D::reserve_space);
 	ClassDB::bind_method(D_METHOD("clear"), &AStar3D::clear);
 
+	ClassDB::bind_method(D_METHOD("set_incremental_search_enabled", "enabled"), &AStar3D::set_incremental_search_enabled);
+	ClassDB::bind_method(D_METHOD("is_incremental_search_enabled"), &AStar3D::is_incremental_search_enabled);
+
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar3D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar3D::get_closest_position_in_segment);
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStar3D::get_point_path);
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStar3D::get_id_path);
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids"), &AStar3D::get_id_paths);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "incremental_search_enabled"), "set_incremental_search_enabled", "is_incremental_search_enabled");
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -645,6 +1068,14 @@ void AStar2D::reserve_space(int64_t p_num_nodes) {
 	astar.reserve_space(p_num_nodes);
 }
 
+void AStar2D::set_incremental_search_enabled(bool p_enabled) {
+	astar.set_incremental_search_enabled(p_enabled);
+}
+
+bool AStar2D::is_incremental_search_enabled() const {
+	return astar.is_incremental_search_enabled();
+}
+
 int64_t AStar2D::get_closest_point(const Vector2 &p_point, bool p_include_disabled) const {
 	return astar.get_closest_point(Vector3(p_point.x, p_point.y, 0), p_include_disabled);
 }
@@ -660,15 +1091,15 @@ real_t AStar2D::_estimate_cost(int64_t p_from_id, int64_t p_to_id) {
 		return scost;
 	}
 
-	AStar3D::Point *from_point;
-	bool from_exists = astar.points.lookup(p_from_id, from_point);
+	uint32_t from_index;
+	bool from_exists = astar.point_indices.lookup(p_from_id, from_index);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
 
-	AStar3D::Point *to_point;
-	bool to_exists = astar.points.lookup(p_to_id, to_point);
+	uint32_t to_index;
+	bool to_exists = astar.point_indices.lookup(p_to_id, to_index);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_to_id));
 
-	return from_point->pos.distance_to(to_point->pos);
+	return astar.points[from_index].pos.distance_to(astar.points[to_index].pos);
 }
 
 real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
@@ -677,174 +1108,70 @@ real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 		return scost;
 	}
 
-	AStar3D::Point *from_point;
-	bool from_exists = astar.points.lookup(p_from_id, from_point);
+	uint32_t from_index;
+	bool from_exists = astar.point_indices.lookup(p_from_id, from_index);
 	ERR_FAIL_COND_V_MSG(!from_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
 
-	AStar3D::Point *to_point;
-	bool to_exists = astar.points.lookup(p_to_id, to_point);
+	uint32_t to_index;
+	bool to_exists = astar.point_indices.lookup(p_to_id, to_index);
 	ERR_FAIL_COND_V_MSG(!to_exists, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_to_id));
 
-	return from_point->pos.distance_to(to_point->pos);
+	return astar.points[from_index].pos.distance_to(astar.points[to_index].pos);
 }
 
 Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id) {
-	AStar3D::Point *a;
-	bool from_exists = astar.points.lookup(p_from_id, a);
+	uint32_t a;
+	bool from_exists = astar.point_indices.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
 
-	AStar3D::Point *b;
-	bool to_exists = astar.points.lookup(p_to_id, b);
+	uint32_t b;
+	bool to_exists = astar.point_indices.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Vector<Vector2> ret = { Vector2(a->pos.x, a->pos.y) };
-		return ret;
-	}
-
-	AStar3D::Point *begin_point = a;
-	AStar3D::Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
+	LocalVector<uint32_t> route;
+	if (!astar._find_path(this, a, b, route)) {
 		return Vector<Vector2>();
 	}
 
-	AStar3D::Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<Vector2> path;
-	path.resize(pc);
+	path.resize(route.size());
 
-	{
-		Vector2 *w = path.ptrw();
-
-		AStar3D::Point *p2 = end_point;
-		int64_t idx = pc - 1;
-		while (p2 != begin_point) {
-			w[idx--] = Vector2(p2->pos.x, p2->pos.y);
-			p2 = p2->prev_point;
-		}
-
-		w[0] = Vector2(p2->pos.x, p2->pos.y); // Assign first
+	Vector2 *w = path.ptrw();
+	for (uint32_t i = 0; i < route.size(); i++) {
+		const Vector3 &pos = astar.points[route[i]].pos;
+		w[i] = Vector2(pos.x, pos.y);
 	}
 
 	return path;
 }
 
 Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id) {
-	AStar3D::Point *a;
-	bool from_exists = astar.points.lookup(p_from_id, a);
+	uint32_t a;
+	bool from_exists = astar.point_indices.lookup(p_from_id, a);
 	ERR_FAIL_COND_V_MSG(!from_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
 
-	AStar3D::Point *b;
-	bool to_exists = astar.points.lookup(p_to_id, b);
+	uint32_t b;
+	bool to_exists = astar.point_indices.lookup(p_to_id, b);
 	ERR_FAIL_COND_V_MSG(!to_exists, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
 
-	if (a == b) {
-		Vector<int64_t> ret;
-		ret.push_back(a->id);
-		return ret;
-	}
-
-	AStar3D::Point *begin_point = a;
-	AStar3D::Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
+	LocalVector<uint32_t> route;
+	if (!astar._find_path(this, a, b, route)) {
 		return Vector<int64_t>();
 	}
 
-	AStar3D::Point *p = end_point;
-	int64_t pc = 1; // Begin point
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<int64_t> path;
-	path.resize(pc);
-
-	{
-		int64_t *w = path.ptrw();
-
-		p = end_point;
-		int64_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->id;
-			p = p->prev_point;
-		}
+	path.resize(route.size());
 
-		w[0] = p->id; // Assign first
+	int64_t *w = path.ptrw();
+	for (uint32_t i = 0; i < route.size(); i++) {
+		w[i] = astar.points[route[i]].id;
 	}
 
 	return path;
 }
 
-bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point) {
-	astar.pass++;
-
-	if (!end_point->enabled) {
-		return false;
-	}
-
-	bool found_route = false;
-
-	LocalVector<AStar3D::Point *> open_list;
-	SortArray<AStar3D::Point *, AStar3D::SortPoints> sorter;
-
-	begin_point->g_score = 0;
-	begin_point->f_score = _estimate_cost(begin_point->id, end_point->id);
-	open_list.push_back(begin_point);
-
-	while (!open_list.is_empty()) {
-		AStar3D::Point *p = open_list[0]; // The currently processed point.
-
-		if (p == end_point) {
-			found_route = true;
-			break;
-		}
-
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = astar.pass; // Mark the point as closed.
-
-		for (OAHashMap<int64_t, AStar3D::Point *>::Iterator it = p->neighbors.iter(); it.valid; it = p->neighbors.next_iter(it)) {
-			AStar3D::Point *e = *(it.value); // The neighbor point.
-
-			if (!e->enabled || e->closed_pass == astar.pass) {
-				continue;
-			}
-
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * e->weight_scale;
-
-			bool new_point = false;
-
-			if (e->open_pass != astar.pass) { // The point wasn't inside the open list.
-				e->open_pass = astar.pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
-				continue;
-			}
-
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, end_point->id);
-
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
-			}
-		}
-	}
-
-	return found_route;
+TypedArray<PackedInt64Array> AStar2D::get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids) {
+	return astar._get_id_paths(this, p_from_ids, p_to_ids);
 }
 
 void AStar2D::_bind_methods() {
@@ -871,11 +1198,17 @@ void AStar2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("reserve_space", "num_nodes"), &AStar2D::reserve_space);
 	ClassDB::bind_method(D_METHOD("clear"), &AStar2D::clear);
 
+	ClassDB::bind_method(D_METHOD("set_incremental_search_enabled", "enabled"), &AStar2D::set_incremental_search_enabled);
+	ClassDB::bind_method(D_METHOD("is_incremental_search_enabled"), &AStar2D::is_incremental_search_enabled);
+
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar2D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar2D::get_closest_position_in_segment);
 
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id"), &AStar2D::get_point_path);
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id"), &AStar2D::get_id_path);
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids"), &AStar2D::get_id_paths);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "incremental_search_enabled"), "set_incremental_search_enabled", "is_incremental_search_enabled");
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "to_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
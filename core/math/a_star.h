@@ -34,7 +34,9 @@
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
+#include "core/variant/typed_array.h"
 
 /**
 	A* pathfinding algorithm.
@@ -44,6 +46,8 @@ class AStar3D : public RefCounted {
 	GDCLASS(AStar3D, RefCounted);
 	friend class AStar2D;
 
+	// Points are stored contiguously and referenced by their index in the storage, which is
+	// looked up from their ID only once per query. Indices of removed points are reused.
 	struct Point {
 		Point() {}
 
@@ -51,28 +55,10 @@ class AStar3D : public RefCounted {
 		Vector3 pos;
 		real_t weight_scale = 0;
 		bool enabled = false;
+		bool valid = false;
 
-		OAHashMap<int64_t, Point *> neighbors = 4u;
-		OAHashMap<int64_t, Point *> unlinked_neighbours = 4u;
-
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
-		real_t g_score = 0;
-		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
-	};
-
-	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
-				return true;
-			} else if (A->f_score < B->f_score) {
-				return false;
-			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
-			}
-		}
+		LocalVector<uint32_t> neighbors; // Points that can be reached from this point.
+		LocalVector<uint32_t> incoming; // Points this point can be reached from.
 	};
 
 	struct Segment {
@@ -105,13 +91,120 @@ class AStar3D : public RefCounted {
 		}
 	};
 
+	// Used for pathfinding, kept apart from the points so that searches touch as little memory as possible.
+	struct PointState {
+		uint32_t prev_point = 0;
+		uint32_t open_pass = 0;
+		uint32_t closed_pass = 0;
+		real_t g_score = 0;
+	};
+
+	struct OpenPoint {
+		real_t f_score = 0;
+		real_t g_score = 0;
+		uint32_t index = 0;
+	};
+
+	struct SortOpenPoints {
+		_FORCE_INLINE_ bool operator()(const OpenPoint &A, const OpenPoint &B) const { // Returns true when the Point A is worse than Point B.
+			if (A.f_score > B.f_score) {
+				return true;
+			} else if (A.f_score < B.f_score) {
+				return false;
+			} else {
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+			}
+		}
+	};
+
+	// Used by the incremental search (D* Lite). It searches backwards from the end point, so its
+	// results remain valid when the begin point moves, and only the points affected by changes
+	// to the graph are updated before the next query.
+	struct IncrementalState {
+		real_t g_score = INFINITY;
+		real_t rhs_score = INFINITY;
+		real_t key_first = 0;
+		real_t key_second = 0;
+		uint32_t open_version = 0;
+		bool open = false;
+		bool dirty = false;
+	};
+
+	struct IncrementalOpenPoint {
+		real_t key_first = 0;
+		real_t key_second = 0;
+		uint32_t index = 0;
+		uint32_t version = 0;
+	};
+
+	struct SortIncrementalOpenPoints {
+		_FORCE_INLINE_ bool operator()(const IncrementalOpenPoint &A, const IncrementalOpenPoint &B) const { // Returns true when the Point A is worse than Point B.
+			if (A.key_first > B.key_first) {
+				return true;
+			} else if (A.key_first < B.key_first) {
+				return false;
+			} else {
+				return A.key_second > B.key_second;
+			}
+		}
+	};
+
+	static const uint32_t INVALID_POINT = UINT32_MAX;
+
 	int64_t last_free_id = 0;
-	uint64_t pass = 1;
 
-	OAHashMap<int64_t, Point *> points;
+	LocalVector<Point> points;
+	LocalVector<uint32_t> free_points;
+	OAHashMap<int64_t, uint32_t> point_indices;
 	HashSet<Segment, Segment> segments;
 
-	bool _solve(Point *begin_point, Point *end_point);
+	LocalVector<PointState> point_states;
+	LocalVector<OpenPoint> open_list;
+	uint32_t pass = 0;
+
+	bool incremental_search_enabled = false;
+	LocalVector<IncrementalState> incremental_states;
+	LocalVector<IncrementalOpenPoint> incremental_open_list;
+	LocalVector<uint32_t> incremental_dirty_points;
+	uint32_t incremental_open_count = 0;
+	uint32_t incremental_begin = INVALID_POINT;
+	uint32_t incremental_end = INVALID_POINT;
+	real_t incremental_key_modifier = 0;
+
+	_FORCE_INLINE_ bool _get_point_index(int64_t p_id, uint32_t &r_index) const {
+		return point_indices.lookup(p_id, r_index);
+	}
+
+	void _add_edge(uint32_t p_from, uint32_t p_to);
+	void _remove_edge(uint32_t p_from, uint32_t p_to);
+	void _update_segment(uint32_t p_first, uint32_t p_second, unsigned char p_old_direction, unsigned char p_new_direction);
+
+	// The search routines take the object whose cost functions are used, which is the AStar2D when called from it.
+	void _begin_pass();
+	template <class T>
+	bool _solve(T *p_owner, uint32_t p_begin_point, uint32_t p_end_point);
+	void _get_solved_path(uint32_t p_begin_point, uint32_t p_end_point, LocalVector<uint32_t> &r_path) const;
+	template <class T>
+	bool _find_path(T *p_owner, uint32_t p_begin_point, uint32_t p_end_point, LocalVector<uint32_t> &r_path);
+	template <class T>
+	TypedArray<PackedInt64Array> _get_id_paths(T *p_owner, const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids);
+
+	void _reset_incremental_search();
+	void _mark_incremental_dirty(uint32_t p_index);
+	void _mark_incremental_predecessors_dirty(uint32_t p_index);
+	void _push_incremental(uint32_t p_index, real_t p_key_first, real_t p_key_second);
+	bool _get_incremental_top(IncrementalOpenPoint &r_top);
+	void _compact_incremental_open_list();
+	template <class T>
+	real_t _get_incremental_edge_cost(T *p_owner, uint32_t p_from, uint32_t p_to);
+	template <class T>
+	void _get_incremental_key(T *p_owner, uint32_t p_index, real_t &r_key_first, real_t &r_key_second);
+	template <class T>
+	void _queue_incremental_point(T *p_owner, uint32_t p_index);
+	template <class T>
+	void _update_incremental_point(T *p_owner, uint32_t p_index);
+	template <class T>
+	bool _solve_incremental(T *p_owner, uint32_t p_begin_point, uint32_t p_end_point, LocalVector<uint32_t> &r_path);
 
 protected:
 	static void _bind_methods();
@@ -147,11 +240,15 @@ public:
 	void reserve_space(int64_t p_num_nodes);
 	void clear();
 
+	void set_incremental_search_enabled(bool p_enabled);
+	bool is_incremental_search_enabled() const;
+
 	int64_t get_closest_point(const Vector3 &p_point, bool p_include_disabled = false) const;
 	Vector3 get_closest_position_in_segment(const Vector3 &p_point) const;
 
 	Vector<Vector3> get_point_path(int64_t p_from_id, int64_t p_to_id);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id);
+	TypedArray<PackedInt64Array> get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids);
 
 	AStar3D() {}
 	~AStar3D();
@@ -159,9 +256,9 @@ public:
 
 class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
-	AStar3D astar;
+	friend class AStar3D;
 
-	bool _solve(AStar3D::Point *begin_point, AStar3D::Point *end_point);
+	AStar3D astar;
 
 protected:
 	static void _bind_methods();
@@ -197,11 +294,15 @@ public:
 	void reserve_space(int64_t p_num_nodes);
 	void clear();
 
+	void set_incremental_search_enabled(bool p_enabled);
+	bool is_incremental_search_enabled() const;
+
 	int64_t get_closest_point(const Vector2 &p_point, bool p_include_disabled = false) const;
 	Vector2 get_closest_position_in_segment(const Vector2 &p_point) const;
 
 	Vector<Vector2> get_point_path(int64_t p_from_id, int64_t p_to_id);
 	Vector<int64_t> get_id_path(int64_t p_from_id, int64_t p_to_id);
+	TypedArray<PackedInt64Array> get_id_paths(const PackedInt64Array &p_from_ids, const PackedInt64Array &p_to_ids);
 
 	AStar2D() {}
 	~AStar2D() {}
@@ -32,8 +32,6 @@
 
 #include "core/variant/typed_array.h"
 
-#define GET_POINT_UNCHECKED(m_id) points[m_id.y - region.position.y][m_id.x - region.position.x]
-
 static real_t heuristic_euclidian(const Vector2i &p_from, const Vector2i &p_to) {
 	real_t dx = (real_t)ABS(p_to.x - p_from.x);
 	real_t dy = (real_t)ABS(p_to.y - p_from.y);
@@ -109,16 +107,21 @@ Size2 AStarGrid2D::get_cell_size() const {
 }
 
 void AStarGrid2D::update() {
-	points.clear();
-	const int64_t end_x = region.position.x + region.size.width;
-	const int64_t end_y = region.position.y + region.size.height;
-	for (int64_t y = region.position.y; y < end_y; y++) {
-		LocalVector<Point> line;
-		for (int64_t x = region.position.x; x < end_x; x++) {
-			line.push_back(Point(Vector2i(x, y), offset + Vector2(x, y) * cell_size));
-		}
-		points.push_back(line);
+	const int64_t point_count = int64_t(region.size.width) * region.size.height;
+	ERR_FAIL_COND_MSG(point_count >= INVALID_POINT, vformat("Grid region %s has too many points.", region));
+
+	solid_mask.reset();
+	solid_mask.resize((point_count + 63) / 64);
+	if (!solid_mask.is_empty()) {
+		memset(solid_mask.ptr(), 0, solid_mask.size() * sizeof(uint64_t));
 	}
+	weight_scales.reset();
+	point_states.reset();
+	abstract_nodes.reset();
+	cluster_nodes.reset();
+	abstract_states.reset();
+	abstract_graph_dirty = true;
+	search_region = region;
 	dirty = false;
 }
 
@@ -144,7 +147,10 @@ bool AStarGrid2D::is_jumping_enabled() const {
 
 void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
 	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
-	diagonal_mode = p_diagonal_mode;
+	if (diagonal_mode != p_diagonal_mode) {
+		diagonal_mode = p_diagonal_mode;
+		abstract_graph_dirty = true;
+	}
 }
 
 AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
@@ -153,7 +159,10 @@ AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
 
 void AStarGrid2D::set_default_compute_heuristic(Heuristic p_heuristic) {
 	ERR_FAIL_INDEX((int)p_heuristic, (int)HEURISTIC_MAX);
-	default_compute_heuristic = p_heuristic;
+	if (default_compute_heuristic != p_heuristic) {
+		default_compute_heuristic = p_heuristic;
+		abstract_graph_dirty = true;
+	}
 }
 
 AStarGrid2D::Heuristic AStarGrid2D::get_default_compute_heuristic() const {
@@ -169,29 +178,49 @@ AStarGrid2D::Heuristic AStarGrid2D::get_default_estimate_heuristic() const {
 	return default_estimate_heuristic;
 }
 
+void AStarGrid2D::set_hierarchical_enabled(bool p_enabled) {
+	hierarchical_enabled = p_enabled;
+}
+
+bool AStarGrid2D::is_hierarchical_enabled() const {
+	return hierarchical_enabled;
+}
+
+void AStarGrid2D::set_cluster_size(int p_cluster_size) {
+	ERR_FAIL_COND_MSG(p_cluster_size < 2, vformat("Can't set cluster size less than 2: %d.", p_cluster_size));
+	if (cluster_size != p_cluster_size) {
+		cluster_size = p_cluster_size;
+		abstract_graph_dirty = true;
+	}
+}
+
+int AStarGrid2D::get_cluster_size() const {
+	return cluster_size;
+}
+
 void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is disabled. Point %s out of bounds %s.", p_id, region));
-	GET_POINT_UNCHECKED(p_id).solid = p_solid;
+	_set_solid(_get_index(p_id.x, p_id.y), p_solid);
 }
 
 bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, false, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), false, vformat("Can't get if point is disabled. Point %s out of bounds %s.", p_id, region));
-	return GET_POINT_UNCHECKED(p_id).solid;
+	return _is_solid(_get_index(p_id.x, p_id.y));
 }
 
 void AStarGrid2D::set_point_weight_scale(const Vector2i &p_id, real_t p_weight_scale) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set point's weight scale. Point %s out of bounds %s.", p_id, region));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
-	GET_POINT_UNCHECKED(p_id).weight_scale = p_weight_scale;
+	_set_weight_scale(_get_index(p_id.x, p_id.y), p_weight_scale);
 }
 
 real_t AStarGrid2D::get_point_weight_scale(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, 0, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), 0, vformat("Can't get point's weight scale. Point %s out of bounds %s.", p_id, region));
-	return GET_POINT_UNCHECKED(p_id).weight_scale;
+	return _get_weight_scale(_get_index(p_id.x, p_id.y));
 }
 
 void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
@@ -203,9 +232,9 @@ void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
 	int end_x = safe_region.get_end().x;
 	int end_y = safe_region.get_end().y;
 
-	for (int x = from_x; x < end_x; x++) {
-		for (int y = from_y; y < end_y; y++) {
-			GET_POINT_UNCHECKED(Vector2i(x, y)).solid = p_solid;
+	for (int y = from_y; y < end_y; y++) {
+		for (int x = from_x; x < end_x; x++) {
+			_set_solid(_get_index(x, y), p_solid);
 		}
 	}
 }
@@ -219,163 +248,166 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 	int from_y = safe_region.get_position().y;
 	int end_x = safe_region.get_end().x;
 	int end_y = safe_region.get_end().y;
-	for (int x = from_x; x < end_x; x++) {
-		for (int y = from_y; y < end_y; y++) {
-			GET_POINT_UNCHECKED(Vector2i(x, y)).weight_scale = p_weight_scale;
+	for (int y = from_y; y < end_y; y++) {
+		for (int x = from_x; x < end_x; x++) {
+			_set_weight_scale(_get_index(x, y), p_weight_scale);
 		}
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
-	if (!p_to || p_to->solid) {
-		return nullptr;
+void AStarGrid2D::_set_solid(uint32_t p_index, bool p_solid) {
+	uint64_t &word = solid_mask[p_index >> 6];
+	const uint64_t bit = uint64_t(1) << (p_index & 63);
+	const uint64_t new_word = p_solid ? (word | bit) : (word & ~bit);
+	if (new_word != word) {
+		word = new_word;
+		abstract_graph_dirty = true;
+	}
+}
+
+void AStarGrid2D::_set_weight_scale(uint32_t p_index, real_t p_weight_scale) {
+	if (weight_scales.is_empty()) {
+		if (p_weight_scale == 1.0) {
+			return;
+		}
+		weight_scales.resize(region.size.width * region.size.height);
+		for (real_t &weight_scale : weight_scales) {
+			weight_scale = 1.0;
+		}
 	}
-	if (p_to == end) {
-		return p_to;
+	if (weight_scales[p_index] != p_weight_scale) {
+		weight_scales[p_index] = p_weight_scale;
+		abstract_graph_dirty = true;
 	}
+}
 
-	int64_t from_x = p_from->id.x;
-	int64_t from_y = p_from->id.y;
+uint32_t AStarGrid2D::_jump(int64_t p_from_x, int64_t p_from_y, int64_t p_to_x, int64_t p_to_y) const {
+	const int64_t dx = p_to_x - p_from_x;
+	const int64_t dy = p_to_y - p_from_y;
 
-	int64_t to_x = p_to->id.x;
-	int64_t to_y = p_to->id.y;
+	int64_t to_x = p_to_x;
+	int64_t to_y = p_to_y;
 
-	int64_t dx = to_x - from_x;
-	int64_t dy = to_y - from_y;
+	// Keeps moving in the same direction until a jump point is found, only jumps branching off of a diagonal recurse.
+	while (true) {
+		if (!_is_walkable(to_x, to_y)) {
+			return INVALID_POINT;
+		}
+		const uint32_t to = _get_index(to_x, to_y);
+		if (to == end) {
+			return to;
+		}
 
-	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
-		if (dx != 0 && dy != 0) {
-			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
-			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x + dx, to_y + 1) && !_is_walkable(to_x, to_y + 1)) || (_is_walkable(to_x + dx, to_y - 1) && !_is_walkable(to_x, to_y - 1))) {
-					return p_to;
+		if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
+			if (dx != 0 && dy != 0) {
+				if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
+					return to;
+				}
+				if (_jump(to_x, to_y, to_x + dx, to_y) != INVALID_POINT) {
+					return to;
+				}
+				if (_jump(to_x, to_y, to_x, to_y + dy) != INVALID_POINT) {
+					return to;
 				}
 			} else {
-				if ((_is_walkable(to_x + 1, to_y + dy) && !_is_walkable(to_x + 1, to_y)) || (_is_walkable(to_x - 1, to_y + dy) && !_is_walkable(to_x - 1, to_y))) {
-					return p_to;
+				if (dx != 0) {
+					if ((_is_walkable(to_x + dx, to_y + 1) && !_is_walkable(to_x, to_y + 1)) || (_is_walkable(to_x + dx, to_y - 1) && !_is_walkable(to_x, to_y - 1))) {
+						return to;
+					}
+				} else {
+					if ((_is_walkable(to_x + 1, to_y + dy) && !_is_walkable(to_x + 1, to_y)) || (_is_walkable(to_x - 1, to_y + dy) && !_is_walkable(to_x - 1, to_y))) {
+						return to;
+					}
 				}
 			}
-		}
-		if (_is_walkable(to_x + dx, to_y + dy) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || (_is_walkable(to_x + dx, to_y) || _is_walkable(to_x, to_y + dy)))) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
-		}
-	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
-		if (dx != 0 && dy != 0) {
-			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + dx, to_y)) != nullptr) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x, to_y + dy)) != nullptr) {
-				return p_to;
+			if (_is_walkable(to_x + dx, to_y + dy) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || (_is_walkable(to_x + dx, to_y) || _is_walkable(to_x, to_y + dy)))) {
+				to_x += dx;
+				to_y += dy;
+				continue;
 			}
-		} else {
-			if (dx != 0) {
-				if ((_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1)) || (_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1))) {
-					return p_to;
+		} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
+			if (dx != 0 && dy != 0) {
+				if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
+					return to;
+				}
+				if (_jump(to_x, to_y, to_x + dx, to_y) != INVALID_POINT) {
+					return to;
+				}
+				if (_jump(to_x, to_y, to_x, to_y + dy) != INVALID_POINT) {
+					return to;
 				}
 			} else {
-				if ((_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy)) || (_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy))) {
-					return p_to;
+				if (dx != 0) {
+					if ((_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1)) || (_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1))) {
+						return to;
+					}
+				} else {
+					if ((_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy)) || (_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy))) {
+						return to;
+					}
 				}
 			}
-		}
-		if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
-			return _jump(p_to, _get_point(to_x + dx, to_y + dy));
-		}
-	} else { // DIAGONAL_MODE_NEVER
-		if (dx != 0) {
-			if ((_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1)) || (_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1))) {
-				return p_to;
-			}
-		} else if (dy != 0) {
-			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
-				return p_to;
-			}
-			if (_jump(p_to, _get_point(to_x + 1, to_y)) != nullptr) {
-				return p_to;
+			if (_is_walkable(to_x + dx, to_y + dy) && _is_walkable(to_x + dx, to_y) && _is_walkable(to_x, to_y + dy)) {
+				to_x += dx;
+				to_y += dy;
+				continue;
 			}
-			if (_jump(p_to, _get_point(to_x - 1, to_y)) != nullptr) {
-				return p_to;
+		} else { // DIAGONAL_MODE_NEVER
+			if (dx != 0) {
+				if ((_is_walkable(to_x, to_y - 1) && !_is_walkable(to_x - dx, to_y - 1)) || (_is_walkable(to_x, to_y + 1) && !_is_walkable(to_x - dx, to_y + 1))) {
+					return to;
+				}
+			} else if (dy != 0) {
+				if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
+					return to;
+				}
+				if (_jump(to_x, to_y, to_x + 1, to_y) != INVALID_POINT) {
+					return to;
+				}
+				if (_jump(to_x, to_y, to_x - 1, to_y) != INVALID_POINT) {
+					return to;
+				}
 			}
+			to_x += dx;
+			to_y += dy;
+			continue;
 		}
-		return _jump(p_to, _get_point(to_x + dx, to_y + dy));
+		return INVALID_POINT;
 	}
-	return nullptr;
 }
 
-void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
+uint32_t AStarGrid2D::_get_nbors(uint32_t p_index, uint32_t *r_nbors) const {
+	const Vector2i id = _get_id(p_index);
+	const int64_t width = region.size.width;
+	uint32_t nbor_count = 0;
+
+	const bool has_left = id.x - 1 >= search_region.position.x;
+	const bool has_right = id.x + 1 < search_region.position.x + search_region.size.width;
+	const bool has_top = id.y - 1 >= search_region.position.y;
+	const bool has_bottom = id.y + 1 < search_region.position.y + search_region.size.height;
+
+	const uint32_t top = p_index - width;
+	const uint32_t bottom = p_index + width;
+
 	bool ts0 = false, td0 = false,
 		 ts1 = false, td1 = false,
 		 ts2 = false, td2 = false,
 		 ts3 = false, td3 = false;
 
-	Point *left = nullptr;
-	Point *right = nullptr;
-	Point *top = nullptr;
-	Point *bottom = nullptr;
-
-	Point *top_left = nullptr;
-	Point *top_right = nullptr;
-	Point *bottom_left = nullptr;
-	Point *bottom_right = nullptr;
-
-	{
-		bool has_left = false;
-		bool has_right = false;
-
-		if (p_point->id.x - 1 >= region.position.x) {
-			left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y);
-			has_left = true;
-		}
-		if (p_point->id.x + 1 < region.position.x + region.size.width) {
-			right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y);
-			has_right = true;
-		}
-		if (p_point->id.y - 1 >= region.position.y) {
-			top = _get_point_unchecked(p_point->id.x, p_point->id.y - 1);
-			if (has_left) {
-				top_left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y - 1);
-			}
-			if (has_right) {
-				top_right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y - 1);
-			}
-		}
-		if (p_point->id.y + 1 < region.position.y + region.size.height) {
-			bottom = _get_point_unchecked(p_point->id.x, p_point->id.y + 1);
-			if (has_left) {
-				bottom_left = _get_point_unchecked(p_point->id.x - 1, p_point->id.y + 1);
-			}
-			if (has_right) {
-				bottom_right = _get_point_unchecked(p_point->id.x + 1, p_point->id.y + 1);
-			}
-		}
-	}
-
-	if (top && !top->solid) {
-		r_nbors.push_back(top);
+	if (has_top && !_is_solid(top)) {
+		r_nbors[nbor_count++] = top;
 		ts0 = true;
 	}
-	if (right && !right->solid) {
-		r_nbors.push_back(right);
+	if (has_right && !_is_solid(p_index + 1)) {
+		r_nbors[nbor_count++] = p_index + 1;
 		ts1 = true;
 	}
-	if (bottom && !bottom->solid) {
-		r_nbors.push_back(bottom);
+	if (has_bottom && !_is_solid(bottom)) {
+		r_nbors[nbor_count++] = bottom;
 		ts2 = true;
 	}
-	if (left && !left->solid) {
-		r_nbors.push_back(left);
+	if (has_left && !_is_solid(p_index - 1)) {
+		r_nbors[nbor_count++] = p_index - 1;
 		ts3 = true;
 	}
 
@@ -404,92 +436,564 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 			break;
 	}
 
-	if (td0 && (top_left && !top_left->solid)) {
-		r_nbors.push_back(top_left);
+	if (td0 && has_top && has_left && !_is_solid(top - 1)) {
+		r_nbors[nbor_count++] = top - 1;
 	}
-	if (td1 && (top_right && !top_right->solid)) {
-		r_nbors.push_back(top_right);
+	if (td1 && has_top && has_right && !_is_solid(top + 1)) {
+		r_nbors[nbor_count++] = top + 1;
 	}
-	if (td2 && (bottom_right && !bottom_right->solid)) {
-		r_nbors.push_back(bottom_right);
+	if (td2 && has_bottom && has_right && !_is_solid(bottom + 1)) {
+		r_nbors[nbor_count++] = bottom + 1;
 	}
-	if (td3 && (bottom_left && !bottom_left->solid)) {
-		r_nbors.push_back(bottom_left);
+	if (td3 && has_bottom && has_left && !_is_solid(bottom - 1)) {
+		r_nbors[nbor_count++] = bottom - 1;
 	}
+
+	return nbor_count;
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point) {
+void AStarGrid2D::_begin_pass() {
+	const uint32_t point_count = region.size.width * region.size.height;
+	if (point_states.size() != point_count) {
+		point_states.clear();
+		point_states.resize(point_count);
+		pass = 0;
+	}
+
 	pass++;
+	if (pass == 0) {
+		// The pass counter wrapped around, old passes could be taken for the current one.
+		for (PointState &state : point_states) {
+			state.open_pass = 0;
+			state.closed_pass = 0;
+		}
+		pass = 1;
+	}
+}
 
-	if (p_end_point->solid) {
+bool AStarGrid2D::_solve(uint32_t p_begin_point, uint32_t p_end_point, bool p_jumping) {
+	_begin_pass();
+
+	if (_is_solid(p_end_point)) {
 		return false;
 	}
 
-	bool found_route = false;
+	SortArray<OpenPoint, SortOpenPoints> sorter;
+	const Vector2i end_id = _get_id(p_end_point);
+	uint32_t nbors[8];
 
-	LocalVector<Point *> open_list;
-	SortArray<Point *, SortPoints> sorter;
+	PointState &begin_state = point_states[p_begin_point];
+	begin_state.g_score = 0;
+	begin_state.open_pass = pass;
 
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	open_list.push_back(p_begin_point);
+	OpenPoint begin;
+	begin.f_score = _estimate_cost(_get_id(p_begin_point), end_id);
+	begin.index = p_begin_point;
+
+	open_list.clear();
+	open_list.push_back(begin);
 	end = p_end_point;
 
 	while (!open_list.is_empty()) {
-		Point *p = open_list[0]; // The currently processed point.
+		const OpenPoint current = open_list[0]; // The currently processed point.
+		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
+		open_list.remove_at(open_list.size() - 1);
 
-		if (p == p_end_point) {
-			found_route = true;
-			break;
+		PointState &p = point_states[current.index];
+		if (p.closed_pass == pass || current.g_score > p.g_score) {
+			continue; // The point was reached again with a better score after being added to the open list.
 		}
 
-		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
-		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		if (current.index == p_end_point) {
+			return true;
+		}
 
-		LocalVector<Point *> nbors;
-		_get_nbors(p, nbors);
+		p.closed_pass = pass; // Mark the point as closed.
 
-		for (Point *e : nbors) {
+		const Vector2i p_id = _get_id(current.index);
+		const uint32_t nbor_count = _get_nbors(current.index, nbors);
+
+		for (uint32_t i = 0; i < nbor_count; i++) {
+			uint32_t e = nbors[i];
 			real_t weight_scale = 1.0;
 
-			if (jumping_enabled) {
-				// TODO: Make it works with weight_scale.
-				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+			if (p_jumping) {
+				// Jump point search relies on uniform costs, weight scales are ignored while jumping (see jumping_enabled docs).
+				const Vector2i nbor_id = _get_id(e);
+				e = _jump(p_id.x, p_id.y, nbor_id.x, nbor_id.y);
+				if (e == INVALID_POINT || point_states[e].closed_pass == pass) {
 					continue;
 				}
 			} else {
-				if (e->solid || e->closed_pass == pass) {
+				if (point_states[e].closed_pass == pass) {
 					continue;
 				}
-				weight_scale = e->weight_scale;
+				weight_scale = _get_weight_scale(e);
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
-			bool new_point = false;
+			const Vector2i e_id = _get_id(e);
+			real_t tentative_g_score = p.g_score + _compute_cost(p_id, e_id) * weight_scale;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
-				open_list.push_back(e);
-				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			PointState &e_state = point_states[e];
+			if (e_state.open_pass == pass && tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
+			e_state.open_pass = pass;
+			e_state.prev_point = current.index;
+			e_state.g_score = tentative_g_score;
+
+			// Points are not moved up in the open list when their score improves, they are added again instead.
+			OpenPoint open_point;
+			open_point.f_score = tentative_g_score + _estimate_cost(e_id, end_id);
+			open_point.g_score = tentative_g_score;
+			open_point.index = e;
+			open_list.push_back(open_point);
+			sorter.push_heap(0, open_list.size() - 1, 0, open_point, open_list.ptr());
+		}
+	}
+
+	return false;
+}
 
-			if (new_point) { // The position of the new points is already known.
-				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
-			} else {
-				sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+void AStarGrid2D::_search_costs(uint32_t p_from_point, bool p_reverse) {
+	_begin_pass();
+
+	SortArray<OpenPoint, SortOpenPoints> sorter;
+	uint32_t nbors[8];
+
+	PointState &from_state = point_states[p_from_point];
+	from_state.g_score = 0;
+	from_state.open_pass = pass;
+
+	OpenPoint from;
+	from.index = p_from_point;
+
+	open_list.clear();
+	open_list.push_back(from);
+
+	while (!open_list.is_empty()) {
+		const OpenPoint current = open_list[0];
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.remove_at(open_list.size() - 1);
+
+		PointState &p = point_states[current.index];
+		if (p.closed_pass == pass || current.g_score > p.g_score) {
+			continue;
+		}
+		p.closed_pass = pass;
+
+		const Vector2i p_id = _get_id(current.index);
+		const uint32_t nbor_count = _get_nbors(current.index, nbors);
+
+		for (uint32_t i = 0; i < nbor_count; i++) {
+			const uint32_t e = nbors[i];
+			PointState &e_state = point_states[e];
+			if (e_state.closed_pass == pass) {
+				continue;
 			}
+
+			// When searching in reverse, the costs are the ones of moving from the neighbor to this point.
+			const Vector2i e_id = _get_id(e);
+			const real_t cost = p_reverse ? _compute_cost(e_id, p_id) * _get_weight_scale(current.index) : _compute_cost(p_id, e_id) * _get_weight_scale(e);
+			const real_t tentative_g_score = p.g_score + cost;
+			if (e_state.open_pass == pass && tentative_g_score >= e_state.g_score) {
+				continue;
+			}
+
+			e_state.open_pass = pass;
+			e_state.prev_point = current.index;
+			e_state.g_score = tentative_g_score;
+
+			OpenPoint open_point;
+			open_point.f_score = tentative_g_score;
+			open_point.g_score = tentative_g_score;
+			open_point.index = e;
+			open_list.push_back(open_point);
+			sorter.push_heap(0, open_list.size() - 1, 0, open_point, open_list.ptr());
 		}
 	}
+}
+
+void AStarGrid2D::_append_path(uint32_t p_begin_point, uint32_t p_end_point, LocalVector<uint32_t> &r_path) const {
+	if (r_path.is_empty() || r_path[r_path.size() - 1] != p_begin_point) {
+		r_path.push_back(p_begin_point);
+	}
 
-	return found_route;
+	const uint32_t first = r_path.size();
+	for (uint32_t p = p_end_point; p != p_begin_point; p = point_states[p].prev_point) {
+		r_path.push_back(p);
+	}
+
+	for (uint32_t i = first, j = r_path.size() - 1; i < j; i++, j--) {
+		SWAP(r_path[i], r_path[j]);
+	}
+}
+
+Rect2i AStarGrid2D::_get_cluster_region(uint32_t p_cluster) const {
+	const Vector2i cluster = Vector2i(p_cluster % cluster_count.width, p_cluster / cluster_count.width);
+	return Rect2i(region.position + cluster * cluster_size, Vector2i(cluster_size, cluster_size)).intersection(region);
+}
+
+uint32_t AStarGrid2D::_get_cluster(uint32_t p_index) const {
+	const Vector2i local = _get_id(p_index) - region.position;
+	return (local.y / cluster_size) * cluster_count.width + local.x / cluster_size;
+}
+
+uint32_t AStarGrid2D::_get_abstract_node(uint32_t p_index, HashMap<uint32_t, uint32_t> &r_node_ids) {
+	const uint32_t *node_id = r_node_ids.getptr(p_index);
+	if (node_id) {
+		return *node_id;
+	}
+
+	AbstractNode node;
+	node.index = p_index;
+	node.cluster = _get_cluster(p_index);
+
+	const uint32_t new_node_id = abstract_nodes.size();
+	abstract_nodes.push_back(node);
+	cluster_nodes[node.cluster].push_back(new_node_id);
+	r_node_ids.insert(p_index, new_node_id);
+	return new_node_id;
+}
+
+void AStarGrid2D::_add_transition(uint32_t p_from_index, uint32_t p_to_index, HashMap<uint32_t, uint32_t> &r_node_ids) {
+	const uint32_t from_node = _get_abstract_node(p_from_index, r_node_ids);
+	const uint32_t to_node = _get_abstract_node(p_to_index, r_node_ids);
+	const Vector2i from_id = _get_id(p_from_index);
+	const Vector2i to_id = _get_id(p_to_index);
+
+	AbstractEdge edge;
+	edge.to = to_node;
+	edge.cost = _compute_cost(from_id, to_id) * _get_weight_scale(p_to_index);
+	abstract_nodes[from_node].edges.push_back(edge);
+
+	edge.to = from_node;
+	edge.cost = _compute_cost(to_id, from_id) * _get_weight_scale(p_from_index);
+	abstract_nodes[to_node].edges.push_back(edge);
+}
+
+// Openings along a border at least this long get a transition at each of their ends instead of a single one in the middle.
+#define LONG_ENTRANCE_LENGTH 6
+
+void AStarGrid2D::_add_border_transitions(const Vector2i &p_start, const Vector2i &p_along, const Vector2i &p_across, int p_length, HashMap<uint32_t, uint32_t> &r_node_ids) {
+	LocalVector<uint8_t> open;
+	open.resize(p_length);
+	for (int i = 0; i < p_length; i++) {
+		const Vector2i from = p_start + p_along * i;
+		const Vector2i to = from + p_across;
+		open[i] = _is_walkable(from.x, from.y) && _is_walkable(to.x, to.y);
+	}
+
+	int run_start = -1;
+	for (int i = 0; i <= p_length; i++) {
+		if (i < p_length && open[i]) {
+			if (run_start < 0) {
+				run_start = i;
+			}
+			continue;
+		}
+		if (run_start < 0) {
+			continue;
+		}
+
+		// All the points of an opening are connected along the border, so a few transitions are enough.
+		const int run_end = i - 1;
+		if (run_end - run_start + 1 >= LONG_ENTRANCE_LENGTH) {
+			const Vector2i first = p_start + p_along * run_start;
+			const Vector2i last = p_start + p_along * run_end;
+			_add_transition(_get_index(first.x, first.y), _get_index(first.x + p_across.x, first.y + p_across.y), r_node_ids);
+			_add_transition(_get_index(last.x, last.y), _get_index(last.x + p_across.x, last.y + p_across.y), r_node_ids);
+		} else {
+			const Vector2i middle = p_start + p_along * ((run_start + run_end) / 2);
+			_add_transition(_get_index(middle.x, middle.y), _get_index(middle.x + p_across.x, middle.y + p_across.y), r_node_ids);
+		}
+		run_start = -1;
+	}
+
+	if (diagonal_mode != DIAGONAL_MODE_ALWAYS) {
+		// In the other modes, a diagonal step through the border is only possible next to an opening.
+		return;
+	}
+
+	for (int i = 0; i + 1 < p_length; i++) {
+		if (open[i] || open[i + 1]) {
+			continue;
+		}
+		const Vector2i from = p_start + p_along * i;
+		const Vector2i next = from + p_along;
+		if (_is_walkable(from.x, from.y) && _is_walkable(next.x + p_across.x, next.y + p_across.y)) {
+			_add_transition(_get_index(from.x, from.y), _get_index(next.x + p_across.x, next.y + p_across.y), r_node_ids);
+		}
+		if (_is_walkable(next.x, next.y) && _is_walkable(from.x + p_across.x, from.y + p_across.y)) {
+			_add_transition(_get_index(next.x, next.y), _get_index(from.x + p_across.x, from.y + p_across.y), r_node_ids);
+		}
+	}
+}
+
+void AStarGrid2D::_build_abstract_graph() {
+	abstract_nodes.clear();
+	cluster_nodes.clear();
+	search_region = region;
+
+	cluster_count = Size2i((region.size.width + cluster_size - 1) / cluster_size, (region.size.height + cluster_size - 1) / cluster_size);
+	cluster_nodes.resize(cluster_count.width * cluster_count.height);
+
+	HashMap<uint32_t, uint32_t> node_ids;
+	const Vector2i end_point = region.get_end();
+
+	for (int cy = 0; cy < cluster_count.height; cy++) {
+		for (int cx = 0; cx < cluster_count.width; cx++) {
+			const Vector2i from = region.position + Vector2i(cx, cy) * cluster_size;
+			const Vector2i to = (from + Vector2i(cluster_size, cluster_size)).min(end_point);
+
+			if (cx + 1 < cluster_count.width) { // Border with the cluster on the right.
+				_add_border_transitions(Vector2i(to.x - 1, from.y), Vector2i(0, 1), Vector2i(1, 0), to.y - from.y, node_ids);
+			}
+			if (cy + 1 < cluster_count.height) { // Border with the cluster below.
+				_add_border_transitions(Vector2i(from.x, to.y - 1), Vector2i(1, 0), Vector2i(0, 1), to.x - from.x, node_ids);
+			}
+			if (diagonal_mode == DIAGONAL_MODE_ALWAYS && cx + 1 < cluster_count.width && cy + 1 < cluster_count.height) {
+				// Clusters meeting at a corner are only connected diagonally when both other clusters are blocked there.
+				const Vector2i corner = to - Vector2i(1, 1);
+				if (!_is_walkable(corner.x + 1, corner.y) && !_is_walkable(corner.x, corner.y + 1) && _is_walkable(corner.x, corner.y) && _is_walkable(corner.x + 1, corner.y + 1)) {
+					_add_transition(_get_index(corner.x, corner.y), _get_index(corner.x + 1, corner.y + 1), node_ids);
+				}
+				if (!_is_walkable(corner.x, corner.y) && !_is_walkable(corner.x + 1, corner.y + 1) && _is_walkable(corner.x + 1, corner.y) && _is_walkable(corner.x, corner.y + 1)) {
+					_add_transition(_get_index(corner.x + 1, corner.y), _get_index(corner.x, corner.y + 1), node_ids);
+				}
+			}
+		}
+	}
+
+	// Precompute the costs between the border points of each cluster.
+	for (uint32_t cluster = 0; cluster < cluster_nodes.size(); cluster++) {
+		const LocalVector<uint32_t> &nodes = cluster_nodes[cluster];
+		if (nodes.size() < 2) {
+			continue;
+		}
+
+		search_region = _get_cluster_region(cluster);
+		for (uint32_t node_id : nodes) {
+			_search_costs(abstract_nodes[node_id].index, false);
+			for (uint32_t other_node_id : nodes) {
+				const PointState &state = point_states[abstract_nodes[other_node_id].index];
+				if (other_node_id == node_id || state.closed_pass != pass) {
+					continue;
+				}
+				AbstractEdge edge;
+				edge.to = other_node_id;
+				edge.cost = state.g_score;
+				abstract_nodes[node_id].edges.push_back(edge);
+			}
+		}
+	}
+	search_region = region;
+
+	abstract_states.clear();
+	abstract_states.resize(abstract_nodes.size() + 1);
+	abstract_pass = 0;
+	abstract_graph_dirty = false;
+}
+
+bool AStarGrid2D::_solve_hierarchical(uint32_t p_begin_point, uint32_t p_end_point, LocalVector<uint32_t> &r_path) {
+	if (abstract_graph_dirty) {
+		_build_abstract_graph();
+	}
+
+	if (_is_solid(p_end_point)) {
+		return false;
+	}
+
+	const uint32_t begin_cluster = _get_cluster(p_begin_point);
+	const uint32_t end_cluster = _get_cluster(p_end_point);
+
+	if (begin_cluster == end_cluster) {
+		search_region = _get_cluster_region(begin_cluster);
+		const bool found_route = _solve(p_begin_point, p_end_point, false);
+		search_region = region;
+		if (found_route) {
+			_append_path(p_begin_point, p_end_point, r_path);
+			return true;
+		}
+	}
+
+	// Connect the begin and end points to the border points of their clusters.
+	LocalVector<AbstractEdge> begin_edges;
+	LocalVector<AbstractEdge> end_edges;
+
+	search_region = _get_cluster_region(begin_cluster);
+	_search_costs(p_begin_point, false);
+	for (uint32_t node_id : cluster_nodes[begin_cluster]) {
+		const PointState &state = point_states[abstract_nodes[node_id].index];
+		if (state.closed_pass == pass) {
+			AbstractEdge edge;
+			edge.to = node_id;
+			edge.cost = state.g_score;
+			begin_edges.push_back(edge);
+		}
+	}
+
+	search_region = _get_cluster_region(end_cluster);
+	_search_costs(p_end_point, true);
+	for (uint32_t node_id : cluster_nodes[end_cluster]) {
+		const PointState &state = point_states[abstract_nodes[node_id].index];
+		if (state.closed_pass == pass) {
+			AbstractEdge edge;
+			edge.to = node_id;
+			edge.cost = state.g_score;
+			end_edges.push_back(edge);
+		}
+	}
+	search_region = region;
+
+	if (begin_edges.is_empty() || end_edges.is_empty()) {
+		return false;
+	}
+
+	// Search the abstract graph. The end point is an extra node after all the others,
+	// and is also used as the previous node of the nodes reached from the begin point.
+	abstract_pass++;
+	if (abstract_pass == 0) {
+		for (AbstractState &state : abstract_states) {
+			state.open_pass = 0;
+			state.closed_pass = 0;
+		}
+		abstract_pass = 1;
+	}
+
+	const uint32_t goal = abstract_nodes.size();
+	const Vector2i end_id = _get_id(p_end_point);
+	SortArray<OpenPoint, SortOpenPoints> sorter;
+	open_list.clear();
+
+	for (const AbstractEdge &edge : begin_edges) {
+		AbstractState &state = abstract_states[edge.to];
+		state.open_pass = abstract_pass;
+		state.prev_node = goal;
+		state.g_score = edge.cost;
+
+		OpenPoint open_point;
+		open_point.f_score = edge.cost + _estimate_cost(_get_id(abstract_nodes[edge.to].index), end_id);
+		open_point.g_score = edge.cost;
+		open_point.index = edge.to;
+		open_list.push_back(open_point);
+		sorter.push_heap(0, open_list.size() - 1, 0, open_point, open_list.ptr());
+	}
+
+	bool found_route = false;
+	while (!open_list.is_empty()) {
+		const OpenPoint current = open_list[0];
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.remove_at(open_list.size() - 1);
+
+		AbstractState &p = abstract_states[current.index];
+		if (p.closed_pass == abstract_pass || current.g_score > p.g_score) {
+			continue;
+		}
+		if (current.index == goal) {
+			found_route = true;
+			break;
+		}
+		p.closed_pass = abstract_pass;
+
+		const AbstractNode &node = abstract_nodes[current.index];
+		for (const AbstractEdge &edge : node.edges) {
+			AbstractState &e_state = abstract_states[edge.to];
+			const real_t tentative_g_score = p.g_score + edge.cost;
+			if (e_state.closed_pass == abstract_pass || (e_state.open_pass == abstract_pass && tentative_g_score >= e_state.g_score)) {
+				continue;
+			}
+			e_state.open_pass = abstract_pass;
+			e_state.prev_node = current.index;
+			e_state.g_score = tentative_g_score;
+
+			OpenPoint open_point;
+			open_point.f_score = tentative_g_score + _estimate_cost(_get_id(abstract_nodes[edge.to].index), end_id);
+			open_point.g_score = tentative_g_score;
+			open_point.index = edge.to;
+			open_list.push_back(open_point);
+			sorter.push_heap(0, open_list.size() - 1, 0, open_point, open_list.ptr());
+		}
+
+		if (node.cluster != end_cluster) {
+			continue;
+		}
+		for (const AbstractEdge &edge : end_edges) {
+			if (edge.to != current.index) {
+				continue;
+			}
+			AbstractState &goal_state = abstract_states[goal];
+			const real_t tentative_g_score = p.g_score + edge.cost;
+			if (goal_state.open_pass == abstract_pass && tentative_g_score >= goal_state.g_score) {
+				continue;
+			}
+			goal_state.open_pass = abstract_pass;
+			goal_state.prev_node = current.index;
+			goal_state.g_score = tentative_g_score;
+
+			OpenPoint open_point;
+			open_point.f_score = tentative_g_score;
+			open_point.g_score = tentative_g_score;
+			open_point.index = goal;
+			open_list.push_back(open_point);
+			sorter.push_heap(0, open_list.size() - 1, 0, open_point, open_list.ptr());
+		}
+	}
+
+	if (!found_route) {
+		return false;
+	}
+
+	LocalVector<uint32_t> abstract_path;
+	for (uint32_t node_id = abstract_states[goal].prev_node; node_id != goal; node_id = abstract_states[node_id].prev_node) {
+		abstract_path.push_back(node_id);
+	}
+
+	// Refine the abstract path into points, searching each cluster it goes through again.
+	uint32_t from = p_begin_point;
+	uint32_t from_cluster = begin_cluster;
+	for (int64_t i = int64_t(abstract_path.size()) - 1; i >= -1; i--) {
+		const uint32_t to = i >= 0 ? abstract_nodes[abstract_path[i]].index : p_end_point;
+		const uint32_t to_cluster = i >= 0 ? abstract_nodes[abstract_path[i]].cluster : end_cluster;
+
+		if (from_cluster == to_cluster) {
+			search_region = _get_cluster_region(from_cluster);
+			const bool found_segment = _solve(from, to, false);
+			search_region = region;
+			ERR_FAIL_COND_V_MSG(!found_segment, false, "Hierarchical path goes through unconnected points.");
+			_append_path(from, to, r_path);
+		} else {
+			r_path.push_back(to); // Neighbors across the border of two clusters.
+		}
+
+		from = to;
+		from_cluster = to_cluster;
+	}
+
+	return true;
+}
+
+bool AStarGrid2D::_find_path(const Vector2i &p_from_id, const Vector2i &p_to_id, LocalVector<uint32_t> &r_path) {
+	const uint32_t begin_point = _get_index(p_from_id.x, p_from_id.y);
+	const uint32_t end_point = _get_index(p_to_id.x, p_to_id.y);
+
+	if (begin_point == end_point) {
+		r_path.push_back(begin_point);
+		return true;
+	}
+
+	search_region = region;
+
+	if (hierarchical_enabled) {
+		return _solve_hierarchical(begin_point, end_point, r_path);
+	}
+
+	if (!_solve(begin_point, end_point, jumping_enabled)) {
+		return false;
+	}
+	_append_path(begin_point, end_point, r_path);
+	return true;
 }
 
 real_t AStarGrid2D::_estimate_cost(const Vector2i &p_from_id, const Vector2i &p_to_id) {
@@ -509,14 +1013,22 @@ real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_t
 }
 
 void AStarGrid2D::clear() {
-	points.clear();
+	solid_mask.reset();
+	weight_scales.reset();
+	point_states.reset();
+	open_list.reset();
+	abstract_nodes.reset();
+	cluster_nodes.reset();
+	abstract_states.reset();
+	abstract_graph_dirty = true;
 	region = Rect2i();
+	search_region = Rect2i();
 }
 
 Vector2 AStarGrid2D::get_point_position(const Vector2i &p_id) const {
 	ERR_FAIL_COND_V_MSG(dirty, Vector2(), "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), Vector2(), vformat("Can't get point's position. Point %s out of bounds %s.", p_id, region));
-	return GET_POINT_UNCHECKED(p_id).pos;
+	return offset + Vector2(p_id) * cell_size;
 }
 
 Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vector2i &p_to_id) {
@@ -524,44 +1036,19 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), Vector<Vector2>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
-
-	if (a == b) {
-		Vector<Vector2> ret;
-		ret.push_back(a->pos);
-		return ret;
-	}
-
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
+	LocalVector<uint32_t> points;
+	if (!_find_path(p_from_id, p_to_id, points)) {
 		return Vector<Vector2>();
 	}
 
-	Point *p = end_point;
-	int64_t pc = 1;
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	Vector<Vector2> path;
-	path.resize(pc);
+	path.resize(points.size());
 
 	{
 		Vector2 *w = path.ptrw();
-
-		p = end_point;
-		int64_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->pos;
-			p = p->prev_point;
+		for (uint32_t i = 0; i < points.size(); i++) {
+			w[i] = offset + Vector2(_get_id(points[i])) * cell_size;
 		}
-
-		w[0] = p->pos;
 	}
 
 	return path;
@@ -572,42 +1059,15 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_from_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_from_id, region));
 	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_to_id), TypedArray<Vector2i>(), vformat("Can't get id path. Point %s out of bounds %s.", p_to_id, region));
 
-	Point *a = _get_point(p_from_id.x, p_from_id.y);
-	Point *b = _get_point(p_to_id.x, p_to_id.y);
-
-	if (a == b) {
-		TypedArray<Vector2i> ret;
-		ret.push_back(a->id);
-		return ret;
-	}
-
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point);
-	if (!found_route) {
+	LocalVector<uint32_t> points;
+	if (!_find_path(p_from_id, p_to_id, points)) {
 		return TypedArray<Vector2i>();
 	}
 
-	Point *p = end_point;
-	int64_t pc = 1;
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
-	}
-
 	TypedArray<Vector2i> path;
-	path.resize(pc);
-
-	{
-		p = end_point;
-		int64_t idx = pc - 1;
-		while (p != begin_point) {
-			path[idx--] = p->id;
-			p = p->prev_point;
-		}
-
-		path[0] = p->id;
+	path.resize(points.size());
+	for (uint32_t i = 0; i < points.size(); i++) {
+		path[i] = _get_id(points[i]);
 	}
 
 	return path;
@@ -634,6 +1094,10 @@ void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_default_compute_heuristic"), &AStarGrid2D::get_default_compute_heuristic);
 	ClassDB::bind_method(D_METHOD("set_default_estimate_heuristic", "heuristic"), &AStarGrid2D::set_default_estimate_heuristic);
 	ClassDB::bind_method(D_METHOD("get_default_estimate_heuristic"), &AStarGrid2D::get_default_estimate_heuristic);
+	ClassDB::bind_method(D_METHOD("set_hierarchical_enabled", "enabled"), &AStarGrid2D::set_hierarchical_enabled);
+	ClassDB::bind_method(D_METHOD("is_hierarchical_enabled"), &AStarGrid2D::is_hierarchical_enabled);
+	ClassDB::bind_method(D_METHOD("set_cluster_size", "cluster_size"), &AStarGrid2D::set_cluster_size);
+	ClassDB::bind_method(D_METHOD("get_cluster_size"), &AStarGrid2D::get_cluster_size);
 	ClassDB::bind_method(D_METHOD("set_point_solid", "id", "solid"), &AStarGrid2D::set_point_solid, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("is_point_solid", "id"), &AStarGrid2D::is_point_solid);
 	ClassDB::bind_method(D_METHOD("set_point_weight_scale", "id", "weight_scale"), &AStarGrid2D::set_point_weight_scale);
@@ -658,6 +1122,8 @@ void AStarGrid2D::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "default_compute_heuristic", PROPERTY_HINT_ENUM, "Euclidean,Manhattan,Octile,Chebyshev"), "set_default_compute_heuristic", "get_default_compute_heuristic");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "default_estimate_heuristic", PROPERTY_HINT_ENUM, "Euclidean,Manhattan,Octile,Chebyshev"), "set_default_estimate_heuristic", "get_default_estimate_heuristic");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "diagonal_mode", PROPERTY_HINT_ENUM, "Never,Always,At Least One Walkable,Only If No Obstacles"), "set_diagonal_mode", "get_diagonal_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "hierarchical_enabled"), "set_hierarchical_enabled", "is_hierarchical_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "cluster_size", PROPERTY_HINT_RANGE, "2,256,1,or_greater"), "set_cluster_size", "get_cluster_size");
 
 	BIND_ENUM_CONSTANT(HEURISTIC_EUCLIDEAN);
 	BIND_ENUM_CONSTANT(HEURISTIC_MANHATTAN);
@@ -672,4 +1138,4 @@ void AStarGrid2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(DIAGONAL_MODE_MAX);
 }
 
-#undef GET_POINT_UNCHECKED
+#undef LONG_ENTRANCE_LENGTH
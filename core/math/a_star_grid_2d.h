@@ -34,6 +34,7 @@
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/list.h"
 #include "core/templates/local_vector.h"
 
@@ -68,65 +69,121 @@ private:
 	Heuristic default_compute_heuristic = HEURISTIC_EUCLIDEAN;
 	Heuristic default_estimate_heuristic = HEURISTIC_EUCLIDEAN;
 
-	struct Point {
-		Vector2i id;
+	bool hierarchical_enabled = false;
+	int cluster_size = 16;
 
-		bool solid = false;
-		Vector2 pos;
-		real_t weight_scale = 1.0;
+	// Points are stored as indices into the grid region, row by row.
+	// Solidity is one bit per point, weight scales are only allocated once a point gets a weight scale other than 1.
+	LocalVector<uint64_t> solid_mask;
+	LocalVector<real_t> weight_scales;
 
-		// Used for pathfinding.
-		Point *prev_point = nullptr;
+	// Used for pathfinding, only allocated for the first search.
+	struct PointState {
+		uint32_t prev_point = 0;
+		uint32_t open_pass = 0;
+		uint32_t closed_pass = 0;
 		real_t g_score = 0;
-		real_t f_score = 0;
-		uint64_t open_pass = 0;
-		uint64_t closed_pass = 0;
-
-		Point() {}
+	};
 
-		Point(const Vector2i &p_id, const Vector2 &p_pos) :
-				id(p_id), pos(p_pos) {}
+	struct OpenPoint {
+		real_t f_score = 0;
+		real_t g_score = 0;
+		uint32_t index = 0;
 	};
 
-	struct SortPoints {
-		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+	struct SortOpenPoints {
+		_FORCE_INLINE_ bool operator()(const OpenPoint &A, const OpenPoint &B) const { // Returns true when the Point A is worse than Point B.
+			if (A.f_score > B.f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (A.f_score < B.f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return A.g_score < B.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
-	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
+	LocalVector<PointState> point_states;
+	LocalVector<OpenPoint> open_list;
+	uint32_t end = 0;
+	uint32_t pass = 0;
+
+	// Area the current search is restricted to, the whole region unless searching inside of a cluster.
+	Rect2i search_region;
+
+	// Abstract graph used by the hierarchical mode. Clusters of cluster_size x cluster_size points
+	// are connected through the points at their borders, and the costs between the border points
+	// of a cluster are precomputed.
+	struct AbstractEdge {
+		uint32_t to = 0;
+		real_t cost = 0;
+	};
+
+	struct AbstractNode {
+		uint32_t index = 0;
+		uint32_t cluster = 0;
+		LocalVector<AbstractEdge> edges;
+	};
 
-	uint64_t pass = 1;
+	struct AbstractState {
+		uint32_t prev_node = 0;
+		uint32_t open_pass = 0;
+		uint32_t closed_pass = 0;
+		real_t g_score = 0;
+	};
+
+	LocalVector<AbstractNode> abstract_nodes;
+	LocalVector<LocalVector<uint32_t>> cluster_nodes;
+	LocalVector<AbstractState> abstract_states;
+	Size2i cluster_count;
+	uint32_t abstract_pass = 0;
+	bool abstract_graph_dirty = true;
 
 private: // Internal routines.
+	static const uint32_t INVALID_POINT = UINT32_MAX;
+
+	_FORCE_INLINE_ uint32_t _get_index(int64_t p_x, int64_t p_y) const {
+		return (p_y - region.position.y) * region.size.width + (p_x - region.position.x);
+	}
+
+	_FORCE_INLINE_ Vector2i _get_id(uint32_t p_index) const {
+		return Vector2i(region.position.x + p_index % region.size.width, region.position.y + p_index / region.size.width);
+	}
+
+	_FORCE_INLINE_ bool _is_solid(uint32_t p_index) const {
+		return solid_mask[p_index >> 6] & (uint64_t(1) << (p_index & 63));
+	}
+
+	_FORCE_INLINE_ real_t _get_weight_scale(uint32_t p_index) const {
+		return weight_scales.is_empty() ? real_t(1.0) : weight_scales[p_index];
+	}
+
 	_FORCE_INLINE_ bool _is_walkable(int64_t p_x, int64_t p_y) const {
-		if (region.has_point(Vector2i(p_x, p_y))) {
-			return !points[p_y - region.position.y][p_x - region.position.x].solid;
+		if (search_region.has_point(Vector2i(p_x, p_y))) {
+			return !_is_solid(_get_index(p_x, p_y));
 		}
 		return false;
 	}
 
-	_FORCE_INLINE_ Point *_get_point(int64_t p_x, int64_t p_y) {
-		if (region.has_point(Vector2i(p_x, p_y))) {
-			return &points[p_y - region.position.y][p_x - region.position.x];
-		}
-		return nullptr;
-	}
+	void _set_solid(uint32_t p_index, bool p_solid);
+	void _set_weight_scale(uint32_t p_index, real_t p_weight_scale);
 
-	_FORCE_INLINE_ Point *_get_point_unchecked(int64_t p_x, int64_t p_y) {
-		return &points[p_y - region.position.y][p_x - region.position.x];
-	}
+	uint32_t _get_nbors(uint32_t p_index, uint32_t *r_nbors) const;
+	uint32_t _jump(int64_t p_from_x, int64_t p_from_y, int64_t p_to_x, int64_t p_to_y) const;
+	void _begin_pass();
+	bool _solve(uint32_t p_begin_point, uint32_t p_end_point, bool p_jumping);
+	void _search_costs(uint32_t p_from_point, bool p_reverse);
+	void _append_path(uint32_t p_begin_point, uint32_t p_end_point, LocalVector<uint32_t> &r_path) const;
 
-	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point);
+	Rect2i _get_cluster_region(uint32_t p_cluster) const;
+	uint32_t _get_cluster(uint32_t p_index) const;
+	uint32_t _get_abstract_node(uint32_t p_index, HashMap<uint32_t, uint32_t> &r_node_ids);
+	void _add_transition(uint32_t p_from_index, uint32_t p_to_index, HashMap<uint32_t, uint32_t> &r_node_ids);
+	void _add_border_transitions(const Vector2i &p_start, const Vector2i &p_along, const Vector2i &p_across, int p_length, HashMap<uint32_t, uint32_t> &r_node_ids);
+	void _build_abstract_graph();
+	bool _solve_hierarchical(uint32_t p_begin_point, uint32_t p_end_point, LocalVector<uint32_t> &r_path);
+
+	bool _find_path(const Vector2i &p_from_id, const Vector2i &p_to_id, LocalVector<uint32_t> &r_path);
 
 protected:
 	static void _bind_methods();
@@ -171,6 +228,12 @@ public:
 	void set_default_estimate_heuristic(Heuristic p_heuristic);
 	Heuristic get_default_estimate_heuristic() const;
 
+	void set_hierarchical_enabled(bool p_enabled);
+	bool is_hierarchical_enabled() const;
+
+	void set_cluster_size(int p_cluster_size);
+	int get_cluster_size() const;
+
 	void set_point_solid(const Vector2i &p_id, bool p_solid = true);
 	bool is_point_solid(const Vector2i &p_id) const;
 
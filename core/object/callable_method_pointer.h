@@ -77,6 +77,48 @@ public:
 	virtual uint32_t hash() const;
 };
 
+// Argument types matched by CallableCustom::call_typed(). Non-const references never match the emitted values,
+// since the method could modify them for the next callable.
+template <class T>
+struct CallableTypedArg {
+	typedef T type;
+};
+
+template <class T>
+struct CallableTypedArg<const T> {
+	typedef T type;
+};
+
+template <class T>
+struct CallableTypedArg<T &> {
+	typedef T &type;
+};
+
+template <class T>
+struct CallableTypedArg<const T &> {
+	typedef T type;
+};
+
+template <class T, class R, class... P, size_t... Is>
+void call_with_typed_args_helper(T *p_instance, R (T::*p_method)(P...), const void **p_args, IndexSequence<Is...>) {
+	(p_instance->*p_method)(*(typename GetSimpleTypeT<P>::type_t *)p_args[Is]...);
+}
+
+template <class T, class R, class... P, size_t... Is>
+void call_with_typed_args_helper(T *p_instance, R (T::*p_method)(P...) const, const void **p_args, IndexSequence<Is...>) {
+	(p_instance->*p_method)(*(typename GetSimpleTypeT<P>::type_t *)p_args[Is]...);
+}
+
+template <class T, class R, class... P>
+void call_with_typed_args(T *p_instance, R (T::*p_method)(P...), const void **p_args) {
+	call_with_typed_args_helper(p_instance, p_method, p_args, BuildIndexSequence<sizeof...(P)>{});
+}
+
+template <class T, class R, class... P>
+void call_with_typed_args(T *p_instance, R (T::*p_method)(P...) const, const void **p_args) {
+	call_with_typed_args_helper(p_instance, p_method, p_args, BuildIndexSequence<sizeof...(P)>{});
+}
+
 template <class T, class... P>
 class CallableCustomMethodPointer : public CallableCustomMethodPointerBase {
 	struct Data {
@@ -104,6 +146,19 @@ public:
 		call_with_variant_args(data.instance, data.method, p_arguments, p_argcount, r_call_error);
 	}
 
+	virtual bool call_typed(const void *p_signature, const void **p_arguments) const override {
+		if (p_signature != CallableSignature<typename CallableTypedArg<P>::type...>::get_id()) {
+			return false;
+		}
+#ifdef DEBUG_ENABLED
+		if (ObjectDB::get_instance(ObjectID(data.object_id)) == nullptr) {
+			return false; // Let call() report it.
+		}
+#endif
+		call_with_typed_args(data.instance, data.method, p_arguments);
+		return true;
+	}
+
 	CallableCustomMethodPointer(T *p_instance, void (T::*p_method)(P...)) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.instance = p_instance;
@@ -159,6 +214,19 @@ public:
 		call_with_variant_args_ret(data.instance, data.method, p_arguments, p_argcount, r_return_value, r_call_error);
 	}
 
+	virtual bool call_typed(const void *p_signature, const void **p_arguments) const override {
+		if (p_signature != CallableSignature<typename CallableTypedArg<P>::type...>::get_id()) {
+			return false;
+		}
+#ifdef DEBUG_ENABLED
+		if (ObjectDB::get_instance(ObjectID(data.object_id)) == nullptr) {
+			return false; // Let call() report it.
+		}
+#endif
+		call_with_typed_args(data.instance, data.method, p_arguments);
+		return true;
+	}
+
 	CallableCustomMethodPointerRet(T *p_instance, R (T::*p_method)(P...)) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.instance = p_instance;
@@ -214,6 +282,19 @@ public:
 		call_with_variant_args_retc(data.instance, data.method, p_arguments, p_argcount, r_return_value, r_call_error);
 	}
 
+	virtual bool call_typed(const void *p_signature, const void **p_arguments) const override {
+		if (p_signature != CallableSignature<typename CallableTypedArg<P>::type...>::get_id()) {
+			return false;
+		}
+#ifdef DEBUG_ENABLED
+		if (ObjectDB::get_instance(ObjectID(data.object_id)) == nullptr) {
+			return false; // Let call() report it.
+		}
+#endif
+		call_with_typed_args(data.instance, data.method, p_arguments);
+		return true;
+	}
+
 	CallableCustomMethodPointerRetC(T *p_instance, R (T::*p_method)(P...) const) {
 		memset(&data, 0, sizeof(Data)); // Clear beforehand, may have padding bytes.
 		data.instance = p_instance;
@@ -33,6 +33,7 @@
 #include "core/config/engine.h"
 #include "core/object/script_language.h"
 #include "core/os/mutex.h"
+#include "core/variant/variant_internal.h"
 #include "core/version.h"
 
 #define OBJTYPE_RLOCK RWLockRead _rw_lockr_(lock);
@@ -65,6 +66,8 @@ ClassDB::APIType ClassDB::get_current_api() {
 }
 
 HashMap<StringName, ClassDB::ClassInfo> ClassDB::classes;
+SafeNumeric<uint32_t> ClassDB::property_accessor_version;
+thread_local ClassDB::PropertyAccessorCache ClassDB::property_accessor_cache;
 HashMap<StringName, StringName> ClassDB::resource_base_extensions;
 HashMap<StringName, StringName> ClassDB::compat_classes;
 
@@ -353,6 +356,31 @@ Object *ClassDB::instantiate(const StringName &p_class) {
 	}
 }
 
+// Returns the constructor that instantiate() would end up calling for p_class, so callers
+// creating many objects of the same class can skip the lookup. Returns nullptr for classes
+// that can't be created that way (missing, disabled, extension or editor-only classes).
+ClassDB::CreationFunc ClassDB::get_native_creation_func(const StringName &p_class, StringName *r_class) {
+	OBJTYPE_RLOCK;
+	ClassInfo *ti = classes.getptr(p_class);
+	if (!ti || ti->disabled || !ti->creation_func || (ti->gdextension && !ti->gdextension->create_instance)) {
+		if (compat_classes.has(p_class)) {
+			ti = classes.getptr(compat_classes[p_class]);
+		}
+	}
+	if (!ti || ti->disabled || !ti->creation_func || ti->gdextension) {
+		return nullptr;
+	}
+#ifdef TOOLS_ENABLED
+	if (ti->api == API_EDITOR && !Engine::get_singleton()->is_editor_hint()) {
+		return nullptr;
+	}
+#endif
+	if (r_class) {
+		*r_class = ti->name;
+	}
+	return ti->creation_func;
+}
+
 void ClassDB::set_object_extension_instance(Object *p_object, const StringName &p_class, GDExtensionClassInstancePtr p_instance) {
 	ERR_FAIL_COND(!p_object);
 	ClassInfo *ti;
@@ -424,6 +452,8 @@ void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherit
 	} else {
 		ti.inherits_ptr = nullptr;
 	}
+
+	_invalidate_property_accessors();
 }
 
 static MethodInfo info_from_bind(MethodBind *p_method) {
@@ -628,6 +658,7 @@ void ClassDB::bind_integer_constant(const StringName &p_class, const StringName
 	}
 
 	type->constant_map[p_name] = p_constant;
+	_invalidate_property_accessors();
 
 	String enum_name = p_enum;
 	if (!enum_name.is_empty()) {
@@ -866,6 +897,7 @@ void ClassDB::add_signal(const StringName &p_class, const MethodInfo &p_signal)
 #endif
 
 	type->signal_map[sname] = p_signal;
+	_invalidate_property_accessors();
 }
 
 void ClassDB::get_signal_list(const StringName &p_class, List<MethodInfo> *p_signals, bool p_no_inheritance) {
@@ -1018,6 +1050,7 @@ void ClassDB::add_property(const StringName &p_class, const PropertyInfo &p_pinf
 	psg.type = p_pinfo.type;
 
 	type->property_setget[p_pinfo.name] = psg;
+	_invalidate_property_accessors();
 }
 
 void ClassDB::set_property_default_value(const StringName &p_class, const StringName &p_name, const Variant &p_default) {
@@ -1111,84 +1144,158 @@ bool ClassDB::get_property_info(const StringName &p_class, const StringName &p_p
 	return false;
 }
 
-bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
-	ERR_FAIL_NULL_V(p_object, false);
+const ClassDB::PropertyAccessor *ClassDB::_get_property_accessor(const StringName &p_class, const StringName &p_property) {
+	PropertyAccessorCache &cache = property_accessor_cache;
+	uint32_t version = property_accessor_version.get();
+	if (unlikely(cache.version != version)) {
+		cache.classes.clear();
+		cache.version = version;
+	}
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->setter) {
-				if (r_valid) {
-					*r_valid = false;
-				}
-				return true; //return true but do nothing
+	HashMap<StringName, PropertyAccessor> *accessors = cache.classes.getptr(p_class);
+	if (unlikely(!accessors)) {
+		const ClassInfo *type = classes.getptr(p_class);
+		if (!type) {
+			return nullptr;
+		}
+		accessors = &cache.classes.insert(p_class, HashMap<StringName, PropertyAccessor>())->value;
+		_build_property_accessors(type, *accessors);
+	}
+
+	return accessors->getptr(p_property);
+}
+
+void ClassDB::_build_property_accessors(const ClassInfo *p_type, HashMap<StringName, PropertyAccessor> &r_accessors) {
+	for (const ClassInfo *check = p_type; check; check = check->inherits_ptr) {
+		for (const KeyValue<StringName, PropertySetGet> &E : check->property_setget) {
+			if (r_accessors.has(E.key)) {
+				continue; // Redefined by a derived class.
 			}
 
-			Callable::CallError ce;
+			PropertyAccessor accessor;
+			accessor.setget = E.value;
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 2, ce);
+			for (const ClassInfo *derived = p_type; derived != check; derived = derived->inherits_ptr) {
+				if (derived->constant_map.has(E.key) || derived->method_map.has(E.key) || derived->signal_map.has(E.key)) {
+					accessor.shadowed_for_get = true;
+					break;
 				}
+			}
 
-			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 1, ce);
+			// Validated calls skip argument conversion, only use them where a Variant maps to the argument unambiguously.
+			// Objects need class checks and arrays may be typed, so those always go through checked calls.
+			// Extension method binds are left to checked calls as well.
+			int index_args = E.value.index >= 0 ? 1 : 0;
+			const MethodBind *setter = E.value._setptr;
+			if (setter && !check->gdextension && !setter->is_vararg() && !setter->has_return() && setter->get_argument_count() == index_args + 1 && (!index_args || setter->get_argument_type(0) == Variant::INT)) {
+				Variant::Type type = setter->get_argument_type(index_args);
+				if (type != Variant::OBJECT && type != Variant::ARRAY) {
+					accessor.validated_set_type = type;
 				}
 			}
-
-			if (r_valid) {
-				*r_valid = ce.error == Callable::CallError::CALL_OK;
+			const MethodBind *getter = E.value._getptr;
+			if (getter && !check->gdextension && !getter->is_vararg() && getter->has_return() && getter->get_argument_count() == index_args && (!index_args || getter->get_argument_type(0) == Variant::INT)) {
+				Variant::Type type = getter->get_argument_type(-1);
+				if (type != Variant::OBJECT) {
+					accessor.validated_get_type = type;
+				}
 			}
 
-			return true;
+			r_accessors.insert(E.key, accessor);
 		}
+	}
+}
 
-		check = check->inherits_ptr;
+bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
+	ERR_FAIL_NULL_V(p_object, false);
+
+	const PropertyAccessor *accessor = _get_property_accessor(p_object->get_class_name(), p_property);
+	if (!accessor) {
+		return false;
 	}
 
-	return false;
+	const PropertySetGet *psg = &accessor->setget;
+	if (!psg->setter) {
+		if (r_valid) {
+			*r_valid = false;
+		}
+		return true; //return true but do nothing
+	}
+
+	Callable::CallError ce;
+	bool validated = accessor->validated_set_type == Variant::NIL || accessor->validated_set_type == p_value.get_type();
+
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg->setter,arg,2,ce);
+		if (validated) {
+			psg->_setptr->validated_call(p_object, arg, nullptr);
+		} else if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->callp(psg->setter, arg, 2, ce);
+		}
+
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (validated) {
+			psg->_setptr->validated_call(p_object, arg, nullptr);
+		} else if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->callp(psg->setter, arg, 1, ce);
+		}
+	}
+
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
+	}
+
+	return true;
 }
 
 bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
 	ERR_FAIL_NULL_V(p_object, false);
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->getter) {
-				return true; //return true but do nothing
-			}
+	const PropertyAccessor *accessor = _get_property_accessor(p_object->get_class_name(), p_property);
+	if (accessor && !accessor->shadowed_for_get) {
+		const PropertySetGet *psg = &accessor->setget;
+		if (!psg->getter) {
+			return true; //return true but do nothing
+		}
 
+		if (accessor->validated_get_type != Variant::VARIANT_MAX && (psg->index < 0 || !p_object->get_script_instance())) {
+			VariantInternal::initialize(&r_value, accessor->validated_get_type);
 			if (psg->index >= 0) {
 				Variant index = psg->index;
 				const Variant *arg[1] = { &index };
-				Callable::CallError ce;
-				r_value = p_object->callp(psg->getter, arg, 1, ce);
+				psg->_getptr->validated_call(p_object, arg, &r_value);
+			} else {
+				psg->_getptr->validated_call(p_object, nullptr, &r_value);
+			}
+
+		} else if (psg->index >= 0) {
+			Variant index = psg->index;
+			const Variant *arg[1] = { &index };
+			Callable::CallError ce;
+			r_value = p_object->callp(psg->getter, arg, 1, ce);
 
+		} else {
+			Callable::CallError ce;
+			if (psg->_getptr) {
+				r_value = psg->_getptr->call(p_object, nullptr, 0, ce);
 			} else {
-				Callable::CallError ce;
-				if (psg->_getptr) {
-					r_value = psg->_getptr->call(p_object, nullptr, 0, ce);
-				} else {
-					r_value = p_object->callp(psg->getter, nullptr, 0, ce);
-				}
+				r_value = p_object->callp(psg->getter, nullptr, 0, ce);
 			}
-			return true;
 		}
+		return true;
+	}
 
+	// Not a property, or shadowed by one of these in a derived class.
+	ClassInfo *type = classes.getptr(p_object->get_class_name());
+	ClassInfo *check = type;
+	while (check) {
 		const int64_t *c = check->constant_map.getptr(p_property); //constants count
 		if (c) {
 			r_value = *c;
@@ -1270,6 +1377,25 @@ StringName ClassDB::get_property_setter(const StringName &p_class, const StringN
 	return StringName();
 }
 
+MethodBind *ClassDB::get_property_setter_method(const StringName &p_class, const StringName &p_property, int *r_index) {
+	OBJTYPE_RLOCK;
+	ClassInfo *type = classes.getptr(p_class);
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			if (r_index) {
+				*r_index = psg->index;
+			}
+			return psg->_setptr;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return nullptr;
+}
+
 StringName ClassDB::get_property_getter(const StringName &p_class, const StringName &p_property) {
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
@@ -1362,6 +1488,7 @@ void ClassDB::_bind_method_custom(const StringName &p_class, MethodBind *p_metho
 #endif
 
 	type->method_map[p_method->get_name()] = p_method;
+	_invalidate_property_accessors();
 }
 
 MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p_name, const Vector<Variant> &p_default_args, bool p_compatibility) {
@@ -1388,6 +1515,7 @@ MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p
 		ERR_FAIL_V_MSG(nullptr, "Method already bound: " + instance_type + "::" + p_name + ".");
 	}
 	type->method_map[p_name] = bind;
+	_invalidate_property_accessors();
 #ifdef DEBUG_METHODS_ENABLED
 	// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
 	//bind->set_return_type("Variant");
@@ -1446,6 +1574,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, bool p_
 		_bind_compatibility(type, p_bind);
 	} else {
 		type->method_map[mdname] = p_bind;
+		_invalidate_property_accessors();
 	}
 
 	Vector<Variant> defvals;
@@ -1669,6 +1798,7 @@ void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 	c.exposed = true;
 
 	classes[p_extension->class_name] = c;
+	_invalidate_property_accessors();
 }
 
 void ClassDB::unregister_extension_class(const StringName &p_class) {
@@ -1678,6 +1808,7 @@ void ClassDB::unregister_extension_class(const StringName &p_class) {
 		memdelete(F.value);
 	}
 	classes.erase(p_class);
+	_invalidate_property_accessors();
 }
 
 HashMap<StringName, ClassDB::NativeStruct> ClassDB::native_structs;
@@ -1728,6 +1859,8 @@ void ClassDB::cleanup() {
 	}
 
 	classes.clear();
+	property_accessor_cache.classes.clear(); // Other threads are gone by now.
+	_invalidate_property_accessors();
 	resource_base_extensions.clear();
 	compat_classes.clear();
 	native_structs.clear();
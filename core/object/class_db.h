@@ -143,6 +143,28 @@ public:
 		return memnew(T);
 	}
 
+	// Setter and getter of a property as set_property() and get_property() resolve it, including inherited ones.
+	struct PropertyAccessor {
+		PropertySetGet setget;
+		Variant::Type validated_set_type = Variant::VARIANT_MAX; // Value type the setter takes without conversion (NIL for any), VARIANT_MAX if it needs a checked call.
+		Variant::Type validated_get_type = Variant::VARIANT_MAX; // Return type of the getter, VARIANT_MAX if it needs a checked call.
+		bool shadowed_for_get = false; // A derived class has a constant, method or signal with this name, which get_property() returns instead.
+	};
+
+	// Flattened per class and built lazily by each thread, so lookups take no lock.
+	// Any change to ClassDB bumps the version, which makes every thread rebuild its tables.
+	struct PropertyAccessorCache {
+		uint32_t version = 0;
+		HashMap<StringName, HashMap<StringName, PropertyAccessor>> classes;
+	};
+
+	static SafeNumeric<uint32_t> property_accessor_version;
+	static thread_local PropertyAccessorCache property_accessor_cache;
+
+	static const PropertyAccessor *_get_property_accessor(const StringName &p_class, const StringName &p_property);
+	static void _build_property_accessors(const ClassInfo *p_type, HashMap<StringName, PropertyAccessor> &r_accessors);
+	_FORCE_INLINE_ static void _invalidate_property_accessors() { property_accessor_version.increment(); }
+
 	static RWLock lock;
 	static HashMap<StringName, ClassInfo> classes;
 	static HashMap<StringName, StringName> resource_base_extensions;
@@ -242,6 +264,8 @@ public:
 	static bool can_instantiate(const StringName &p_class);
 	static bool is_virtual(const StringName &p_class);
 	static Object *instantiate(const StringName &p_class);
+	typedef Object *(*CreationFunc)();
+	static CreationFunc get_native_creation_func(const StringName &p_class, StringName *r_class = nullptr);
 	static void set_object_extension_instance(Object *p_object, const StringName &p_class, GDExtensionClassInstancePtr p_instance);
 
 	static APIType get_api_type(const StringName &p_class);
@@ -374,6 +398,7 @@ public:
 	static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static StringName get_property_setter(const StringName &p_class, const StringName &p_property);
+	static MethodBind *get_property_setter_method(const StringName &p_class, const StringName &p_property, int *r_index = nullptr);
 	static StringName get_property_getter(const StringName &p_class, const StringName &p_property);
 
 	static bool has_method(const StringName &p_class, const StringName &p_method, bool p_no_inheritance = false);
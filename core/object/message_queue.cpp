@@ -34,6 +34,8 @@
 #include "core/core_string_names.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
 
 #ifdef DEV_ENABLED
 // Includes sanity checks to ensure that a queue set as a thread singleton override
@@ -57,7 +59,17 @@
 		mutex.unlock();                           \
 	}
 
+// Threads other than the main one push to their own producer queue instead of contending on the main queue's lock.
+#define PUSH_TO_THREAD_PRODUCER(m_push)                                             \
+	if (unlikely(this == MessageQueue::main_singleton && !Thread::is_main_thread())) { \
+		return MessageQueue::_get_thread_producer()->m_push;                         \
+	}
+
 void CallQueue::_add_page() {
+	if (unlikely(pages_used == max_pages && !max_pages_warned)) {
+		WARN_PRINT("Message queue grew past " + itos(uint64_t(max_pages) * PAGE_SIZE_BYTES / 1024) + " KiB and will keep growing. " + error_text);
+		max_pages_warned = true;
+	}
 	if (pages_used == page_bytes.size()) {
 		pages.push_back(allocator->alloc());
 		page_bytes.push_back(0);
@@ -87,17 +99,13 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
+	PUSH_TO_THREAD_PRODUCER(push_callablep(p_callable, p_args, p_argcount, p_show_error));
+
 	LOCK_MUTEX;
 
 	_ensure_first_page();
 
 	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			ERR_PRINT("Failed method: " + p_callable + ". Message queue out of memory. " + error_text);
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
 		_add_page();
 	}
 
@@ -133,23 +141,14 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
+	PUSH_TO_THREAD_PRODUCER(push_set(p_id, p_prop, p_value));
+
 	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
 	_ensure_first_page();
 
 	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			ERR_PRINT("Failed set: " + type + ":" + p_prop + " target ID: " + itos(p_id) + ". Message queue out of memory. " + error_text);
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
 		_add_page();
 	}
 
@@ -174,18 +173,14 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
+	PUSH_TO_THREAD_PRODUCER(push_notification(p_id, p_notification));
+
 	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
 	_ensure_first_page();
 
 	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			ERR_PRINT("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id) + ". Message queue out of memory. " + error_text);
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
 		_add_page();
 	}
 
@@ -222,13 +217,16 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 	}
 }
 
-Error CallQueue::_transfer_messages_to_main_queue() {
-	if (pages.size() == 0) {
+Error CallQueue::_transfer_messages_to(CallQueue *p_queue) {
+	if (!has_messages()) {
 		return OK;
 	}
 
-	CallQueue *mq = MessageQueue::main_singleton;
-	DEV_ASSERT(!mq->allocator_is_custom && !allocator_is_custom); // Transferring pages is only safe if using the same alloator parameters.
+	CallQueue *mq = p_queue;
+	// Transferring pages is only safe if using the same allocator parameters.
+	// Pages from the same allocator can simply be swapped instead of copied.
+	const bool shared_allocator = allocator == mq->allocator;
+	DEV_ASSERT(shared_allocator || (!mq->allocator_is_custom && !allocator_is_custom));
 
 	mq->mutex.lock();
 
@@ -253,16 +251,13 @@ Error CallQueue::_transfer_messages_to_main_queue() {
 
 	// Any other possibly existing source page needs to be added.
 
-	if (mq->pages_used + (pages_used - src_page) > mq->max_pages) {
-		ERR_PRINT("Failed appending thread queue. Message queue out of memory. " + mq->error_text);
-		mq->statistics();
-		mq->mutex.unlock();
-		return ERR_OUT_OF_MEMORY;
-	}
-
 	for (; src_page < pages_used; src_page++) {
 		mq->_add_page();
-		memcpy(mq->pages[mq->pages_used - 1]->data, pages[src_page]->data, page_bytes[src_page]);
+		if (shared_allocator) {
+			SWAP(mq->pages[mq->pages_used - 1], pages[src_page]);
+		} else {
+			memcpy(mq->pages[mq->pages_used - 1]->data, pages[src_page]->data, page_bytes[src_page]);
+		}
 		mq->page_bytes[mq->pages_used - 1] = page_bytes[src_page];
 	}
 
@@ -277,7 +272,12 @@ Error CallQueue::_transfer_messages_to_main_queue() {
 Error CallQueue::flush() {
 	// Thread overrides are not meant to be flushed, but appended to the main one.
 	if (unlikely(this == MessageQueue::thread_singleton)) {
-		return _transfer_messages_to_main_queue();
+		return _transfer_messages_to(MessageQueue::main_singleton);
+	}
+
+	// Messages pushed by other threads are appended after the ones already queued, keeping the order of each thread.
+	if (this == MessageQueue::main_singleton) {
+		static_cast<MessageQueue *>(this)->_merge_thread_producers();
 	}
 
 	LOCK_MUTEX;
@@ -295,59 +295,87 @@ Error CallQueue::flush() {
 
 	flushing = true;
 
+	const uint64_t flush_begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t flushed_messages = 0;
+
 	uint32_t i = 0;
 	uint32_t offset = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	while (true) {
+		while (i < pages_used && offset < page_bytes[i]) {
+			Page *page = pages[i];
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+			//lock on each iteration, so a call can re-add itself to the message queue
 
-		Message *message = (Message *)&page->data[offset];
+			Message *message = (Message *)&page->data[offset];
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
+			uint32_t advance = sizeof(Message);
+			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+				advance += sizeof(Variant) * message->args;
+			}
 
-		//pre-advance so this function is reentrant
-		offset += advance;
+			//pre-advance so this function is reentrant
+			offset += advance;
 
-		Object *target = message->callable.get_object();
+			Object *target = message->callable.get_object();
 
-		UNLOCK_MUTEX;
+			UNLOCK_MUTEX;
 
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
+			switch (message->type & FLAG_MASK) {
+				case TYPE_CALL: {
+					if (target || (message->type & FLAG_NULL_IS_OK)) {
+						Variant *args = (Variant *)(message + 1);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+					}
+				} break;
+				case TYPE_NOTIFICATION: {
+					if (target) {
+						target->notification(message->notification);
+					}
+				} break;
+				case TYPE_SET: {
+					if (target) {
+						Variant *arg = (Variant *)(message + 1);
+						target->set(message->callable.get_method(), *arg);
+					}
+				} break;
+			}
+
+			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+				Variant *args = (Variant *)(message + 1);
+				for (int k = 0; k < message->args; k++) {
+					args[k].~Variant();
 				}
-			} break;
-		}
+			}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
+			message->~Message();
+			flushed_messages++;
+
+			LOCK_MUTEX;
+			if (offset == page_bytes[i]) {
+				i++;
+				offset = 0;
 			}
 		}
 
-		message->~Message();
+		if (this != MessageQueue::main_singleton) {
+			break;
+		}
 
+		// Also handle what other threads pushed while this flush was running, as happened when they
+		// pushed to this queue directly. Step back to the end of the last page, which they may append to.
+		if (i == pages_used) {
+			i--;
+			offset = page_bytes[i];
+		}
+		UNLOCK_MUTEX;
+		bool merged = static_cast<MessageQueue *>(this)->_merge_thread_producers();
 		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
+		if (!merged) {
+			break;
+		}
+		if (offset == page_bytes[i] && i + 1 < pages_used) {
+			// The last page was full, they went to new ones.
 			i++;
 			offset = 0;
 		}
@@ -356,6 +384,9 @@ Error CallQueue::flush() {
 	page_bytes[0] = 0;
 	pages_used = 1;
 
+	frame_flushed_messages += flushed_messages;
+	frame_flush_usec += OS::get_singleton()->get_ticks_usec() - flush_begin;
+
 	flushing = false;
 	UNLOCK_MUTEX;
 	return OK;
@@ -516,6 +547,15 @@ int CallQueue::get_max_buffer_usage() const {
 	return pages.size() * PAGE_SIZE_BYTES;
 }
 
+void CallQueue::end_frame_statistics() {
+	LOCK_MUTEX;
+	last_frame_flushed_messages = frame_flushed_messages;
+	last_frame_flush_usec = frame_flush_usec;
+	frame_flushed_messages = 0;
+	frame_flush_usec = 0;
+	UNLOCK_MUTEX;
+}
+
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
 	if (p_custom_allocator) {
 		allocator = p_custom_allocator;
@@ -547,6 +587,49 @@ CallQueue::~CallQueue() {
 
 CallQueue *MessageQueue::main_singleton = nullptr;
 thread_local CallQueue *MessageQueue::thread_singleton = nullptr;
+thread_local MessageQueue::ThreadProducer MessageQueue::thread_producer;
+
+MessageQueue::ThreadProducer::~ThreadProducer() {
+	if (!queue) {
+		return;
+	}
+	// The thread is exiting, hand over whatever it left behind to the main queue.
+	MessageQueue *mq = static_cast<MessageQueue *>(main_singleton);
+	if (mq) {
+		MutexLock lock(mq->producers_mutex);
+		mq->producers.erase(this);
+		queue->_transfer_messages_to(mq);
+	}
+	memdelete(queue);
+	queue = nullptr;
+}
+
+CallQueue *MessageQueue::_get_thread_producer() {
+	ThreadProducer &producer = thread_producer;
+	if (unlikely(!producer.queue)) {
+		MessageQueue *mq = static_cast<MessageQueue *>(main_singleton);
+		// Sharing the allocator lets pages be moved to the main queue without copying them.
+		producer.queue = memnew(CallQueue(mq->allocator, mq->max_pages, mq->error_text));
+		MutexLock lock(mq->producers_mutex);
+		mq->producers.push_back(&producer);
+	}
+	return producer.queue;
+}
+
+bool MessageQueue::_merge_thread_producers() {
+	MutexLock lock(producers_mutex);
+	bool merged = false;
+	for (ThreadProducer *producer : producers) {
+		CallQueue *queue = producer->queue;
+		queue->mutex.lock();
+		if (queue->has_messages()) {
+			queue->_transfer_messages_to(this);
+			merged = true;
+		}
+		queue->mutex.unlock();
+	}
+	return merged;
+}
 
 void MessageQueue::set_thread_singleton_override(CallQueue *p_thread_singleton) {
 	DEV_ASSERT(p_thread_singleton); // To unset the thread singleton, don't call this with nullptr, but just memfree() it.
@@ -566,11 +649,19 @@ void MessageQueue::set_thread_singleton_override(CallQueue *p_thread_singleton)
 MessageQueue::MessageQueue() :
 		CallQueue(nullptr,
 				int(GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_mb", PROPERTY_HINT_RANGE, "1,512,1,or_greater"), 32)) * 1024 * 1024 / PAGE_SIZE_BYTES,
-				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
+				"Consider increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
 }
 
 MessageQueue::~MessageQueue() {
+	{
+		MutexLock lock(producers_mutex);
+		for (ThreadProducer *producer : producers) {
+			memdelete(producer->queue);
+			producer->queue = nullptr;
+		}
+		producers.clear();
+	}
 	main_singleton = nullptr;
 }
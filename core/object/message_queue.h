@@ -73,9 +73,15 @@ private:
 
 	LocalVector<Page *> pages;
 	LocalVector<uint32_t> page_bytes;
-	uint32_t max_pages = 0;
+	uint32_t max_pages = 0; // Soft limit, the queue keeps growing past it after printing a warning.
 	uint32_t pages_used = 0;
 	bool flushing = false;
+	bool max_pages_warned = false;
+
+	uint32_t frame_flushed_messages = 0;
+	uint64_t frame_flush_usec = 0;
+	uint32_t last_frame_flushed_messages = 0;
+	uint64_t last_frame_flush_usec = 0;
 
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
@@ -98,7 +104,7 @@ private:
 		}
 	}
 
-	Error _transfer_messages_to_main_queue();
+	Error _transfer_messages_to(CallQueue *p_queue);
 
 	void _add_page();
 
@@ -155,6 +161,11 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
+	// Statistics of the last frame, updated by end_frame_statistics().
+	void end_frame_statistics();
+	uint32_t get_frame_flushed_messages() const { return last_frame_flushed_messages; }
+	uint64_t get_frame_flush_time_usec() const { return last_frame_flush_usec; }
+
 	CallQueue(Allocator *p_custom_allocator = 0, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
 };
@@ -164,6 +175,20 @@ class MessageQueue : public CallQueue {
 	static thread_local CallQueue *thread_singleton;
 	friend class CallQueue;
 
+	// Messages pushed to the main queue from other threads go to a queue owned by
+	// the pushing thread, which is merged into the main one when it's flushed.
+	struct ThreadProducer {
+		CallQueue *queue = nullptr;
+		~ThreadProducer();
+	};
+	static thread_local ThreadProducer thread_producer;
+
+	Mutex producers_mutex;
+	LocalVector<ThreadProducer *> producers;
+
+	static CallQueue *_get_thread_producer();
+	bool _merge_thread_producers();
+
 public:
 	_FORCE_INLINE_ static CallQueue *get_singleton() { return thread_singleton ? thread_singleton : main_singleton; }
 
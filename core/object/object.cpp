@@ -43,18 +43,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	Object *obj;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj = p_obj;
-		obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		obj->_lock_index.unref();
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1016,6 +1004,14 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 }
 
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
+	return _emit_signalp(p_name, p_args, p_argcount, nullptr);
+}
+
+Error Object::_emit_signal_typedp(const StringName &p_name, const Variant **p_args, int p_argcount, const SignalTypedArgs &p_typed_args) {
+	return _emit_signalp(p_name, p_args, p_argcount, &p_typed_args);
+}
+
+Error Object::_emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount, const SignalTypedArgs *p_typed_args) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
@@ -1033,27 +1029,49 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	// If this is a ref-counted object, prevent it from being destroyed during signal emission,
 	// which is needed in certain edge cases; e.g., https://github.com/godotengine/godot/issues/73889.
-	Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
+	Ref<RefCounted> rc;
+	if (is_ref_counted()) {
+		rc = Ref<RefCounted>(static_cast<RefCounted *>(this));
+	}
 
 	List<_ObjectSignalDisconnectData> disconnect_data;
 
 	// Ensure that disconnecting the signal or even deleting the object
 	// will not affect the signal calling.
-	LocalVector<Connection> slot_conns;
-	slot_conns.resize(s->slot_map.size());
+	// Only the callables and flags are copied, on the stack unless there are a lot of connections.
+	struct SlotCall {
+		Callable callable;
+		uint32_t flags = 0;
+	};
+
+	const uint32_t MAX_SIGNAL_SLOTS_ON_STACK = 8;
+	const uint32_t slot_count = s->slot_map.size();
+	SlotCall slot_calls_stack[MAX_SIGNAL_SLOTS_ON_STACK];
+	LocalVector<SlotCall> slot_calls_heap;
+	SlotCall *slot_calls = slot_calls_stack;
+	if (slot_count > MAX_SIGNAL_SLOTS_ON_STACK) {
+		slot_calls_heap.resize(slot_count);
+		slot_calls = slot_calls_heap.ptr();
+	}
 	{
 		uint32_t idx = 0;
 		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			slot_conns[idx++] = slot_kv.value.conn;
+			slot_calls[idx].callable = slot_kv.value.conn.callable;
+			slot_calls[idx].flags = slot_kv.value.conn.flags;
+			idx++;
 		}
-		DEV_ASSERT(idx == s->slot_map.size());
+		DEV_ASSERT(idx == slot_count);
 	}
 
+	// Typed arguments are boxed the first time a callable needs them as variants.
+	bool boxed = p_typed_args == nullptr;
+
 	OBJ_DEBUG_LOCK
 
 	Error err = OK;
 
-	for (const Connection &c : slot_conns) {
+	for (uint32_t slot_idx = 0; slot_idx < slot_count; slot_idx++) {
+		const SlotCall &c = slot_calls[slot_idx];
 		Object *target = c.callable.get_object();
 		if (!target) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1063,7 +1081,22 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		const Variant **args = p_args;
 		int argc = p_argcount;
 
-		if (c.flags & CONNECT_DEFERRED) {
+		// Native callables that take exactly the emitted types are called without boxing the arguments.
+		bool called_typed = false;
+		if (p_typed_args && !(c.flags & CONNECT_DEFERRED) && c.callable.is_custom()) {
+			_emitting = true;
+			called_typed = c.callable.get_custom()->call_typed(p_typed_args->signature, p_typed_args->args);
+			_emitting = false;
+		}
+
+		if (!called_typed && !boxed) {
+			p_typed_args->box(p_typed_args->args, p_typed_args->variants);
+			boxed = true;
+		}
+
+		if (called_typed) {
+			// Already called.
+		} else if (c.flags & CONNECT_DEFERRED) {
 			MessageQueue::get_singleton()->push_callablep(c.callable, args, argc, true);
 		} else {
 			Callable::CallError ce;
@@ -1900,8 +1933,9 @@ void ObjectDB::debug_objects(DebugFunc p_func) {
 	spin_lock.lock();
 
 	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object);
+		ObjectSlot &object_slot = _get_slot(i);
+		if (ObjectSlot::get_validator(object_slot.data.load(std::memory_order_relaxed))) {
+			p_func(object_slot.object.load(std::memory_order_relaxed));
 			count--;
 		}
 	}
@@ -1954,7 +1988,7 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 SpinLock ObjectDB::spin_lock;
 uint32_t ObjectDB::slot_count = 0;
 uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::object_slot_blocks[OBJECTDB_SLOT_MAX_BLOCKS] = {};
 uint64_t ObjectDB::validator_counter = 0;
 
 int ObjectDB::get_object_count() {
@@ -1966,29 +2000,36 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 	if (unlikely(slot_count == slot_max)) {
 		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+		ObjectSlot *block = memnew_arr(ObjectSlot, OBJECTDB_SLOT_BLOCK_SIZE);
+		for (uint32_t i = 0; i < OBJECTDB_SLOT_BLOCK_SIZE; i++) {
+			block[i].object.store(nullptr, std::memory_order_relaxed);
+			block[i].data.store(uint64_t(slot_max + i) << OBJECTDB_VALIDATOR_BITS, std::memory_order_relaxed); // next_free = i
 		}
-		slot_max = new_slot_max;
+		// Publish the block only once it's initialized, lookups don't take the lock.
+		object_slot_blocks[slot_max >> OBJECTDB_SLOT_BLOCK_BITS].store(block, std::memory_order_release);
+		slot_max += OBJECTDB_SLOT_BLOCK_SIZE;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
+	uint32_t slot = ObjectSlot::get_next_free(_get_slot(slot_count).data.load(std::memory_order_relaxed));
+	ObjectSlot &object_slot = _get_slot(slot);
+	if (object_slot.object.load(std::memory_order_relaxed) != nullptr) {
 		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+		ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
 	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
 	if (unlikely(validator_counter == 0)) {
 		validator_counter = 1;
 	}
-	object_slots[slot].validator = validator_counter;
+
+	uint64_t data = object_slot.data.load(std::memory_order_relaxed) & ~(OBJECTDB_VALIDATOR_MASK | OBJECTDB_REFERENCE_BIT);
+	data |= validator_counter;
+	if (p_object->is_ref_counted()) {
+		data |= OBJECTDB_REFERENCE_BIT;
+	}
+	// The object must be visible before the validator that makes lookups accept it.
+	// Releasing the pointer itself also pairs with the fence after lookups load it.
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.data.store(data, std::memory_order_release);
 
 	uint64_t id = validator_counter;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
@@ -2011,17 +2052,19 @@ void ObjectDB::remove_instance(Object *p_object) {
 
 	spin_lock.lock();
 
+	ObjectSlot &object_slot = _get_slot(slot);
+
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
+	if (object_slot.object.load(std::memory_order_relaxed) != p_object) {
 		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
+		ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	}
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
+		if (ObjectSlot::get_validator(object_slot.data.load(std::memory_order_relaxed)) != validator) {
 			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
+			ERR_FAIL_COND(ObjectSlot::get_validator(object_slot.data.load(std::memory_order_relaxed)) != validator);
 		}
 	}
 
@@ -2029,11 +2072,15 @@ void ObjectDB::remove_instance(Object *p_object) {
 	//decrease slot count
 	slot_count--;
 	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
+	ObjectSlot &free_slot = _get_slot(slot_count);
+	uint64_t free_data = free_slot.data.load(std::memory_order_relaxed) & ~(OBJECTDB_SLOT_MAX_COUNT_MASK << OBJECTDB_VALIDATOR_BITS);
+	free_slot.data.store(free_data | (uint64_t(slot) << OBJECTDB_VALIDATOR_BITS), std::memory_order_relaxed);
 	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	uint64_t data = object_slot.data.load(std::memory_order_relaxed) & ~(OBJECTDB_VALIDATOR_MASK | OBJECTDB_REFERENCE_BIT);
+	object_slot.data.store(data, std::memory_order_relaxed);
+	// Lookups that see the cleared pointer must also see the cleared validator.
+	std::atomic_thread_fence(std::memory_order_release);
+	object_slot.object.store(nullptr, std::memory_order_relaxed);
 
 	spin_lock.unlock();
 }
@@ -2056,8 +2103,9 @@ void ObjectDB::cleanup() {
 			Callable::CallError call_error;
 
 			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+				uint64_t data = _get_slot(i).data.load(std::memory_order_relaxed);
+				if (ObjectSlot::get_validator(data)) {
+					Object *obj = _get_slot(i).object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2067,7 +2115,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Resource path: " + String(resource_get_path->call(obj, nullptr, 0, call_error));
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_VALIDATOR_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (ObjectSlot::get_validator(data) << OBJECTDB_VALIDATOR_BITS) | (ObjectSlot::is_ref_counted(data) ? OBJECTDB_REFERENCE_BIT : 0);
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + itos(id) + extra_info);
 
 					count--;
@@ -2078,7 +2126,12 @@ void ObjectDB::cleanup() {
 		spin_lock.unlock();
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < OBJECTDB_SLOT_MAX_BLOCKS; i++) {
+		ObjectSlot *block = object_slot_blocks[i].exchange(nullptr);
+		if (!block) {
+			break;
+		}
+		memdelete_arr(block);
 	}
+	slot_max = 0;
 }
@@ -499,6 +499,12 @@ protected:
 			m_inherits::_get_property_listv(p_list, p_reversed);                                                                                 \
 		}                                                                                                                                        \
 	}                                                                                                                                            \
+	virtual bool _has_dynamic_property_listv() const override {                                                                                  \
+		if (m_class::_get_get_property_list() != m_inherits::_get_get_property_list()) {                                                         \
+			return true;                                                                                                                         \
+		}                                                                                                                                        \
+		return m_inherits::_has_dynamic_property_listv();                                                                                        \
+	}                                                                                                                                            \
 	_FORCE_INLINE_ void (Object::*_get_validate_property() const)(PropertyInfo & p_property) const {                                             \
 		return (void(Object::*)(PropertyInfo &) const) & m_class::_validate_property;                                                            \
 	}                                                                                                                                            \
@@ -674,6 +680,7 @@ protected:
 	virtual bool _setv(const StringName &p_name, const Variant &p_property) { return false; };
 	virtual bool _getv(const StringName &p_name, Variant &r_property) const { return false; };
 	virtual void _get_property_listv(List<PropertyInfo> *p_list, bool p_reversed) const {};
+	virtual bool _has_dynamic_property_listv() const { return false; };
 	virtual void _validate_propertyv(PropertyInfo &p_property) const {};
 	virtual bool _property_can_revertv(const StringName &p_name) const { return false; };
 	virtual bool _property_get_revertv(const StringName &p_name, Variant &r_property) const { return false; };
@@ -881,14 +888,43 @@ public:
 
 	void add_user_signal(const MethodInfo &p_signal);
 
+protected:
+	// Unboxed arguments of emit_signal(), boxed into variants only for the callables that can't take them as they are.
+	struct SignalTypedArgs {
+		const void *signature = nullptr;
+		const void **args = nullptr;
+		Variant *variants = nullptr;
+		void (*box)(const void **p_args, Variant *r_variants) = nullptr;
+	};
+
+	template <typename... VarArgs, size_t... Is>
+	static void _box_signal_args_helper(const void **p_args, Variant *r_variants, IndexSequence<Is...>) {
+		((r_variants[Is] = *(const VarArgs *)p_args[Is]), ...);
+	}
+
+	template <typename... VarArgs>
+	static void _box_signal_args(const void **p_args, Variant *r_variants) {
+		_box_signal_args_helper<VarArgs...>(p_args, r_variants, BuildIndexSequence<sizeof...(VarArgs)>{});
+	}
+
+	Error _emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount, const SignalTypedArgs *p_typed_args);
+	MTVIRTUAL Error _emit_signal_typedp(const StringName &p_name, const Variant **p_args, int p_argcount, const SignalTypedArgs &p_typed_args);
+
+public:
 	template <typename... VarArgs>
 	Error emit_signal(const StringName &p_name, VarArgs... p_args) {
-		Variant args[sizeof...(p_args) + 1] = { p_args..., Variant() }; // +1 makes sure zero sized arrays are also supported.
+		Variant args[sizeof...(p_args) + 1]; // +1 makes sure zero sized arrays are also supported.
 		const Variant *argptrs[sizeof...(p_args) + 1];
 		for (uint32_t i = 0; i < sizeof...(p_args); i++) {
 			argptrs[i] = &args[i];
 		}
-		return emit_signalp(p_name, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
+		const void *typed_argptrs[sizeof...(p_args) + 1] = { &p_args..., nullptr };
+		SignalTypedArgs typed_args;
+		typed_args.signature = CallableSignature<VarArgs...>::get_id();
+		typed_args.args = typed_argptrs;
+		typed_args.variants = args;
+		typed_args.box = &_box_signal_args<VarArgs...>;
+		return _emit_signal_typedp(p_name, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args), typed_args);
 	}
 
 	MTVIRTUAL Error emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount);
@@ -955,6 +991,21 @@ public:
 bool predelete_handler(Object *p_object);
 void postinitialize_handler(Object *p_object);
 
+#ifdef DEBUG_ENABLED
+// Keeps an object from being freed by the method being called on it.
+struct _ObjectDebugLock {
+	Object *obj;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj = p_obj;
+		obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		obj->_lock_index.unref();
+	}
+};
+#endif
+
 class ObjectDB {
 // This needs to add up to 63, 1 bit is for reference.
 #define OBJECTDB_VALIDATOR_BITS 39
@@ -962,20 +1013,33 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
+// Slots are allocated in blocks that never move, so lookups don't need the lock.
+#define OBJECTDB_SLOT_BLOCK_BITS 12
+#define OBJECTDB_SLOT_BLOCK_SIZE (uint32_t(1) << OBJECTDB_SLOT_BLOCK_BITS)
+#define OBJECTDB_SLOT_BLOCK_MASK (OBJECTDB_SLOT_BLOCK_SIZE - 1)
+#define OBJECTDB_SLOT_MAX_BLOCKS (uint32_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SLOT_BLOCK_BITS))
 
 	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+		// Validator, next free slot and reference bit, packed so a single load yields the validator.
+		// Only written with the lock held; the validator of a slot is zero while it's free.
+		std::atomic<uint64_t> data;
+		std::atomic<Object *> object;
+
+		_ALWAYS_INLINE_ static uint64_t get_validator(uint64_t p_data) { return p_data & OBJECTDB_VALIDATOR_MASK; }
+		_ALWAYS_INLINE_ static uint32_t get_next_free(uint64_t p_data) { return (p_data >> OBJECTDB_VALIDATOR_BITS) & OBJECTDB_SLOT_MAX_COUNT_MASK; }
+		_ALWAYS_INLINE_ static bool is_ref_counted(uint64_t p_data) { return p_data & OBJECTDB_REFERENCE_BIT; }
 	};
 
 	static SpinLock spin_lock;
 	static uint32_t slot_count;
 	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
+	static std::atomic<ObjectSlot *> object_slot_blocks[OBJECTDB_SLOT_MAX_BLOCKS];
 	static uint64_t validator_counter;
 
+	_ALWAYS_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return object_slot_blocks[p_slot >> OBJECTDB_SLOT_BLOCK_BITS].load(std::memory_order_relaxed)[p_slot & OBJECTDB_SLOT_BLOCK_MASK];
+	}
+
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
@@ -993,20 +1057,31 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
+		ObjectSlot *block = object_slot_blocks[slot >> OBJECTDB_SLOT_BLOCK_BITS].load(std::memory_order_acquire);
+		ERR_FAIL_NULL_V(block, nullptr); // This should never happen unless RID is corrupted.
+		const ObjectSlot &object_slot = block[slot & OBJECTDB_SLOT_BLOCK_MASK];
 
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		// Lookups don't take the lock, so they rely on this ordering:
+		// - add_instance() stores the pointer, then the validator, both with release. Seeing the new
+		//   validator (acquire) guarantees that the pointer loaded after it is the new one.
+		// - remove_instance() clears the validator, then issues a release fence and clears the pointer.
+		//   If the pointer load sees it cleared, the acquire fence after it guarantees that the
+		//   second validator load sees the cleared validator too.
+		// Validators are never reused by another instance (until they wrap around),
+		// so if the slot holds the same validator before and after reading the pointer,
+		// the pointer belongs to the requested instance.
+		if (unlikely(ObjectSlot::get_validator(object_slot.data.load(std::memory_order_acquire)) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_relaxed);
 
-		spin_lock.unlock();
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (unlikely(ObjectSlot::get_validator(object_slot.data.load(std::memory_order_relaxed)) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
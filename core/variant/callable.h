@@ -149,6 +149,9 @@ public:
 	virtual StringName get_method() const;
 	virtual ObjectID get_object() const = 0;
 	virtual void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const = 0;
+	// Calls with unboxed arguments if the callable takes exactly the argument types identified by p_signature (see CallableSignature).
+	// Returns false without calling otherwise, so the caller can fall back to call().
+	virtual bool call_typed(const void *p_signature, const void **p_arguments) const;
 	virtual Error rpc(int p_peer_id, const Variant **p_arguments, int p_argcount, Callable::CallError &r_call_error) const;
 	virtual const Callable *get_base_comparator() const;
 	virtual int get_bound_arguments_count() const;
@@ -158,6 +161,15 @@ public:
 	virtual ~CallableCustom() {}
 };
 
+// Identifies a list of argument types for CallableCustom::call_typed().
+template <class... P>
+struct CallableSignature {
+	static const void *get_id() {
+		static const char id = 0;
+		return &id;
+	}
+};
+
 // This is just a proxy object to object signals, its only
 // allocated on demand by/for scripting languages so it can
 // be put inside a Variant, but it is not
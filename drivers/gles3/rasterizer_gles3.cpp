@@ -196,6 +196,7 @@ void RasterizerGLES3::finalize() {
 	memdelete(texture_storage);
 	memdelete(utilities);
 	memdelete(config);
+	ShaderCompiler::set_shader_cache_dir(String());
 }
 
 RasterizerGLES3 *RasterizerGLES3::singleton = nullptr;
@@ -282,6 +283,7 @@ RasterizerGLES3::RasterizerGLES3() {
 
 				if (!shader_cache_dir.is_empty()) {
 					ShaderGLES3::set_shader_cache_dir(shader_cache_dir);
+					ShaderCompiler::set_shader_cache_dir(shader_cache_dir);
 				}
 			}
 		}
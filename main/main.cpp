@@ -3460,6 +3460,7 @@ bool Main::iteration() {
 		exit = true;
 	}
 	message_queue->flush();
+	message_queue->end_frame_statistics();
 
 	RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
 
@@ -85,6 +85,9 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(RENDER_TOTAL_OCCLUSION_RAYS_IN_FRAME);
+	BIND_ENUM_CONSTANT(TIME_MESSAGE_QUEUE_FLUSH);
+	BIND_ENUM_CONSTANT(OBJECT_MESSAGE_QUEUE_MESSAGES_IN_FRAME);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -133,6 +136,9 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"raster/total_occlusion_rays",
+		"time/message_queue_flush",
+		"object/message_queue_messages",
 
 	};
 
@@ -162,7 +168,7 @@ double Performance::get_monitor(Monitor p_monitor) const {
 		case OBJECT_NODE_COUNT:
 			return _get_node_count();
 		case OBJECT_ORPHAN_NODE_COUNT:
-			return Node::orphan_node_count;
+			return Node::orphan_node_count.get();
 		case RENDER_TOTAL_OBJECTS_IN_FRAME:
 			return RS::get_singleton()->get_rendering_info(RS::RENDERING_INFO_TOTAL_OBJECTS_IN_FRAME);
 		case RENDER_TOTAL_PRIMITIVES_IN_FRAME:
@@ -207,6 +213,12 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case RENDER_TOTAL_OCCLUSION_RAYS_IN_FRAME:
+			return RS::get_singleton()->get_rendering_info(RS::RENDERING_INFO_TOTAL_OCCLUSION_RAYS_IN_FRAME);
+		case TIME_MESSAGE_QUEUE_FLUSH:
+			return USEC_TO_SEC(MessageQueue::get_singleton()->get_frame_flush_time_usec());
+		case OBJECT_MESSAGE_QUEUE_MESSAGES_IN_FRAME:
+			return MessageQueue::get_singleton()->get_frame_flushed_messages();
 
 		default: {
 		}
@@ -252,6 +264,9 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
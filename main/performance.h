@@ -100,6 +100,9 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		RENDER_TOTAL_OCCLUSION_RAYS_IN_FRAME,
+		TIME_MESSAGE_QUEUE_FLUSH,
+		OBJECT_MESSAGE_QUEUE_MESSAGES_IN_FRAME,
 		MONITOR_MAX
 	};
 
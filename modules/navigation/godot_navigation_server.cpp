@@ -930,6 +930,81 @@ COMMAND_2(obstacle_set_avoidance_layers, RID, p_obstacle, uint32_t, p_layers) {
 	obstacle->set_avoidance_layers(p_layers);
 }
 
+RID GodotNavigationServer::flow_field_create() {
+	MutexLock lock(operations_mutex);
+
+	RID rid = flow_field_owner.make_rid();
+	NavFlowField *flow_field = flow_field_owner.get_or_null(rid);
+	flow_field->set_self(rid);
+	return rid;
+}
+
+COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND(flow_field == nullptr);
+
+	NavMap *map = map_owner.get_or_null(p_map);
+
+	flow_field->set_map(map);
+}
+
+RID GodotNavigationServer::flow_field_get_map(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, RID());
+	if (flow_field->get_map()) {
+		return flow_field->get_map()->get_self();
+	}
+	return RID();
+}
+
+COMMAND_2(flow_field_set_target_position, RID, p_flow_field, Vector3, p_position) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND(flow_field == nullptr);
+	flow_field->set_target_position(p_position);
+}
+
+Vector3 GodotNavigationServer::flow_field_get_target_position(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, Vector3());
+	return flow_field->get_target_position();
+}
+
+COMMAND_2(flow_field_set_cell_size, RID, p_flow_field, real_t, p_cell_size) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND(flow_field == nullptr);
+	flow_field->set_cell_size(p_cell_size);
+}
+
+real_t GodotNavigationServer::flow_field_get_cell_size(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, 0);
+	return flow_field->get_cell_size();
+}
+
+COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND(flow_field == nullptr);
+	flow_field->set_navigation_layers(p_navigation_layers);
+}
+
+uint32_t GodotNavigationServer::flow_field_get_navigation_layers(RID p_flow_field) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, 0);
+	return flow_field->get_navigation_layers();
+}
+
+Vector3 GodotNavigationServer::flow_field_get_direction(RID p_flow_field, const Vector3 &p_position) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, Vector3());
+	return flow_field->get_direction(p_position);
+}
+
+real_t GodotNavigationServer::flow_field_get_distance(RID p_flow_field, const Vector3 &p_position) const {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_flow_field);
+	ERR_FAIL_COND_V(flow_field == nullptr, -1.0);
+	return flow_field->get_distance(p_position);
+}
+
 void GodotNavigationServer::parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback) {
 #ifndef _3D_DISABLED
 	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "The SceneTree can only be parsed on the main thread. Call this function from the main thread or use call_deferred().");
@@ -990,6 +1065,11 @@ COMMAND_1(free, RID, p_object) {
 			obstacle->set_map(nullptr);
 		}
 
+		// Remove any assigned flow fields
+		while (map->get_flow_fields().size() > 0) {
+			map->get_flow_fields()[0]->set_map(nullptr);
+		}
+
 		int map_index = active_maps.find(map);
 		if (map_index >= 0) {
 			active_maps.remove_at(map_index);
@@ -1025,6 +1105,9 @@ COMMAND_1(free, RID, p_object) {
 	} else if (obstacle_owner.owns(p_object)) {
 		internal_free_obstacle(p_object);
 
+	} else if (flow_field_owner.owns(p_object)) {
+		internal_free_flow_field(p_object);
+
 	} else {
 		ERR_PRINT("Attempted to free a NavigationServer RID that did not exist (or was already freed).");
 	}
@@ -1058,6 +1141,14 @@ void GodotNavigationServer::internal_free_obstacle(RID p_object) {
 	}
 }
 
+void GodotNavigationServer::internal_free_flow_field(RID p_object) {
+	NavFlowField *flow_field = flow_field_owner.get_or_null(p_object);
+	if (flow_field) {
+		flow_field->set_map(nullptr);
+		flow_field_owner.free(p_object);
+	}
+}
+
 void GodotNavigationServer::set_active(bool p_active) {
 	MutexLock lock(operations_mutex);
 
@@ -32,6 +32,7 @@
 #define GODOT_NAVIGATION_SERVER_H
 
 #include "nav_agent.h"
+#include "nav_flow_field.h"
 #include "nav_link.h"
 #include "nav_map.h"
 #include "nav_obstacle.h"
@@ -75,6 +76,7 @@ class GodotNavigationServer : public NavigationServer3D {
 	mutable RID_Owner<NavRegion> region_owner;
 	mutable RID_Owner<NavAgent> agent_owner;
 	mutable RID_Owner<NavObstacle> obstacle_owner;
+	mutable RID_Owner<NavFlowField> flow_field_owner;
 
 	bool active = true;
 	LocalVector<NavMap *> active_maps;
@@ -228,6 +230,18 @@ public:
 	virtual void obstacle_set_vertices(RID p_obstacle, const Vector<Vector3> &p_vertices) override;
 	COMMAND_2(obstacle_set_avoidance_layers, RID, p_obstacle, uint32_t, p_layers);
 
+	virtual RID flow_field_create() override;
+	COMMAND_2(flow_field_set_map, RID, p_flow_field, RID, p_map);
+	virtual RID flow_field_get_map(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_target_position, RID, p_flow_field, Vector3, p_position);
+	virtual Vector3 flow_field_get_target_position(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_cell_size, RID, p_flow_field, real_t, p_cell_size);
+	virtual real_t flow_field_get_cell_size(RID p_flow_field) const override;
+	COMMAND_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers);
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const override;
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, const Vector3 &p_position) const override;
+	virtual real_t flow_field_get_distance(RID p_flow_field, const Vector3 &p_position) const override;
+
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override;
 	virtual void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override;
 
@@ -247,6 +261,7 @@ public:
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+	void internal_free_flow_field(RID p_object);
 };
 
 #undef COMMAND_1
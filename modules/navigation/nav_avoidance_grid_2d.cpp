@@ -0,0 +1,185 @@
+/**************************************************************************/
+/*  nav_avoidance_grid_2d.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_avoidance_grid_2d.h"
+
+#include "nav_agent.h"
+
+// Cell size is kept within this factor of the largest neighbor distance,
+// otherwise the grid is rebuilt with a new cell size.
+#define CELL_SIZE_TOLERANCE 2.0
+#define MIN_CELL_SIZE 0.1
+// Cells added around the agents on rebuild, so moving agents do not trigger another one right away.
+#define REGION_MARGIN 4
+// Grids covering sparse agents grow their cells instead of allocating more than this many cells per agent.
+#define MAX_CELLS_PER_AGENT 8
+#define MIN_CELL_BUDGET 4096
+
+void NavAvoidanceGrid2D::_rebuild(const LocalVector<NavAgent *> &p_agents, const Rect2 &p_bounds, float p_cell_size) {
+	cells.clear();
+	entries.clear();
+
+	const int64_t cell_budget = MAX(int64_t(p_agents.size()) * MAX_CELLS_PER_AGENT, int64_t(MIN_CELL_BUDGET));
+	cell_size = p_cell_size;
+	while (true) {
+		const Vector2i from = _get_cell(p_bounds.position.x, p_bounds.position.y) - Vector2i(REGION_MARGIN, REGION_MARGIN);
+		const Vector2i to = _get_cell(p_bounds.position.x + p_bounds.size.x, p_bounds.position.y + p_bounds.size.y) + Vector2i(REGION_MARGIN, REGION_MARGIN);
+		if (int64_t(to.x - from.x + 1) * int64_t(to.y - from.y + 1) <= cell_budget) {
+			region = Rect2i(from, to - from + Vector2i(1, 1));
+			break;
+		}
+		cell_size *= 2.0;
+	}
+
+	cells.resize(region.size.x * region.size.y);
+
+	for (NavAgent *agent : p_agents) {
+		RVO2D::Agent2D *rvo_agent = agent->get_rvo_agent_2d();
+		Entry &entry = entries.insert(rvo_agent, Entry())->value;
+		entry.update_id = update_id;
+		_insert(rvo_agent, entry, _get_cell_index(_get_cell(rvo_agent->position_.x(), rvo_agent->position_.y())));
+	}
+}
+
+void NavAvoidanceGrid2D::_insert(RVO2D::Agent2D *p_agent, Entry &r_entry, uint32_t p_cell) {
+	LocalVector<RVO2D::Agent2D *> &bucket = cells[p_cell];
+	r_entry.cell = p_cell;
+	r_entry.slot = bucket.size();
+	bucket.push_back(p_agent);
+}
+
+void NavAvoidanceGrid2D::_erase(const Entry &p_entry) {
+	LocalVector<RVO2D::Agent2D *> &bucket = cells[p_entry.cell];
+	ERR_FAIL_UNSIGNED_INDEX(p_entry.slot, bucket.size());
+
+	const uint32_t last = bucket.size() - 1;
+	if (p_entry.slot != last) {
+		RVO2D::Agent2D *moved = bucket[last];
+		bucket[p_entry.slot] = moved;
+		entries[moved].slot = p_entry.slot;
+	}
+	bucket.resize(last);
+}
+
+void NavAvoidanceGrid2D::update(const LocalVector<NavAgent *> &p_agents) {
+	if (p_agents.is_empty()) {
+		clear();
+		return;
+	}
+
+	update_id++;
+
+	float max_neighbor_distance = 0.0;
+	Rect2 bounds;
+	for (uint32_t i = 0; i < p_agents.size(); i++) {
+		const RVO2D::Agent2D *rvo_agent = p_agents[i]->get_rvo_agent_2d();
+		max_neighbor_distance = MAX(max_neighbor_distance, rvo_agent->neighborDist_);
+		const Vector2 position = Vector2(rvo_agent->position_.x(), rvo_agent->position_.y());
+		if (i == 0) {
+			bounds = Rect2(position, Vector2());
+		} else {
+			bounds.expand_to(position);
+		}
+	}
+	max_neighbor_distance = MAX(max_neighbor_distance, float(MIN_CELL_SIZE));
+
+	// Cells as large as the largest query range keep every query within 3x3 cells.
+	// Small changes in the neighbor distances do not justify moving every agent.
+	const bool cell_size_changed = cell_size <= 0.0 || max_neighbor_distance > cell_size * CELL_SIZE_TOLERANCE || max_neighbor_distance < cell_size / CELL_SIZE_TOLERANCE;
+	if (cell_size_changed || !region.has_point(_get_cell(bounds.position.x, bounds.position.y)) || !region.has_point(_get_cell(bounds.position.x + bounds.size.x, bounds.position.y + bounds.size.y))) {
+		_rebuild(p_agents, bounds, cell_size_changed ? max_neighbor_distance : cell_size);
+		return;
+	}
+
+	for (NavAgent *agent : p_agents) {
+		RVO2D::Agent2D *rvo_agent = agent->get_rvo_agent_2d();
+		const uint32_t cell = _get_cell_index(_get_cell(rvo_agent->position_.x(), rvo_agent->position_.y()));
+
+		Entry *entry = entries.getptr(rvo_agent);
+		if (!entry) {
+			entry = &entries.insert(rvo_agent, Entry())->value;
+			_insert(rvo_agent, *entry, cell);
+		} else if (entry->cell != cell) {
+			_erase(*entry);
+			_insert(rvo_agent, *entry, cell);
+		}
+		entry->update_id = update_id;
+	}
+
+	if (entries.size() == p_agents.size()) {
+		return;
+	}
+
+	// Some agents were removed from avoidance since the last update.
+	LocalVector<RVO2D::Agent2D *> stale_agents;
+	for (const KeyValue<RVO2D::Agent2D *, Entry> &E : entries) {
+		if (E.value.update_id != update_id) {
+			stale_agents.push_back(E.key);
+		}
+	}
+	for (RVO2D::Agent2D *stale_agent : stale_agents) {
+		_erase(entries[stale_agent]);
+		entries.erase(stale_agent);
+	}
+}
+
+void NavAvoidanceGrid2D::clear() {
+	cells.clear();
+	entries.clear();
+	region = Rect2i();
+	cell_size = 0.0;
+}
+
+void NavAvoidanceGrid2D::compute_agent_neighbors(RVO2D::Agent2D *p_agent) const {
+	if (p_agent->maxNeighbors_ == 0 || cells.is_empty()) {
+		return;
+	}
+
+	const float range = p_agent->neighborDist_;
+	float range_sq = range * range;
+
+	const RVO2D::Vector2 &position = p_agent->position_;
+	const Vector2i from = _get_cell(position.x() - range, position.y() - range).max(region.position);
+	const Vector2i to = _get_cell(position.x() + range, position.y() + range).min(region.get_end() - Vector2i(1, 1));
+
+	for (int32_t y = from.y; y <= to.y; y++) {
+		// Distance from the agent to the cell row, cells out of the (shrinking) range are skipped.
+		const float dy = MAX(MAX(y * cell_size - position.y(), position.y() - (y + 1) * cell_size), 0.0f);
+		for (int32_t x = from.x; x <= to.x; x++) {
+			const float dx = MAX(MAX(x * cell_size - position.x(), position.x() - (x + 1) * cell_size), 0.0f);
+			if (dx * dx + dy * dy >= range_sq) {
+				continue;
+			}
+			for (const RVO2D::Agent2D *other : cells[_get_cell_index(Vector2i(x, y))]) {
+				p_agent->insertAgentNeighbor(other, range_sq);
+			}
+		}
+	}
+}
@@ -0,0 +1,87 @@
+/**************************************************************************/
+/*  nav_avoidance_grid_2d.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_AVOIDANCE_GRID_2D_H
+#define NAV_AVOIDANCE_GRID_2D_H
+
+#include "core/math/rect2i.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+#include <Agent2d.h>
+
+class NavAgent;
+
+/// Uniform grid of the 2D avoidance agents of a map.
+/// Used in place of the RVO2 agent KdTree, which has to be rebuilt from scratch
+/// each time agents move. Only agents that changed cell since the last update
+/// touch the grid, it is only rebuilt when agents leave the covered area or the
+/// neighbor distances change a lot.
+class NavAvoidanceGrid2D {
+	struct Entry {
+		uint32_t cell = 0;
+		uint32_t slot = 0;
+		uint32_t update_id = 0;
+	};
+
+	/// Area covered by the grid, in cells.
+	Rect2i region;
+	real_t cell_size = 0.0;
+	uint32_t update_id = 0;
+
+	LocalVector<LocalVector<RVO2D::Agent2D *>> cells;
+	HashMap<RVO2D::Agent2D *, Entry> entries;
+
+	_FORCE_INLINE_ Vector2i _get_cell(float p_x, float p_y) const {
+		return Vector2i(Math::floor(p_x / cell_size), Math::floor(p_y / cell_size));
+	}
+
+	_FORCE_INLINE_ uint32_t _get_cell_index(const Vector2i &p_cell) const {
+		return (p_cell.y - region.position.y) * region.size.x + (p_cell.x - region.position.x);
+	}
+
+	void _rebuild(const LocalVector<NavAgent *> &p_agents, const Rect2 &p_bounds, float p_cell_size);
+	void _insert(RVO2D::Agent2D *p_agent, Entry &r_entry, uint32_t p_cell);
+	void _erase(const Entry &p_entry);
+
+public:
+	void update(const LocalVector<NavAgent *> &p_agents);
+	void clear();
+
+	/// Same as the agent part of RVO2D::Agent2D::computeNeighbors().
+	/// Only reads the grid, so it is safe to call from multiple threads.
+	void compute_agent_neighbors(RVO2D::Agent2D *p_agent) const;
+
+	real_t get_cell_size() const { return cell_size; }
+	uint32_t get_agent_count() const { return entries.size(); }
+	uint32_t get_cell_count() const { return cells.size(); }
+};
+
+#endif // NAV_AVOIDANCE_GRID_2D_H
@@ -0,0 +1,743 @@
+/**************************************************************************/
+/*  nav_flow_field.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_flow_field.h"
+
+#include "nav_base.h"
+#include "nav_map.h"
+#include "nav_obstacle.h"
+
+#include "core/math/geometry_2d.h"
+
+// Keeps a single flow field below ~64 MB of memory.
+#define MAX_FLOW_FIELD_CELLS (1 << 22)
+
+static const int neighbor_offsets[8][2] = {
+	{ -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 }, // Orthogonal.
+	{ -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } // Diagonal.
+};
+
+NavFlowField::NavFlowField() {}
+
+NavFlowField::~NavFlowField() {}
+
+void NavFlowField::set_map(NavMap *p_map) {
+	if (map == p_map) {
+		return;
+	}
+
+	if (map) {
+		map->remove_flow_field(this);
+	}
+
+	map = p_map;
+	grid_dirty = true;
+	map_update_id = 0;
+
+	if (map) {
+		map->add_flow_field(this);
+	}
+}
+
+void NavFlowField::set_target_position(const Vector3 &p_position) {
+	if (target_position == p_position) {
+		return;
+	}
+	target_position = p_position;
+	target_dirty = true;
+}
+
+void NavFlowField::set_cell_size(real_t p_cell_size) {
+	ERR_FAIL_COND_MSG(p_cell_size <= 0.0, "Flow field cell size must be greater than 0.");
+	if (cell_size == p_cell_size) {
+		return;
+	}
+	cell_size = p_cell_size;
+	grid_dirty = true;
+}
+
+void NavFlowField::set_navigation_layers(uint32_t p_navigation_layers) {
+	if (navigation_layers == p_navigation_layers) {
+		return;
+	}
+	navigation_layers = p_navigation_layers;
+	grid_dirty = true;
+}
+
+// Height of the polygon at a point of its XZ projection, using the same triangle fan as the map queries.
+static real_t get_polygon_height(const gd::Polygon &p_polygon, const Vector2 &p_point) {
+	const Vector3 &a = p_polygon.points[0].pos;
+	for (uint32_t i = 2; i < p_polygon.points.size(); i++) {
+		const Vector3 &b = p_polygon.points[i - 1].pos;
+		const Vector3 &c = p_polygon.points[i].pos;
+		const Vector2 ab = Vector2(b.x - a.x, b.z - a.z);
+		const Vector2 ac = Vector2(c.x - a.x, c.z - a.z);
+		const Vector2 ap = p_point - Vector2(a.x, a.z);
+		const real_t area = ab.cross(ac);
+		if (Math::is_zero_approx(area)) {
+			continue;
+		}
+		const real_t u = ap.cross(ac) / area;
+		const real_t v = ab.cross(ap) / area;
+		if (u >= -CMP_EPSILON && v >= -CMP_EPSILON && u + v <= 1.0 + CMP_EPSILON) {
+			return a.y + (b.y - a.y) * u + (c.y - a.y) * v;
+		}
+	}
+	return p_polygon.center.y;
+}
+
+int NavFlowField::_get_neighbor_column(int p_column, int p_neighbor) const {
+	const int x = p_column % grid_size.x + neighbor_offsets[p_neighbor][0];
+	const int z = p_column / grid_size.x + neighbor_offsets[p_neighbor][1];
+	if (x < 0 || z < 0 || x >= grid_size.x || z >= grid_size.y) {
+		return -1;
+	}
+	return z * grid_size.x + x;
+}
+
+bool NavFlowField::_are_polygons_connected(uint32_t p_polygon, uint32_t p_other_polygon) const {
+	if (p_polygon == p_other_polygon) {
+		return true;
+	}
+	for (uint32_t i = polygon_neighbors_start[p_polygon]; i < polygon_neighbors_start[p_polygon + 1]; i++) {
+		if (polygon_neighbors[i] == p_other_polygon) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool NavFlowField::_has_connected_cell(uint32_t p_cell, int p_column) const {
+	for (uint32_t i = column_cells[p_column]; i < column_cells[p_column + 1]; i++) {
+		if (_is_passable(i) && _are_polygons_connected(cells[p_cell].polygon, cells[i].polygon)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int NavFlowField::_get_column(const Vector3 &p_position) const {
+	const int x = int(Math::floor(p_position.x / cell_size)) - grid_origin.x;
+	const int z = int(Math::floor(p_position.z / cell_size)) - grid_origin.y;
+	if (x < 0 || z < 0 || x >= grid_size.x || z >= grid_size.y) {
+		return -1;
+	}
+	return z * grid_size.x + x;
+}
+
+int NavFlowField::_get_cell(const Vector3 &p_position) const {
+	const int column = _get_column(p_position);
+	if (column < 0) {
+		return -1;
+	}
+
+	// Pick the layer closest to the position.
+	int closest_cell = -1;
+	real_t closest_distance = FLT_MAX;
+	for (uint32_t i = column_cells[column]; i < column_cells[column + 1]; i++) {
+		const real_t distance = Math::abs(cells[i].height - p_position.y);
+		if (distance < closest_distance) {
+			closest_distance = distance;
+			closest_cell = i;
+		}
+	}
+	return closest_cell;
+}
+
+int NavFlowField::_find_target_cell() const {
+	const Vector3 target_on_map = map->get_closest_point(target_position);
+	const int column = _get_column(target_on_map);
+	if (column < 0) {
+		return -1;
+	}
+	const int cell = _get_cell(target_on_map);
+	if (cell >= 0) {
+		return cell;
+	}
+
+	// The closest point can be on a polygon edge that does not cover the center of its column.
+	int closest_cell = -1;
+	real_t closest_distance = FLT_MAX;
+	for (int i = 0; i < 8; i++) {
+		const int neighbor_column = _get_neighbor_column(column, i);
+		if (neighbor_column < 0) {
+			continue;
+		}
+		for (uint32_t j = column_cells[neighbor_column]; j < column_cells[neighbor_column + 1]; j++) {
+			const real_t distance = Math::abs(cells[j].height - target_on_map.y);
+			if (distance < closest_distance) {
+				closest_distance = distance;
+				closest_cell = j;
+			}
+		}
+	}
+	return closest_cell;
+}
+
+void NavFlowField::_rasterize_polygons() {
+	grid_origin = Vector2i();
+	grid_size = Vector2i();
+	cells.clear();
+	column_cells.clear();
+	polygon_neighbors_start.clear();
+	polygon_neighbors.clear();
+	links.clear();
+	incoming_links.clear();
+	blocked.clear();
+	blocked_cells.clear();
+	distances.clear();
+	next_cells.clear();
+
+	const LocalVector<gd::Polygon> &polygons = map->get_polygons();
+
+	Rect2 bounds;
+	bool first = true;
+	for (const gd::Polygon &polygon : polygons) {
+		if (!(polygon.owner->get_navigation_layers() & navigation_layers)) {
+			continue;
+		}
+		for (const gd::Point &point : polygon.points) {
+			if (first) {
+				bounds = Rect2(point.pos.x, point.pos.z, 0.0, 0.0);
+				first = false;
+			} else {
+				bounds.expand_to(Vector2(point.pos.x, point.pos.z));
+			}
+		}
+	}
+	if (first) {
+		return;
+	}
+
+	const Vector2i new_grid_origin = Vector2i(Math::floor(bounds.position.x / cell_size), Math::floor(bounds.position.y / cell_size));
+	const Vector2i grid_end = Vector2i(Math::floor(bounds.get_end().x / cell_size), Math::floor(bounds.get_end().y / cell_size));
+	const Vector2i new_grid_size = grid_end - new_grid_origin + Vector2i(1, 1);
+	ERR_FAIL_COND_MSG(int64_t(new_grid_size.x) * new_grid_size.y > MAX_FLOW_FIELD_CELLS, vformat("Flow field would need %d x %d cells to cover the navigation map, increase the flow field cell size.", new_grid_size.x, new_grid_size.y));
+	grid_origin = new_grid_origin;
+	grid_size = new_grid_size;
+
+	// Sample every polygon at the column centers it covers.
+	LocalVector<Cell> samples;
+	Vector<Vector2> polygon_points;
+	for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+		const gd::Polygon &polygon = polygons[polygon_index];
+		if (!(polygon.owner->get_navigation_layers() & navigation_layers)) {
+			continue;
+		}
+
+		Cell sample;
+		sample.polygon = polygon_index;
+		sample.cost = MAX(polygon.owner->get_travel_cost(), (real_t)CMP_EPSILON);
+
+		polygon_points.resize(polygon.points.size());
+		Rect2 polygon_bounds = Rect2(polygon.points[0].pos.x, polygon.points[0].pos.z, 0.0, 0.0);
+		for (uint32_t i = 0; i < polygon.points.size(); i++) {
+			polygon_points.write[i] = Vector2(polygon.points[i].pos.x, polygon.points[i].pos.z);
+			polygon_bounds.expand_to(polygon_points[i]);
+		}
+
+		const int from_x = int(Math::floor(polygon_bounds.position.x / cell_size)) - grid_origin.x;
+		const int from_z = int(Math::floor(polygon_bounds.position.y / cell_size)) - grid_origin.y;
+		const int to_x = int(Math::floor(polygon_bounds.get_end().x / cell_size)) - grid_origin.x;
+		const int to_z = int(Math::floor(polygon_bounds.get_end().y / cell_size)) - grid_origin.y;
+
+		bool covered_any = false;
+		for (int z = from_z; z <= to_z; z++) {
+			for (int x = from_x; x <= to_x; x++) {
+				const int column = z * grid_size.x + x;
+				const Vector2 column_center = _get_column_center(column);
+				if (!Geometry2D::is_point_in_polygon(column_center, polygon_points)) {
+					continue;
+				}
+				covered_any = true;
+				sample.column = column;
+				sample.height = get_polygon_height(polygon, column_center);
+				samples.push_back(sample);
+			}
+		}
+
+		// Keep polygons smaller than a cell connected.
+		if (!covered_any) {
+			const int column = _get_column(polygon.center);
+			if (column >= 0) {
+				sample.column = column;
+				sample.height = polygon.center.y;
+				samples.push_back(sample);
+			}
+		}
+	}
+
+	// Sort the samples into their columns.
+	const uint32_t column_count = grid_size.x * grid_size.y;
+	column_cells.resize(column_count + 1);
+	memset(column_cells.ptr(), 0, (column_count + 1) * sizeof(uint32_t));
+	for (const Cell &sample : samples) {
+		column_cells[sample.column + 1]++;
+	}
+	for (uint32_t i = 0; i < column_count; i++) {
+		column_cells[i + 1] += column_cells[i];
+	}
+	cells.resize(samples.size());
+	LocalVector<uint32_t> column_fill;
+	column_fill.resize(column_count);
+	memcpy(column_fill.ptr(), column_cells.ptr(), column_count * sizeof(uint32_t));
+	for (const Cell &sample : samples) {
+		cells[column_fill[sample.column]++] = sample;
+	}
+
+	blocked.resize(cells.size());
+	distances.resize(cells.size());
+	next_cells.resize(cells.size());
+	memset(blocked.ptr(), 0, cells.size() * sizeof(uint8_t));
+
+	// Finds the cell of a polygon at or next to a position, polygons can miss the center of the column the position is in.
+	auto find_polygon_cell = [&](uint32_t p_polygon, const Vector3 &p_position) -> int {
+		const int column = _get_column(p_position);
+		if (column < 0) {
+			return -1;
+		}
+		for (int i = -1; i < 8; i++) {
+			const int search_column = i < 0 ? column : _get_neighbor_column(column, i);
+			if (search_column < 0) {
+				continue;
+			}
+			for (uint32_t j = column_cells[search_column]; j < column_cells[search_column + 1]; j++) {
+				if (cells[j].polygon == p_polygon) {
+					return j;
+				}
+			}
+		}
+		return -1;
+	};
+
+	// Connect the polygons the same way the map does, through shared or nearby edges and navigation links.
+	const gd::Polygon *polygons_begin = polygons.ptr();
+	const gd::Polygon *polygons_end = polygons_begin + polygons.size();
+	LocalVector<LocalVector<uint32_t>> connected_polygons;
+	connected_polygons.resize(polygons.size());
+	for (uint32_t polygon_index = 0; polygon_index < polygons.size(); polygon_index++) {
+		const gd::Polygon &polygon = polygons[polygon_index];
+		if (!(polygon.owner->get_navigation_layers() & navigation_layers)) {
+			continue;
+		}
+		for (const gd::Edge &edge : polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				if (connection.polygon >= polygons_begin && connection.polygon < polygons_end) {
+					if (!(connection.polygon->owner->get_navigation_layers() & navigation_layers)) {
+						continue;
+					}
+					const uint32_t other_index = connection.polygon - polygons_begin;
+					if (connected_polygons[polygon_index].find(other_index) < 0) {
+						connected_polygons[polygon_index].push_back(other_index);
+						connected_polygons[other_index].push_back(polygon_index);
+					}
+					continue;
+				}
+
+				// Connections to polygons outside of the map polygons enter a navigation link, which leaves from its other end.
+				const gd::Polygon *link_polygon = connection.polygon;
+				if (!(link_polygon->owner->get_navigation_layers() & navigation_layers)) {
+					continue;
+				}
+				const int exit_edge = connection.pathway_start.is_equal_approx(link_polygon->points[0].pos) ? 2 : 0;
+				for (const gd::Edge::Connection &exit_connection : link_polygon->edges[exit_edge].connections) {
+					if (exit_connection.polygon < polygons_begin || exit_connection.polygon >= polygons_end || !(exit_connection.polygon->owner->get_navigation_layers() & navigation_layers)) {
+						continue;
+					}
+					CellLink link;
+					const int from = find_polygon_cell(polygon_index, connection.pathway_start);
+					const int to = find_polygon_cell(exit_connection.polygon - polygons_begin, exit_connection.pathway_start);
+					if (from < 0 || to < 0 || from == to) {
+						continue;
+					}
+					link.from = from;
+					link.to = to;
+					link.cost = connection.pathway_start.distance_to(exit_connection.pathway_start) * MAX(link_polygon->owner->get_travel_cost(), (real_t)CMP_EPSILON);
+					incoming_links[link.to].push_back(links.size());
+					links.push_back(link);
+				}
+			}
+		}
+	}
+
+	polygon_neighbors_start.resize(polygons.size() + 1);
+	polygon_neighbors_start[0] = 0;
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		for (uint32_t other_index : connected_polygons[i]) {
+			polygon_neighbors.push_back(other_index);
+		}
+		polygon_neighbors_start[i + 1] = polygon_neighbors.size();
+	}
+}
+
+void NavFlowField::_rasterize_obstacles(LocalVector<uint32_t> &r_newly_blocked, LocalVector<uint32_t> &r_newly_unblocked) {
+	// Cells still blocked are marked 3, newly blocked cells 2, cells left at 1 are not blocked anymore.
+	Vector<Vector2> obstacle_points;
+	for (NavObstacle *obstacle : map->get_obstacles()) {
+		if (obstacle->get_paused()) {
+			continue;
+		}
+
+		const Vector3 &position = obstacle->get_position();
+		const Vector<Vector3> &vertices = obstacle->get_vertices();
+		Rect2 obstacle_bounds;
+		if (vertices.size() >= 3) {
+			obstacle_points.resize(vertices.size());
+			obstacle_bounds = Rect2(vertices[0].x + position.x, vertices[0].z + position.z, 0.0, 0.0);
+			for (int i = 0; i < vertices.size(); i++) {
+				obstacle_points.write[i] = Vector2(vertices[i].x + position.x, vertices[i].z + position.z);
+				obstacle_bounds.expand_to(obstacle_points[i]);
+			}
+		} else if (obstacle->get_radius() > 0.0) {
+			const real_t radius = obstacle->get_radius();
+			obstacle_bounds = Rect2(position.x - radius, position.z - radius, radius * 2.0, radius * 2.0);
+		} else {
+			continue;
+		}
+
+		// Obstacles only block the layers they stand on.
+		const real_t height_margin = map->get_cell_height();
+		const real_t min_height = position.y - height_margin;
+		const real_t max_height = position.y + MAX(obstacle->get_height(), (real_t)0.0) + height_margin;
+
+		const int from_x = MAX(int(Math::floor(obstacle_bounds.position.x / cell_size)) - grid_origin.x, 0);
+		const int from_z = MAX(int(Math::floor(obstacle_bounds.position.y / cell_size)) - grid_origin.y, 0);
+		const int to_x = MIN(int(Math::floor(obstacle_bounds.get_end().x / cell_size)) - grid_origin.x, grid_size.x - 1);
+		const int to_z = MIN(int(Math::floor(obstacle_bounds.get_end().y / cell_size)) - grid_origin.y, grid_size.y - 1);
+
+		for (int z = from_z; z <= to_z; z++) {
+			for (int x = from_x; x <= to_x; x++) {
+				const int column = z * grid_size.x + x;
+				if (column_cells[column] == column_cells[column + 1]) {
+					continue;
+				}
+				const Vector2 column_center = _get_column_center(column);
+				if (vertices.size() >= 3) {
+					if (!Geometry2D::is_point_in_polygon(column_center, obstacle_points)) {
+						continue;
+					}
+				} else if (column_center.distance_squared_to(Vector2(position.x, position.z)) > obstacle->get_radius() * obstacle->get_radius()) {
+					continue;
+				}
+
+				for (uint32_t cell = column_cells[column]; cell < column_cells[column + 1]; cell++) {
+					if (blocked[cell] >= 2 || cells[cell].height < min_height || cells[cell].height > max_height) {
+						continue;
+					}
+					if (blocked[cell] == 1) {
+						blocked[cell] = 3;
+					} else {
+						blocked[cell] = 2;
+						r_newly_blocked.push_back(cell);
+					}
+				}
+			}
+		}
+	}
+
+	LocalVector<uint32_t> still_blocked;
+	for (uint32_t cell : blocked_cells) {
+		if (blocked[cell] == 3) {
+			blocked[cell] = 1;
+			still_blocked.push_back(cell);
+		} else {
+			blocked[cell] = 0;
+			r_newly_unblocked.push_back(cell);
+		}
+	}
+	for (uint32_t cell : r_newly_blocked) {
+		blocked[cell] = 1;
+		still_blocked.push_back(cell);
+	}
+	blocked_cells = still_blocked;
+}
+
+void NavFlowField::_open_cell(uint32_t p_cell, real_t p_distance) {
+	// Binary min-heap on the distance.
+	uint32_t index = open_cells.size();
+	open_cells.push_back(OpenCell());
+	while (index > 0) {
+		const uint32_t parent = (index - 1) / 2;
+		if (open_cells[parent].distance <= p_distance) {
+			break;
+		}
+		open_cells[index] = open_cells[parent];
+		index = parent;
+	}
+	open_cells[index].distance = p_distance;
+	open_cells[index].cell = p_cell;
+}
+
+void NavFlowField::_propagate() {
+	while (open_cells.size() > 0) {
+		const OpenCell current = open_cells[0];
+		const OpenCell last = open_cells[open_cells.size() - 1];
+		open_cells.resize(open_cells.size() - 1);
+		if (open_cells.size() > 0) {
+			uint32_t index = 0;
+			while (true) {
+				uint32_t child = index * 2 + 1;
+				if (child >= open_cells.size()) {
+					break;
+				}
+				if (child + 1 < open_cells.size() && open_cells[child + 1].distance < open_cells[child].distance) {
+					child++;
+				}
+				if (last.distance <= open_cells[child].distance) {
+					break;
+				}
+				open_cells[index] = open_cells[child];
+				index = child;
+			}
+			open_cells[index] = last;
+		}
+
+		if (current.distance > distances[current.cell]) {
+			continue; // Outdated entry, the cell was reached through a shorter route since.
+		}
+
+		const Cell &current_cell = cells[current.cell];
+		const int x = current_cell.column % grid_size.x;
+		const int z = current_cell.column / grid_size.x;
+		for (int i = 0; i < 8; i++) {
+			const int neighbor_column = _get_neighbor_column(current_cell.column, i);
+			if (neighbor_column < 0) {
+				continue;
+			}
+			const bool diagonal = i >= 4;
+			// Do not cut corners of walls or obstacles.
+			if (diagonal && (!_has_connected_cell(current.cell, z * grid_size.x + x + neighbor_offsets[i][0]) || !_has_connected_cell(current.cell, (z + neighbor_offsets[i][1]) * grid_size.x + x))) {
+				continue;
+			}
+
+			for (uint32_t neighbor = column_cells[neighbor_column]; neighbor < column_cells[neighbor_column + 1]; neighbor++) {
+				if (!_is_passable(neighbor) || !_are_polygons_connected(current_cell.polygon, cells[neighbor].polygon)) {
+					continue;
+				}
+				const real_t step = (diagonal ? Math_SQRT2 : 1.0) * cell_size * (current_cell.cost + cells[neighbor].cost) * 0.5;
+				const real_t distance = current.distance + step;
+				if (distance < distances[neighbor]) {
+					distances[neighbor] = distance;
+					next_cells[neighbor] = current.cell;
+					_open_cell(neighbor, distance);
+				}
+			}
+		}
+
+		// Agents reach this cell through the links ending in it.
+		const LocalVector<uint32_t> *cell_links = incoming_links.is_empty() ? nullptr : incoming_links.getptr(current.cell);
+		if (cell_links) {
+			for (uint32_t link_index : *cell_links) {
+				const CellLink &link = links[link_index];
+				if (!_is_passable(link.from)) {
+					continue;
+				}
+				const real_t distance = current.distance + link.cost;
+				if (distance < distances[link.from]) {
+					distances[link.from] = distance;
+					next_cells[link.from] = current.cell;
+					_open_cell(link.from, distance);
+				}
+			}
+		}
+	}
+}
+
+void NavFlowField::_integrate() {
+	for (uint32_t i = 0; i < distances.size(); i++) {
+		distances[i] = FLT_MAX;
+		next_cells[i] = -1;
+	}
+	open_cells.clear();
+
+	if (target_cell < 0 || !_is_passable(target_cell)) {
+		return;
+	}
+
+	distances[target_cell] = 0.0;
+	_open_cell(target_cell, 0.0);
+	_propagate();
+}
+
+void NavFlowField::_invalidate_cell(uint32_t p_cell, LocalVector<uint32_t> &r_invalidated) {
+	distances[p_cell] = FLT_MAX;
+	next_cells[p_cell] = -1;
+	r_invalidated.push_back(p_cell);
+}
+
+void NavFlowField::_repair(const LocalVector<uint32_t> &p_newly_blocked, const LocalVector<uint32_t> &p_newly_unblocked) {
+	if (target_cell < 0) {
+		return;
+	}
+	if (!_is_passable(target_cell) || distances[target_cell] != 0.0) {
+		// The target itself got blocked or unblocked.
+		_integrate();
+		return;
+	}
+
+	// Invalidate the newly blocked cells and every cell whose route to the target passed through them.
+	LocalVector<uint32_t> invalidated;
+	for (uint32_t cell : p_newly_blocked) {
+		if (distances[cell] != FLT_MAX) {
+			_invalidate_cell(cell, invalidated);
+		}
+	}
+	// Diagonal steps past a newly blocked cell cut its corner now, invalidate the cells taking them too.
+	for (uint32_t cell : p_newly_blocked) {
+		const int x = cells[cell].column % grid_size.x;
+		const int z = cells[cell].column / grid_size.x;
+		for (int j = 0; j < 4; j++) {
+			// Pairs of an X and a Z neighbor column, which are diagonal to each other.
+			const int ax = x + neighbor_offsets[j / 2][0];
+			const int bz = z + neighbor_offsets[2 + j % 2][1];
+			if (ax < 0 || bz < 0 || ax >= grid_size.x || bz >= grid_size.y) {
+				continue;
+			}
+			const uint32_t a_column = z * grid_size.x + ax;
+			const uint32_t b_column = bz * grid_size.x + x;
+			for (int pass = 0; pass < 2; pass++) {
+				const uint32_t from_column = pass == 0 ? a_column : b_column;
+				const uint32_t to_column = pass == 0 ? b_column : a_column;
+				for (uint32_t i = column_cells[from_column]; i < column_cells[from_column + 1]; i++) {
+					if (next_cells[i] >= 0 && cells[next_cells[i]].column == to_column) {
+						_invalidate_cell(i, invalidated);
+					}
+				}
+			}
+		}
+	}
+	for (uint32_t i = 0; i < invalidated.size(); i++) {
+		const uint32_t cell = invalidated[i];
+		for (int j = 0; j < 8; j++) {
+			const int neighbor_column = _get_neighbor_column(cells[cell].column, j);
+			if (neighbor_column < 0) {
+				continue;
+			}
+			for (uint32_t neighbor = column_cells[neighbor_column]; neighbor < column_cells[neighbor_column + 1]; neighbor++) {
+				if (next_cells[neighbor] == int32_t(cell)) {
+					_invalidate_cell(neighbor, invalidated);
+				}
+			}
+		}
+		const LocalVector<uint32_t> *cell_links = incoming_links.is_empty() ? nullptr : incoming_links.getptr(cell);
+		if (cell_links) {
+			for (uint32_t link_index : *cell_links) {
+				if (next_cells[links[link_index].from] == int32_t(cell)) {
+					_invalidate_cell(links[link_index].from, invalidated);
+				}
+			}
+		}
+	}
+
+	// Propagate again from the valid cells bordering the invalidated and the newly unblocked cells.
+	open_cells.clear();
+	for (int pass = 0; pass < 2; pass++) {
+		const LocalVector<uint32_t> &border_cells = pass == 0 ? invalidated : p_newly_unblocked;
+		for (uint32_t cell : border_cells) {
+			for (int j = 0; j < 8; j++) {
+				const int neighbor_column = _get_neighbor_column(cells[cell].column, j);
+				if (neighbor_column < 0) {
+					continue;
+				}
+				for (uint32_t neighbor = column_cells[neighbor_column]; neighbor < column_cells[neighbor_column + 1]; neighbor++) {
+					if (distances[neighbor] != FLT_MAX && _is_passable(neighbor)) {
+						_open_cell(neighbor, distances[neighbor]);
+					}
+				}
+			}
+		}
+	}
+	// Links starting in a cell without a distance may lead it back to the target.
+	for (const CellLink &link : links) {
+		if (distances[link.from] == FLT_MAX && distances[link.to] != FLT_MAX && _is_passable(link.to)) {
+			_open_cell(link.to, distances[link.to]);
+		}
+	}
+	_propagate();
+}
+
+void NavFlowField::sync(bool p_obstacles_dirty) {
+	if (!map || map->get_map_update_id() == 0) {
+		return;
+	}
+
+	if (map_update_id != map->get_map_update_id()) {
+		map_update_id = map->get_map_update_id();
+		grid_dirty = true;
+	}
+
+	LocalVector<uint32_t> newly_blocked;
+	LocalVector<uint32_t> newly_unblocked;
+
+	if (grid_dirty) {
+		_rasterize_polygons();
+		_rasterize_obstacles(newly_blocked, newly_unblocked);
+		target_cell = grid_size.x > 0 ? _find_target_cell() : -1;
+		_integrate();
+	} else if (target_dirty) {
+		if (p_obstacles_dirty) {
+			_rasterize_obstacles(newly_blocked, newly_unblocked);
+		}
+		target_cell = grid_size.x > 0 ? _find_target_cell() : -1;
+		_integrate();
+	} else if (p_obstacles_dirty && grid_size.x > 0) {
+		_rasterize_obstacles(newly_blocked, newly_unblocked);
+		if (!newly_blocked.is_empty() || !newly_unblocked.is_empty()) {
+			_repair(newly_blocked, newly_unblocked);
+		}
+	}
+
+	grid_dirty = false;
+	target_dirty = false;
+}
+
+Vector3 NavFlowField::get_direction(const Vector3 &p_position) const {
+	const int cell = _get_cell(p_position);
+	if (cell < 0 || distances[cell] == FLT_MAX) {
+		return Vector3();
+	}
+
+	Vector2 direction;
+	if (cell == target_cell) {
+		direction = Vector2(target_position.x - p_position.x, target_position.z - p_position.z);
+	} else {
+		direction = _get_column_center(cells[next_cells[cell]].column) - Vector2(p_position.x, p_position.z);
+	}
+	direction = direction.normalized();
+	return Vector3(direction.x, 0.0, direction.y);
+}
+
+real_t NavFlowField::get_distance(const Vector3 &p_position) const {
+	const int cell = _get_cell(p_position);
+	if (cell < 0 || distances[cell] == FLT_MAX) {
+		return -1.0;
+	}
+	return distances[cell];
+}
@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  nav_flow_field.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_FLOW_FIELD_H
+#define NAV_FLOW_FIELD_H
+
+#include "nav_rid.h"
+
+#include "core/math/vector2.h"
+#include "core/math/vector2i.h"
+#include "core/math/vector3.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+class NavMap;
+
+/// A flow field over the XZ plane of a navigation map that leads towards a single target position.
+/// It is built once from the map polygons and shared by all agents heading to the same target,
+/// looking up the direction for a position is a single grid read.
+class NavFlowField : public NavRid {
+	NavMap *map = nullptr;
+	Vector3 target_position;
+	real_t cell_size = 1.0;
+	uint32_t navigation_layers = 1;
+
+	/// Set when the map or the grid settings changed and the cells need to be rasterized again.
+	bool grid_dirty = true;
+	/// Set when only the target changed and the distances need to be integrated again.
+	bool target_dirty = true;
+	uint32_t map_update_id = 0;
+
+	/// A walkable sample of the grid. Every grid column holds one cell per polygon covering its
+	/// center, so floors stacked above each other and bridges get cells of their own.
+	struct Cell {
+		uint32_t column = 0;
+		/// Index of the covering polygon in the map polygons.
+		uint32_t polygon = 0;
+		real_t height = 0.0;
+		/// Travel cost taken from the owner of the covering polygon.
+		real_t cost = 0.0;
+	};
+
+	/// A navigation link leading from one cell to another, possibly far away.
+	struct CellLink {
+		uint32_t from = 0;
+		uint32_t to = 0;
+		real_t cost = 0.0;
+	};
+
+	/// Grid covering the bounds of the map polygons.
+	Vector2i grid_origin;
+	Vector2i grid_size;
+	int target_cell = -1;
+
+	LocalVector<Cell> cells;
+	/// First cell of each grid column, with one more entry for the end of the last column.
+	LocalVector<uint32_t> column_cells;
+	/// Polygons connected to each polygon through its edges, cells are only linked to neighbor
+	/// cells of the same or a connected polygon.
+	LocalVector<uint32_t> polygon_neighbors_start;
+	LocalVector<uint32_t> polygon_neighbors;
+	LocalVector<CellLink> links;
+	/// Indices of the links ending in a cell, keyed by that cell.
+	HashMap<uint32_t, LocalVector<uint32_t>> incoming_links;
+
+	/// Cells covered by obstacles, they are kept separate so obstacle changes only repair the field.
+	LocalVector<uint8_t> blocked;
+	LocalVector<uint32_t> blocked_cells;
+	/// Integrated distance to the target and the neighbor cell to move to next.
+	LocalVector<real_t> distances;
+	LocalVector<int32_t> next_cells;
+
+	struct OpenCell {
+		real_t distance = 0.0;
+		uint32_t cell = 0;
+	};
+	LocalVector<OpenCell> open_cells;
+
+	_FORCE_INLINE_ bool _is_passable(int p_cell) const {
+		return !blocked[p_cell];
+	}
+	_FORCE_INLINE_ Vector2 _get_column_center(int p_column) const {
+		return Vector2(grid_origin.x + p_column % grid_size.x + 0.5, grid_origin.y + p_column / grid_size.x + 0.5) * cell_size;
+	}
+	int _get_neighbor_column(int p_column, int p_neighbor) const;
+	bool _are_polygons_connected(uint32_t p_polygon, uint32_t p_other_polygon) const;
+	bool _has_connected_cell(uint32_t p_cell, int p_column) const;
+	int _get_column(const Vector3 &p_position) const;
+	int _get_cell(const Vector3 &p_position) const;
+	int _find_target_cell() const;
+
+	void _rasterize_polygons();
+	void _rasterize_obstacles(LocalVector<uint32_t> &r_newly_blocked, LocalVector<uint32_t> &r_newly_unblocked);
+	void _integrate();
+	void _repair(const LocalVector<uint32_t> &p_newly_blocked, const LocalVector<uint32_t> &p_newly_unblocked);
+
+	void _open_cell(uint32_t p_cell, real_t p_distance);
+	void _invalidate_cell(uint32_t p_cell, LocalVector<uint32_t> &r_invalidated);
+	void _propagate();
+
+public:
+	NavFlowField();
+	~NavFlowField();
+
+	void set_map(NavMap *p_map);
+	NavMap *get_map() const { return map; }
+
+	void set_target_position(const Vector3 &p_position);
+	const Vector3 &get_target_position() const { return target_position; }
+
+	void set_cell_size(real_t p_cell_size);
+	real_t get_cell_size() const { return cell_size; }
+
+	void set_navigation_layers(uint32_t p_navigation_layers);
+	uint32_t get_navigation_layers() const { return navigation_layers; }
+
+	Vector3 get_direction(const Vector3 &p_position) const;
+	real_t get_distance(const Vector3 &p_position) const;
+
+	void sync(bool p_obstacles_dirty);
+};
+
+#endif // NAV_FLOW_FIELD_H
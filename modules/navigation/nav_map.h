@@ -31,6 +31,7 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_avoidance_grid_2d.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
@@ -46,6 +47,7 @@ class NavLink;
 class NavRegion;
 class NavAgent;
 class NavObstacle;
+class NavFlowField;
 
 class NavMap : public NavRid {
 	/// Map Up
@@ -84,6 +86,9 @@ class NavMap : public NavRid {
 	LocalVector<NavAgent *> active_2d_avoidance_agents;
 	LocalVector<NavAgent *> active_3d_avoidance_agents;
 
+	/// Spatial hash used to find the neighbors of the 2D avoidance agents
+	NavAvoidanceGrid2D avoidance_grid_2d;
+
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
@@ -96,6 +101,9 @@ class NavMap : public NavRid {
 	/// Are rvo obstacles modified?
 	bool obstacles_dirty = true;
 
+	/// Flow fields updated on each sync.
+	LocalVector<NavFlowField *> flow_fields;
+
 	/// Physics delta time
 	real_t deltatime = 0.0;
 
@@ -186,6 +194,17 @@ public:
 		return obstacles;
 	}
 
+	bool has_flow_field(NavFlowField *p_flow_field) const;
+	void add_flow_field(NavFlowField *p_flow_field);
+	void remove_flow_field(NavFlowField *p_flow_field);
+	const LocalVector<NavFlowField *> &get_flow_fields() const {
+		return flow_fields;
+	}
+
+	const LocalVector<gd::Polygon> &get_polygons() const {
+		return polygons;
+	}
+
 	uint32_t get_map_update_id() const {
 		return map_update_id;
 	}
@@ -213,7 +232,8 @@ private:
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
-	void _update_rvo_agents_tree_2d();
+	void _update_rvo_agents_grid_2d();
+	void _compute_rvo_neighbors_2d(RVO2D::Agent2D *p_agent) const;
 	void _update_rvo_agents_tree_3d();
 };
 
@@ -33,6 +33,7 @@
 #include "nav_mesh_generator_3d.h"
 
 #include "core/math/convex_hull.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/thread.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/multimesh_instance_3d.h"
@@ -64,6 +65,8 @@
 NavMeshGenerator3D *NavMeshGenerator3D::singleton = nullptr;
 Mutex NavMeshGenerator3D::baking_navmesh_mutex;
 HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
+Mutex NavMeshGenerator3D::tiled_bake_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::TiledBakeCache> NavMeshGenerator3D::tiled_bake_caches;
 
 NavMeshGenerator3D *NavMeshGenerator3D::get_singleton() {
 	return singleton;
@@ -82,6 +85,10 @@ void NavMeshGenerator3D::cleanup() {
 	baking_navmesh_mutex.lock();
 	baking_navmeshes.clear();
 	baking_navmesh_mutex.unlock();
+
+	tiled_bake_cache_mutex.lock();
+	tiled_bake_caches.clear();
+	tiled_bake_cache_mutex.unlock();
 }
 
 void NavMeshGenerator3D::finish() {
@@ -591,6 +598,11 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
 	}
 
+	if (p_navigation_mesh->get_tile_size() > 0) {
+		generator_bake_tiled(p_navigation_mesh, cfg, verts, nverts, tris, ntris);
+		return;
+	}
+
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
@@ -716,6 +728,441 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	bake_state = "Baking finished."; // step #12
 }
 
+namespace {
+// Frees all intermediate Recast data of a tile bake on every exit path.
+struct RecastTileBakeData {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+
+	~RecastTileBakeData() {
+		rcFreeHeightField(hf);
+		rcFreeCompactHeightfield(chf);
+		rcFreeContourSet(cset);
+		rcFreePolyMesh(poly_mesh);
+		rcFreePolyMeshDetail(detail_mesh);
+	}
+};
+} // namespace
+
+uint32_t NavMeshGenerator3D::generator_get_bake_settings_hash(const NavigationMesh *p_navigation_mesh, const rcConfig &p_config) {
+	uint32_t h = hash_murmur3_one_32(p_navigation_mesh->get_tile_size());
+	h = hash_murmur3_one_float(p_config.cs, h);
+	h = hash_murmur3_one_float(p_config.ch, h);
+	h = hash_murmur3_one_float(p_config.walkableSlopeAngle, h);
+	h = hash_murmur3_one_32(p_config.walkableHeight, h);
+	h = hash_murmur3_one_32(p_config.walkableClimb, h);
+	h = hash_murmur3_one_32(p_config.walkableRadius, h);
+	h = hash_murmur3_one_32(p_config.maxEdgeLen, h);
+	h = hash_murmur3_one_float(p_config.maxSimplificationError, h);
+	h = hash_murmur3_one_32(p_config.minRegionArea, h);
+	h = hash_murmur3_one_32(p_config.mergeRegionArea, h);
+	h = hash_murmur3_one_32(p_config.maxVertsPerPoly, h);
+	h = hash_murmur3_one_float(p_config.detailSampleDist, h);
+	h = hash_murmur3_one_float(p_config.detailSampleMaxError, h);
+	h = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type(), h);
+	h = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), h);
+	h = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), h);
+	h = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), h);
+	h = hash_murmur3_one_real(p_navigation_mesh->get_filter_baking_aabb().position.x, h);
+	h = hash_murmur3_one_real(p_navigation_mesh->get_filter_baking_aabb().position.y, h);
+	h = hash_murmur3_one_real(p_navigation_mesh->get_filter_baking_aabb().position.z, h);
+	h = hash_murmur3_one_real(p_navigation_mesh->get_filter_baking_aabb().size.x, h);
+	h = hash_murmur3_one_real(p_navigation_mesh->get_filter_baking_aabb().size.y, h);
+	h = hash_murmur3_one_real(p_navigation_mesh->get_filter_baking_aabb().size.z, h);
+	h = hash_murmur3_one_real(p_navigation_mesh->get_filter_baking_aabb_offset().x, h);
+	h = hash_murmur3_one_real(p_navigation_mesh->get_filter_baking_aabb_offset().y, h);
+	h = hash_murmur3_one_real(p_navigation_mesh->get_filter_baking_aabb_offset().z, h);
+	return hash_fmix32(h);
+}
+
+void NavMeshGenerator3D::generator_bake_tiled(Ref<NavigationMesh> p_navigation_mesh, const rcConfig &p_config, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris) {
+	// Tiles are aligned to the world origin instead of the source geometry bounds so that the
+	// voxel grid of a tile stays the same between bakes and unchanged tiles can be reused.
+	const int tile_size = p_navigation_mesh->get_tile_size();
+	const int border_size = p_config.walkableRadius + 3;
+	const float tile_world_size = tile_size * p_config.cs;
+	const float border_world_size = border_size * p_config.cs;
+
+	rcConfig base_cfg = p_config;
+	base_cfg.tileSize = tile_size;
+	base_cfg.borderSize = border_size;
+	// Snap the baking bounds to the cell grid so clipped tiles keep an aligned voxel grid.
+	base_cfg.bmin[0] = Math::floor(p_config.bmin[0] / p_config.cs) * p_config.cs;
+	base_cfg.bmin[1] = Math::floor(p_config.bmin[1] / p_config.ch) * p_config.ch;
+	base_cfg.bmin[2] = Math::floor(p_config.bmin[2] / p_config.cs) * p_config.cs;
+	base_cfg.bmax[0] = Math::ceil(p_config.bmax[0] / p_config.cs) * p_config.cs;
+	base_cfg.bmax[2] = Math::ceil(p_config.bmax[2] / p_config.cs) * p_config.cs;
+
+	if (base_cfg.bmin[0] >= base_cfg.bmax[0] || base_cfg.bmin[2] >= base_cfg.bmax[2]) {
+		p_navigation_mesh->clear();
+		return;
+	}
+
+	const Vector2i tile_min = Vector2i(Math::floor(base_cfg.bmin[0] / tile_world_size), Math::floor(base_cfg.bmin[2] / tile_world_size));
+	const Vector2i tile_max = Vector2i(Math::floor(base_cfg.bmax[0] / tile_world_size), Math::floor(base_cfg.bmax[2] / tile_world_size));
+
+	// Take the cache out of the shared map while baking, the navigation mesh is guarded against concurrent bakes.
+	const ObjectID navmesh_id = p_navigation_mesh->get_instance_id();
+	TiledBakeCache cache;
+	tiled_bake_cache_mutex.lock();
+	if (tiled_bake_caches.has(navmesh_id)) {
+		cache = tiled_bake_caches[navmesh_id];
+		tiled_bake_caches.erase(navmesh_id);
+	}
+	tiled_bake_cache_mutex.unlock();
+
+	const uint32_t settings_hash = generator_get_bake_settings_hash(p_navigation_mesh.ptr(), p_config);
+	if (cache.settings_hash != settings_hash) {
+		cache.tiles.clear();
+		cache.settings_hash = settings_hash;
+	}
+
+	// Assign every triangle to all tiles its XZ bounds overlap, including the tile borders.
+	HashMap<Vector2i, BakeTile> tiles;
+	for (int i = 0; i < p_ntris; i++) {
+		const float *v0 = &p_verts[p_tris[i * 3 + 0] * 3];
+		const float *v1 = &p_verts[p_tris[i * 3 + 1] * 3];
+		const float *v2 = &p_verts[p_tris[i * 3 + 2] * 3];
+		const float tri_min_x = MIN(v0[0], MIN(v1[0], v2[0])) - border_world_size;
+		const float tri_max_x = MAX(v0[0], MAX(v1[0], v2[0])) + border_world_size;
+		const float tri_min_z = MIN(v0[2], MIN(v1[2], v2[2])) - border_world_size;
+		const float tri_max_z = MAX(v0[2], MAX(v1[2], v2[2])) + border_world_size;
+
+		const int from_x = MAX((int)Math::floor(tri_min_x / tile_world_size), tile_min.x);
+		const int to_x = MIN((int)Math::floor(tri_max_x / tile_world_size), tile_max.x);
+		const int from_z = MAX((int)Math::floor(tri_min_z / tile_world_size), tile_min.y);
+		const int to_z = MIN((int)Math::floor(tri_max_z / tile_world_size), tile_max.y);
+
+		for (int z = from_z; z <= to_z; z++) {
+			for (int x = from_x; x <= to_x; x++) {
+				const Vector2i coords = Vector2i(x, z);
+				BakeTile *tile = tiles.getptr(coords);
+				if (!tile) {
+					tile = &tiles.insert(coords, BakeTile())->value;
+					tile->coords = coords;
+				}
+				tile->triangles.push_back(i);
+				for (int j = 0; j < 3; j++) {
+					const float *v = &p_verts[p_tris[i * 3 + j] * 3];
+					tile->geometry_hash = hash_murmur3_one_float(v[0], tile->geometry_hash);
+					tile->geometry_hash = hash_murmur3_one_float(v[1], tile->geometry_hash);
+					tile->geometry_hash = hash_murmur3_one_float(v[2], tile->geometry_hash);
+				}
+			}
+		}
+	}
+
+	TiledBakeData bake_data;
+	bake_data.base_config = &base_cfg;
+	bake_data.navigation_mesh = p_navigation_mesh.ptr();
+	bake_data.verts = p_verts;
+	bake_data.nverts = p_nverts;
+	bake_data.tris = p_tris;
+
+	// Only the baking AABB filter clips tiles, the geometry bounds change between bakes and would invalidate cached tiles.
+	const bool clip_tiles = p_navigation_mesh->get_filter_baking_aabb().has_volume();
+
+	for (KeyValue<Vector2i, BakeTile> &E : tiles) {
+		BakeTile &tile = E.value;
+		tile.bmin[0] = E.key.x * tile_world_size;
+		tile.bmin[1] = base_cfg.bmin[1];
+		tile.bmin[2] = E.key.y * tile_world_size;
+		tile.bmax[0] = (E.key.x + 1) * tile_world_size;
+		tile.bmax[1] = base_cfg.bmax[1];
+		tile.bmax[2] = (E.key.y + 1) * tile_world_size;
+		if (clip_tiles) {
+			tile.bmin[0] = MAX(tile.bmin[0], base_cfg.bmin[0]);
+			tile.bmin[2] = MAX(tile.bmin[2], base_cfg.bmin[2]);
+			tile.bmax[0] = MIN(tile.bmax[0], base_cfg.bmax[0]);
+			tile.bmax[2] = MIN(tile.bmax[2], base_cfg.bmax[2]);
+		}
+
+		const BakeTile *cached_tile = cache.tiles.getptr(E.key);
+		if (cached_tile && cached_tile->geometry_hash == tile.geometry_hash) {
+			tile.vertices = cached_tile->vertices;
+			tile.polygons = cached_tile->polygons;
+		} else {
+			bake_data.dirty_tiles.push_back(&tile);
+		}
+	}
+
+	if (bake_data.dirty_tiles.size() > 1 && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_bake_tile_task, &bake_data, bake_data.dirty_tiles.size(), -1, true, SNAME("NavMeshGeneratorBakeTiles"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		// Waiting for a group task from inside the pool can starve it, bake on the calling thread instead.
+		for (uint32_t i = 0; i < bake_data.dirty_tiles.size(); i++) {
+			generator_bake_tile_task(&bake_data, i);
+		}
+	}
+
+	// Stitch the tiles in a deterministic order, welding the vertices shared along tile borders.
+	LocalVector<Vector2i> tile_order;
+	tile_order.reserve(tiles.size());
+	for (const KeyValue<Vector2i, BakeTile> &E : tiles) {
+		tile_order.push_back(E.key);
+	}
+	tile_order.sort();
+
+	const real_t weld_precision = p_config.cs * 0.01;
+	HashMap<Vector3i, int> welded_vertices;
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+
+	for (const Vector2i &coords : tile_order) {
+		const BakeTile &tile = tiles[coords];
+		LocalVector<int> vertex_remap;
+		vertex_remap.resize(tile.vertices.size());
+		for (int i = 0; i < tile.vertices.size(); i++) {
+			const Vector3 &vertex = tile.vertices[i];
+			const Vector3i key = Vector3i((vertex / weld_precision).round());
+			const int *existing = welded_vertices.getptr(key);
+			if (existing) {
+				vertex_remap[i] = *existing;
+			} else {
+				vertex_remap[i] = nav_vertices.size();
+				welded_vertices.insert(key, nav_vertices.size());
+				nav_vertices.push_back(vertex);
+			}
+		}
+		for (const Vector<int> &polygon : tile.polygons) {
+			Vector<int> nav_indices;
+			nav_indices.resize(polygon.size());
+			for (int i = 0; i < polygon.size(); i++) {
+				nav_indices.write[i] = vertex_remap[polygon[i]];
+			}
+			if (nav_indices[0] == nav_indices[1] || nav_indices[1] == nav_indices[2] || nav_indices[2] == nav_indices[0]) {
+				continue; // Collapsed by welding.
+			}
+			nav_polygons.push_back(nav_indices);
+		}
+	}
+
+	// Neighboring tiles don't place the same vertices along their shared border, and NavMap
+	// only connects polygons of one region through edges with matching vertices. Split every
+	// border edge at the vertices the neighboring tile placed on it to remove the T-junctions.
+	HashMap<Vector2i, LocalVector<int>> border_vertices; // Keyed by axis and tile border line.
+	for (int i = 0; i < nav_vertices.size(); i++) {
+		const Vector3 &vertex = nav_vertices[i];
+		for (int axis = 0; axis < 2; axis++) {
+			const real_t coord = axis == 0 ? vertex.x : vertex.z;
+			const int line = Math::round(coord / tile_world_size);
+			if (Math::abs(coord - line * tile_world_size) <= weld_precision) {
+				border_vertices[Vector2i(axis, line)].push_back(i);
+			}
+		}
+	}
+
+	const real_t max_height_offset = p_config.walkableClimb * p_config.ch;
+	LocalVector<Pair<real_t, int>> edge_splits;
+	for (Vector<int> &polygon : nav_polygons) {
+		Vector<int> split_polygon;
+		for (int i = 0; i < polygon.size(); i++) {
+			const int from = polygon[i];
+			const int to = polygon[(i + 1) % polygon.size()];
+			split_polygon.push_back(from);
+
+			const Vector3 &from_vertex = nav_vertices[from];
+			const Vector3 &to_vertex = nav_vertices[to];
+			for (int axis = 0; axis < 2; axis++) {
+				const real_t from_coord = axis == 0 ? from_vertex.x : from_vertex.z;
+				const real_t to_coord = axis == 0 ? to_vertex.x : to_vertex.z;
+				const int line = Math::round(from_coord / tile_world_size);
+				if (Math::abs(from_coord - line * tile_world_size) > weld_precision || Math::abs(to_coord - line * tile_world_size) > weld_precision) {
+					continue;
+				}
+				const LocalVector<int> *line_vertices = border_vertices.getptr(Vector2i(axis, line));
+				if (!line_vertices) {
+					continue;
+				}
+
+				// Interpolate along the axis that runs along the border line.
+				const real_t from_along = axis == 0 ? from_vertex.z : from_vertex.x;
+				const real_t to_along = axis == 0 ? to_vertex.z : to_vertex.x;
+				const real_t length = to_along - from_along;
+				if (Math::abs(length) <= weld_precision) {
+					continue;
+				}
+				edge_splits.clear();
+				for (const int vertex_index : *line_vertices) {
+					const Vector3 &vertex = nav_vertices[vertex_index];
+					const real_t along = axis == 0 ? vertex.z : vertex.x;
+					const real_t t = (along - from_along) / length;
+					if (t * Math::abs(length) <= weld_precision || (1.0 - t) * Math::abs(length) <= weld_precision) {
+						continue; // Outside of the edge or on one of its ends.
+					}
+					// Vertices of floors stacked above or below the edge are not part of it.
+					if (Math::abs(vertex.y - Math::lerp(from_vertex.y, to_vertex.y, t)) > max_height_offset) {
+						continue;
+					}
+					edge_splits.push_back(Pair<real_t, int>(t, vertex_index));
+				}
+				edge_splits.sort_custom<PairSort<real_t, int>>();
+				for (const Pair<real_t, int> &split : edge_splits) {
+					split_polygon.push_back(split.second);
+				}
+				break;
+			}
+		}
+		if (split_polygon.size() != polygon.size()) {
+			polygon = split_polygon;
+		}
+	}
+
+	p_navigation_mesh->set_vertices(nav_vertices);
+	p_navigation_mesh->clear_polygons();
+	for (const Vector<int> &polygon : nav_polygons) {
+		p_navigation_mesh->add_polygon(polygon);
+	}
+
+	// Tiles without geometry are dropped from the cache, they are rebaked for free anyway.
+	for (KeyValue<Vector2i, BakeTile> &E : tiles) {
+		E.value.triangles.clear();
+	}
+	cache.tiles = tiles;
+
+	tiled_bake_cache_mutex.lock();
+	// Drop caches of navigation meshes that were freed in the meantime.
+	LocalVector<ObjectID> stale_caches;
+	for (const KeyValue<ObjectID, TiledBakeCache> &E : tiled_bake_caches) {
+		if (!ObjectDB::get_instance(E.key)) {
+			stale_caches.push_back(E.key);
+		}
+	}
+	for (const ObjectID &stale_cache : stale_caches) {
+		tiled_bake_caches.erase(stale_cache);
+	}
+	tiled_bake_caches.insert(navmesh_id, cache);
+	tiled_bake_cache_mutex.unlock();
+}
+
+void NavMeshGenerator3D::generator_bake_tile_task(void *p_userdata, uint32_t p_index) {
+	TiledBakeData *bake_data = static_cast<TiledBakeData *>(p_userdata);
+	BakeTile *tile = bake_data->dirty_tiles[p_index];
+	if (!generator_bake_tile(bake_data->navigation_mesh, *bake_data->base_config, bake_data->verts, bake_data->nverts, bake_data->tris, *tile)) {
+		ERR_PRINT(vformat("NavigationMesh baking failed for tile %s.", tile->coords));
+		tile->vertices.clear();
+		tile->polygons.clear();
+	}
+}
+
+bool NavMeshGenerator3D::generator_bake_tile(const NavigationMesh *p_navigation_mesh, const rcConfig &p_base_config, const float *p_verts, int p_nverts, const int *p_tris, BakeTile &r_tile) {
+	r_tile.vertices.clear();
+	r_tile.polygons.clear();
+
+	rcConfig cfg = p_base_config;
+	rcContext ctx(false);
+	RecastTileBakeData data;
+
+	// Expand the tile by the border so regions and contours match up with the neighboring tiles.
+	cfg.bmin[0] = r_tile.bmin[0] - cfg.borderSize * cfg.cs;
+	cfg.bmin[1] = r_tile.bmin[1];
+	cfg.bmin[2] = r_tile.bmin[2] - cfg.borderSize * cfg.cs;
+	cfg.bmax[0] = r_tile.bmax[0] + cfg.borderSize * cfg.cs;
+	cfg.bmax[1] = r_tile.bmax[1];
+	cfg.bmax[2] = r_tile.bmax[2] + cfg.borderSize * cfg.cs;
+	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+
+	data.hf = rcAllocHeightfield();
+	ERR_FAIL_NULL_V(data.hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *data.hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch), false);
+
+	{
+		const int ntris = r_tile.triangles.size();
+		Vector<int> tile_tris;
+		tile_tris.resize(ntris * 3);
+		int *tile_tris_ptrw = tile_tris.ptrw();
+		for (int i = 0; i < ntris; i++) {
+			const int tri = r_tile.triangles[i];
+			tile_tris_ptrw[i * 3 + 0] = p_tris[tri * 3 + 0];
+			tile_tris_ptrw[i * 3 + 1] = p_tris[tri * 3 + 1];
+			tile_tris_ptrw[i * 3 + 2] = p_tris[tri * 3 + 2];
+		}
+
+		Vector<unsigned char> tri_areas;
+		tri_areas.resize(ntris);
+		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, p_verts, p_nverts, tile_tris.ptr(), ntris, tri_areas.ptrw());
+
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, tile_tris.ptr(), tri_areas.ptr(), ntris, *data.hf, cfg.walkableClimb), false);
+	}
+
+	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
+		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *data.hf);
+	}
+	if (p_navigation_mesh->get_filter_ledge_spans()) {
+		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *data.hf);
+	}
+	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
+		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *data.hf);
+	}
+
+	data.chf = rcAllocCompactHeightfield();
+	ERR_FAIL_NULL_V(data.chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *data.hf, *data.chf), false);
+
+	rcFreeHeightField(data.hf);
+	data.hf = nullptr;
+
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *data.chf), false);
+
+	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *data.chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *data.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
+	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *data.chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea), false);
+	} else {
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *data.chf, cfg.borderSize, cfg.minRegionArea), false);
+	}
+
+	data.cset = rcAllocContourSet();
+	ERR_FAIL_NULL_V(data.cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *data.chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *data.cset), false);
+
+	if (data.cset->nconts == 0) {
+		return true; // Nothing walkable in this tile.
+	}
+
+	data.poly_mesh = rcAllocPolyMesh();
+	ERR_FAIL_NULL_V(data.poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *data.cset, cfg.maxVertsPerPoly, *data.poly_mesh), false);
+
+	data.detail_mesh = rcAllocPolyMeshDetail();
+	ERR_FAIL_NULL_V(data.detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *data.poly_mesh, *data.chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *data.detail_mesh), false);
+
+	const rcPolyMeshDetail *detail_mesh = data.detail_mesh;
+
+	r_tile.vertices.resize(detail_mesh->nverts);
+	Vector3 *vertices_ptrw = r_tile.vertices.ptrw();
+	for (int i = 0; i < detail_mesh->nverts; i++) {
+		const float *v = &detail_mesh->verts[i * 3];
+		vertices_ptrw[i] = Vector3(v[0], v[1], v[2]);
+	}
+
+	for (int i = 0; i < detail_mesh->nmeshes; i++) {
+		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
+		const unsigned int detail_mesh_bverts = detail_mesh_m[0];
+		const unsigned int detail_mesh_m_btris = detail_mesh_m[2];
+		const unsigned int detail_mesh_ntris = detail_mesh_m[3];
+		const unsigned char *detail_mesh_tris = &detail_mesh->tris[detail_mesh_m_btris * 4];
+		for (unsigned int j = 0; j < detail_mesh_ntris; j++) {
+			Vector<int> nav_indices;
+			nav_indices.resize(3);
+			// Polygon order in recast is opposite than godot's
+			nav_indices.write[0] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]));
+			nav_indices.write[1] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]));
+			nav_indices.write[2] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]));
+			r_tile.polygons.push_back(nav_indices);
+		}
+	}
+
+	return true;
+}
+
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
 	ERR_FAIL_COND_V(!p_callback.is_valid(), false);
 
@@ -40,6 +40,8 @@ class Node;
 class NavigationMesh;
 class NavigationMeshSourceGeometryData3D;
 
+struct rcConfig;
+
 class NavMeshGenerator3D : public Object {
 	static NavMeshGenerator3D *singleton;
 
@@ -47,9 +49,41 @@ class NavMeshGenerator3D : public Object {
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
+	struct BakeTile {
+		Vector2i coords;
+		float bmin[3] = { 0.0, 0.0, 0.0 };
+		float bmax[3] = { 0.0, 0.0, 0.0 };
+		LocalVector<int> triangles;
+		uint32_t geometry_hash = 0;
+
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	struct TiledBakeCache {
+		uint32_t settings_hash = 0;
+		HashMap<Vector2i, BakeTile> tiles;
+	};
+
+	struct TiledBakeData {
+		const rcConfig *base_config = nullptr;
+		const NavigationMesh *navigation_mesh = nullptr;
+		const float *verts = nullptr;
+		int nverts = 0;
+		const int *tris = nullptr;
+		LocalVector<BakeTile *> dirty_tiles;
+	};
+
+	static Mutex tiled_bake_cache_mutex;
+	static HashMap<ObjectID, TiledBakeCache> tiled_bake_caches;
+
 	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static void generator_bake_tiled(Ref<NavigationMesh> p_navigation_mesh, const rcConfig &p_config, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris);
+	static bool generator_bake_tile(const NavigationMesh *p_navigation_mesh, const rcConfig &p_base_config, const float *p_verts, int p_nverts, const int *p_tris, BakeTile &r_tile);
+	static void generator_bake_tile_task(void *p_userdata, uint32_t p_index);
+	static uint32_t generator_get_bake_settings_hash(const NavigationMesh *p_navigation_mesh, const rcConfig &p_config);
 
 	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
 	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
@@ -51,6 +51,11 @@ void RaycastOcclusionCull::RaycastHZBuffer::clear() {
 	camera_ray_masks.clear();
 	camera_rays_tile_count = 0;
 	tile_grid_size = Size2i();
+
+	previous_depth.clear();
+	trace_tiles.clear();
+	has_previous = false;
+	ray_count = 0;
 }
 
 void RaycastOcclusionCull::RaycastHZBuffer::resize(const Size2i &p_size) {
@@ -78,6 +83,9 @@ void RaycastOcclusionCull::RaycastHZBuffer::resize(const Size2i &p_size) {
 
 	camera_ray_masks.resize(camera_rays_tile_count * TILE_RAYS);
 	memset(camera_ray_masks.ptr(), ~0, camera_rays_tile_count * TILE_RAYS * sizeof(uint32_t));
+
+	previous_depth.resize(p_size.x * p_size.y);
+	has_previous = false;
 }
 
 void RaycastOcclusionCull::RaycastHZBuffer::update_camera_rays(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
@@ -181,6 +189,9 @@ void RaycastOcclusionCull::RaycastHZBuffer::sort_rays(const Vector3 &p_camera_di
 					}
 					int k = tile_i * TILE_SIZE + tile_j;
 					int tile_index = i * tile_grid_size.x + j;
+					if (camera_ray_masks[tile_index * TILE_RAYS + k] == 0) {
+						continue; // Not traced, keeps the reprojected depth.
+					}
 					float d = camera_rays[tile_index].ray.tfar[k];
 
 					if (!p_orthogonal) {
@@ -198,6 +209,123 @@ void RaycastOcclusionCull::RaycastHZBuffer::sort_rays(const Vector3 &p_camera_di
 	}
 }
 
+bool RaycastOcclusionCull::RaycastHZBuffer::is_unchanged(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, uint64_t p_scene_version) const {
+	return has_previous && previous_scene_version == p_scene_version && previous_orthogonal == p_cam_orthogonal && previous_transform == p_cam_transform && previous_projection == p_cam_projection;
+}
+
+bool RaycastOcclusionCull::RaycastHZBuffer::reproject(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, uint64_t p_scene_version) {
+	if (!has_previous || previous_scene_version != p_scene_version || previous_orthogonal != p_cam_orthogonal) {
+		return false;
+	}
+
+	const Size2i &buffer_size = sizes[0];
+	float *depth = mips[0];
+
+	// Scatter every depth sample of the previous update into the current view, keeping the closest one per pixel.
+	// Pixels nothing lands on are left negative, and are traced again.
+	for (int i = 0; i < buffer_size.x * buffer_size.y; i++) {
+		depth[i] = -1.0f;
+	}
+
+	Projection inv_previous_projection = previous_projection.inverse();
+	Transform3D previous_to_current = p_cam_transform.affine_inverse() * previous_transform;
+	float previous_near = previous_projection.get_z_near();
+	float z_near = p_cam_projection.get_z_near();
+
+	for (int y = 0; y < buffer_size.y; y++) {
+		for (int x = 0; x < buffer_size.x; x++) {
+			float d = previous_depth[y * buffer_size.x + x];
+			Vector3 near_point = inv_previous_projection.xform(Vector3((float(x) + 0.5f) / buffer_size.x * 2.0f - 1.0f, (float(y) + 0.5f) / buffer_size.y * 2.0f - 1.0f, -1.0f));
+			Vector3 view_point;
+			if (p_cam_orthogonal) {
+				view_point = Vector3(near_point.x, near_point.y, -d);
+			} else {
+				view_point = near_point * (d / previous_near);
+			}
+
+			Vector3 current_view = previous_to_current.xform(view_point);
+			float current_depth = -current_view.z;
+			if (current_depth <= z_near) {
+				continue;
+			}
+
+			Plane projected = p_cam_projection.xform4(Plane(current_view, 1.0f));
+			if (projected.d <= 0.0f) {
+				continue;
+			}
+			int px = Math::floor((projected.normal.x / projected.d * 0.5f + 0.5f) * buffer_size.x);
+			int py = Math::floor((projected.normal.y / projected.d * 0.5f + 0.5f) * buffer_size.y);
+			if (px < 0 || py < 0 || px >= buffer_size.x || py >= buffer_size.y) {
+				continue;
+			}
+
+			float &dst = depth[py * buffer_size.x + px];
+			if (dst < 0.0f || current_depth < dst) {
+				dst = current_depth;
+			}
+		}
+	}
+
+	// Trace every tile that has holes or a depth edge, where point samples can't be trusted, plus a rotating
+	// slice of the rest so reprojection errors don't pile up.
+	trace_tiles.clear();
+	refresh_frame = (refresh_frame + 1) % REPROJECTION_REFRESH_FRAMES;
+
+	for (int i = 0; i < tile_grid_size.y; i++) {
+		for (int j = 0; j < tile_grid_size.x; j++) {
+			int tile_index = i * tile_grid_size.x + j;
+			bool trace = (uint32_t)tile_index % REPROJECTION_REFRESH_FRAMES == refresh_frame;
+			float min_depth = FLT_MAX;
+			float max_depth = 0.0f;
+
+			for (int tile_i = 0; tile_i < TILE_SIZE && !trace; tile_i++) {
+				for (int tile_j = 0; tile_j < TILE_SIZE; tile_j++) {
+					int x = j * TILE_SIZE + tile_j;
+					int y = i * TILE_SIZE + tile_i;
+					if (x >= buffer_size.x || y >= buffer_size.y) {
+						continue;
+					}
+					float d = depth[y * buffer_size.x + x];
+					if (d < 0.0f) {
+						trace = true;
+						break;
+					}
+					min_depth = MIN(min_depth, d);
+					max_depth = MAX(max_depth, d);
+				}
+			}
+
+			if (!trace && max_depth > min_depth * REPROJECTION_MAX_DEPTH_RATIO) {
+				trace = true;
+			}
+
+			memset(&camera_ray_masks[tile_index * TILE_RAYS], trace ? ~0 : 0, TILE_RAYS * sizeof(uint32_t));
+			if (trace) {
+				trace_tiles.push_back(tile_index);
+			}
+		}
+	}
+
+	return true;
+}
+
+void RaycastOcclusionCull::RaycastHZBuffer::trace_all_tiles() {
+	memset(camera_ray_masks.ptr(), ~0, camera_rays_tile_count * TILE_RAYS * sizeof(uint32_t));
+	trace_tiles.resize(camera_rays_tile_count);
+	for (uint32_t i = 0; i < camera_rays_tile_count; i++) {
+		trace_tiles[i] = i;
+	}
+}
+
+void RaycastOcclusionCull::RaycastHZBuffer::store_previous(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, uint64_t p_scene_version) {
+	memcpy(previous_depth.ptr(), mips[0], previous_depth.size() * sizeof(float));
+	previous_transform = p_cam_transform;
+	previous_projection = p_cam_projection;
+	previous_orthogonal = p_cam_orthogonal;
+	previous_scene_version = p_scene_version;
+	has_previous = true;
+}
+
 RaycastOcclusionCull::RaycastHZBuffer::~RaycastHZBuffer() {
 	if (camera_rays_unaligned_buffer) {
 		memfree(camera_rays_unaligned_buffer);
@@ -225,6 +353,7 @@ void RaycastOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3
 
 	occluder->vertices = p_vertices;
 	occluder->indices = p_indices;
+	occluder->version++;
 
 	for (const InstanceID &E : occluder->users) {
 		RID scenario_rid = E.scenario;
@@ -233,10 +362,7 @@ void RaycastOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3
 		Scenario &scenario = scenarios[scenario_rid];
 		ERR_CONTINUE(!scenario.instances.has(instance_rid));
 
-		if (!scenario.dirty_instances.has(instance_rid)) {
-			scenario.dirty_instances.insert(instance_rid);
-			scenario.dirty_instances_array.push_back(instance_rid);
-		}
+		scenario._mark_dirty(instance_rid);
 	}
 }
 
@@ -277,7 +403,6 @@ void RaycastOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance,
 
 	if (instance.removed) {
 		instance.removed = false;
-		scenario.removed_instances.erase(p_instance);
 		changed = true; // It was removed and re-added, we might have missed some changes
 	}
 
@@ -304,13 +429,11 @@ void RaycastOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance,
 
 	if (instance.enabled != p_enabled) {
 		instance.enabled = p_enabled;
-		scenario.dirty = true; // The scenario needs a scene re-build, but the instance doesn't need update
+		changed = true; // Only toggles the instance's geometry, its vertices are kept.
 	}
 
-	if (changed && !scenario.dirty_instances.has(p_instance)) {
-		scenario.dirty_instances.insert(p_instance);
-		scenario.dirty_instances_array.push_back(p_instance);
-		scenario.dirty = true;
+	if (changed) {
+		scenario._mark_dirty(p_instance);
 	}
 }
 
@@ -327,8 +450,17 @@ void RaycastOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instan
 				occluder->users.erase(InstanceID(p_scenario, p_instance));
 			}
 
-			scenario.removed_instances.push_back(p_instance);
 			instance.removed = true;
+			scenario._mark_dirty(p_instance);
+		}
+	}
+}
+
+void RaycastOcclusionCull::Scenario::_mark_dirty(RID p_instance) {
+	for (int i = 0; i < 2; i++) {
+		if (!dirty_instances[i].has(p_instance)) {
+			dirty_instances[i].insert(p_instance);
+			dirty_instances_array[i].push_back(p_instance);
 		}
 	}
 }
@@ -346,21 +478,38 @@ void RaycastOcclusionCull::Scenario::_update_dirty_instance(int p_idx, RID *p_in
 
 	Occluder *occ = raycast_singleton->occluder_owner.get_or_null(occ_inst->occluder);
 
-	if (!occ) {
-		return;
+	if (!occ || occ_inst->removed) {
+		return; // Detached in _commit_dirty_instance().
+	}
+
+	OccluderInstance::Geometry &geometry = occ_inst->geometries[updating_scene_idx];
+	bool new_mesh = geometry.geom_id == RTC_INVALID_GEOMETRY_ID || geometry.occluder != occ_inst->occluder || geometry.occluder_version != occ->version;
+
+	if (!new_mesh && geometry.xform == occ_inst->xform) {
+		return; // Only enabled state changed.
 	}
 
 	int vertices_size = occ->vertices.size();
 
-	// Embree requires the last element to be readable by a 16-byte SSE load instruction, so we add padding to be safe.
-	occ_inst->xformed_vertices.resize(vertices_size + 1);
+	if (new_mesh) {
+		// Embree requires the last element to be readable by a 16-byte SSE load instruction, so we add padding to be safe.
+		geometry.xformed_vertices.resize(vertices_size + 1);
+		geometry.indices.resize(occ->indices.size());
+		memcpy(geometry.indices.ptr(), occ->indices.ptr(), occ->indices.size() * sizeof(int32_t));
+		geometry.occluder = occ_inst->occluder;
+		geometry.occluder_version = occ->version;
+		geometry.rebuild = true;
+	} else {
+		geometry.refit = true;
+	}
+	geometry.xform = occ_inst->xform;
 
 	const Vector3 *read_ptr = occ->vertices.ptr();
-	Vector3 *write_ptr = occ_inst->xformed_vertices.ptr();
+	Vector3 *write_ptr = geometry.xformed_vertices.ptr();
 
 	if (vertices_size > 1024) {
 		TransformThreadData td;
-		td.xform = occ_inst->xform;
+		td.xform = geometry.xform;
 		td.read = read_ptr;
 		td.write = write_ptr;
 		td.vertex_count = vertices_size;
@@ -369,11 +518,64 @@ void RaycastOcclusionCull::Scenario::_update_dirty_instance(int p_idx, RID *p_in
 		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	} else {
-		_transform_vertices_range(read_ptr, write_ptr, occ_inst->xform, 0, vertices_size);
+		_transform_vertices_range(read_ptr, write_ptr, geometry.xform, 0, vertices_size);
+	}
+}
+
+void RaycastOcclusionCull::Scenario::_commit_dirty_instance(RID p_instance, RTCBuildQuality p_quality) {
+	OccluderInstance *occ_inst = instances.getptr(p_instance);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	RTCScene scene = ebr_scene[updating_scene_idx];
+	OccluderInstance::Geometry &geometry = occ_inst->geometries[updating_scene_idx];
+	const Occluder *occ = raycast_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ || occ_inst->removed) {
+		if (geometry.geom_id != RTC_INVALID_GEOMETRY_ID) {
+			rtcDetachGeometry(scene, geometry.geom_id);
+		}
+		geometry = OccluderInstance::Geometry();
+
+		if (occ_inst->removed && occ_inst->geometries[1 - updating_scene_idx].geom_id == RTC_INVALID_GEOMETRY_ID) {
+			instances.erase(p_instance); // Gone from both scenes.
+		}
+		return;
 	}
 
-	occ_inst->indices.resize(occ->indices.size());
-	memcpy(occ_inst->indices.ptr(), occ->indices.ptr(), occ->indices.size() * sizeof(int32_t));
+	if (geometry.rebuild) {
+		if (geometry.geom_id != RTC_INVALID_GEOMETRY_ID) {
+			rtcDetachGeometry(scene, geometry.geom_id);
+		}
+
+		RTCGeometry geom = rtcNewGeometry(raycast_singleton->ebr_device, RTC_GEOMETRY_TYPE_TRIANGLE);
+		rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, geometry.xformed_vertices.ptr(), 0, sizeof(Vector3), geometry.xformed_vertices.size());
+		rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, geometry.indices.ptr(), 0, sizeof(uint32_t) * 3, geometry.indices.size() / 3);
+		rtcSetGeometryBuildQuality(geom, p_quality);
+		rtcCommitGeometry(geom);
+		geometry.geom_id = rtcAttachGeometry(scene, geom);
+		rtcReleaseGeometry(geom);
+		geometry.enabled = true;
+	} else if (geometry.refit) {
+		// Rigidly moved, refitting the existing BVH is much cheaper than building a new one.
+		RTCGeometry geom = rtcGetGeometry(scene, geometry.geom_id);
+		rtcSetGeometryBuildQuality(geom, RTC_BUILD_QUALITY_REFIT);
+		rtcUpdateGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0);
+		rtcCommitGeometry(geom);
+	}
+	geometry.rebuild = false;
+	geometry.refit = false;
+
+	if (geometry.enabled != occ_inst->enabled) {
+		if (occ_inst->enabled) {
+			rtcEnableGeometry(rtcGetGeometry(scene, geometry.geom_id));
+		} else {
+			rtcDisableGeometry(rtcGetGeometry(scene, geometry.geom_id));
+		}
+		geometry.enabled = occ_inst->enabled;
+	}
 }
 
 void RaycastOcclusionCull::Scenario::_transform_vertices_thread(uint32_t p_thread, TransformThreadData *p_data) {
@@ -408,6 +610,7 @@ bool RaycastOcclusionCull::Scenario::update() {
 		if (commit_done) {
 			commit_thread->wait_to_finish();
 			current_scene_idx = 1 - current_scene_idx;
+			version++;
 		} else {
 			return false;
 		}
@@ -423,61 +626,62 @@ bool RaycastOcclusionCull::Scenario::update() {
 		return true;
 	}
 
-	if (!dirty && removed_instances.is_empty() && dirty_instances_array.is_empty()) {
-		return false;
-	}
-
-	for (const RID &scenario : removed_instances) {
-		instances.erase(scenario);
-	}
+	// Both scenes persist and get the same changes, the one not in use is brought up to date and committed.
+	updating_scene_idx = 1 - current_scene_idx;
+	RTCBuildQuality quality = RTCBuildQuality(raycast_singleton->build_quality);
+	LocalVector<RID> &dirty_array = dirty_instances_array[updating_scene_idx];
 
-	if (dirty_instances_array.size() / WorkerThreadPool::get_singleton()->get_thread_count() > 128) {
-		// Lots of instances, use per-instance threading
-		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance_thread, dirty_instances_array.ptr(), dirty_instances_array.size(), -1, true, SNAME("RaycastOcclusionCullUpdate"));
-		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	} else {
-		// Few instances, use threading on the vertex transforms
-		for (unsigned int i = 0; i < dirty_instances_array.size(); i++) {
-			_update_dirty_instance(i, dirty_instances_array.ptr());
-		}
+	if (dirty_array.is_empty() && ebr_scene_quality[updating_scene_idx] == quality) {
+		return false;
 	}
 
-	dirty_instances.clear();
-	dirty_instances_array.clear();
-	removed_instances.clear();
-
 	if (raycast_singleton->ebr_device == nullptr) {
 		raycast_singleton->_init_embree();
 	}
 
-	int next_scene_idx = 1 - current_scene_idx;
-	RTCScene &next_scene = ebr_scene[next_scene_idx];
+	RTCScene &next_scene = ebr_scene[updating_scene_idx];
 
-	if (next_scene) {
-		rtcReleaseScene(next_scene);
+	if (next_scene == nullptr) {
+		next_scene = rtcNewScene(raycast_singleton->ebr_device);
+		// Low build quality selects Embree's two-level builder: each geometry keeps its own BVH, and only
+		// the ones modified since the last commit are rebuilt before the top level is built over them.
+		rtcSetSceneBuildQuality(next_scene, RTC_BUILD_QUALITY_LOW);
+		rtcSetSceneFlags(next_scene, RTC_SCENE_FLAG_DYNAMIC);
+		ebr_scene_quality[updating_scene_idx] = quality;
 	}
 
-	next_scene = rtcNewScene(raycast_singleton->ebr_device);
-	rtcSetSceneBuildQuality(next_scene, RTCBuildQuality(raycast_singleton->build_quality));
+	if (ebr_scene_quality[updating_scene_idx] != quality) {
+		for (KeyValue<RID, OccluderInstance> &E : instances) {
+			OccluderInstance::Geometry &geometry = E.value.geometries[updating_scene_idx];
+			if (geometry.geom_id != RTC_INVALID_GEOMETRY_ID) {
+				RTCGeometry geom = rtcGetGeometry(next_scene, geometry.geom_id);
+				rtcSetGeometryBuildQuality(geom, quality);
+				rtcCommitGeometry(geom);
+			}
+		}
+		ebr_scene_quality[updating_scene_idx] = quality;
+	}
 
-	for (const KeyValue<RID, OccluderInstance> &E : instances) {
-		const OccluderInstance *occ_inst = &E.value;
-		const Occluder *occ = raycast_singleton->occluder_owner.get_or_null(occ_inst->occluder);
+	if (dirty_array.size() / WorkerThreadPool::get_singleton()->get_thread_count() > 128) {
+		// Lots of instances, use per-instance threading
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_update_dirty_instance_thread, dirty_array.ptr(), dirty_array.size(), -1, true, SNAME("RaycastOcclusionCullUpdate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
-		if (!occ || !occ_inst->enabled) {
-			continue;
+	} else {
+		// Few instances, use threading on the vertex transforms
+		for (unsigned int i = 0; i < dirty_array.size(); i++) {
+			_update_dirty_instance(i, dirty_array.ptr());
 		}
+	}
 
-		RTCGeometry geom = rtcNewGeometry(raycast_singleton->ebr_device, RTC_GEOMETRY_TYPE_TRIANGLE);
-		rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, occ_inst->xformed_vertices.ptr(), 0, sizeof(Vector3), occ_inst->xformed_vertices.size());
-		rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, occ_inst->indices.ptr(), 0, sizeof(uint32_t) * 3, occ_inst->indices.size() / 3);
-		rtcCommitGeometry(geom);
-		rtcAttachGeometry(next_scene, geom);
-		rtcReleaseGeometry(geom);
+	// Embree scene changes are not thread safe, apply them after the vertices are ready.
+	for (const RID &instance : dirty_array) {
+		_commit_dirty_instance(instance, quality);
 	}
 
-	dirty = false;
+	dirty_instances[updating_scene_idx].clear();
+	dirty_array.clear();
+
 	commit_done = false;
 	commit_thread->start(&Scenario::_commit_scene, this);
 	return false;
@@ -488,10 +692,11 @@ void RaycastOcclusionCull::Scenario::_raycast(uint32_t p_idx, const RaycastThrea
 	rtcInitIntersectContext(&ctx);
 	ctx.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
 
-	rtcIntersect16((const int *)&p_raycast_data->masks[p_idx * TILE_RAYS], ebr_scene[current_scene_idx], &ctx, &p_raycast_data->rays[p_idx]);
+	uint32_t tile = p_raycast_data->tiles[p_idx];
+	rtcIntersect16((const int *)&p_raycast_data->masks[tile * TILE_RAYS], ebr_scene[current_scene_idx], &ctx, &p_raycast_data->rays[tile]);
 }
 
-void RaycastOcclusionCull::Scenario::raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count) const {
+void RaycastOcclusionCull::Scenario::raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, const uint32_t *p_tiles, uint32_t p_tile_count) const {
 	ERR_FAIL_COND(singleton == nullptr);
 	if (raycast_singleton->ebr_device == nullptr) {
 		return; // Embree is initialized on demand when there is some scenario with occluders in it.
@@ -504,6 +709,7 @@ void RaycastOcclusionCull::Scenario::raycast(CameraRayTile *r_rays, const uint32
 	RaycastThreadData td;
 	td.rays = r_rays;
 	td.masks = p_valid_masks;
+	td.tiles = p_tiles;
 
 	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &Scenario::_raycast, &td, p_tile_count, -1, true, SNAME("RaycastOcclusionCullRaycast"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
@@ -552,11 +758,32 @@ void RaycastOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_
 		return;
 	}
 
+	if (use_temporal_reprojection && buffer.is_unchanged(p_cam_transform, p_cam_projection, p_cam_orthogonal, scenario.version)) {
+		buffer.ray_count = 0; // Nothing moved, the buffer is still exact.
+		return;
+	}
+
 	buffer.update_camera_rays(p_cam_transform, p_cam_projection, p_cam_orthogonal);
 
-	scenario.raycast(buffer.camera_rays, buffer.camera_ray_masks.ptr(), buffer.camera_rays_tile_count);
+	if (!use_temporal_reprojection || !buffer.reproject(p_cam_transform, p_cam_projection, p_cam_orthogonal, scenario.version)) {
+		buffer.trace_all_tiles();
+	}
+	buffer.ray_count = buffer.trace_tiles.size() * TILE_RAYS;
+
+	scenario.raycast(buffer.camera_rays, buffer.camera_ray_masks.ptr(), buffer.trace_tiles.ptr(), buffer.trace_tiles.size());
 	buffer.sort_rays(-p_cam_transform.basis.get_column(2), p_cam_orthogonal);
 	buffer.update_mips();
+
+	if (use_temporal_reprojection) {
+		buffer.store_previous(p_cam_transform, p_cam_projection, p_cam_orthogonal, scenario.version);
+	}
+}
+
+uint32_t RaycastOcclusionCull::buffer_get_ray_count(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return 0;
+	}
+	return buffers[p_buffer].ray_count;
 }
 
 RaycastOcclusionCull::HZBuffer *RaycastOcclusionCull::buffer_get_ptr(RID p_buffer) {
@@ -578,11 +805,8 @@ void RaycastOcclusionCull::set_build_quality(RS::ViewportOcclusionCullingBuildQu
 		return;
 	}
 
+	// Scenarios apply the new quality to their geometries on the next update.
 	build_quality = p_quality;
-
-	for (KeyValue<RID, Scenario> &K : scenarios) {
-		K.value.dirty = true;
-	}
 }
 
 void RaycastOcclusionCull::_init_embree() {
@@ -599,6 +823,7 @@ RaycastOcclusionCull::RaycastOcclusionCull() {
 	raycast_singleton = this;
 	int default_quality = GLOBAL_GET("rendering/occlusion_culling/bvh_build_quality");
 	build_quality = RS::ViewportOcclusionCullingBuildQuality(default_quality);
+	use_temporal_reprojection = GLOBAL_GET("rendering/occlusion_culling/use_temporal_reprojection");
 }
 
 RaycastOcclusionCull::~RaycastOcclusionCull() {
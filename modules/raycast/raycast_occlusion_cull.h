@@ -66,11 +66,22 @@ public:
 		void _camera_rays_threaded(uint32_t p_thread, const CameraRayThreadData *p_data);
 		void _generate_camera_rays(const CameraRayThreadData *p_data, int p_from, int p_to);
 
+		// Depth and camera of the previous update, reprojected into the next one.
+		LocalVector<float> previous_depth;
+		Transform3D previous_transform;
+		Projection previous_projection;
+		bool previous_orthogonal = false;
+		uint64_t previous_scene_version = 0;
+		bool has_previous = false;
+		uint32_t refresh_frame = 0;
+
 	public:
 		unsigned int camera_rays_tile_count = 0;
 		uint8_t *camera_rays_unaligned_buffer = nullptr;
 		CameraRayTile *camera_rays = nullptr;
 		LocalVector<uint32_t> camera_ray_masks;
+		LocalVector<uint32_t> trace_tiles;
+		uint32_t ray_count = 0;
 		RID scenario_rid;
 
 		virtual void clear() override;
@@ -78,6 +89,11 @@ public:
 		void sort_rays(const Vector3 &p_camera_dir, bool p_orthogonal);
 		void update_camera_rays(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal);
 
+		bool is_unchanged(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, uint64_t p_scene_version) const;
+		bool reproject(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, uint64_t p_scene_version);
+		void trace_all_tiles();
+		void store_previous(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, uint64_t p_scene_version);
+
 		~RaycastHZBuffer();
 	};
 
@@ -103,22 +119,38 @@ private:
 	struct Occluder {
 		PackedVector3Array vertices;
 		PackedInt32Array indices;
+		uint64_t version = 0;
 		HashSet<InstanceID, InstanceID> users;
 	};
 
 	struct OccluderInstance {
+		// What each of the scenario's two Embree scenes currently holds for this instance.
+		// Every instance is its own geometry, so Embree keeps a BVH per occluder and only
+		// rebuilds (or refits, once moved) the ones that changed before building the top level.
+		struct Geometry {
+			LocalVector<uint32_t> indices;
+			LocalVector<Vector3> xformed_vertices;
+			RID occluder;
+			uint64_t occluder_version = 0;
+			Transform3D xform;
+			bool enabled = true;
+			bool rebuild = false;
+			bool refit = false;
+			unsigned int geom_id = RTC_INVALID_GEOMETRY_ID;
+		};
+
 		RID occluder;
-		LocalVector<uint32_t> indices;
-		LocalVector<Vector3> xformed_vertices;
 		Transform3D xform;
 		bool enabled = true;
 		bool removed = false;
+		Geometry geometries[2];
 	};
 
 	struct Scenario {
 		struct RaycastThreadData {
 			CameraRayTile *rays = nullptr;
 			const uint32_t *masks;
+			const uint32_t *tiles;
 		};
 
 		struct TransformThreadData {
@@ -131,38 +163,45 @@ private:
 
 		Thread *commit_thread = nullptr;
 		bool commit_done = true;
-		bool dirty = false;
 		bool removed = false;
 
 		RTCScene ebr_scene[2] = { nullptr, nullptr };
+		RTCBuildQuality ebr_scene_quality[2] = { RTC_BUILD_QUALITY_LOW, RTC_BUILD_QUALITY_LOW };
 		int current_scene_idx = 0;
+		int updating_scene_idx = 0;
+		uint64_t version = 0; // Incremented every time a newly committed scene becomes current.
 
 		HashMap<RID, OccluderInstance> instances;
-		HashSet<RID> dirty_instances; // To avoid duplicates
-		LocalVector<RID> dirty_instances_array; // To iterate and split into threads
-		LocalVector<RID> removed_instances;
+		// Changes are queued once per scene, as each one is brought up to date on its own update.
+		HashSet<RID> dirty_instances[2]; // To avoid duplicates
+		LocalVector<RID> dirty_instances_array[2]; // To iterate and split into threads
 
+		void _mark_dirty(RID p_instance);
 		void _update_dirty_instance_thread(int p_idx, RID *p_instances);
 		void _update_dirty_instance(int p_idx, RID *p_instances);
+		void _commit_dirty_instance(RID p_instance, RTCBuildQuality p_quality);
 		void _transform_vertices_thread(uint32_t p_thread, TransformThreadData *p_data);
 		void _transform_vertices_range(const Vector3 *p_read, Vector3 *p_write, const Transform3D &p_xform, int p_from, int p_to);
 		static void _commit_scene(void *p_ud);
 		bool update();
 
 		void _raycast(uint32_t p_thread, const RaycastThreadData *p_raycast_data) const;
-		void raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, uint32_t p_tile_count) const;
+		void raycast(CameraRayTile *r_rays, const uint32_t *p_valid_masks, const uint32_t *p_tiles, uint32_t p_tile_count) const;
 	};
 
 	static RaycastOcclusionCull *raycast_singleton;
 
 	static const int TILE_SIZE = 4;
 	static const int TILE_RAYS = TILE_SIZE * TILE_SIZE;
+	static const uint32_t REPROJECTION_REFRESH_FRAMES = 8;
+	static constexpr float REPROJECTION_MAX_DEPTH_RATIO = 1.1f;
 
 	RTCDevice ebr_device = nullptr;
 	RID_PtrOwner<Occluder> occluder_owner;
 	HashMap<RID, Scenario> scenarios;
 	HashMap<RID, RaycastHZBuffer> buffers;
 	RS::ViewportOcclusionCullingBuildQuality build_quality;
+	bool use_temporal_reprojection = true;
 
 	void _init_embree();
 
@@ -184,6 +223,7 @@ public:
 	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
 	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
 	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+	virtual uint32_t buffer_get_ray_count(RID p_buffer) override;
 
 	virtual RID buffer_get_debug_texture(RID p_buffer) override;
 
@@ -31,6 +31,7 @@
 #include "node_3d.h"
 
 #include "core/object/message_queue.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/visual_instance_3d.h"
 #include "scene/main/viewport.h"
 #include "scene/property_utils.h"
@@ -104,30 +105,174 @@ void Node3D::_propagate_transform_changed_deferred() {
 	}
 }
 
-void Node3D::_propagate_transform_changed(Node3D *p_origin) {
+bool Node3D::_propagate_transform_changed(Node3D *p_origin) {
 	if (!is_inside_tree()) {
-		return;
+		return true;
 	}
 
+	// With batched transform updates, the change list is only emptied when flushing. A subtree that was completely
+	// propagated during the current pass and is still dirty has all its nodes marked and queued already.
+	SceneTree *tree = get_tree();
+	const bool batched = tree->batch_transform_updates && !is_group_processing();
+	const uint64_t pass = batched ? tree->xform_change_pass.get() : 0;
+	if (batched && data.xform_change_pass == pass && _test_dirty_bits(DIRTY_GLOBAL_TRANSFORM)) {
+		return true;
+	}
+
+	bool complete = true;
 	for (Node3D *&E : data.children) {
 		if (E->data.top_level) {
 			continue; //don't propagate to a top_level
 		}
-		E->_propagate_transform_changed(p_origin);
+		if (!E->_propagate_transform_changed(p_origin)) {
+			complete = false;
+		}
 	}
 #ifdef TOOLS_ENABLED
-	if ((!data.gizmos.is_empty() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
+	if ((!data.gizmos.is_empty() || data.notify_transform) && !xform_change.in_list()) {
 #else
-	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
+	if (data.notify_transform && !xform_change.in_list()) {
 #endif
-		if (likely(is_accessible_from_caller_thread())) {
-			get_tree()->xform_change_list.add(&xform_change);
+		if (data.ignore_notification) {
+			// Not queued, so the next change must visit this node again.
+			complete = false;
+		} else if (likely(is_accessible_from_caller_thread())) {
+			tree->xform_change_list.add(&xform_change);
 		} else {
 			// This should very rarely happen, but if it does at least make sure the notification is received eventually.
 			MessageQueue::get_singleton()->push_callable(callable_mp(this, &Node3D::_propagate_transform_changed_deferred));
+			complete = false;
 		}
 	}
 	_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM);
+
+	if (batched && complete) {
+		data.xform_change_pass = pass;
+	}
+	return complete;
+}
+
+void Node3D::_invalidate_transform_change_pass() {
+	// Subtrees propagated during the current pass may now contain nodes that need to be queued again.
+	if (is_inside_tree() && get_tree()->batch_transform_updates) {
+		get_tree()->xform_change_pass.increment();
+	}
+}
+
+// Dirty nodes laid out so that the subtree of each root is contiguous and parents come before
+// their children. Roots are nodes whose parent is not part of the batch, their slot in
+// global_transforms starts out holding the parent's global transform.
+struct Node3D::GlobalTransformBatch {
+	LocalVector<Node3D *> nodes;
+	LocalVector<Transform3D> local_transforms;
+	LocalVector<Transform3D> global_transforms;
+	LocalVector<int32_t> parents;
+	LocalVector<uint32_t> root_offsets;
+
+	void process_root(uint32_t p_root) {
+		for (uint32_t i = root_offsets[p_root]; i < root_offsets[p_root + 1]; i++) {
+			Transform3D xform = global_transforms[parents[i] >= 0 ? parents[i] : i] * local_transforms[i];
+			Node3D *node = nodes[i];
+			if (node->data.disable_scale) {
+				xform.basis.orthonormalize();
+			}
+			global_transforms[i] = xform;
+			node->data.global_transform = xform;
+			node->_clear_dirty_bits(DIRTY_GLOBAL_TRANSFORM);
+		}
+	}
+
+	void process_root_threaded(uint32_t p_root, void *p_userdata) {
+		process_root(p_root);
+	}
+};
+
+void Node3D::update_global_transforms(Node3D *const *p_nodes, uint32_t p_count) {
+	// Batches below this size are not worth dispatching to worker threads.
+	const uint32_t THREADED_MIN_NODES = 512;
+
+	LocalVector<Node3D *> gathered;
+	LocalVector<int32_t> gathered_parents;
+	LocalVector<uint32_t> gathered_roots;
+	LocalVector<uint32_t> root_sizes;
+	HashMap<const Node3D *, uint32_t> indices;
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		Node3D *node = p_nodes[i];
+		if (!node->is_inside_tree() || !node->_test_dirty_bits(DIRTY_GLOBAL_TRANSFORM) || indices.has(node)) {
+			continue;
+		}
+
+		uint32_t index = gathered.size();
+		indices.insert(node, index);
+		gathered.push_back(node);
+
+		HashMap<const Node3D *, uint32_t>::Iterator E;
+		if (node->data.parent && !node->data.top_level) {
+			E = indices.find(node->data.parent);
+		}
+		if (E) {
+			uint32_t root = gathered_roots[E->value];
+			gathered_parents.push_back(E->value);
+			gathered_roots.push_back(root);
+			root_sizes[root]++;
+		} else {
+			gathered_parents.push_back(-1);
+			gathered_roots.push_back(root_sizes.size());
+			root_sizes.push_back(1);
+		}
+	}
+
+	uint32_t count = gathered.size();
+	if (count == 0) {
+		return;
+	}
+
+	GlobalTransformBatch batch;
+	uint32_t root_count = root_sizes.size();
+	batch.root_offsets.resize(root_count + 1);
+	batch.root_offsets[0] = 0;
+	for (uint32_t i = 0; i < root_count; i++) {
+		batch.root_offsets[i + 1] = batch.root_offsets[i] + root_sizes[i];
+		root_sizes[i] = batch.root_offsets[i]; // Reused as the write cursor of each root.
+	}
+
+	batch.nodes.resize(count);
+	batch.local_transforms.resize(count);
+	batch.global_transforms.resize(count);
+	batch.parents.resize(count);
+
+	// Gathering order is depth order, so parents keep preceding their children within each root.
+	LocalVector<uint32_t> remap;
+	remap.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t j = root_sizes[gathered_roots[i]]++;
+		remap[i] = j;
+
+		Node3D *node = gathered[i];
+		if (node->_test_dirty_bits(DIRTY_LOCAL_TRANSFORM)) {
+			node->_update_local_transform();
+		}
+
+		batch.nodes[j] = node;
+		batch.local_transforms[j] = node->data.local_transform;
+		if (gathered_parents[i] >= 0) {
+			batch.parents[j] = remap[gathered_parents[i]];
+		} else {
+			batch.parents[j] = -1;
+			Node3D *parent = node->data.top_level ? nullptr : node->data.parent;
+			batch.global_transforms[j] = parent ? parent->get_global_transform() : Transform3D();
+		}
+	}
+
+	if (root_count > 1 && count >= THREADED_MIN_NODES) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(&batch, &GlobalTransformBatch::process_root_threaded, (void *)nullptr, root_count, -1, true, SNAME("UpdateGlobalTransforms"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < root_count; i++) {
+			batch.process_root(i);
+		}
+	}
 }
 
 void Node3D::_notification(int p_what) {
@@ -148,6 +293,8 @@ void Node3D::_notification(int p_what) {
 				data.C = nullptr;
 			}
 
+			data.xform_change_pass = 0;
+
 			if (data.top_level && !Engine::get_singleton()->is_editor_hint()) {
 				if (data.parent) {
 					data.local_transform = data.parent->get_global_transform() * get_transform();
@@ -590,6 +737,7 @@ void Node3D::add_gizmo(Ref<Node3DGizmo> p_gizmo) {
 		return;
 	}
 	data.gizmos.push_back(p_gizmo);
+	_invalidate_transform_change_pass();
 
 	if (p_gizmo.is_valid() && is_inside_world()) {
 		p_gizmo->create();
@@ -727,6 +875,7 @@ void Node3D::set_as_top_level(bool p_enabled) {
 		}
 	}
 	data.top_level = p_enabled;
+	_invalidate_transform_change_pass();
 }
 
 bool Node3D::is_set_as_top_level() const {
@@ -934,6 +1083,9 @@ Vector3 Node3D::to_global(Vector3 p_local) const {
 
 void Node3D::set_notify_transform(bool p_enabled) {
 	ERR_THREAD_GUARD;
+	if (p_enabled && !data.notify_transform) {
+		_invalidate_transform_change_pass();
+	}
 	data.notify_transform = p_enabled;
 }
 
@@ -959,6 +1111,7 @@ void Node3D::force_update_transform() {
 		return; //nothing to update
 	}
 	get_tree()->xform_change_list.remove(&xform_change);
+	_invalidate_transform_change_pass();
 
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
@@ -50,6 +50,7 @@ public:
 
 class Node3D : public Node {
 	GDCLASS(Node3D, Node);
+	friend class TestNode3DInternalsAccessor;
 
 public:
 	// Edit mode for the rotation.
@@ -87,6 +88,8 @@ private:
 
 	mutable SelfList<Node> xform_change;
 
+	struct GlobalTransformBatch;
+
 	// This Data struct is to avoid namespace pollution in derived classes.
 
 	struct Data {
@@ -110,6 +113,9 @@ private:
 		List<Node3D *> children;
 		List<Node3D *>::Element *C = nullptr;
 
+		// Transform change pass of the SceneTree in which the whole subtree was last propagated, see _propagate_transform_changed().
+		uint64_t xform_change_pass = 0;
+
 		bool ignore_notification = false;
 		bool notify_local_transform = false;
 		bool notify_transform = false;
@@ -136,7 +142,8 @@ private:
 
 	void _update_gizmos();
 	void _notify_dirty();
-	void _propagate_transform_changed(Node3D *p_origin);
+	bool _propagate_transform_changed(Node3D *p_origin);
+	void _invalidate_transform_change_pass();
 
 	void _propagate_visibility_changed();
 
@@ -167,6 +174,9 @@ public:
 		NOTIFICATION_LOCAL_TRANSFORM_CHANGED = 44,
 	};
 
+	// Resolves the global transforms of p_nodes in a single pass. Parents must come before their children (e.g. sorted by tree depth).
+	static void update_global_transforms(Node3D *const *p_nodes, uint32_t p_count);
+
 	Node3D *get_parent_node_3d() const;
 
 	Ref<World3D> get_world_3d() const;
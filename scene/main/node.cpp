@@ -34,6 +34,7 @@
 #include "core/core_string_names.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/rw_lock.h"
 #include "core/string/print_string.h"
 #include "instance_placeholder.h"
 #include "scene/animation/tween.h"
@@ -46,7 +47,7 @@
 
 #include <stdint.h>
 
-int Node::orphan_node_count = 0;
+SafeNumeric<int> Node::orphan_node_count;
 
 thread_local Node *Node::current_process_thread_group = nullptr;
 
@@ -112,7 +113,7 @@ void Node::_notification(int p_notification) {
 			}
 
 			get_tree()->nodes_in_tree_count++;
-			orphan_node_count--;
+			orphan_node_count.decrement();
 		} break;
 
 		case NOTIFICATION_EXIT_TREE: {
@@ -120,7 +121,7 @@ void Node::_notification(int p_notification) {
 			ERR_FAIL_NULL(get_tree());
 
 			get_tree()->nodes_in_tree_count--;
-			orphan_node_count++;
+			orphan_node_count.increment();
 
 			if (data.input) {
 				remove_from_group("_vp_input" + itos(get_viewport()->get_instance_id()));
@@ -2416,6 +2417,124 @@ bool Node::get_scene_instance_load_placeholder() const {
 	return data.use_placeholder;
 }
 
+// Storage candidates of classes whose property list is fully described by ClassDB, in get_property_list() order.
+// Usages are validated per instance, since _validate_property() may depend on the node state.
+struct DuplicatePropertyInfo {
+	StringName name;
+	PropertyInfo info;
+};
+
+// Rebuilt whenever ClassDB changes (classes registered or unregistered, properties added...).
+// The lists are copy-on-write, so threads that got one before a rebuild can keep using it.
+static RWLock duplicate_cache_lock;
+static HashMap<StringName, Vector<DuplicatePropertyInfo>> duplicate_cache;
+static uint32_t duplicate_cache_version = 0;
+
+static Vector<DuplicatePropertyInfo> _get_duplicate_property_list(const StringName &p_class) {
+	const uint32_t version = ClassDB::property_accessor_version.get();
+	{
+		RWLockRead rl(duplicate_cache_lock);
+		if (duplicate_cache_version == version) {
+			const Vector<DuplicatePropertyInfo> *cached = duplicate_cache.getptr(p_class);
+			if (cached) {
+				return *cached;
+			}
+		}
+	}
+
+	Vector<StringName> classes;
+	for (StringName c = p_class; c != StringName(); c = ClassDB::get_parent_class(c)) {
+		classes.push_back(c);
+	}
+
+	Vector<DuplicatePropertyInfo> props;
+	StringName script_property_name = CoreStringNames::get_singleton()->_script;
+	for (int i = classes.size() - 1; i >= 0; i--) {
+		List<PropertyInfo> plist;
+		ClassDB::get_property_list(classes[i], &plist, true);
+		for (const PropertyInfo &E : plist) {
+			if (E.usage & (PROPERTY_USAGE_CATEGORY | PROPERTY_USAGE_GROUP | PROPERTY_USAGE_SUBGROUP)) {
+				continue;
+			}
+			DuplicatePropertyInfo prop;
+			prop.name = E.name;
+			if (prop.name == script_property_name) {
+				continue;
+			}
+			prop.info = E;
+			props.push_back(prop);
+		}
+	}
+
+	RWLockWrite wl(duplicate_cache_lock);
+	if (duplicate_cache_version != version) {
+		duplicate_cache.clear();
+		duplicate_cache_version = version;
+	}
+	if (!duplicate_cache.has(p_class)) { // Another thread may have filled it in the meantime.
+		duplicate_cache.insert(p_class, props);
+	}
+	return props;
+}
+
+void Node::cleanup_duplicate_cache() {
+	RWLockWrite wl(duplicate_cache_lock);
+	duplicate_cache.clear();
+}
+
+void Node::_duplicate_property(const Node *p_from, Node *p_to, const StringName &p_name, uint32_t p_usage) {
+	Variant value = p_from->get(p_name).duplicate(true);
+
+	if (p_usage & PROPERTY_USAGE_ALWAYS_DUPLICATE) {
+		Resource *res = Object::cast_to<Resource>(value);
+		if (res) { // Duplicate only if it's a resource
+			p_to->set(p_name, res->duplicate());
+		}
+		return;
+	}
+
+	p_to->set(p_name, value);
+}
+
+void Node::_duplicate_properties(const Node *p_from, Node *p_to) {
+	if (p_from->get_script_instance() || p_from->_get_extension() || p_from->_has_dynamic_property_listv()) {
+		// The property list depends on the instance, so it can't be cached.
+		StringName script_property_name = CoreStringNames::get_singleton()->_script;
+
+		List<PropertyInfo> plist;
+		p_from->get_property_list(&plist);
+
+		for (const PropertyInfo &E : plist) {
+			if (!(E.usage & PROPERTY_USAGE_STORAGE)) {
+				continue;
+			}
+			StringName name = E.name;
+			if (name == script_property_name) {
+				continue;
+			}
+			_duplicate_property(p_from, p_to, name, E.usage);
+		}
+		return;
+	}
+
+	const Vector<DuplicatePropertyInfo> props = _get_duplicate_property_list(p_from->get_class_name());
+	for (const DuplicatePropertyInfo &E : props) {
+		PropertyInfo info = E.info;
+		p_from->validate_property(info);
+		if (!(info.usage & PROPERTY_USAGE_STORAGE)) {
+			continue;
+		}
+		_duplicate_property(p_from, p_to, E.name, info.usage);
+	}
+
+	// Metadata is listed last by get_property_list().
+	List<StringName> meta_list;
+	p_from->get_meta_list(&meta_list);
+	for (const StringName &E : meta_list) {
+		p_to->set_meta(E, p_from->get_meta(E).duplicate(true));
+	}
+}
+
 Node *Node::_duplicate(int p_flags, HashMap<const Node *, Node *> *r_duplimap) const {
 	ERR_THREAD_GUARD_V(nullptr);
 	Node *node = nullptr;
@@ -2504,30 +2623,7 @@ Node *Node::_duplicate(int p_flags, HashMap<const Node *, Node *> *r_duplimap) c
 			}
 		}
 
-		List<PropertyInfo> plist;
-		N->get()->get_property_list(&plist);
-
-		for (const PropertyInfo &E : plist) {
-			if (!(E.usage & PROPERTY_USAGE_STORAGE)) {
-				continue;
-			}
-			String name = E.name;
-			if (name == script_property_name) {
-				continue;
-			}
-
-			Variant value = N->get()->get(name).duplicate(true);
-
-			if (E.usage & PROPERTY_USAGE_ALWAYS_DUPLICATE) {
-				Resource *res = Object::cast_to<Resource>(value);
-				if (res) { // Duplicate only if it's a resource
-					current_node->set(name, res->duplicate());
-				}
-
-			} else {
-				current_node->set(name, value);
-			}
-		}
+		_duplicate_properties(N->get(), current_node);
 	}
 
 	if (get_name() != String()) {
@@ -3516,7 +3612,7 @@ String Node::_get_name_num_separator() {
 }
 
 Node::Node() {
-	orphan_node_count++;
+	orphan_node_count.increment();
 }
 
 Node::~Node() {
@@ -3528,7 +3624,7 @@ Node::~Node() {
 	ERR_FAIL_COND(data.parent);
 	ERR_FAIL_COND(data.children_cache.size());
 
-	orphan_node_count--;
+	orphan_node_count.decrement();
 }
 
 ////////////////////////////////
@@ -3576,6 +3672,11 @@ Error Node::emit_signalp(const StringName &p_name, const Variant **p_args, int p
 	return Object::emit_signalp(p_name, p_args, p_argcount);
 }
 
+Error Node::_emit_signal_typedp(const StringName &p_name, const Variant **p_args, int p_argcount, const SignalTypedArgs &p_typed_args) {
+	ERR_THREAD_GUARD_V(ERR_INVALID_PARAMETER);
+	return Object::_emit_signal_typedp(p_name, p_args, p_argcount, p_typed_args);
+}
+
 bool Node::has_signal(const StringName &p_name) const {
 	ERR_THREAD_GUARD_V(false);
 	return Object::has_signal(p_name);
@@ -112,7 +112,7 @@ public:
 		bool operator()(const Node *p_a, const Node *p_b) const { return p_b->is_greater_than(p_a); }
 	};
 
-	static int orphan_node_count;
+	static SafeNumeric<int> orphan_node_count; // Nodes can be created and freed outside the tree from any thread.
 
 	void _update_process(bool p_enable, bool p_for_children);
 
@@ -237,6 +237,8 @@ private:
 	void _propagate_groups_dirty();
 	Array _get_node_and_resource(const NodePath &p_path);
 
+	static void _duplicate_property(const Node *p_from, Node *p_to, const StringName &p_name, uint32_t p_usage);
+	static void _duplicate_properties(const Node *p_from, Node *p_to);
 	void _duplicate_signals(const Node *p_original, Node *p_copy) const;
 	Node *_duplicate(int p_flags, HashMap<const Node *, Node *> *r_duplimap = nullptr) const;
 
@@ -309,6 +311,10 @@ protected:
 
 	void _validate_property(PropertyInfo &p_property) const;
 
+#ifdef DEBUG_ENABLED
+	virtual Error _emit_signal_typedp(const StringName &p_name, const Variant **p_args, int p_argcount, const SignalTypedArgs &p_typed_args) override;
+#endif
+
 protected:
 	virtual void input(const Ref<InputEvent> &p_event);
 	virtual void shortcut_input(const Ref<InputEvent> &p_key_event);
@@ -616,6 +622,7 @@ public:
 
 	//hacks for speed
 	static void init_node_hrcr();
+	static void cleanup_duplicate_cache();
 
 	void force_parent_owned() { data.parent_owned = true; } //hack to avoid duplicate nodes
 
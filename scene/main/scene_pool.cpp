@@ -0,0 +1,209 @@
+/**************************************************************************/
+/*  scene_pool.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "scene_pool.h"
+
+void ScenePool::set_scene(const Ref<PackedScene> &p_scene) {
+	if (scene == p_scene) {
+		return;
+	}
+	clear();
+	acquired.clear();
+	scene = p_scene;
+}
+
+Ref<PackedScene> ScenePool::get_scene() const {
+	return scene;
+}
+
+void ScenePool::set_max_size(int p_max_size) {
+	ERR_FAIL_COND(p_max_size < 0);
+	max_size = p_max_size;
+	while ((int)available.size() > max_size) {
+		Node *node = _pop_available();
+		if (node) {
+			memdelete(node);
+		}
+	}
+}
+
+int ScenePool::get_max_size() const {
+	return max_size;
+}
+
+Node *ScenePool::_pop_available() {
+	ObjectID id = available[available.size() - 1];
+	available.resize(available.size() - 1);
+	return Object::cast_to<Node>(ObjectDB::get_instance(id));
+}
+
+void ScenePool::_prune_acquired() {
+	LocalVector<ObjectID> freed;
+	for (const ObjectID &id : acquired) {
+		if (!ObjectDB::get_instance(id)) {
+			freed.push_back(id);
+		}
+	}
+	for (const ObjectID &id : freed) {
+		acquired.erase(id);
+	}
+}
+
+Node *ScenePool::acquire() {
+	if (acquired.size() >= acquired_prune_size) {
+		_prune_acquired();
+		acquired_prune_size = MAX(64u, acquired.size() * 2);
+	}
+
+	while (available.size()) {
+		Node *node = _pop_available();
+		if (!node) {
+			continue; // Freed while it was in the pool.
+		}
+		hit_count++;
+		acquired.insert(node->get_instance_id());
+		emit_signal(SNAME("instance_acquired"), node);
+		return node;
+	}
+
+	ERR_FAIL_COND_V_MSG(scene.is_null(), nullptr, "No scene is set to instantiate from.");
+	Node *node = scene->instantiate();
+	ERR_FAIL_NULL_V(node, nullptr);
+	miss_count++;
+	acquired.insert(node->get_instance_id());
+	emit_signal(SNAME("instance_acquired"), node);
+	return node;
+}
+
+void ScenePool::release(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_node->is_queued_for_deletion(), "Can't release a node that is queued for deletion.");
+	// Also catches nodes released twice, and instances of the scene set before the current one.
+	ERR_FAIL_COND_MSG(!acquired.has(p_node->get_instance_id()), "Can't release a node that was not acquired from this pool.");
+	acquired.erase(p_node->get_instance_id());
+
+	Node *parent = p_node->get_parent();
+	if (parent) {
+		parent->remove_child(p_node);
+	}
+
+	emit_signal(SNAME("instance_released"), p_node);
+
+	if ((int)available.size() >= max_size) {
+		// Deleting right away is not safe if this is called from one of the node's own callbacks.
+		p_node->queue_free();
+		return;
+	}
+
+	available.push_back(p_node->get_instance_id());
+}
+
+void ScenePool::prewarm(int p_count) {
+	ERR_FAIL_COND_MSG(scene.is_null(), "No scene is set to instantiate from.");
+	int count = MIN(p_count, max_size);
+	while ((int)available.size() < count) {
+		Node *node = scene->instantiate();
+		ERR_FAIL_NULL(node);
+		available.push_back(node->get_instance_id());
+	}
+}
+
+void ScenePool::clear() {
+	while (available.size()) {
+		Node *node = _pop_available();
+		if (node) {
+			memdelete(node);
+		}
+	}
+
+	// Forget acquired instances that were freed without being released.
+	_prune_acquired();
+}
+
+int ScenePool::get_available_count() const {
+	int count = 0;
+	for (const ObjectID &id : available) {
+		if (ObjectDB::get_instance(id)) {
+			count++;
+		}
+	}
+	return count;
+}
+
+int ScenePool::get_acquired_count() const {
+	int count = 0;
+	for (const ObjectID &id : acquired) {
+		if (ObjectDB::get_instance(id)) {
+			count++;
+		}
+	}
+	return count;
+}
+
+uint64_t ScenePool::get_hit_count() const {
+	return hit_count;
+}
+
+uint64_t ScenePool::get_miss_count() const {
+	return miss_count;
+}
+
+void ScenePool::reset_statistics() {
+	hit_count = 0;
+	miss_count = 0;
+}
+
+void ScenePool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_scene", "scene"), &ScenePool::set_scene);
+	ClassDB::bind_method(D_METHOD("get_scene"), &ScenePool::get_scene);
+	ClassDB::bind_method(D_METHOD("set_max_size", "max_size"), &ScenePool::set_max_size);
+	ClassDB::bind_method(D_METHOD("get_max_size"), &ScenePool::get_max_size);
+
+	ClassDB::bind_method(D_METHOD("acquire"), &ScenePool::acquire);
+	ClassDB::bind_method(D_METHOD("release", "node"), &ScenePool::release);
+	ClassDB::bind_method(D_METHOD("prewarm", "count"), &ScenePool::prewarm);
+	ClassDB::bind_method(D_METHOD("clear"), &ScenePool::clear);
+
+	ClassDB::bind_method(D_METHOD("get_available_count"), &ScenePool::get_available_count);
+	ClassDB::bind_method(D_METHOD("get_acquired_count"), &ScenePool::get_acquired_count);
+	ClassDB::bind_method(D_METHOD("get_hit_count"), &ScenePool::get_hit_count);
+	ClassDB::bind_method(D_METHOD("get_miss_count"), &ScenePool::get_miss_count);
+	ClassDB::bind_method(D_METHOD("reset_statistics"), &ScenePool::reset_statistics);
+
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "scene", PROPERTY_HINT_RESOURCE_TYPE, "PackedScene"), "set_scene", "get_scene");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_size", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_max_size", "get_max_size");
+
+	ADD_SIGNAL(MethodInfo("instance_acquired", PropertyInfo(Variant::OBJECT, "node", PROPERTY_HINT_RESOURCE_TYPE, "Node")));
+	ADD_SIGNAL(MethodInfo("instance_released", PropertyInfo(Variant::OBJECT, "node", PROPERTY_HINT_RESOURCE_TYPE, "Node")));
+}
+
+ScenePool::~ScenePool() {
+	clear();
+}
@@ -43,6 +43,7 @@
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 #include "node.h"
+#include "scene/3d/node_3d.h"
 #include "scene/animation/tween.h"
 #include "scene/debugger/scene_debugger.h"
 #include "scene/gui/control.h"
@@ -179,6 +180,11 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
+	if (batch_transform_updates) {
+		_flush_transform_notifications_batched();
+		return;
+	}
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -189,6 +195,53 @@ void SceneTree::flush_transform_notifications() {
 	}
 }
 
+void SceneTree::_flush_transform_notifications_batched() {
+	struct NodeDepthSort {
+		_FORCE_INLINE_ bool operator()(const Node *p_a, const Node *p_b) const {
+			return p_a->data.depth < p_b->data.depth;
+		}
+	};
+
+	// Only the notifications pending now are sent, the ones queued while sending them wait for the next flush.
+	LocalVector<Node *> nodes;
+	while (SelfList<Node> *n = xform_change_list.first()) {
+		xform_change_list.remove(n);
+		nodes.push_back(n->self());
+	}
+	if (nodes.is_empty()) {
+		return;
+	}
+	xform_change_pass.increment();
+
+	nodes.sort_custom<NodeDepthSort>();
+
+#ifndef _3D_DISABLED
+	// Resolve all the dirty global transforms at once, so the notified nodes don't have to climb the tree.
+	LocalVector<Node3D *> nodes_3d;
+	for (Node *node : nodes) {
+		Node3D *node_3d = Object::cast_to<Node3D>(node);
+		if (node_3d) {
+			nodes_3d.push_back(node_3d);
+		}
+	}
+	Node3D::update_global_transforms(nodes_3d.ptr(), nodes_3d.size());
+#endif // _3D_DISABLED
+
+	LocalVector<ObjectID> ids;
+	ids.resize(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		ids[i] = nodes[i]->get_instance_id();
+	}
+
+	// A notification may remove or free nodes that come later in the list.
+	for (const ObjectID &id : ids) {
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+		if (node && node->is_inside_tree()) {
+			node->notification(NOTIFICATION_TRANSFORM_CHANGED);
+		}
+	}
+}
+
 void SceneTree::_flush_ugc() {
 	ugc_locked = true;
 
@@ -226,6 +279,110 @@ void SceneTree::_update_group_order(Group &g) {
 	g.changed = false;
 }
 
+// Keeps what group operations resolved through ClassDB for each class of node they went through,
+// so that a large group made of a few classes only pays for the lookups once per class.
+struct GroupClassCache {
+	struct Entry {
+		StringName class_name;
+		MethodBind *method = nullptr;
+		int index = -1;
+	};
+
+	LocalVector<Entry> entries;
+	uint32_t last_hit = 0;
+
+	_FORCE_INLINE_ Entry *find(const StringName &p_class) {
+		if (last_hit < entries.size() && entries[last_hit].class_name == p_class) {
+			return &entries[last_hit];
+		}
+		for (uint32_t i = 0; i < entries.size(); i++) {
+			if (entries[i].class_name == p_class) {
+				last_hit = i;
+				return &entries[i];
+			}
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ Entry *insert(const StringName &p_class) {
+		last_hit = entries.size();
+		entries.push_back(Entry());
+		entries[last_hit].class_name = p_class;
+		return &entries[last_hit];
+	}
+};
+
+static MethodBind *_get_group_call_method(GroupClassCache &r_cache, Node *p_node, const StringName &p_function) {
+	if (p_node->get_script_instance()) {
+		return nullptr; // Scripts can override native methods, let Object::callp() resolve those.
+	}
+
+	const StringName &class_name = p_node->get_class_name();
+	GroupClassCache::Entry *entry = r_cache.find(class_name);
+	if (!entry) {
+		entry = r_cache.insert(class_name);
+		entry->method = ClassDB::get_method(class_name, p_function);
+	}
+	return entry->method;
+}
+
+static _FORCE_INLINE_ void _call_group_node(Node *p_node, MethodBind *p_method, const StringName &p_function, const Variant **p_args, int p_argcount) {
+	Callable::CallError ce;
+	if (p_method) {
+#ifdef DEBUG_ENABLED
+		_ObjectDebugLock debug_lock(p_node); // Held by Object::callp() too.
+#endif
+		p_method->call(p_node, p_args, p_argcount, ce);
+	} else {
+		p_node->callp(p_function, p_args, p_argcount, ce);
+	}
+}
+
+static MethodBind *_get_group_setter(GroupClassCache &r_cache, Node *p_node, const StringName &p_name, int &r_index) {
+	if (p_node->get_script_instance()) {
+		return nullptr; // Scripts can override native properties, let Object::set() resolve those.
+	}
+
+	const StringName &class_name = p_node->get_class_name();
+	GroupClassCache::Entry *entry = r_cache.find(class_name);
+	if (!entry) {
+		entry = r_cache.insert(class_name);
+		ClassDB::APIType api = ClassDB::get_api_type(class_name);
+		bool can_skip_set = api != ClassDB::API_EXTENSION && api != ClassDB::API_EDITOR_EXTENSION; // Extensions get to handle properties first.
+#ifdef TOOLS_ENABLED
+		can_skip_set = can_skip_set && !Engine::get_singleton()->is_editor_hint(); // Object::set() also marks objects as edited.
+#endif
+		if (can_skip_set) {
+			entry->method = ClassDB::get_property_setter_method(class_name, p_name, &entry->index);
+		}
+	}
+	r_index = entry->index;
+	return entry->method;
+}
+
+static void _set_group_node(GroupClassCache &r_cache, Node *p_node, const StringName &p_name, const Variant &p_value) {
+	int index = -1;
+	MethodBind *setter = _get_group_setter(r_cache, p_node, p_name, index);
+	if (!setter) {
+		p_node->set(p_name, p_value);
+		return;
+	}
+
+	Callable::CallError ce;
+	if (index >= 0) {
+		Variant index_arg = index;
+		const Variant *args[2] = { &index_arg, &p_value };
+		setter->call(p_node, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		setter->call(p_node, args, 1, ce);
+	}
+}
+
+void SceneTree::_call_group_threaded(uint32_t p_index, ThreadedGroupCall *p_call) {
+	_call_group_node(p_call->nodes[p_index], p_call->methods[p_index], p_call->function, p_call->args, p_call->argcount);
+}
+
 void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, const Variant **p_args, int p_argcount) {
 	Vector<Node *> nodes_copy;
 
@@ -273,15 +430,37 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 		nodes_removed_on_group_call_lock++;
 	}
 
-	if (p_call_flags & GROUP_CALL_REVERSE) {
+	GroupClassCache cache;
+
+	if ((p_call_flags & GROUP_CALL_THREADED) && !(p_call_flags & GROUP_CALL_DEFERRED)) {
+		// Methods are resolved upfront, so the worker threads only have to make the calls.
+		ThreadedGroupCall call;
+		call.function = p_function;
+		call.args = p_args;
+		call.argcount = p_argcount;
+		call.nodes.reserve(gr_node_count);
+		call.methods.reserve(gr_node_count);
+		for (int i = 0; i < gr_node_count; i++) {
+			if (nodes_removed_on_group_call.has(gr_nodes[i])) {
+				continue;
+			}
+			call.nodes.push_back(gr_nodes[i]);
+			call.methods.push_back(_get_group_call_method(cache, gr_nodes[i], p_function));
+		}
+
+		if (!call.nodes.is_empty()) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_call_group_threaded, &call, call.nodes.size(), -1, true, SNAME("SceneTreeGroupCall"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+	} else if (p_call_flags & GROUP_CALL_REVERSE) {
 		for (int i = gr_node_count - 1; i >= 0; i--) {
 			if (nodes_removed_on_group_call_lock && nodes_removed_on_group_call.has(gr_nodes[i])) {
 				continue;
 			}
 
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
-				Callable::CallError ce;
-				gr_nodes[i]->callp(p_function, p_args, p_argcount, ce);
+				_call_group_node(gr_nodes[i], _get_group_call_method(cache, gr_nodes[i], p_function), p_function, p_args, p_argcount);
 			} else {
 				MessageQueue::get_singleton()->push_callp(gr_nodes[i], p_function, p_args, p_argcount);
 			}
@@ -294,8 +473,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 			}
 
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
-				Callable::CallError ce;
-				gr_nodes[i]->callp(p_function, p_args, p_argcount, ce);
+				_call_group_node(gr_nodes[i], _get_group_call_method(cache, gr_nodes[i], p_function), p_function, p_args, p_argcount);
 			} else {
 				MessageQueue::get_singleton()->push_callp(gr_nodes[i], p_function, p_args, p_argcount);
 			}
@@ -399,6 +577,9 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 		nodes_removed_on_group_call_lock++;
 	}
 
+	const StringName name = p_name;
+	GroupClassCache cache;
+
 	if (p_call_flags & GROUP_CALL_REVERSE) {
 		for (int i = gr_node_count - 1; i >= 0; i--) {
 			if (nodes_removed_on_group_call.has(gr_nodes[i])) {
@@ -406,9 +587,9 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 			}
 
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
-				gr_nodes[i]->set(p_name, p_value);
+				_set_group_node(cache, gr_nodes[i], name, p_value);
 			} else {
-				MessageQueue::get_singleton()->push_set(gr_nodes[i], p_name, p_value);
+				MessageQueue::get_singleton()->push_set(gr_nodes[i], name, p_value);
 			}
 		}
 
@@ -419,9 +600,9 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 			}
 
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
-				gr_nodes[i]->set(p_name, p_value);
+				_set_group_node(cache, gr_nodes[i], name, p_value);
 			} else {
-				MessageQueue::get_singleton()->push_set(gr_nodes[i], p_name, p_value);
+				MessageQueue::get_singleton()->push_set(gr_nodes[i], name, p_value);
 			}
 		}
 	}
@@ -892,37 +1073,53 @@ bool SceneTree::is_paused() const {
 	return paused;
 }
 
-void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
-	// When reading this function, keep in mind that this code must work in a way where
-	// if any node is removed, this needs to continue working.
-
-	p_group->call_queue.flush(); // Flush messages before processing.
-
-	Vector<Node *> &nodes = p_physics ? p_group->physics_nodes : p_group->nodes;
-	if (nodes.is_empty()) {
+// Nodes are only ever appended to the process lists, and removing one keeps the others in order.
+// Only the nodes added since the last sort need sorting, then they are merged with the sorted ones.
+template <typename C>
+static void _sort_process_nodes(Vector<Node *> &r_nodes, uint32_t &r_sorted) {
+	const uint32_t count = r_nodes.size();
+	if (r_sorted >= count) {
+		r_sorted = count;
 		return;
 	}
 
-	if (p_physics) {
-		if (p_group->physics_node_order_dirty) {
-			nodes.sort_custom<Node::ComparatorWithPhysicsPriority>();
-			p_group->physics_node_order_dirty = false;
+	Node **nodes = r_nodes.ptrw();
+	SortArray<Node *, C> sorter;
+	sorter.sort(&nodes[r_sorted], count - r_sorted);
+
+	C compare;
+	if (r_sorted > 0 && compare(nodes[r_sorted], nodes[r_sorted - 1])) {
+		LocalVector<Node *> merged;
+		merged.resize(count);
+		uint32_t a = 0;
+		uint32_t b = r_sorted;
+		uint32_t to = 0;
+		while (a < r_sorted && b < count) {
+			merged[to++] = compare(nodes[b], nodes[a]) ? nodes[b++] : nodes[a++];
 		}
-	} else {
-		if (p_group->node_order_dirty) {
-			nodes.sort_custom<Node::ComparatorWithPriority>();
-			p_group->node_order_dirty = false;
+		while (a < r_sorted) {
+			merged[to++] = nodes[a++];
+		}
+		while (b < count) {
+			merged[to++] = nodes[b++];
 		}
+		memcpy(nodes, merged.ptr(), sizeof(Node *) * count);
 	}
 
-	// Make a copy, so if nodes are added/removed from process, this does not break
-	Vector<Node *> nodes_copy = nodes;
+	r_sorted = count;
+}
 
-	uint32_t node_count = nodes_copy.size();
-	Node **nodes_ptr = (Node **)nodes_copy.ptr(); // Force cast, pointer will not change.
+void SceneTree::_sort_process_group(ProcessGroup *p_group, bool p_physics) {
+	if (p_physics) {
+		_sort_process_nodes<Node::ComparatorWithPhysicsPriority>(p_group->physics_nodes, p_group->physics_nodes_sorted);
+	} else {
+		_sort_process_nodes<Node::ComparatorWithPriority>(p_group->nodes, p_group->nodes_sorted);
+	}
+}
 
-	for (uint32_t i = 0; i < node_count; i++) {
-		Node *n = nodes_ptr[i];
+void SceneTree::_process_nodes(Node *const *p_nodes, uint32_t p_count, bool p_physics) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		Node *n = p_nodes[i];
 		if (nodes_removed_on_group_call.has(n)) {
 			// Node may have been removed during process, skip it.
 			// Keep in mind removals can only happen on the main thread.
@@ -949,16 +1146,96 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 			}
 		}
 	}
+}
+
+void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
+	// When reading this function, keep in mind that this code must work in a way where
+	// if any node is removed, this needs to continue working.
+
+	const uint64_t process_begin = OS::get_singleton()->get_ticks_usec();
+
+	p_group->call_queue.flush(); // Flush messages before processing.
+
+	Vector<Node *> &nodes = p_physics ? p_group->physics_nodes : p_group->nodes;
+	if (nodes.is_empty()) {
+		p_group->process_usec = OS::get_singleton()->get_ticks_usec() - process_begin;
+		return;
+	}
+
+	_sort_process_group(p_group, p_physics);
+
+	// Make a copy, so if nodes are added/removed from process, this does not break
+	Vector<Node *> nodes_copy = nodes;
+
+	_process_nodes(nodes_copy.ptr(), nodes_copy.size(), p_physics);
 
 	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
+
+	p_group->process_usec = OS::get_singleton()->get_ticks_usec() - process_begin;
+}
+
+void SceneTree::_queue_threaded_process_group(ProcessGroup *p_group, bool p_physics) {
+	const Vector<Node *> &nodes = p_physics ? p_group->physics_nodes : p_group->nodes;
+	const uint32_t chunk_size = process_thread_group_chunk_size;
+
+	ProcessGroupTask task;
+	task.group = p_group;
+
+	if (chunk_size == 0 || uint32_t(nodes.size()) <= chunk_size) {
+		local_process_group_cache.push_back(task);
+		return;
+	}
+
+	// Large groups are split into chunks of nodes, so a single heavy group can't keep the other threads waiting.
+	// Messages for the group are flushed here and after all its chunks are done, instead of by each chunk.
+	const uint64_t flush_begin = OS::get_singleton()->get_ticks_usec();
+	Node::current_process_thread_group = p_group->owner;
+	p_group->call_queue.flush();
+	Node::current_process_thread_group = nullptr;
+	p_group->process_usec = OS::get_singleton()->get_ticks_usec() - flush_begin;
+
+	_sort_process_group(p_group, p_physics);
+
+	// Make a copy, so if nodes are added/removed from process, this does not break.
+	local_process_group_snapshots.push_back(nodes);
+	const Vector<Node *> &snapshot = local_process_group_snapshots[local_process_group_snapshots.size() - 1];
+	const uint32_t node_count = snapshot.size();
+
+	for (uint32_t from = 0; from < node_count; from += chunk_size) {
+		task.nodes = snapshot.ptr() + from;
+		task.node_count = MIN(chunk_size, node_count - from);
+		task.last_chunk = from + chunk_size >= node_count;
+		local_process_group_cache.push_back(task);
+	}
 }
 
 void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
-	Node::current_process_thread_group = local_process_group_cache[p_index]->owner;
-	_process_group(local_process_group_cache[p_index], p_physics);
+	ProcessGroupTask &task = local_process_group_cache[p_index];
+	Node::current_process_thread_group = task.group->owner;
+	if (task.nodes) {
+		const uint64_t process_begin = OS::get_singleton()->get_ticks_usec();
+		_process_nodes(task.nodes, task.node_count, p_physics);
+		task.usec = OS::get_singleton()->get_ticks_usec() - process_begin;
+	} else {
+		_process_group(task.group, p_physics);
+	}
 	Node::current_process_thread_group = nullptr;
 }
 
+void SceneTree::_send_process_group_times(bool p_physics) {
+	const StringName server_name = p_physics ? SNAME("physics_process_groups") : SNAME("process_groups");
+	for (ProcessGroup *pg : process_groups) {
+		if (pg->removed || pg->last_pass != process_last_pass) {
+			continue;
+		}
+		Array values;
+		values.push_back(server_name);
+		values.push_back(pg->owner ? String(pg->owner->get_path()) : String("Default"));
+		values.push_back(USEC_TO_SEC(pg->process_usec));
+		EngineDebugger::profiler_add_frame_data("servers", values);
+	}
+}
+
 void SceneTree::_process(bool p_physics) {
 	if (process_groups_dirty) {
 		{
@@ -1016,11 +1293,12 @@ void SceneTree::_process(bool p_physics) {
 
 				if (using_threads) {
 					local_process_group_cache.clear();
+					local_process_group_snapshots.clear();
 				}
 				for (uint32_t j = from; j < i; j++) {
 					if (process_groups[j]->last_pass == process_last_pass) {
 						if (using_threads) {
-							local_process_group_cache.push_back(process_groups[j]);
+							_queue_threaded_process_group(process_groups[j], p_physics);
 						} else {
 							_process_group(process_groups[j], p_physics);
 						}
@@ -1030,6 +1308,21 @@ void SceneTree::_process(bool p_physics) {
 				if (using_threads) {
 					WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_groups_thread, p_physics, local_process_group_cache.size(), -1, true);
 					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
+
+					// Finish the groups that were split into chunks.
+					for (const ProcessGroupTask &task : local_process_group_cache) {
+						if (!task.nodes) {
+							continue;
+						}
+						task.group->process_usec += task.usec;
+						if (task.last_chunk) {
+							const uint64_t flush_begin = OS::get_singleton()->get_ticks_usec();
+							Node::current_process_thread_group = task.group->owner;
+							task.group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
+							Node::current_process_thread_group = nullptr;
+							task.group->process_usec += OS::get_singleton()->get_ticks_usec() - flush_begin;
+						}
+					}
 				}
 			}
 
@@ -1075,6 +1368,10 @@ void SceneTree::_process(bool p_physics) {
 	if (nodes_removed_on_group_call_lock == 0) {
 		nodes_removed_on_group_call.clear();
 	}
+
+	if (EngineDebugger::is_profiling("servers")) {
+		_send_process_group_times(p_physics);
+	}
 }
 
 bool SceneTree::ProcessGroupSort::operator()(const ProcessGroup *p_left, const ProcessGroup *p_right) const {
@@ -1120,13 +1417,21 @@ void SceneTree::_remove_node_from_process_group(Node *p_node, Node *p_owner) {
 	ProcessGroup *pg = p_owner ? (ProcessGroup *)p_owner->data.process_group : &default_process_group;
 
 	if (p_node->is_processing() || p_node->is_processing_internal()) {
-		bool found = pg->nodes.erase(p_node);
-		ERR_FAIL_COND(!found);
+		int index = pg->nodes.find(p_node);
+		ERR_FAIL_COND(index == -1);
+		pg->nodes.remove_at(index);
+		if (uint32_t(index) < pg->nodes_sorted) {
+			pg->nodes_sorted--;
+		}
 	}
 
 	if (p_node->is_physics_processing() || p_node->is_physics_processing_internal()) {
-		bool found = pg->physics_nodes.erase(p_node);
-		ERR_FAIL_COND(!found);
+		int index = pg->physics_nodes.find(p_node);
+		ERR_FAIL_COND(index == -1);
+		pg->physics_nodes.remove_at(index);
+		if (uint32_t(index) < pg->physics_nodes_sorted) {
+			pg->physics_nodes_sorted--;
+		}
 	}
 }
 
@@ -1136,12 +1441,10 @@ void SceneTree::_add_node_to_process_group(Node *p_node, Node *p_owner) {
 
 	if (p_node->is_processing() || p_node->is_processing_internal()) {
 		pg->nodes.push_back(p_node);
-		pg->node_order_dirty = true;
 	}
 
 	if (p_node->is_physics_processing() || p_node->is_physics_processing_internal()) {
 		pg->physics_nodes.push_back(p_node);
-		pg->physics_node_order_dirty = true;
 	}
 }
 
@@ -1631,6 +1934,7 @@ void SceneTree::_bind_methods() {
 	BIND_ENUM_CONSTANT(GROUP_CALL_REVERSE);
 	BIND_ENUM_CONSTANT(GROUP_CALL_DEFERRED);
 	BIND_ENUM_CONSTANT(GROUP_CALL_UNIQUE);
+	BIND_ENUM_CONSTANT(GROUP_CALL_THREADED);
 }
 
 SceneTree *SceneTree::singleton = nullptr;
@@ -1830,6 +2134,9 @@ SceneTree::SceneTree() {
 
 	root->set_physics_object_picking(GLOBAL_DEF("physics/common/enable_object_picking", true));
 
+	batch_transform_updates = GLOBAL_DEF("application/run/batch_transform_updates", false);
+	process_thread_group_chunk_size = GLOBAL_DEF(PropertyInfo(Variant::INT, "application/run/process_thread_group_chunk_size", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), 0);
+
 	root->connect("close_requested", callable_mp(this, &SceneTree::_main_window_close));
 	root->connect("go_back_requested", callable_mp(this, &SceneTree::_main_window_go_back));
 	root->connect("focus_entered", callable_mp(this, &SceneTree::_main_window_focus_in));
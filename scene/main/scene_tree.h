@@ -34,6 +34,7 @@
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "scene/resources/mesh.h"
 
@@ -82,6 +83,7 @@ class SceneTree : public MainLoop {
 	_THREAD_SAFE_CLASS_
 
 	GDCLASS(SceneTree, MainLoop);
+	friend class TestNode3DInternalsAccessor;
 
 public:
 	typedef void (*IdleCallback)();
@@ -93,11 +95,22 @@ private:
 		CallQueue call_queue;
 		Vector<Node *> nodes;
 		Vector<Node *> physics_nodes;
-		bool node_order_dirty = true;
-		bool physics_node_order_dirty = true;
+		// Nodes are kept sorted up to these counts, the ones after were added since the last sort.
+		uint32_t nodes_sorted = 0;
+		uint32_t physics_nodes_sorted = 0;
 		bool removed = false;
 		Node *owner = nullptr;
 		uint64_t last_pass = 0;
+		uint64_t process_usec = 0; // Time spent processing the group in the last pass.
+	};
+
+	// A sub-thread group is processed in a single task, unless it's split into chunks of its nodes.
+	struct ProcessGroupTask {
+		ProcessGroup *group = nullptr;
+		Node *const *nodes = nullptr;
+		uint32_t node_count = 0;
+		bool last_chunk = false;
+		uint64_t usec = 0;
 	};
 
 	struct ProcessGroupSort {
@@ -108,7 +121,9 @@ private:
 
 	LocalVector<ProcessGroup *> process_groups;
 	bool process_groups_dirty = true;
-	LocalVector<ProcessGroup *> local_process_group_cache; // Used when processing to group what needs to
+	LocalVector<ProcessGroupTask> local_process_group_cache; // Used when processing to group what needs to
+	LocalVector<Vector<Node *>> local_process_group_snapshots; // Nodes of the groups split into chunks.
+	int process_thread_group_chunk_size = 0;
 	uint64_t process_last_pass = 1;
 
 	ProcessGroup default_process_group;
@@ -175,6 +190,15 @@ private:
 
 	_FORCE_INLINE_ void _update_group_order(Group &g);
 
+	struct ThreadedGroupCall {
+		LocalVector<Node *> nodes;
+		LocalVector<MethodBind *> methods; // Resolved per node, nullptr falls back to Object::callp().
+		StringName function;
+		const Variant **args = nullptr;
+		int argcount = 0;
+	};
+	void _call_group_threaded(uint32_t p_index, ThreadedGroupCall *p_call);
+
 	TypedArray<Node> _get_nodes_in_group(const StringName &p_group);
 
 	Node *current_scene = nullptr;
@@ -215,8 +239,12 @@ private:
 	void remove_from_group(const StringName &p_group, Node *p_node);
 	void make_group_changed(const StringName &p_group);
 
+	void _sort_process_group(ProcessGroup *p_group, bool p_physics);
+	void _process_nodes(Node *const *p_nodes, uint32_t p_count, bool p_physics);
 	void _process_group(ProcessGroup *p_group, bool p_physics);
+	void _queue_threaded_process_group(ProcessGroup *p_group, bool p_physics);
 	void _process_groups_thread(uint32_t p_index, bool p_physics);
+	void _send_process_group_times(bool p_physics);
 	void _process(bool p_physics);
 
 	void _remove_process_group(Node *p_node);
@@ -234,6 +262,11 @@ private:
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	bool batch_transform_updates = false;
+	// Advanced whenever batched transform updates flush the change list, so earlier propagations stop counting as queued.
+	SafeNumeric<uint64_t> xform_change_pass{ 1 };
+
+	void _flush_transform_notifications_batched();
 
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
@@ -275,6 +308,7 @@ public:
 		GROUP_CALL_REVERSE = 1,
 		GROUP_CALL_DEFERRED = 2,
 		GROUP_CALL_UNIQUE = 4,
+		GROUP_CALL_THREADED = 8,
 	};
 
 	_FORCE_INLINE_ Window *get_root() const { return root; }
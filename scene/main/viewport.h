@@ -129,6 +129,9 @@ public:
 		RENDER_INFO_OBJECTS_IN_FRAME,
 		RENDER_INFO_PRIMITIVES_IN_FRAME,
 		RENDER_INFO_DRAW_CALLS_IN_FRAME,
+		RENDER_INFO_INSTANCES_TESTED,
+		RENDER_INFO_INSTANCES_SKIPPED,
+		RENDER_INFO_OCCLUSION_RAYS_IN_FRAME,
 		RENDER_INFO_MAX
 	};
 
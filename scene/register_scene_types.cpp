@@ -135,6 +135,7 @@
 #include "scene/main/missing_node.h"
 #include "scene/main/multiplayer_api.h"
 #include "scene/main/resource_preloader.h"
+#include "scene/main/scene_pool.h"
 #include "scene/main/scene_tree.h"
 #include "scene/main/timer.h"
 #include "scene/main/viewport.h"
@@ -347,6 +348,7 @@ void register_scene_types() {
 	GDREGISTER_CLASS(CanvasLayer);
 	GDREGISTER_CLASS(CanvasModulate);
 	GDREGISTER_CLASS(ResourcePreloader);
+	GDREGISTER_CLASS(ScenePool);
 	GDREGISTER_CLASS(Window);
 
 	/* REGISTER GUI */
@@ -1222,6 +1224,7 @@ void unregister_scene_types() {
 	ParticleProcessMaterial::finish_shaders();
 	CanvasItemMaterial::finish_shaders();
 	ColorPicker::finish_shaders();
+	Node::cleanup_duplicate_cache();
 	SceneStringNames::free();
 }
 
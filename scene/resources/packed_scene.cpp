@@ -74,6 +74,74 @@ static Array _sanitize_node_pinned_properties(Node *p_node) {
 	return pinned;
 }
 
+void SceneState::_build_instantiation_plan() const {
+	MutexLock lock(instantiation_plan_mutex);
+	if (instantiation_plan_built.is_set()) {
+		return;
+	}
+
+	instantiation_plan.nodes.clear();
+	instantiation_plan.nodes.resize(nodes.size());
+
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		InstantiationPlan::NodePlan &node_plan = instantiation_plan.nodes[i];
+
+		// Only nodes created by this scene are planned, instances and inherited nodes go through the regular path.
+		if ((i == 0 && base_scene_idx >= 0) || n.instance >= 0 || n.type == TYPE_INSTANTIATED || n.type < 0 || n.type >= names.size()) {
+			continue;
+		}
+
+		StringName class_name;
+		node_plan.create = ClassDB::get_native_creation_func(names[n.type], &class_name);
+		if (!node_plan.create) {
+			continue;
+		}
+
+		node_plan.properties.resize(n.properties.size());
+		for (int j = 0; j < n.properties.size(); j++) {
+			const NodeData::Property &prop = n.properties[j];
+			if ((prop.name & FLAG_PATH_PROPERTY_IS_NODE) || prop.name < 0 || prop.name >= names.size() || prop.value < 0 || prop.value >= variants.size()) {
+				continue;
+			}
+
+			const StringName &prop_name = names[prop.name];
+			const Variant &value = variants[prop.value];
+			// Scripts, resources and arrays need the extra handling done in instantiate().
+			if (prop_name == CoreStringNames::get_singleton()->_script || value.get_type() == Variant::OBJECT || value.get_type() == Variant::ARRAY) {
+				continue;
+			}
+
+			int index = -1;
+			MethodBind *setter = ClassDB::get_property_setter_method(class_name, prop_name, &index);
+			if (!setter) {
+				continue;
+			}
+
+			InstantiationPlan::PropertyPlan &prop_plan = node_plan.properties[j];
+			prop_plan.setter = setter;
+			prop_plan.index = index;
+
+			// Values that already match the argument types can skip the Variant conversions. Setters that
+			// return a value are left out, a validated call expects the return Variant to have its type already.
+			int value_arg = index >= 0 ? 1 : 0;
+			Variant::Type arg_type = setter->get_argument_type(value_arg);
+			prop_plan.validated = !setter->is_vararg() && !setter->has_return() && setter->get_argument_count() == value_arg + 1 && (index < 0 || setter->get_argument_type(0) == Variant::INT) && (arg_type == Variant::NIL || arg_type == value.get_type());
+		}
+	}
+
+	instantiation_plan_built.set();
+}
+
+void SceneState::_clear_instantiation_plan() {
+	if (!instantiation_plan_built.is_set()) {
+		return;
+	}
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan_built.clear();
+	instantiation_plan.nodes.clear();
+}
+
 Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	// Nodes where instantiation failed (because something is missing.)
 	List<Node *> stray_instances;
@@ -109,6 +177,14 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
 
+	const InstantiationPlan::NodePlan *plan_nodes = nullptr;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) {
+		if (!instantiation_plan_built.is_set()) {
+			_build_instantiation_plan();
+		}
+		plan_nodes = instantiation_plan.nodes.ptr();
+	}
+
 	bool gen_node_path_cache = p_edit_state != GEN_EDIT_STATE_DISABLED && node_path_cache.is_empty();
 
 	HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_scene;
@@ -140,6 +216,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 		Node *node = nullptr;
 		MissingNode *missing_node = nullptr;
+		const InstantiationPlan::NodePlan *node_plan = nullptr;
 
 		if (i == 0 && base_scene_idx >= 0) {
 			//scene inheritance on root node
@@ -185,11 +262,18 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			}
 		} else {
 			//node belongs to this scene and must be created
-			Object *obj = ClassDB::instantiate(snames[n.type]);
+			Object *obj = nullptr;
+			if (plan_nodes && plan_nodes[i].create) {
+				node_plan = &plan_nodes[i];
+				obj = node_plan->create();
+			} else {
+				obj = ClassDB::instantiate(snames[n.type]);
+			}
 
 			node = Object::cast_to<Node>(obj);
 
 			if (!node) {
+				node_plan = nullptr;
 				if (obj) {
 					memdelete(obj);
 					obj = nullptr;
@@ -254,6 +338,25 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 					ERR_FAIL_INDEX_V(nprops[j].name, sname_count, nullptr);
 
+					if (node_plan && node_plan->properties[j].setter && !node->get_script_instance()) {
+						// Same as what Object::set() ends up doing for a native property, minus the lookups.
+						const InstantiationPlan::PropertyPlan &prop_plan = node_plan->properties[j];
+						const Variant &value = props[nprops[j].value];
+						Variant index = prop_plan.index;
+						const Variant *args[2] = { &index, &value };
+						const Variant **argptrs = prop_plan.index >= 0 ? args : args + 1;
+						int argcount = prop_plan.index >= 0 ? 2 : 1;
+
+						if (prop_plan.validated) {
+							Variant ret;
+							prop_plan.setter->validated_call(node, argptrs, &ret);
+						} else {
+							Callable::CallError ce;
+							prop_plan.setter->call(node, argptrs, argcount, ce);
+						}
+						continue;
+					}
+
 					if (snames[nprops[j].name] == CoreStringNames::get_singleton()->_script) {
 						//work around to avoid old script variables from disappearing, should be the proper fix to:
 						//https://github.com/godotengine/godot/issues/2958
@@ -423,7 +526,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			if (p_edit_state == GEN_EDIT_STATE_MAIN) {
 				_sanitize_node_pinned_properties(node);
 			} else {
-				node->remove_meta("_edit_pinned_properties_");
+				node->remove_meta(SNAME("_edit_pinned_properties_"));
 			}
 		}
 
@@ -1076,6 +1179,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1291,6 +1395,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_clear_instantiation_plan();
+
 	const int node_count = p_dictionary["node_count"];
 	const Vector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -1753,6 +1859,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.instance = p_instance;
 	nd.index = p_index;
 
+	_clear_instantiation_plan();
 	nodes.push_back(nd);
 
 	return nodes.size() - 1;
@@ -1769,6 +1876,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 		prop.name |= FLAG_PATH_PROPERTY_IS_NODE;
 	}
 	prop.value = p_value;
+	_clear_instantiation_plan();
 	nodes.write[p_node].properties.push_back(prop);
 }
 
@@ -1780,6 +1888,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_clear_instantiation_plan();
 	base_scene_idx = p_idx;
 }
 
@@ -89,6 +89,30 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Lookups resolved the first time the scene is instantiated at runtime, so that
+	// repeated instantiations can construct nodes and set properties directly.
+	struct InstantiationPlan {
+		struct PropertyPlan {
+			MethodBind *setter = nullptr;
+			int index = -1;
+			bool validated = false;
+		};
+
+		struct NodePlan {
+			ClassDB::CreationFunc create = nullptr;
+			LocalVector<PropertyPlan> properties;
+		};
+
+		LocalVector<NodePlan> nodes;
+	};
+
+	mutable InstantiationPlan instantiation_plan;
+	mutable SafeFlag instantiation_plan_built;
+	mutable Mutex instantiation_plan_mutex;
+
+	void _build_instantiation_plan() const;
+	void _clear_instantiation_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
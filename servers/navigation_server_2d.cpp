@@ -467,6 +467,18 @@ void NavigationServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("obstacle_set_vertices", "obstacle", "vertices"), &NavigationServer2D::obstacle_set_vertices);
 	ClassDB::bind_method(D_METHOD("obstacle_set_avoidance_layers", "obstacle", "layers"), &NavigationServer2D::obstacle_set_avoidance_layers);
 
+	ClassDB::bind_method(D_METHOD("flow_field_create"), &NavigationServer2D::flow_field_create);
+	ClassDB::bind_method(D_METHOD("flow_field_set_map", "flow_field", "map"), &NavigationServer2D::flow_field_set_map);
+	ClassDB::bind_method(D_METHOD("flow_field_get_map", "flow_field"), &NavigationServer2D::flow_field_get_map);
+	ClassDB::bind_method(D_METHOD("flow_field_set_target_position", "flow_field", "position"), &NavigationServer2D::flow_field_set_target_position);
+	ClassDB::bind_method(D_METHOD("flow_field_get_target_position", "flow_field"), &NavigationServer2D::flow_field_get_target_position);
+	ClassDB::bind_method(D_METHOD("flow_field_set_cell_size", "flow_field", "cell_size"), &NavigationServer2D::flow_field_set_cell_size);
+	ClassDB::bind_method(D_METHOD("flow_field_get_cell_size", "flow_field"), &NavigationServer2D::flow_field_get_cell_size);
+	ClassDB::bind_method(D_METHOD("flow_field_set_navigation_layers", "flow_field", "navigation_layers"), &NavigationServer2D::flow_field_set_navigation_layers);
+	ClassDB::bind_method(D_METHOD("flow_field_get_navigation_layers", "flow_field"), &NavigationServer2D::flow_field_get_navigation_layers);
+	ClassDB::bind_method(D_METHOD("flow_field_get_direction", "flow_field", "position"), &NavigationServer2D::flow_field_get_direction);
+	ClassDB::bind_method(D_METHOD("flow_field_get_distance", "flow_field", "position"), &NavigationServer2D::flow_field_get_distance);
+
 	ClassDB::bind_method(D_METHOD("free_rid", "rid"), &NavigationServer2D::free);
 
 	ClassDB::bind_method(D_METHOD("set_debug_enabled", "enabled"), &NavigationServer2D::set_debug_enabled);
@@ -635,6 +647,18 @@ void NavigationServer2D::obstacle_set_vertices(RID p_obstacle, const Vector<Vect
 	NavigationServer3D::get_singleton()->obstacle_set_vertices(p_obstacle, vector_v2_to_v3(p_vertices));
 }
 
+RID FORWARD_0(flow_field_create);
+void FORWARD_2(flow_field_set_map, RID, p_flow_field, RID, p_map, rid_to_rid, rid_to_rid);
+RID FORWARD_1_C(flow_field_get_map, RID, p_flow_field, rid_to_rid);
+void FORWARD_2(flow_field_set_target_position, RID, p_flow_field, Vector2, p_position, rid_to_rid, v2_to_v3);
+Vector2 FORWARD_1_R_C(v3_to_v2, flow_field_get_target_position, RID, p_flow_field, rid_to_rid);
+void FORWARD_2(flow_field_set_cell_size, RID, p_flow_field, real_t, p_cell_size, rid_to_rid, real_to_real);
+real_t FORWARD_1_C(flow_field_get_cell_size, RID, p_flow_field, rid_to_rid);
+void FORWARD_2(flow_field_set_navigation_layers, RID, p_flow_field, uint32_t, p_navigation_layers, rid_to_rid, uint32_to_uint32);
+uint32_t FORWARD_1_C(flow_field_get_navigation_layers, RID, p_flow_field, rid_to_rid);
+Vector2 FORWARD_2_R_C(v3_to_v2, flow_field_get_direction, RID, p_flow_field, const Vector2 &, p_position, rid_to_rid, v2_to_v3);
+real_t FORWARD_2_C(flow_field_get_distance, RID, p_flow_field, const Vector2 &, p_position, rid_to_rid, v2_to_v3);
+
 void NavigationServer2D::query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result) const {
 	ERR_FAIL_COND(!p_query_parameters.is_valid());
 	ERR_FAIL_COND(!p_query_result.is_valid());
@@ -262,6 +262,19 @@ public:
 	virtual void obstacle_set_vertices(RID p_obstacle, const Vector<Vector2> &p_vertices);
 	virtual void obstacle_set_avoidance_layers(RID p_obstacle, uint32_t p_layers);
 
+	/// Creates a flow field that many agents can share to move towards the same target.
+	virtual RID flow_field_create();
+	virtual void flow_field_set_map(RID p_flow_field, RID p_map);
+	virtual RID flow_field_get_map(RID p_flow_field) const;
+	virtual void flow_field_set_target_position(RID p_flow_field, Vector2 p_position);
+	virtual Vector2 flow_field_get_target_position(RID p_flow_field) const;
+	virtual void flow_field_set_cell_size(RID p_flow_field, real_t p_cell_size);
+	virtual real_t flow_field_get_cell_size(RID p_flow_field) const;
+	virtual void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers);
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const;
+	virtual Vector2 flow_field_get_direction(RID p_flow_field, const Vector2 &p_position) const;
+	virtual real_t flow_field_get_distance(RID p_flow_field, const Vector2 &p_position) const;
+
 	/// Returns a customized navigation path using a query parameters object
 	virtual void query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result) const;
 
@@ -290,6 +290,20 @@ public:
 	virtual void obstacle_set_vertices(RID p_obstacle, const Vector<Vector3> &p_vertices) = 0;
 	virtual void obstacle_set_avoidance_layers(RID p_obstacle, uint32_t p_layers) = 0;
 
+	/// Creates a flow field leading towards a single target on the XZ plane of a map.
+	/// Not exposed to scripts, used by NavigationServer2D.
+	virtual RID flow_field_create() = 0;
+	virtual void flow_field_set_map(RID p_flow_field, RID p_map) = 0;
+	virtual RID flow_field_get_map(RID p_flow_field) const = 0;
+	virtual void flow_field_set_target_position(RID p_flow_field, Vector3 p_position) = 0;
+	virtual Vector3 flow_field_get_target_position(RID p_flow_field) const = 0;
+	virtual void flow_field_set_cell_size(RID p_flow_field, real_t p_cell_size) = 0;
+	virtual real_t flow_field_get_cell_size(RID p_flow_field) const = 0;
+	virtual void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) = 0;
+	virtual uint32_t flow_field_get_navigation_layers(RID p_flow_field) const = 0;
+	virtual Vector3 flow_field_get_direction(RID p_flow_field, const Vector3 &p_position) const = 0;
+	virtual real_t flow_field_get_distance(RID p_flow_field, const Vector3 &p_position) const = 0;
+
 	/// Destroy the `RID`
 	virtual void free(RID p_object) = 0;
 
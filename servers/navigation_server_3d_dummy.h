@@ -145,6 +145,17 @@ public:
 	void obstacle_set_position(RID p_obstacle, Vector3 p_position) override {}
 	void obstacle_set_vertices(RID p_obstacle, const Vector<Vector3> &p_vertices) override {}
 	void obstacle_set_avoidance_layers(RID p_obstacle, uint32_t p_layers) override {}
+	RID flow_field_create() override { return RID(); }
+	void flow_field_set_map(RID p_flow_field, RID p_map) override {}
+	RID flow_field_get_map(RID p_flow_field) const override { return RID(); }
+	void flow_field_set_target_position(RID p_flow_field, Vector3 p_position) override {}
+	Vector3 flow_field_get_target_position(RID p_flow_field) const override { return Vector3(); }
+	void flow_field_set_cell_size(RID p_flow_field, real_t p_cell_size) override {}
+	real_t flow_field_get_cell_size(RID p_flow_field) const override { return 0; }
+	void flow_field_set_navigation_layers(RID p_flow_field, uint32_t p_navigation_layers) override {}
+	uint32_t flow_field_get_navigation_layers(RID p_flow_field) const override { return 0; }
+	Vector3 flow_field_get_direction(RID p_flow_field, const Vector3 &p_position) const override { return Vector3(); }
+	real_t flow_field_get_distance(RID p_flow_field, const Vector3 &p_position) const override { return -1.0; }
 	void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) override {}
 	void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) override {}
 	void free(RID p_object) override {}
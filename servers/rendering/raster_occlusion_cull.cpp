@@ -0,0 +1,628 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	tile_grid_size = Size2i();
+	tile_count = 0;
+	triangle_count = 0;
+	drawn = false;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	if (is_empty()) {
+		return;
+	}
+
+	tile_grid_size.x = Math::ceil(p_size.x / (float)TILE_SIZE);
+	tile_grid_size.y = Math::ceil(p_size.y / (float)TILE_SIZE);
+	tile_count = tile_grid_size.x * tile_grid_size.y;
+	drawn = false;
+}
+
+uint32_t RasterOcclusionCull::RasterHZBuffer::_find_mesh(const LocalVector<uint32_t> &p_offsets, uint32_t p_index) const {
+	// Last mesh starting at or before the index, skipping empty ones.
+	uint32_t low = 0;
+	uint32_t high = p_offsets.size() - 1;
+	while (high - low > 1) {
+		uint32_t middle = (low + high) / 2;
+		if (p_offsets[middle] <= p_index) {
+			low = middle;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_transform_vertices_threaded(uint32_t p_task, const RasterThreadData *p_data) {
+	uint32_t total = vertex_offsets[p_data->mesh_count];
+	uint32_t from = p_task * total / p_data->task_count;
+	uint32_t to = (p_task + 1) * total / p_data->task_count;
+
+	if (from >= to) {
+		return;
+	}
+
+	uint32_t i = from;
+	for (uint32_t m = _find_mesh(vertex_offsets, from); i < to; m++) {
+		const Mesh &mesh = p_data->meshes[m];
+		Transform3D view_xform = p_data->cam_inv_transform * mesh.xform;
+		Projection clip_xform = p_data->cam_projection * Projection(view_xform);
+		uint32_t end = MIN(to, vertex_offsets[m + 1]);
+
+		for (; i < end; i++) {
+			const Vector3 &vertex = mesh.vertices[i - vertex_offsets[m]];
+			Plane clip = clip_xform.xform4(Plane(vertex, 1.0));
+
+			ClipVertex &cv = clip_vertices[i];
+			cv.x = clip.normal.x;
+			cv.y = clip.normal.y;
+			cv.z = clip.normal.z;
+			cv.w = clip.d;
+			cv.depth = -view_xform.xform(vertex).z;
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_triangles_threaded(uint32_t p_task, const RasterThreadData *p_data) {
+	task_triangles[p_task].clear();
+	for (uint32_t i = 0; i < tile_count; i++) {
+		task_bins[p_task * tile_count + i].clear();
+	}
+
+	uint32_t total = triangle_offsets[p_data->mesh_count];
+	uint32_t from = p_task * total / p_data->task_count;
+	uint32_t to = (p_task + 1) * total / p_data->task_count;
+
+	if (from >= to) {
+		return;
+	}
+
+	uint32_t i = from;
+	for (uint32_t m = _find_mesh(triangle_offsets, from); i < to; m++) {
+		const Mesh &mesh = p_data->meshes[m];
+		const ClipVertex *vertices = clip_vertices.ptr() + vertex_offsets[m];
+		uint32_t end = MIN(to, triangle_offsets[m + 1]);
+
+		for (; i < end; i++) {
+			const int32_t *indices = &mesh.indices[(i - triangle_offsets[m]) * 3];
+			if ((uint32_t)indices[0] >= mesh.vertex_count || (uint32_t)indices[1] >= mesh.vertex_count || (uint32_t)indices[2] >= mesh.vertex_count) {
+				continue;
+			}
+			_clip_triangle(vertices[indices[0]], vertices[indices[1]], vertices[indices[2]], p_data->cam_orthogonal, p_task);
+		}
+	}
+}
+
+static _FORCE_INLINE_ float _clip_plane_distance(float p_x, float p_y, float p_z, float p_w, int p_plane, float p_guard_band) {
+	switch (p_plane) {
+		case 0:
+			return p_z + p_w; // Near.
+		case 1:
+			return p_guard_band * p_w - p_x;
+		case 2:
+			return p_guard_band * p_w + p_x;
+		case 3:
+			return p_guard_band * p_w - p_y;
+		default:
+			return p_guard_band * p_w + p_y;
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_clip_triangle(const ClipVertex &p_v0, const ClipVertex &p_v1, const ClipVertex &p_v2, bool p_orthogonal, uint32_t p_task) {
+	// Clip against the near plane, and against a guard band around the screen so the
+	// edge functions stay in a range floats can represent exactly enough.
+	const int plane_count = 5;
+	const ClipVertex *triangle[3] = { &p_v0, &p_v1, &p_v2 };
+	uint32_t outcodes[3] = { 0, 0, 0 };
+
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < plane_count; j++) {
+			if (_clip_plane_distance(triangle[i]->x, triangle[i]->y, triangle[i]->z, triangle[i]->w, j, GUARD_BAND) < 0.0f) {
+				outcodes[i] |= 1 << j;
+			}
+		}
+	}
+
+	if (outcodes[0] & outcodes[1] & outcodes[2]) {
+		return; // All vertices are outside the same plane.
+	}
+
+	uint32_t clipped_planes = outcodes[0] | outcodes[1] | outcodes[2];
+	if (clipped_planes == 0) {
+		_setup_triangle(p_v0, p_v1, p_v2, p_orthogonal, p_task);
+		return;
+	}
+
+	// Each plane adds at most one vertex.
+	ClipVertex polygons[2][3 + plane_count];
+	int count = 3;
+	int current = 0;
+	for (int i = 0; i < 3; i++) {
+		polygons[0][i] = *triangle[i];
+	}
+
+	for (int j = 0; j < plane_count; j++) {
+		if (!(clipped_planes & (1 << j))) {
+			continue;
+		}
+
+		const ClipVertex *input = polygons[current];
+		ClipVertex *output = polygons[1 - current];
+		int output_count = 0;
+
+		for (int i = 0; i < count; i++) {
+			const ClipVertex &a = input[i];
+			const ClipVertex &b = input[(i + 1) % count];
+			float distance_a = _clip_plane_distance(a.x, a.y, a.z, a.w, j, GUARD_BAND);
+			float distance_b = _clip_plane_distance(b.x, b.y, b.z, b.w, j, GUARD_BAND);
+
+			if (distance_a >= 0.0f) {
+				output[output_count++] = a;
+			}
+			if ((distance_a >= 0.0f) != (distance_b >= 0.0f)) {
+				float t = distance_a / (distance_a - distance_b);
+				ClipVertex &v = output[output_count++];
+				v.x = Math::lerp(a.x, b.x, t);
+				v.y = Math::lerp(a.y, b.y, t);
+				v.z = Math::lerp(a.z, b.z, t);
+				v.w = Math::lerp(a.w, b.w, t);
+				v.depth = Math::lerp(a.depth, b.depth, t);
+			}
+		}
+
+		count = output_count;
+		current = 1 - current;
+		if (count < 3) {
+			return;
+		}
+	}
+
+	for (int i = 1; i < count - 1; i++) {
+		_setup_triangle(polygons[current][0], polygons[current][i], polygons[current][i + 1], p_orthogonal, p_task);
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_setup_triangle(const ClipVertex &p_v0, const ClipVertex &p_v1, const ClipVertex &p_v2, bool p_orthogonal, uint32_t p_task) {
+	const Size2i &buffer_size = sizes[0];
+	const ClipVertex *vertices[3] = { &p_v0, &p_v1, &p_v2 };
+	float x[3];
+	float y[3];
+	float q[3];
+	float min_depth = FLT_MAX;
+
+	for (int i = 0; i < 3; i++) {
+		float inv_w = 1.0f / vertices[i]->w;
+		x[i] = (vertices[i]->x * inv_w * 0.5f + 0.5f) * buffer_size.x;
+		y[i] = (vertices[i]->y * inv_w * 0.5f + 0.5f) * buffer_size.y;
+		// Inverse depth is linear in screen space with a perspective projection, depth itself with an orthogonal one.
+		q[i] = p_orthogonal ? vertices[i]->depth : 1.0f / vertices[i]->depth;
+		min_depth = MIN(min_depth, vertices[i]->depth);
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (Math::abs(area) < CMP_EPSILON) {
+		return;
+	}
+	if (area < 0.0f) {
+		// Occluders are visible from both sides, flip the winding instead of culling.
+		SWAP(x[1], x[2]);
+		SWAP(y[1], y[2]);
+		SWAP(q[1], q[2]);
+		area = -area;
+	}
+
+	Triangle triangle;
+	triangle.min_x = MAX(0, (int)Math::ceil(MIN(x[0], MIN(x[1], x[2])) - 0.5f));
+	triangle.min_y = MAX(0, (int)Math::ceil(MIN(y[0], MIN(y[1], y[2])) - 0.5f));
+	triangle.max_x = MIN(buffer_size.x - 1, (int)Math::floor(MAX(x[0], MAX(x[1], x[2])) - 0.5f));
+	triangle.max_y = MIN(buffer_size.y - 1, (int)Math::floor(MAX(y[0], MAX(y[1], y[2])) - 0.5f));
+
+	if (triangle.min_x > triangle.max_x || triangle.min_y > triangle.max_y) {
+		return; // Doesn't cover any pixel center.
+	}
+
+	for (int i = 0; i < 3; i++) {
+		int j = (i + 1) % 3;
+		triangle.edge_a[i] = y[i] - y[j];
+		triangle.edge_b[i] = x[j] - x[i];
+		triangle.edge_c[i] = x[i] * y[j] - x[j] * y[i];
+	}
+
+	float inv_area = 1.0f / area;
+	triangle.depth_a = ((q[1] - q[0]) * (y[2] - y[0]) - (q[2] - q[0]) * (y[1] - y[0])) * inv_area;
+	triangle.depth_b = ((q[2] - q[0]) * (x[1] - x[0]) - (q[1] - q[0]) * (x[2] - x[0])) * inv_area;
+	triangle.depth_c = q[0] - triangle.depth_a * x[0] - triangle.depth_b * y[0];
+	triangle.min_depth = min_depth;
+
+	LocalVector<Triangle> &triangles = task_triangles[p_task];
+	uint32_t index = triangles.size();
+	triangles.push_back(triangle);
+
+	LocalVector<uint32_t> *bins = &task_bins[p_task * tile_count];
+	for (int tile_y = triangle.min_y / TILE_SIZE; tile_y <= triangle.max_y / TILE_SIZE; tile_y++) {
+		for (int tile_x = triangle.min_x / TILE_SIZE; tile_x <= triangle.max_x / TILE_SIZE; tile_x++) {
+			bins[tile_y * tile_grid_size.x + tile_x].push_back(index);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tile_threaded(uint32_t p_tile, const RasterThreadData *p_data) {
+	const Size2i &buffer_size = sizes[0];
+	const bool orthogonal = p_data->cam_orthogonal;
+	float *depth = mips[0];
+
+	int tile_min_x = (p_tile % tile_grid_size.x) * TILE_SIZE;
+	int tile_min_y = (p_tile / tile_grid_size.x) * TILE_SIZE;
+	int tile_max_x = MIN(tile_min_x + TILE_SIZE, buffer_size.x) - 1;
+	int tile_max_y = MIN(tile_min_y + TILE_SIZE, buffer_size.y) - 1;
+
+	// With a perspective projection, the tile holds inverse depth while it's drawn, as it's linear in screen space.
+	// Closer is larger and empty is 0, so spans compare the interpolated value directly and only the resolve divides.
+	const float clear_value = orthogonal ? FLT_MAX : 0.0f;
+	for (int y = tile_min_y; y <= tile_max_y; y++) {
+		for (int x = tile_min_x; x <= tile_max_x; x++) {
+			depth[y * buffer_size.x + x] = clear_value;
+		}
+	}
+
+	// Conservative farthest depth in the tile, triangles behind it can't change anything.
+	// It's only refreshed every few triangles, as it costs about as much as drawing one.
+	float tile_max_depth = FLT_MAX;
+	uint32_t drawn_since_refresh = 0;
+
+	for (uint32_t task = 0; task < p_data->task_count; task++) {
+		const LocalVector<uint32_t> &bin = task_bins[task * tile_count + p_tile];
+		const Triangle *triangles = task_triangles[task].ptr();
+
+		for (const uint32_t &index : bin) {
+			const Triangle &triangle = triangles[index];
+			if (triangle.min_depth >= tile_max_depth) {
+				continue;
+			}
+
+			int min_x = MAX(triangle.min_x, tile_min_x);
+			int max_x = MIN(triangle.max_x, tile_max_x);
+			int min_y = MAX(triangle.min_y, tile_min_y);
+			int max_y = MIN(triangle.max_y, tile_max_y);
+
+			for (int y = min_y; y <= max_y; y++) {
+				float py = y + 0.5f;
+				float row_edge0 = triangle.edge_b[0] * py + triangle.edge_c[0];
+				float row_edge1 = triangle.edge_b[1] * py + triangle.edge_c[1];
+				float row_edge2 = triangle.edge_b[2] * py + triangle.edge_c[2];
+				float row_depth = triangle.depth_b * py + triangle.depth_c;
+				float *row = &depth[y * buffer_size.x];
+
+				// Branchless, so the spans are vectorized.
+				if (orthogonal) {
+					for (int x = min_x; x <= max_x; x++) {
+						float px = x + 0.5f;
+						float edge0 = triangle.edge_a[0] * px + row_edge0;
+						float edge1 = triangle.edge_a[1] * px + row_edge1;
+						float edge2 = triangle.edge_a[2] * px + row_edge2;
+						float d = triangle.depth_a * px + row_depth;
+						bool write = (edge0 >= 0.0f) & (edge1 >= 0.0f) & (edge2 >= 0.0f) & (d > 0.0f) & (d < row[x]);
+						row[x] = write ? d : row[x];
+					}
+				} else {
+					for (int x = min_x; x <= max_x; x++) {
+						float px = x + 0.5f;
+						float edge0 = triangle.edge_a[0] * px + row_edge0;
+						float edge1 = triangle.edge_a[1] * px + row_edge1;
+						float edge2 = triangle.edge_a[2] * px + row_edge2;
+						float q = triangle.depth_a * px + row_depth;
+						bool write = (edge0 >= 0.0f) & (edge1 >= 0.0f) & (edge2 >= 0.0f) & (q > row[x]);
+						row[x] = write ? q : row[x];
+					}
+				}
+			}
+
+			drawn_since_refresh++;
+			if (drawn_since_refresh == TILE_MAX_DEPTH_INTERVAL) {
+				drawn_since_refresh = 0;
+				if (orthogonal) {
+					tile_max_depth = 0.0f;
+					for (int y = tile_min_y; y <= tile_max_y; y++) {
+						for (int x = tile_min_x; x <= tile_max_x; x++) {
+							tile_max_depth = MAX(tile_max_depth, depth[y * buffer_size.x + x]);
+						}
+					}
+				} else {
+					float tile_min_q = FLT_MAX;
+					for (int y = tile_min_y; y <= tile_max_y; y++) {
+						for (int x = tile_min_x; x <= tile_max_x; x++) {
+							tile_min_q = MIN(tile_min_q, depth[y * buffer_size.x + x]);
+						}
+					}
+					tile_max_depth = tile_min_q > 0.0f ? 1.0f / tile_min_q : FLT_MAX;
+				}
+			}
+		}
+	}
+
+	if (!orthogonal) {
+		for (int y = tile_min_y; y <= tile_max_y; y++) {
+			float *row = &depth[y * buffer_size.x];
+			for (int x = tile_min_x; x <= tile_max_x; x++) {
+				row[x] = row[x] > 0.0f ? 1.0f / row[x] : FLT_MAX;
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const Mesh *p_meshes, uint32_t p_mesh_count, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	ERR_FAIL_COND(is_empty());
+
+	RasterThreadData td;
+	td.meshes = p_meshes;
+	td.mesh_count = p_mesh_count;
+	td.task_count = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
+	td.cam_projection = p_cam_projection;
+	td.cam_inv_transform = p_cam_transform.affine_inverse();
+	td.cam_orthogonal = p_cam_orthogonal;
+
+	vertex_offsets.resize(p_mesh_count + 1);
+	triangle_offsets.resize(p_mesh_count + 1);
+	vertex_offsets[0] = 0;
+	triangle_offsets[0] = 0;
+	for (uint32_t i = 0; i < p_mesh_count; i++) {
+		vertex_offsets[i + 1] = vertex_offsets[i] + p_meshes[i].vertex_count;
+		triangle_offsets[i + 1] = triangle_offsets[i] + p_meshes[i].index_count / 3;
+	}
+
+	clip_vertices.resize(vertex_offsets[p_mesh_count]);
+	task_triangles.resize(td.task_count);
+	task_bins.resize(td.task_count * tile_count);
+
+	// Triangles are set up and binned in submission order, and every tile walks the bins in task order,
+	// so drawing meshes front to back lets tiles skip what is hidden behind them.
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_transform_vertices_threaded, &td, td.task_count, -1, true, SNAME("RasterOcclusionCullTransform"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_setup_triangles_threaded, &td, td.task_count, -1, true, SNAME("RasterOcclusionCullSetup"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_tile_threaded, &td, tile_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	triangle_count = 0;
+	for (const LocalVector<Triangle> &triangles : task_triangles) {
+		triangle_count += triangles.size();
+	}
+
+	debug_tex_range = p_cam_projection.get_z_far();
+	update_mips();
+}
+
+float RasterOcclusionCull::RasterHZBuffer::get_depth(int p_x, int p_y) const {
+	ERR_FAIL_COND_V(is_empty(), FLT_MAX);
+	ERR_FAIL_INDEX_V(p_x, sizes[0].x, FLT_MAX);
+	ERR_FAIL_INDEX_V(p_y, sizes[0].y, FLT_MAX);
+	return mips[0][p_y * sizes[0].x + p_x];
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	occluder->aabb = AABB();
+	for (int i = 0; i < p_vertices.size(); i++) {
+		if (i == 0) {
+			occluder->aabb.position = p_vertices[i];
+		} else {
+			occluder->aabb.expand_to(p_vertices[i]);
+		}
+	}
+
+	// Occluders don't track which scenarios use them, so redraw everything.
+	for (KeyValue<RID, Scenario> &E : scenarios) {
+		E.value.version++;
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+
+	for (KeyValue<RID, Scenario> &E : scenarios) {
+		E.value.version++;
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	if (!scenarios.has(p_scenario)) {
+		scenarios[p_scenario] = Scenario();
+	}
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+	if (instance.occluder != p_occluder || instance.xform != p_xform || instance.enabled != p_enabled) {
+		instance.occluder = p_occluder;
+		instance.xform = p_xform;
+		instance.enabled = p_enabled;
+		scenario.version++;
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.erase(p_instance)) {
+		scenario.version++;
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+	buffers[p_buffer].drawn = false;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	const Scenario &scenario = scenarios[buffer.scenario_rid];
+
+	if (buffer.drawn && buffer.drawn_scenario_version == scenario.version && buffer.drawn_cam_orthogonal == p_cam_orthogonal && buffer.drawn_cam_transform == p_cam_transform && buffer.drawn_cam_projection == p_cam_projection) {
+		return; // Nothing changed since it was last drawn.
+	}
+
+	Vector<Plane> frustum_planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	Vector3 frustum_points[8];
+	p_cam_projection.get_endpoints(p_cam_transform, frustum_points);
+
+	visible_meshes.clear();
+	mesh_order.clear();
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario.instances) {
+		const OccluderInstance &instance = E.value;
+		const Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+
+		if (!instance.enabled || !occluder || occluder->indices.size() < 3) {
+			continue;
+		}
+
+		AABB aabb = instance.xform.xform(occluder->aabb);
+		if (!aabb.intersects_convex_shape(frustum_planes.ptr(), frustum_planes.size(), frustum_points, 8)) {
+			continue;
+		}
+
+		Mesh mesh;
+		mesh.vertices = occluder->vertices.ptr();
+		mesh.vertex_count = occluder->vertices.size();
+		mesh.indices = occluder->indices.ptr();
+		mesh.index_count = occluder->indices.size();
+		mesh.xform = instance.xform;
+
+		MeshSort sort;
+		sort.distance = p_cam_transform.origin.clamp(aabb.position, aabb.position + aabb.size).distance_squared_to(p_cam_transform.origin);
+		sort.index = visible_meshes.size();
+
+		visible_meshes.push_back(mesh);
+		mesh_order.push_back(sort);
+	}
+
+	mesh_order.sort();
+	meshes.resize(visible_meshes.size());
+	for (uint32_t i = 0; i < mesh_order.size(); i++) {
+		meshes[i] = visible_meshes[mesh_order[i].index];
+	}
+
+	buffer.rasterize(meshes.ptr(), meshes.size(), p_cam_transform, p_cam_projection, p_cam_orthogonal);
+
+	buffer.drawn_cam_transform = p_cam_transform;
+	buffer.drawn_cam_projection = p_cam_projection;
+	buffer.drawn_cam_orthogonal = p_cam_orthogonal;
+	buffer.drawn_scenario_version = scenario.version;
+	buffer.drawn = true;
+}
+
+RendererSceneOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/math/projection.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Renders the occluders into the occlusion buffer with a software depth rasterizer.
+// Doesn't depend on Embree, so it is available on every platform.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	struct Mesh {
+		const Vector3 *vertices = nullptr;
+		uint32_t vertex_count = 0;
+		const int32_t *indices = nullptr;
+		uint32_t index_count = 0;
+		Transform3D xform;
+	};
+
+	class RasterHZBuffer : public HZBuffer {
+	public:
+		static const int TILE_SIZE = 16;
+
+	private:
+		static const uint32_t TILE_MAX_DEPTH_INTERVAL = 8;
+		static constexpr float GUARD_BAND = 2.0f;
+
+		struct ClipVertex {
+			float x, y, z, w;
+			float depth;
+		};
+
+		// Edge functions and depth plane of a screen space triangle, all evaluated at pixel centers.
+		// The interpolated depth term is the inverse depth in perspective, and the depth itself in orthogonal.
+		struct Triangle {
+			float edge_a[3];
+			float edge_b[3];
+			float edge_c[3];
+			float depth_a, depth_b, depth_c;
+			float min_depth;
+			int min_x, min_y, max_x, max_y;
+		};
+
+		struct RasterThreadData {
+			const Mesh *meshes = nullptr;
+			uint32_t mesh_count = 0;
+			uint32_t task_count = 0;
+			Projection cam_projection;
+			Transform3D cam_inv_transform;
+			bool cam_orthogonal = false;
+		};
+
+		Size2i tile_grid_size;
+		uint32_t tile_count = 0;
+
+		LocalVector<uint32_t> vertex_offsets;
+		LocalVector<uint32_t> triangle_offsets;
+		LocalVector<ClipVertex> clip_vertices;
+		// Per task, so no synchronization is needed while setting up and binning triangles.
+		LocalVector<LocalVector<Triangle>> task_triangles;
+		LocalVector<LocalVector<uint32_t>> task_bins;
+
+		uint32_t _find_mesh(const LocalVector<uint32_t> &p_offsets, uint32_t p_index) const;
+		void _transform_vertices_threaded(uint32_t p_task, const RasterThreadData *p_data);
+		void _setup_triangles_threaded(uint32_t p_task, const RasterThreadData *p_data);
+		void _clip_triangle(const ClipVertex &p_v0, const ClipVertex &p_v1, const ClipVertex &p_v2, bool p_orthogonal, uint32_t p_task);
+		void _setup_triangle(const ClipVertex &p_v0, const ClipVertex &p_v1, const ClipVertex &p_v2, bool p_orthogonal, uint32_t p_task);
+		void _rasterize_tile_threaded(uint32_t p_tile, const RasterThreadData *p_data);
+
+	public:
+		RID scenario_rid;
+		uint32_t triangle_count = 0;
+
+		// What the buffer was last drawn with, redrawing is skipped if nothing changed.
+		Transform3D drawn_cam_transform;
+		Projection drawn_cam_projection;
+		bool drawn_cam_orthogonal = false;
+		uint64_t drawn_scenario_version = 0;
+		bool drawn = false;
+
+		virtual void clear() override;
+		virtual void resize(const Size2i &p_size) override;
+
+		void rasterize(const Mesh *p_meshes, uint32_t p_mesh_count, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal);
+		float get_depth(int p_x, int p_y) const;
+	};
+
+private:
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		AABB aabb;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		Transform3D xform;
+		bool enabled = true;
+	};
+
+	struct Scenario {
+		HashMap<RID, OccluderInstance> instances;
+		uint64_t version = 0; // Incremented on every change, to skip redrawing unchanged buffers.
+	};
+
+	struct MeshSort {
+		real_t distance;
+		uint32_t index;
+
+		bool operator<(const MeshSort &p_other) const { return distance < p_other.distance; }
+	};
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	LocalVector<Mesh> visible_meshes;
+	LocalVector<MeshSort> mesh_order;
+	LocalVector<Mesh> meshes;
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) override;
+
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
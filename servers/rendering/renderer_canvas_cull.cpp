@@ -31,6 +31,7 @@
 #include "renderer_canvas_cull.h"
 
 #include "core/math/geometry_2d.h"
+#include "core/object/worker_thread_pool.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -39,6 +40,8 @@
 void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask) {
 	RENDER_TIMESTAMP("Cull CanvasItem Tree");
 
+	uint64_t cull_begin_usec = OS::get_singleton()->get_ticks_usec();
+
 	memset(z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 	memset(z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
 
@@ -65,6 +68,8 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 		}
 	}
 
+	cull_usec += OS::get_singleton()->get_ticks_usec() - cull_begin_usec;
+
 	RENDER_TIMESTAMP("Render CanvasItems");
 
 	bool sdf_flag;
@@ -74,38 +79,92 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 	}
 }
 
+void _collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, Transform2D p_transform, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int p_z);
+
+void _collect_ysort_child(RendererCanvasCull::Item *p_child, const Transform2D &p_transform, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int p_z) {
+	int abs_z = 0;
+	if (p_child->visible) {
+		if (r_items) {
+			r_items[r_index] = p_child;
+			p_child->ysort_xform = p_transform;
+			p_child->ysort_pos = p_transform.xform(p_child->xform.columns[2]);
+			p_child->material_owner = p_child->use_parent_material ? p_material_owner : nullptr;
+			p_child->ysort_modulate = p_modulate;
+			p_child->ysort_index = r_index;
+			p_child->ysort_parent_abs_z_index = p_z;
+
+			// Y sorted canvas items are flattened into r_items. Calculate their absolute z index to use when rendering r_items.
+			if (p_child->z_relative) {
+				abs_z = CLAMP(p_z + p_child->z_index, RS::CANVAS_ITEM_Z_MIN, RS::CANVAS_ITEM_Z_MAX);
+			} else {
+				abs_z = p_child->z_index;
+			}
+		}
+
+		r_index++;
+
+		if (p_child->sort_y) {
+			_collect_ysort_children(p_child, p_transform * p_child->xform, p_child->use_parent_material ? p_material_owner : p_child, p_modulate * p_child->modulate, r_items, r_index, abs_z);
+		}
+	}
+}
+
 void _collect_ysort_children(RendererCanvasCull::Item *p_canvas_item, Transform2D p_transform, RendererCanvasCull::Item *p_material_owner, const Color &p_modulate, RendererCanvasCull::Item **r_items, int &r_index, int p_z) {
 	int child_item_count = p_canvas_item->child_items.size();
 	RendererCanvasCull::Item **child_items = p_canvas_item->child_items.ptrw();
 	for (int i = 0; i < child_item_count; i++) {
-		int abs_z = 0;
-		if (child_items[i]->visible) {
-			if (r_items) {
-				r_items[r_index] = child_items[i];
-				child_items[i]->ysort_xform = p_transform;
-				child_items[i]->ysort_pos = p_transform.xform(child_items[i]->xform.columns[2]);
-				child_items[i]->material_owner = child_items[i]->use_parent_material ? p_material_owner : nullptr;
-				child_items[i]->ysort_modulate = p_modulate;
-				child_items[i]->ysort_index = r_index;
-				child_items[i]->ysort_parent_abs_z_index = p_z;
-
-				// Y sorted canvas items are flattened into r_items. Calculate their absolute z index to use when rendering r_items.
-				if (child_items[i]->z_relative) {
-					abs_z = CLAMP(p_z + child_items[i]->z_index, RS::CANVAS_ITEM_Z_MIN, RS::CANVAS_ITEM_Z_MAX);
-				} else {
-					abs_z = child_items[i]->z_index;
-				}
-			}
+		_collect_ysort_child(child_items[i], p_transform, p_material_owner, p_modulate, r_items, r_index, p_z);
+	}
+}
 
-			r_index++;
+// Restores the order of y-sorted items sorted in a previous frame. Items found out of order are set aside
+// along with the item before them, sorted and merged back, which is linear when few items moved.
+void _repair_ysort_order(RendererCanvasCull::Item **p_items, int p_count, LocalVector<RendererCanvasCull::Item *> &r_moved_items) {
+	RendererCanvasCull::ItemPtrSort compare;
+	r_moved_items.clear();
 
-			if (child_items[i]->sort_y) {
-				_collect_ysort_children(child_items[i], p_transform * child_items[i]->xform, child_items[i]->use_parent_material ? p_material_owner : child_items[i], p_modulate * child_items[i]->modulate, r_items, r_index, abs_z);
-			}
+	int kept_count = 0;
+	for (int i = 0; i < p_count; i++) {
+		RendererCanvasCull::Item *item = p_items[i];
+		if (kept_count > 0 && compare(item, p_items[kept_count - 1])) {
+			r_moved_items.push_back(item);
+			r_moved_items.push_back(p_items[--kept_count]);
+		} else {
+			p_items[kept_count++] = item;
+		}
+	}
+
+	if (r_moved_items.is_empty()) {
+		return;
+	}
+
+	SortArray<RendererCanvasCull::Item *, RendererCanvasCull::ItemPtrSort> sorter;
+	sorter.sort(r_moved_items.ptr(), r_moved_items.size());
+
+	// Merge from the back, the kept items are already in place at the front.
+	int kept = kept_count - 1;
+	int moved = r_moved_items.size() - 1;
+	for (int i = p_count - 1; moved >= 0; i--) {
+		if (kept >= 0 && compare(r_moved_items[moved], p_items[kept])) {
+			p_items[i] = p_items[kept--];
+		} else {
+			p_items[i] = r_moved_items[moved--];
 		}
 	}
 }
 
+void RendererCanvasCull::_collect_ysort_children_threaded(uint32_t p_index, YSortCollectData *p_data) {
+	Item *ci = p_data->canvas_item;
+	int child_count = ci->child_items.size();
+	int from = child_count * p_index / p_data->task_count;
+	int to = child_count * (p_index + 1) / p_data->task_count;
+
+	for (int i = from; i < to; i++) {
+		int index = ci->ysort_child_offsets[i];
+		_collect_ysort_child(ci->child_items[i], Transform2D(), p_data->material_owner, Color(1, 1, 1, 1), p_data->items, index, p_data->z);
+	}
+}
+
 void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_Owner<RendererCanvasCull::Item, true> &canvas_item_owner) {
 	do {
 		ysort_owner->ysort_children_count = -1;
@@ -113,6 +172,95 @@ void _mark_ysort_dirty(RendererCanvasCull::Item *ysort_owner, RID_Owner<Renderer
 	} while (ysort_owner && ysort_owner->sort_y);
 }
 
+void RendererCanvasCull::_create_cull_index(Item *p_canvas_item) {
+	p_canvas_item->cull_index = memnew(Item::CullIndex);
+
+	for (int i = 0; i < p_canvas_item->child_items.size(); i++) {
+		Item *child = p_canvas_item->child_items[i];
+		child->parent_cull_index = p_canvas_item->cull_index;
+		child->mark_cull_index_dirty();
+	}
+}
+
+void RendererCanvasCull::_free_cull_index(Item *p_canvas_item) {
+	for (int i = 0; i < p_canvas_item->child_items.size(); i++) {
+		Item *child = p_canvas_item->child_items[i];
+		child->parent_cull_index = nullptr;
+		child->cull_index_id = DynamicBVH::ID();
+		child->cull_index_dirty = false;
+		child->cull_index_unindexed = false;
+	}
+
+	memdelete(p_canvas_item->cull_index);
+	p_canvas_item->cull_index = nullptr;
+}
+
+void RendererCanvasCull::_update_cull_index(Item *p_canvas_item) {
+	Item::CullIndex *cull_index = p_canvas_item->cull_index;
+
+	for (Item *child : cull_index->dirty_items) {
+		child->cull_index_dirty = false;
+
+		// Only leaves whose rect is known ahead of time can be indexed, anything else is culled as usual.
+		bool indexable = child->child_items.is_empty() && !child->skeleton.is_valid() && !child->update_when_visible && !child->vp_render && !child->copy_back_buffer && !child->visibility_notifier && !child->canvas_group;
+
+		if (indexable) {
+			// Grow by a pixel, as snapping may move the item by up to that much.
+			Rect2 rect = child->xform.xform(child->get_rect()).grow(1);
+			AABB aabb(Vector3(rect.position.x, rect.position.y, 0), Vector3(rect.size.x, rect.size.y, 0));
+
+			if (child->cull_index_id.is_valid()) {
+				cull_index->bvh.update(child->cull_index_id, aabb);
+			} else {
+				child->cull_index_id = cull_index->bvh.insert(aabb, child);
+			}
+
+			if (child->cull_index_unindexed) {
+				int64_t idx = cull_index->unindexed_items.find(child);
+				cull_index->unindexed_items.remove_at_unordered(idx);
+				child->cull_index_unindexed = false;
+			}
+		} else {
+			if (child->cull_index_id.is_valid()) {
+				cull_index->bvh.remove(child->cull_index_id);
+				child->cull_index_id = DynamicBVH::ID();
+			}
+
+			if (!child->cull_index_unindexed) {
+				cull_index->unindexed_items.push_back(child);
+				child->cull_index_unindexed = true;
+			}
+		}
+	}
+
+	cull_index->dirty_items.clear();
+}
+
+void RendererCanvasCull::_remove_from_cull_index(Item *p_canvas_item) {
+	Item::CullIndex *cull_index = p_canvas_item->parent_cull_index;
+	if (!cull_index) {
+		return;
+	}
+
+	if (p_canvas_item->cull_index_id.is_valid()) {
+		cull_index->bvh.remove(p_canvas_item->cull_index_id);
+		p_canvas_item->cull_index_id = DynamicBVH::ID();
+	}
+
+	if (p_canvas_item->cull_index_dirty) {
+		cull_index->dirty_items.erase(p_canvas_item);
+		p_canvas_item->cull_index_dirty = false;
+	}
+
+	if (p_canvas_item->cull_index_unindexed) {
+		int64_t idx = cull_index->unindexed_items.find(p_canvas_item);
+		cull_index->unindexed_items.remove_at_unordered(idx);
+		p_canvas_item->cull_index_unindexed = false;
+	}
+
+	p_canvas_item->parent_cull_index = nullptr;
+}
+
 void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *ci, RendererCanvasCull::Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &xform, const Rect2 &p_clip_rect, Rect2 global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *canvas_group_from, const Transform2D &p_xform) {
 	if (ci->copy_back_buffer) {
 		ci->copy_back_buffer->screen_rect = xform.xform(ci->copy_back_buffer->rect).intersection(p_clip_rect);
@@ -299,24 +447,55 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	if (ci->sort_y) {
 		if (allow_y_sort) {
 			if (ci->ysort_children_count == -1) {
-				ci->ysort_children_count = 0;
-				_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), nullptr, ci->ysort_children_count, p_z);
+				// Count the items in the subtree of each child, so their subtrees can be collected independently.
+				ci->ysort_child_offsets.resize(child_item_count);
+				int count = 1;
+				for (int i = 0; i < child_item_count; i++) {
+					ci->ysort_child_offsets[i] = count;
+					_collect_ysort_child(child_items[i], Transform2D(), p_material_owner, Color(1, 1, 1, 1), nullptr, count, p_z);
+				}
+				ci->ysort_children_count = count - 1;
+				ci->ysort_sorted_items.clear();
 			}
 
+			int direct_child_count = child_item_count;
 			child_item_count = ci->ysort_children_count + 1;
 			child_items = (Item **)alloca(child_item_count * sizeof(Item *));
 
 			ci->ysort_parent_abs_z_index = parent_z;
 			child_items[0] = ci;
-			int i = 1;
-			_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), child_items, i, p_z);
+			int thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+			if (child_item_count >= YSORT_PARALLEL_MIN_ITEMS && thread_count > 1 && direct_child_count > 1) {
+				// Each task collects the subtrees of a range of children, which are written to precomputed offsets.
+				YSortCollectData collect_data;
+				collect_data.canvas_item = ci;
+				collect_data.material_owner = p_material_owner;
+				collect_data.items = child_items;
+				collect_data.z = p_z;
+				collect_data.task_count = MIN(direct_child_count, thread_count * 4);
+
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_collect_ysort_children_threaded, &collect_data, collect_data.task_count, -1, true, SNAME("CollectYSortChildren"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			} else {
+				int i = 1;
+				_collect_ysort_children(ci, Transform2D(), p_material_owner, Color(1, 1, 1, 1), child_items, i, p_z);
+			}
 			ci->ysort_xform = ci->xform.affine_inverse();
 			ci->ysort_modulate = Color(1, 1, 1, 1);
 
-			SortArray<Item *, ItemPtrSort> sorter;
-			sorter.sort(child_items, child_item_count);
+			// Items rarely move much between frames, so start from the previous order and repair it.
+			LocalVector<Item *> &sorted_items = ci->ysort_sorted_items;
+			if (sorted_items.size() != (uint32_t)child_item_count) {
+				sorted_items.resize(child_item_count);
+				memcpy(sorted_items.ptr(), child_items, child_item_count * sizeof(Item *));
+				SortArray<Item *, ItemPtrSort> sorter;
+				sorter.sort(sorted_items.ptr(), child_item_count);
+			} else {
+				_repair_ysort_order(sorted_items.ptr(), child_item_count, ysort_moved_items);
+			}
+			child_items = sorted_items.ptr();
 
-			for (i = 0; i < child_item_count; i++) {
+			for (int i = 0; i < child_item_count; i++) {
 				_cull_canvas_item(child_items[i], xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, false, canvas_cull_mask);
 			}
 		} else {
@@ -337,6 +516,39 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			canvas_group_from = r_z_last_list[zidx];
 		}
 
+		if (using_cull_index && !use_canvas_group && child_item_count >= CULL_INDEX_MIN_CHILDREN && xform.determinant() != 0) {
+			if (!ci->cull_index) {
+				_create_cull_index(ci);
+			}
+			_update_cull_index(ci);
+
+			// Only cull the children that overlap the clip rect, in the local space of this item.
+			Rect2 local_clip_rect = xform.affine_inverse().xform(Rect2(Point2(), p_clip_rect.size));
+			AABB query(Vector3(local_clip_rect.position.x, local_clip_rect.position.y, 0), Vector3(local_clip_rect.size.x, local_clip_rect.size.y, 0));
+
+			LocalVector<Item *> &visible_items = ci->cull_index->visible_items;
+			visible_items = ci->cull_index->unindexed_items;
+
+			struct CullIndexQuery {
+				LocalVector<Item *> *items;
+				_FORCE_INLINE_ bool operator()(void *p_data) {
+					items->push_back((Item *)p_data);
+					return false;
+				}
+			} cull_query;
+			cull_query.items = &visible_items;
+			ci->cull_index->bvh.aabb_query(query, cull_query);
+
+			// Keep the draw order of the children.
+			SortArray<Item *, ItemIndexSort> sorter;
+			sorter.sort(visible_items.ptr(), visible_items.size());
+
+			child_items = visible_items.ptr();
+			child_item_count = visible_items.size();
+		} else if (ci->cull_index && (!using_cull_index || use_canvas_group || child_item_count < CULL_INDEX_MIN_CHILDREN)) {
+			_free_cull_index(ci);
+		}
+
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
@@ -358,6 +570,7 @@ void RendererCanvasCull::render_canvas(RID p_render_target, Canvas *p_canvas, co
 
 	sdf_used = false;
 	snapping_2d_transforms_to_pixel = p_snap_2d_transforms_to_pixel;
+	using_cull_index = p_canvas->use_cull_index;
 
 	if (p_canvas->children_order_dirty) {
 		p_canvas->child_items.sort();
@@ -407,6 +620,12 @@ bool RendererCanvasCull::was_sdf_used() {
 	return sdf_used;
 }
 
+uint64_t RendererCanvasCull::take_cull_time_usec() {
+	uint64_t time = cull_usec;
+	cull_usec = 0;
+	return time;
+}
+
 RID RendererCanvasCull::canvas_allocate() {
 	return canvas_owner.allocate_rid();
 }
@@ -435,6 +654,13 @@ void RendererCanvasCull::canvas_set_disable_scale(bool p_disable) {
 	disable_scale = p_disable;
 }
 
+void RendererCanvasCull::canvas_set_use_spatial_index(RID p_canvas, bool p_enable) {
+	Canvas *canvas = canvas_owner.get_or_null(p_canvas);
+	ERR_FAIL_COND(!canvas);
+
+	canvas->use_cull_index = p_enable;
+}
+
 void RendererCanvasCull::canvas_set_parent(RID p_canvas, RID p_parent, float p_scale) {
 	Canvas *canvas = canvas_owner.get_or_null(p_canvas);
 	ERR_FAIL_COND(!canvas);
@@ -461,6 +687,8 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 		} else if (canvas_item_owner.owns(canvas_item->parent)) {
 			Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 			item_owner->child_items.erase(canvas_item);
+			_remove_from_cull_index(canvas_item);
+			item_owner->mark_cull_index_dirty();
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -481,6 +709,12 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			Item *item_owner = canvas_item_owner.get_or_null(p_parent);
 			item_owner->child_items.push_back(canvas_item);
 			item_owner->children_order_dirty = true;
+			item_owner->mark_cull_index_dirty();
+
+			if (item_owner->cull_index) {
+				canvas_item->parent_cull_index = item_owner->cull_index;
+				canvas_item->mark_cull_index_dirty();
+			}
 
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -515,6 +749,7 @@ void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->xform = p_transform;
+	canvas_item->mark_cull_index_dirty();
 }
 
 void RendererCanvasCull::canvas_item_set_visibility_layer(RID p_item, uint32_t p_visibility_layer) {
@@ -551,6 +786,7 @@ void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_r
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
+	canvas_item->mark_cull_index_dirty();
 }
 
 void RendererCanvasCull::canvas_item_set_modulate(RID p_item, const Color &p_color) {
@@ -579,6 +815,7 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 	ERR_FAIL_COND(!canvas_item);
 
 	canvas_item->update_when_visible = p_update;
+	canvas_item->mark_cull_index_dirty();
 }
 
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
@@ -1487,6 +1724,16 @@ void RendererCanvasCull::canvas_item_set_sort_children_by_y(RID p_item, bool p_e
 
 	canvas_item->sort_y = p_enable;
 
+	if (!p_enable) {
+		canvas_item->ysort_sorted_items.reset();
+		canvas_item->ysort_child_offsets.reset();
+	}
+
+	if (p_enable && canvas_item->cull_index) {
+		// Y-sorted children are flattened into the parent and don't use the index.
+		_free_cull_index(canvas_item);
+	}
+
 	_mark_ysort_dirty(canvas_item, canvas_item_owner);
 }
 
@@ -1513,6 +1760,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 		return;
 	}
 	canvas_item->skeleton = p_skeleton;
+	canvas_item->mark_cull_index_dirty();
 
 	Item::Command *c = canvas_item->commands;
 
@@ -1550,6 +1798,8 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 		canvas_item->copy_back_buffer->rect = p_rect;
 		canvas_item->copy_back_buffer->full = p_rect == Rect2();
 	}
+
+	canvas_item->mark_cull_index_dirty();
 }
 
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
@@ -1610,6 +1860,8 @@ void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_
 			canvas_item->visibility_notifier = nullptr;
 		}
 	}
+
+	canvas_item->mark_cull_index_dirty();
 }
 
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
@@ -1631,6 +1883,8 @@ void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::Canva
 		canvas_item->canvas_group->blur_mipmaps = p_blur_mipmaps;
 		canvas_item->canvas_group->clear_margin = p_clear_margin;
 	}
+
+	canvas_item->mark_cull_index_dirty();
 }
 
 RID RendererCanvasCull::canvas_light_allocate() {
@@ -2071,6 +2325,8 @@ bool RendererCanvasCull::free(RID p_rid) {
 			} else if (canvas_item_owner.owns(canvas_item->parent)) {
 				Item *item_owner = canvas_item_owner.get_or_null(canvas_item->parent);
 				item_owner->child_items.erase(canvas_item);
+				_remove_from_cull_index(canvas_item);
+				item_owner->mark_cull_index_dirty();
 
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
@@ -2078,6 +2334,10 @@ bool RendererCanvasCull::free(RID p_rid) {
 			}
 		}
 
+		if (canvas_item->cull_index) {
+			_free_cull_index(canvas_item);
+		}
+
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
 			canvas_item->child_items[i]->parent = RID();
 		}
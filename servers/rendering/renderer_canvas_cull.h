@@ -31,6 +31,7 @@
 #ifndef RENDERER_CANVAS_CULL_H
 #define RENDERER_CANVAS_CULL_H
 
+#include "core/math/dynamic_bvh.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
@@ -57,6 +58,8 @@ public:
 		uint32_t visibility_layer = 0xffffffff;
 
 		Vector<Item *> child_items;
+		LocalVector<Item *> ysort_sorted_items; // Y-sorted items in the order of the last frame.
+		LocalVector<int> ysort_child_offsets; // Where the subtree of each child starts in the y-sorted items.
 
 		struct VisibilityNotifierData {
 			Rect2 area;
@@ -72,6 +75,40 @@ public:
 
 		VisibilityNotifierData *visibility_notifier = nullptr;
 
+		// Spatial index of the leaf children of an item with many children, so that culling
+		// only visits the children that can be visible.
+		struct CullIndex {
+			DynamicBVH bvh;
+			LocalVector<Item *> dirty_items; // Children whose indexed rect must be refreshed.
+			LocalVector<Item *> unindexed_items; // Children that can't be indexed and are always culled one by one.
+			LocalVector<Item *> visible_items; // Query results, reused between frames.
+		};
+
+		CullIndex *cull_index = nullptr; // Index of this item's children.
+		CullIndex *parent_cull_index = nullptr; // Index of the parent this item is a child of.
+		DynamicBVH::ID cull_index_id;
+		bool cull_index_dirty = false;
+		bool cull_index_unindexed = false;
+
+		_FORCE_INLINE_ void mark_cull_index_dirty() {
+			if (parent_cull_index && !cull_index_dirty) {
+				cull_index_dirty = true;
+				parent_cull_index->dirty_items.push_back(this);
+			}
+		}
+
+		// Commands change the rect of the item, so its entry in the parent's index must follow.
+		template <class T>
+		T *alloc_command() {
+			mark_cull_index_dirty();
+			return RendererCanvasRender::Item::alloc_command<T>();
+		}
+
+		void clear() {
+			mark_cull_index_dirty();
+			RendererCanvasRender::Item::clear();
+		}
+
 		Item() {
 			children_order_dirty = true;
 			E = nullptr;
@@ -141,6 +178,7 @@ public:
 		bool children_order_dirty;
 		Vector<ChildItem> child_items;
 		Color modulate;
+		bool use_cull_index = false;
 		RID parent;
 		float parent_scale;
 
@@ -173,6 +211,24 @@ public:
 	bool disable_scale;
 	bool sdf_used = false;
 	bool snapping_2d_transforms_to_pixel = false;
+	bool using_cull_index = false;
+
+	// Items with fewer children than this are always culled without a spatial index.
+	static constexpr int CULL_INDEX_MIN_CHILDREN = 128;
+	// Y-sorted subtrees smaller than this are collected on the calling thread.
+	static constexpr int YSORT_PARALLEL_MIN_ITEMS = 4096;
+
+	struct YSortCollectData {
+		Item *canvas_item = nullptr;
+		Item *material_owner = nullptr;
+		Item **items = nullptr;
+		int z = 0;
+		int task_count = 0;
+	};
+
+	void _collect_ysort_children_threaded(uint32_t p_index, YSortCollectData *p_data);
+
+	LocalVector<Item *> ysort_moved_items;
 
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
@@ -181,6 +237,11 @@ public:
 
 private:
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask);
+	void _create_cull_index(Item *p_canvas_item);
+	void _free_cull_index(Item *p_canvas_item);
+	void _update_cull_index(Item *p_canvas_item);
+	void _remove_from_cull_index(Item *p_canvas_item);
+
 	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool allow_y_sort, uint32_t canvas_cull_mask);
 
 	static constexpr int z_range = RS::CANVAS_ITEM_Z_MAX - RS::CANVAS_ITEM_Z_MIN + 1;
@@ -188,10 +249,14 @@ private:
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	// CPU time spent culling canvas items, in microseconds, until taken by take_cull_time_usec().
+	uint64_t cull_usec = 0;
+
 public:
 	void render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask);
 
 	bool was_sdf_used();
+	uint64_t take_cull_time_usec();
 
 	RID canvas_allocate();
 	void canvas_initialize(RID p_rid);
@@ -200,6 +265,7 @@ public:
 	void canvas_set_modulate(RID p_canvas, const Color &p_color);
 	void canvas_set_parent(RID p_canvas, RID p_parent, float p_scale);
 	void canvas_set_disable_scale(bool p_disable);
+	void canvas_set_use_spatial_index(RID p_canvas, bool p_enable);
 
 	RID canvas_item_allocate();
 	void canvas_item_initialize(RID p_rid);
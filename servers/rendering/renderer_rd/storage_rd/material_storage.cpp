@@ -2002,6 +2002,10 @@ void MaterialStorage::shader_free(RID p_rid) {
 		material_set_shader((*shader->owners.begin())->self, RID());
 	}
 
+	if (shader->compile_queued) {
+		shader_compile_queue.erase(p_rid);
+	}
+
 	//clear data if exists
 	if (shader->data) {
 		memdelete(shader->data);
@@ -2035,6 +2039,8 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 		if (shader->data) {
 			memdelete(shader->data);
 			shader->data = nullptr;
+			shader->compile_queued = false;
+			shader_compile_queue.erase(p_shader);
 		}
 
 		for (Material *E : shader->owners) {
@@ -2076,7 +2082,10 @@ void MaterialStorage::shader_set_code(RID p_shader, const String &p_code) {
 
 	if (shader->data) {
 		shader->data->set_path_hint(shader->path_hint);
-		shader->data->set_code(p_code);
+		if (!shader->compile_queued) {
+			shader->compile_queued = true;
+			shader_compile_queue.push_back(p_shader);
+		}
 	}
 
 	for (Material *E : shader->owners) {
@@ -2105,6 +2114,7 @@ String MaterialStorage::shader_get_code(RID p_shader) const {
 void MaterialStorage::get_shader_parameter_list(RID p_shader, List<PropertyInfo> *p_param_list) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_COND(!shader);
+	_update_queued_shader(shader);
 	if (shader->data) {
 		return shader->data->get_shader_uniform_list(p_param_list);
 	}
@@ -2150,6 +2160,7 @@ RID MaterialStorage::shader_get_default_texture_parameter(RID p_shader, const St
 Variant MaterialStorage::shader_get_parameter_default(RID p_shader, const StringName &p_param) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_COND_V(!shader, Variant());
+	_update_queued_shader(shader);
 	if (shader->data) {
 		return shader->data->get_default_parameter(p_param);
 	}
@@ -2164,12 +2175,50 @@ void MaterialStorage::shader_set_data_request_function(ShaderType p_shader_type,
 RS::ShaderNativeSourceCode MaterialStorage::shader_get_native_source_code(RID p_shader) const {
 	Shader *shader = shader_owner.get_or_null(p_shader);
 	ERR_FAIL_COND_V(!shader, RS::ShaderNativeSourceCode());
+	_update_queued_shader(shader);
 	if (shader->data) {
 		return shader->data->get_native_source_code();
 	}
 	return RS::ShaderNativeSourceCode();
 }
 
+void MaterialStorage::_compile_queued_shaders() const {
+	LocalVector<Shader *> shaders[SHADER_TYPE_MAX];
+	for (const RID &E : shader_compile_queue) {
+		Shader *shader = shader_owner.get_or_null(E);
+		ERR_CONTINUE(!shader);
+		shader->compile_queued = false;
+		if (shader->data && shader->type < SHADER_TYPE_MAX) {
+			shaders[shader->type].push_back(shader);
+		}
+	}
+	shader_compile_queue.clear();
+
+	static const RS::ShaderMode shader_modes[SHADER_TYPE_MAX] = { RS::SHADER_CANVAS_ITEM, RS::SHADER_SPATIAL, RS::SHADER_PARTICLES, RS::SHADER_SKY, RS::SHADER_FOG };
+
+	for (int i = 0; i < SHADER_TYPE_MAX; i++) {
+		uint32_t from = 0;
+		if (shaders[i].size() > 1) {
+			if (!ShaderCompiler::can_precompile(shader_modes[i])) {
+				// The compiler learns which actions a shader type uses from its first compile.
+				shaders[i][0]->data->set_code(shaders[i][0]->code);
+				from = 1;
+			}
+
+			Vector<String> code;
+			for (uint32_t j = from; j < shaders[i].size(); j++) {
+				code.push_back(shaders[i][j]->code);
+			}
+			ShaderCompiler::precompile(shader_modes[i], code);
+		}
+
+		// Creating the RenderingDevice shaders and pipelines stays on this thread.
+		for (uint32_t j = from; j < shaders[i].size(); j++) {
+			shaders[i][j]->data->set_code(shaders[i][j]->code);
+		}
+	}
+}
+
 /* MATERIAL API */
 
 void MaterialStorage::_material_uniform_set_erased(void *p_material) {
@@ -2197,6 +2246,8 @@ void MaterialStorage::_material_queue_update(Material *material, bool p_uniform,
 }
 
 void MaterialStorage::_update_queued_materials() {
+	_update_queued_shaders();
+
 	while (material_update_list.first()) {
 		Material *material = material_update_list.first()->self();
 		bool uniforms_changed = false;
@@ -2290,6 +2341,7 @@ void MaterialStorage::material_set_shader(RID p_material, RID p_shader) {
 MaterialStorage::ShaderData *MaterialStorage::material_get_shader_data(RID p_material) {
 	const MaterialStorage::Material *material = MaterialStorage::get_singleton()->get_material(p_material);
 	if (material && material->shader && material->shader->data) {
+		_update_queued_shader(material->shader);
 		return material->shader->data;
 	}
 
@@ -2307,10 +2359,11 @@ void MaterialStorage::material_set_param(RID p_material, const StringName &p_par
 		material->params[p_param] = p_value;
 	}
 
-	if (material->shader && material->shader->data) { //shader is valid
+	if (material->shader && material->shader->data && !material->shader->compile_queued) { //shader is valid
 		bool is_texture = material->shader->data->is_parameter_texture(p_param);
 		_material_queue_update(material, !is_texture, is_texture);
 	} else {
+		// Which parameters are textures is only known once the shader is compiled.
 		_material_queue_update(material, true, true);
 	}
 }
@@ -2354,6 +2407,7 @@ void MaterialStorage::material_set_render_priority(RID p_material, int priority)
 bool MaterialStorage::material_is_animated(RID p_material) {
 	Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_COND_V(!material, false);
+	_update_queued_shader(material->shader);
 	if (material->shader && material->shader->data) {
 		if (material->shader->data->is_animated()) {
 			return true;
@@ -2367,6 +2421,7 @@ bool MaterialStorage::material_is_animated(RID p_material) {
 bool MaterialStorage::material_casts_shadows(RID p_material) {
 	Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_COND_V(!material, true);
+	_update_queued_shader(material->shader);
 	if (material->shader && material->shader->data) {
 		if (material->shader->data->casts_shadows()) {
 			return true;
@@ -2380,6 +2435,7 @@ bool MaterialStorage::material_casts_shadows(RID p_material) {
 void MaterialStorage::material_get_instance_shader_parameters(RID p_material, List<InstanceShaderParam> *r_parameters) {
 	Material *material = material_owner.get_or_null(p_material);
 	ERR_FAIL_COND(!material);
+	_update_queued_shader(material->shader);
 	if (material->shader && material->shader->data) {
 		material->shader->data->get_instance_param_list(r_parameters);
 
@@ -193,6 +193,7 @@ private:
 		ShaderType type;
 		HashMap<StringName, HashMap<int, RID>> default_texture_parameter;
 		HashSet<Material *> owners;
+		bool compile_queued = false;
 	};
 
 	typedef ShaderData *(*ShaderDataRequestFunction)();
@@ -201,6 +202,11 @@ private:
 	mutable RID_Owner<Shader, true> shader_owner;
 	Shader *get_shader(RID p_rid) { return shader_owner.get_or_null(p_rid); }
 
+	// Shaders whose code was set but not compiled yet. They are compiled together,
+	// with the parsing done in parallel, the first time any of them is needed.
+	mutable LocalVector<RID> shader_compile_queue;
+	void _compile_queued_shaders() const;
+
 	/* MATERIAL API */
 
 	typedef MaterialData *(*MaterialDataRequestFunction)(ShaderData *);
@@ -395,6 +401,19 @@ public:
 
 	virtual RS::ShaderNativeSourceCode shader_get_native_source_code(RID p_shader) const override;
 
+	_FORCE_INLINE_ void _update_queued_shaders() const {
+		if (!shader_compile_queue.is_empty()) {
+			_compile_queued_shaders();
+		}
+	}
+
+	// Only flushes the queue when the given shader is waiting in it, for getters that need its compiled data now.
+	_FORCE_INLINE_ void _update_queued_shader(const Shader *p_shader) const {
+		if (p_shader && p_shader->compile_queued) {
+			_compile_queued_shaders();
+		}
+	}
+
 	/* MATERIAL API */
 
 	bool owns_material(RID p_rid) { return material_owner.owns(p_rid); };
@@ -430,6 +449,8 @@ public:
 		return material->shader_id;
 	}
 
+	// Queued shaders are compiled once per frame when dirty resources are updated, call
+	// _update_queued_shaders() first when material data is needed before the next frame.
 	_FORCE_INLINE_ MaterialData *material_get_data(RID p_material, ShaderType p_shader_type) {
 		Material *material = material_owner.get_or_null(p_material);
 		if (!material || material->shader_type != p_shader_type) {
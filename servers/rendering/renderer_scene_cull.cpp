@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_server_default.h"
 
 #include <new>
@@ -410,6 +411,7 @@ RID RendererSceneCull::scenario_get_environment(RID p_scenario) {
 void RendererSceneCull::scenario_remove_viewport_visibility_mask(RID p_scenario, RID p_viewport) {
 	Scenario *scenario = scenario_owner.get_or_null(p_scenario);
 	ERR_FAIL_COND(!scenario);
+	scenario->cull_coherence.erase(p_viewport);
 	if (!scenario->viewport_visibility_masks.has(p_viewport)) {
 		return;
 	}
@@ -846,6 +848,7 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 	instance->layer_mask = p_mask;
 	if (instance->scenario && instance->array_index >= 0) {
 		instance->scenario->instance_data[instance->array_index].layer_mask = p_mask;
+		instance->scenario->cull_changed(instance->array_index);
 	}
 
 	if ((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK && instance->base_data) {
@@ -854,10 +857,7 @@ void RendererSceneCull::instance_set_layer_mask(RID p_instance, uint32_t p_mask)
 		geom->geometry_instance->set_layer_mask(p_mask);
 
 		if (geom->can_cast_shadows) {
-			for (HashSet<RendererSceneCull::Instance *>::Iterator I = geom->lights.begin(); I != geom->lights.end(); ++I) {
-				InstanceLightData *light = static_cast<InstanceLightData *>((*I)->base_data);
-				light->shadow_dirty = true;
-			}
+			_geometry_instance_dirty_light_shadows(instance, instance->transformed_aabb);
 		}
 	}
 }
@@ -1069,6 +1069,41 @@ void RendererSceneCull::instance_set_ignore_culling(RID p_instance, bool p_enabl
 		} else {
 			idata.flags &= ~uint32_t(InstanceData::FLAG_IGNORE_ALL_CULLING);
 		}
+		instance->scenario->cull_changed(instance->array_index);
+	}
+}
+
+void RendererSceneCull::instances_initialize(const Vector<RID> &p_instances, RID p_base, RID p_scenario, const Vector<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *instances = p_instances.ptr();
+	const Transform3D *transforms = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		instance_initialize(instances[i]);
+		// Transform goes first, so the single queued update inserts the instance into the indexer where it belongs.
+		instance_set_transform(instances[i], transforms[i]);
+		instance_set_base(instances[i], p_base);
+		instance_set_scenario(instances[i], p_scenario);
+	}
+}
+
+void RendererSceneCull::instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *instances = p_instances.ptr();
+	const Transform3D *transforms = p_transforms.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		instance_set_transform(instances[i], transforms[i]);
+	}
+}
+
+void RendererSceneCull::instances_set_visible(const Vector<RID> &p_instances, const Vector<uint8_t> &p_visible) {
+	ERR_FAIL_COND(p_instances.size() != p_visible.size());
+
+	const RID *instances = p_instances.ptr();
+	const uint8_t *visible = p_visible.ptr();
+	for (int i = 0; i < p_instances.size(); i++) {
+		instance_set_visible(instances[i], visible[i] != 0);
 	}
 }
 
@@ -1633,10 +1668,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		//make sure lights are updated if it casts shadow
 
 		if (geom->can_cast_shadows) {
-			for (const Instance *E : geom->lights) {
-				InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
-				light->shadow_dirty = true;
-			}
+			_geometry_instance_dirty_light_shadows(p_instance, p_instance->prev_transformed_aabb);
 		}
 
 		if (!p_instance->lightmap && geom->lightmap_captures.size()) {
@@ -1765,6 +1797,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 
 		p_instance->scenario->instance_data.push_back(idata);
 		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		p_instance->scenario->cull_changed(p_instance->array_index);
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1773,6 +1806,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->cull_changed(p_instance->array_index);
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1800,10 +1834,17 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 
 		pair.pair_mask |= geometry_instance_pair_mask;
 
+		if (light_pairing_clustered) {
+			// Lights are gathered from the light pair grid when rendering.
+			pair.pair_mask &= ~(1 << RS::INSTANCE_LIGHT);
+		}
+
 		pair.bvh2 = &p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES];
 	} else if (p_instance->base_type == RS::INSTANCE_LIGHT) {
-		pair.pair_mask |= RS::INSTANCE_GEOMETRY_MASK;
-		pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
+		if (!light_pairing_clustered) {
+			pair.pair_mask |= RS::INSTANCE_GEOMETRY_MASK;
+			pair.bvh = &p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY];
+		}
 
 		if (RSG::light_storage->light_get_bake_mode(p_instance->base) == RS::LIGHT_BAKE_DYNAMIC) {
 			pair.pair_mask |= (1 << RS::INSTANCE_VOXEL_GI);
@@ -1829,6 +1870,14 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 
 	pair.pair();
 
+	if (light_pairing_clustered && ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK)) {
+		// Without pairs, lights under the new bounds are not told about the shadow caster.
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
+		if (geom->can_cast_shadows) {
+			_geometry_instance_dirty_light_shadows(p_instance, p_instance->transformed_aabb);
+		}
+	}
+
 	p_instance->prev_transformed_aabb = p_instance->transformed_aabb;
 }
 
@@ -1844,6 +1893,13 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		pair_allocator.free(pair);
 	}
 
+	if (light_pairing_clustered && ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK)) {
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
+		if (geom->can_cast_shadows) {
+			_geometry_instance_dirty_light_shadows(p_instance, p_instance->transformed_aabb);
+		}
+	}
+
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 		p_instance->scenario->indexers[Scenario::INDEXER_GEOMETRY].remove(p_instance->indexer_id);
 	} else {
@@ -1859,6 +1915,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		p_instance->scenario->cull_changed(p_instance->array_index);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -1885,6 +1942,12 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 
 		geom->geometry_instance->pair_light_instances(nullptr, 0);
 		geom->geometry_instance->pair_reflection_probe_instances(nullptr, 0);
+		geom->light_pair_hash = 0;
+		if (light_pairing_clustered && (geom->projector_count || geom->softshadow_count)) {
+			geom->projector_count = 0;
+			geom->softshadow_count = 0;
+			geom->geometry_instance->set_softshadow_projector_pairing(false, false);
+		}
 		geom->geometry_instance->pair_decal_instances(nullptr, 0);
 		geom->geometry_instance->pair_voxel_gi_instances(nullptr, 0);
 	}
@@ -2584,6 +2647,9 @@ void RendererSceneCull::render_camera(const Ref<RenderSceneBuffers> &p_render_bu
 	RENDER_TIMESTAMP("Update Occlusion Buffer")
 	// For now just cull on the first camera
 	RendererSceneOcclusionCull::get_singleton()->buffer_update(p_viewport, camera_data.main_transform, camera_data.main_projection, camera_data.is_orthogonal);
+	if (r_render_info) {
+		r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_OCCLUSION_RAYS_IN_FRAME] += RendererSceneOcclusionCull::get_singleton()->buffer_get_ray_count(p_viewport);
+	}
 
 	_render_scene(&camera_data, p_render_buffers, environment, camera->attributes, camera->visible_layers, p_scenario, p_viewport, p_shadow_atlas, RID(), -1, p_screen_mesh_lod_threshold, true, r_render_info);
 #endif
@@ -2685,6 +2751,238 @@ bool RendererSceneCull::_visibility_parent_check(const CullData &p_cull_data, co
 	return ((parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE) || (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 }
 
+bool RendererSceneCull::_is_cull_candidate(const CullData &p_cull_data, uint64_t p_index) const {
+	// Everything _scene_cull() may accept an instance for, minus the checks that depend on per-frame state.
+	const InstanceData &idata = p_cull_data.scenario->instance_data[p_index];
+	if (idata.flags & InstanceData::FLAG_IGNORE_ALL_CULLING) {
+		return true;
+	}
+
+	const InstanceBounds &bounds = p_cull_data.scenario->instance_aabbs[p_index];
+	if ((p_cull_data.visible_layers & idata.layer_mask) && bounds.in_frustum(p_cull_data.cull->frustum)) {
+		return true;
+	}
+
+	for (uint32_t j = 0; j < p_cull_data.cull->shadow_count; j++) {
+		for (uint32_t k = 0; k < p_cull_data.cull->shadows[j].cascade_count; k++) {
+			if (bounds.in_frustum(p_cull_data.cull->shadows[j].cascades[k].frustum)) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void RendererSceneCull::_update_cull_coherence(CullData &r_cull_data, RID p_viewport) {
+	Scenario *scenario = r_cull_data.scenario;
+	Scenario::CullCoherence &coherence = scenario->cull_coherence[p_viewport];
+
+	LocalVector<Plane> planes;
+	LocalVector<uint32_t> plane_counts;
+	for (uint32_t i = 0; i < cull.frustum.plane_count; i++) {
+		planes.push_back(cull.frustum.planes_ptr[i]);
+	}
+	plane_counts.push_back(cull.frustum.plane_count);
+	for (uint32_t j = 0; j < cull.shadow_count; j++) {
+		for (uint32_t k = 0; k < cull.shadows[j].cascade_count; k++) {
+			const Frustum &frustum = cull.shadows[j].cascades[k].frustum;
+			for (uint32_t i = 0; i < frustum.plane_count; i++) {
+				planes.push_back(frustum.planes_ptr[i]);
+			}
+			plane_counts.push_back(frustum.plane_count);
+		}
+	}
+
+	bool rebuild = !coherence.valid || coherence.changes_read < scenario->cull_changes_offset || coherence.visible_layers != r_cull_data.visible_layers || coherence.planes.size() != planes.size() || coherence.plane_counts.size() != plane_counts.size();
+	for (uint32_t i = 0; !rebuild && i < plane_counts.size(); i++) {
+		rebuild = coherence.plane_counts[i] != plane_counts[i];
+	}
+	for (uint32_t i = 0; !rebuild && i < planes.size(); i++) {
+		rebuild = coherence.planes[i] != planes[i];
+	}
+
+	uint32_t instance_count = scenario->instance_data.size();
+	coherence.candidates.resize(instance_count);
+	r_cull_data.cull_candidates = coherence.candidates.ptr();
+	r_cull_data.rebuild_cull_candidates = rebuild;
+
+	if (rebuild) {
+		// The candidate bytes are written by _scene_cull() as it goes.
+		coherence.planes = planes;
+		coherence.plane_counts = plane_counts;
+		coherence.visible_layers = r_cull_data.visible_layers;
+		coherence.valid = true;
+	} else {
+		for (uint64_t i = coherence.changes_read - scenario->cull_changes_offset; i < scenario->cull_changes.size(); i++) {
+			uint32_t index = scenario->cull_changes[i];
+			if (index < instance_count) {
+				coherence.candidates[index] = _is_cull_candidate(r_cull_data, index);
+			}
+		}
+	}
+	coherence.changes_read = scenario->cull_changes_offset + scenario->cull_changes.size();
+
+	// Drop the part of the log every viewport has read.
+	uint64_t oldest_read = coherence.changes_read;
+	for (const KeyValue<RID, Scenario::CullCoherence> &E : scenario->cull_coherence) {
+		if (E.value.valid) {
+			oldest_read = MIN(oldest_read, MAX(E.value.changes_read, scenario->cull_changes_offset));
+		}
+	}
+	if (oldest_read == coherence.changes_read) {
+		scenario->cull_changes_offset = oldest_read;
+		scenario->cull_changes.clear();
+	}
+}
+
+void RendererSceneCull::_geometry_instance_dirty_light_shadows(Instance *p_instance, const AABB &p_aabb) {
+	if (!light_pairing_clustered) {
+		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
+		for (const Instance *E : geom->lights) {
+			InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
+			light->shadow_dirty = true;
+		}
+		return;
+	}
+
+	// Only indexed instances were in range of any light.
+	if (!p_instance->scenario || !p_instance->indexer_id.is_valid()) {
+		return;
+	}
+
+	DirtyLightShadows dirty;
+	dirty.aabb = p_aabb;
+	p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].aabb_query(p_aabb, dirty);
+}
+
+void RendererSceneCull::LightPairGrid::build() {
+	bounds = AABB();
+	for (uint32_t i = 0; i < lights.size(); i++) {
+		if (i == 0) {
+			bounds = lights[i].aabb;
+		} else {
+			bounds.merge_with(lights[i].aabb);
+		}
+	}
+
+	// Roughly one light per cell, fewer cells along flat axes.
+	int32_t cells_per_axis = CLAMP(int32_t(Math::ceil(Math::pow(double(lights.size()), 1.0 / 3.0))), 1, MAX_CELLS_PER_AXIS);
+	uint32_t cell_count = 1;
+	for (int i = 0; i < 3; i++) {
+		if (bounds.size[i] > CMP_EPSILON) {
+			size[i] = cells_per_axis;
+			cell_size_inv[i] = cells_per_axis / bounds.size[i];
+		} else {
+			size[i] = 1;
+			cell_size_inv[i] = 0;
+		}
+		cell_count *= size[i];
+	}
+
+	cell_offsets.resize(cell_count + 1);
+	cell_fill.resize(cell_count);
+	memset(cell_offsets.ptr(), 0, sizeof(uint32_t) * (cell_count + 1));
+
+	int32_t from[3], to[3];
+	for (Light &l : lights) {
+		get_cell_range(l.aabb, from, to);
+		for (int i = 0; i < 3; i++) {
+			l.cell_from[i] = from[i];
+		}
+		for (int32_t z = from[2]; z <= to[2]; z++) {
+			for (int32_t y = from[1]; y <= to[1]; y++) {
+				for (int32_t x = from[0]; x <= to[0]; x++) {
+					cell_offsets[(z * size[1] + y) * size[0] + x + 1]++;
+				}
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < cell_count; i++) {
+		cell_offsets[i + 1] += cell_offsets[i];
+		cell_fill[i] = cell_offsets[i];
+	}
+
+	cell_lights.resize(cell_offsets[cell_count]);
+	for (uint32_t i = 0; i < lights.size(); i++) {
+		get_cell_range(lights[i].aabb, from, to);
+		for (int32_t z = from[2]; z <= to[2]; z++) {
+			for (int32_t y = from[1]; y <= to[1]; y++) {
+				for (int32_t x = from[0]; x <= to[0]; x++) {
+					cell_lights[cell_fill[(z * size[1] + y) * size[0] + x]++] = i;
+				}
+			}
+		}
+	}
+}
+
+void RendererSceneCull::_light_pair_grid_build(const PagedArray<Instance *> &p_lights) {
+	light_pair_grid.lights.clear();
+	for (uint32_t i = 0; i < p_lights.size(); i++) {
+		Instance *ins = p_lights[i];
+		if (RSG::light_storage->light_get_type(ins->base) == RS::LIGHT_DIRECTIONAL) {
+			continue; // Never paired with geometry.
+		}
+		InstanceLightData *light = static_cast<InstanceLightData *>(ins->base_data);
+
+		LightPairGrid::Light l;
+		l.aabb = ins->transformed_aabb;
+		l.instance = light->instance;
+		l.cull_mask = RSG::light_storage->light_get_cull_mask(ins->base);
+		l.uses_projector = light->uses_projector;
+		l.uses_softshadow = light->uses_softshadow;
+		light_pair_grid.lights.push_back(l);
+	}
+
+	light_pair_grid.build();
+}
+
+void RendererSceneCull::_light_pair_geometry(uint32_t p_index, PagedArray<Instance *> *p_geometries) {
+	Instance *ins = (*p_geometries)[p_index];
+	InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(ins->base_data);
+
+	struct PairLights {
+		const LightPairGrid *grid = nullptr;
+		RID instance_pair_buffer[MAX_INSTANCE_PAIRS];
+		uint32_t idx = 0;
+		uint32_t projector_count = 0;
+		uint32_t softshadow_count = 0;
+		uint64_t hash = 0;
+
+		_FORCE_INLINE_ bool operator()(uint32_t p_light) {
+			const LightPairGrid::Light &l = grid->lights[p_light];
+			instance_pair_buffer[idx++] = l.instance;
+			hash ^= hash_murmur3_one_64(l.instance.get_id());
+			projector_count += l.uses_projector ? 1 : 0;
+			softshadow_count += l.uses_softshadow ? 1 : 0;
+			return idx == MAX_INSTANCE_PAIRS;
+		}
+	};
+
+	PairLights pair_lights;
+	pair_lights.grid = &light_pair_grid;
+	light_pair_grid.query(ins->transformed_aabb, ins->layer_mask, pair_lights);
+
+	ERR_FAIL_NULL(geom->geometry_instance);
+
+	if (pair_lights.hash != geom->light_pair_hash) {
+		if (geometry_instance_pair_mask & (1 << RS::INSTANCE_LIGHT)) {
+			geom->geometry_instance->pair_light_instances(pair_lights.instance_pair_buffer, pair_lights.idx);
+		}
+		geom->light_pair_hash = pair_lights.hash;
+	}
+
+	bool pairing_changed = (pair_lights.projector_count > 0) != (geom->projector_count > 0) || (pair_lights.softshadow_count > 0) != (geom->softshadow_count > 0);
+	geom->projector_count = pair_lights.projector_count;
+	geom->softshadow_count = pair_lights.softshadow_count;
+	if (pairing_changed) {
+		cull.lock.lock();
+		geom->geometry_instance->set_softshadow_projector_pairing(pair_lights.softshadow_count > 0, pair_lights.projector_count > 0);
+		cull.lock.unlock();
+	}
+}
+
 void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_data) {
 	uint32_t cull_total = cull_data->scenario->instance_data.size();
 	uint32_t total_threads = WorkerThreadPool::get_singleton()->get_thread_count();
@@ -2707,6 +3005,32 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	float z_near = cull_data.camera_matrix->get_z_near();
 
 	for (uint64_t i = p_from; i < p_to; i++) {
+		if (cull_data.cull_candidates) {
+			if (cull_data.rebuild_cull_candidates) {
+				cull_data.cull_candidates[i] = _is_cull_candidate(cull_data, i);
+				if (!cull_data.cull_candidates[i]) {
+					cull_result.instances_tested++;
+					continue;
+				}
+			} else {
+				if ((i & 7) == 0 && i + 8 <= p_to) {
+					// Static scenes are mostly long runs of instances out of view, skip them a word at a time.
+					uint64_t word;
+					memcpy(&word, cull_data.cull_candidates + i, sizeof(uint64_t));
+					if (word == 0) {
+						cull_result.instances_skipped += 8;
+						i += 7;
+						continue;
+					}
+				}
+				if (!cull_data.cull_candidates[i]) {
+					cull_result.instances_skipped++;
+					continue;
+				}
+			}
+		}
+		cull_result.instances_tested++;
+
 		bool mesh_visible = false;
 
 		InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2810,7 +3134,9 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 						idata.instance_geometry->set_parent_fade_alpha(fade);
 					}
 
-					if (geometry_instance_pair_mask & (1 << RS::INSTANCE_LIGHT) && (idata.flags & InstanceData::FLAG_GEOM_LIGHTING_DIRTY)) {
+					if (light_pairing_clustered) {
+						cull_result.light_pair_geometries.push_back(idata.instance);
+					} else if (geometry_instance_pair_mask & (1 << RS::INSTANCE_LIGHT) && (idata.flags & InstanceData::FLAG_GEOM_LIGHTING_DIRTY)) {
 						InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(idata.instance->base_data);
 						uint32_t idx = 0;
 
@@ -3013,6 +3339,10 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 	/* STEP 2 - CULL */
 
+	// Probes are accounted for in their own frame stage.
+	bool time_stages = !render_reflection_probe;
+	uint64_t stage_usec = time_stages ? OS::get_singleton()->get_ticks_usec() : 0;
+
 	Vector<Plane> planes = p_camera_data->main_projection.get_projection_planes(p_camera_data->main_transform);
 	cull.frustum = Frustum(planes);
 
@@ -3077,6 +3407,12 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		}
 	}
 
+	if (time_stages) {
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		light_setup_usec += now - stage_usec;
+		stage_usec = now;
+	}
+
 	scene_cull_result.clear();
 
 	{
@@ -3095,6 +3431,11 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		cull_data.occlusion_buffer = RendererSceneOcclusionCull::get_singleton()->buffer_get_ptr(p_viewport);
 		cull_data.camera_matrix = &p_camera_data->main_projection;
 		cull_data.visibility_viewport_mask = scenario->viewport_visibility_masks.has(p_viewport) ? scenario->viewport_visibility_masks[p_viewport] : 0;
+
+		// SDFGI regions are tested against every instance, so the cached candidates can't be used while they update.
+		if (cull_temporal_coherence && p_viewport.is_valid() && !render_reflection_probe && cull.sdfgi.region_count == 0) {
+			_update_cull_coherence(cull_data, p_viewport);
+		}
 //#define DEBUG_CULL_TIME
 #ifdef DEBUG_CULL_TIME
 		uint64_t time_from = OS::get_singleton()->get_ticks_usec();
@@ -3117,6 +3458,20 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			_scene_cull(cull_data, scene_cull_result, cull_from, cull_to);
 		}
 
+		if (light_pairing_clustered) {
+			_light_pair_grid_build(scene_cull_result.lights);
+
+			uint32_t geometry_count = scene_cull_result.light_pair_geometries.size();
+			if (geometry_count > thread_cull_threshold) {
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_light_pair_geometry, &scene_cull_result.light_pair_geometries, geometry_count, -1, true, SNAME("RenderPairLights"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			} else {
+				for (uint32_t i = 0; i < geometry_count; i++) {
+					_light_pair_geometry(i, &scene_cull_result.light_pair_geometries);
+				}
+			}
+		}
+
 #ifdef DEBUG_CULL_TIME
 		static float time_avg = 0;
 		static uint32_t time_count = 0;
@@ -3131,6 +3486,17 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			}
 			RSG::mesh_storage->update_mesh_instances();
 		}
+
+		if (r_render_info) {
+			r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_INSTANCES_TESTED] += scene_cull_result.instances_tested;
+			r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_INSTANCES_SKIPPED] += scene_cull_result.instances_skipped;
+		}
+	}
+
+	if (time_stages) {
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		scene_cull_usec += now - stage_usec;
+		stage_usec = now;
 	}
 
 	//render shadows
@@ -3254,6 +3620,10 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 		}
 	}
 
+	if (time_stages) {
+		light_setup_usec += OS::get_singleton()->get_ticks_usec() - stage_usec;
+	}
+
 	//render SDFGI
 
 	{
@@ -3449,6 +3819,25 @@ bool RendererSceneCull::_render_reflection_probe_step(Instance *p_instance, int
 	return false;
 }
 
+uint64_t RendererSceneCull::take_stage_time_usec(RS::FrameStage p_stage) {
+	uint64_t *usec = nullptr;
+	switch (p_stage) {
+		case RS::FRAME_STAGE_SCENE_CULL: {
+			usec = &scene_cull_usec;
+		} break;
+		case RS::FRAME_STAGE_LIGHT_SETUP: {
+			usec = &light_setup_usec;
+		} break;
+		default: {
+			ERR_FAIL_V_MSG(0, "Only the scene cull and light setup stages are timed by the scene.");
+		}
+	}
+
+	uint64_t time = *usec;
+	*usec = 0;
+	return time;
+}
+
 void RendererSceneCull::render_probes() {
 	/* REFLECTION PROBES */
 
@@ -3924,10 +4313,7 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 
 			if (can_cast_shadows != geom->can_cast_shadows) {
 				//ability to cast shadows change, let lights now
-				for (const Instance *E : geom->lights) {
-					InstanceLightData *light = static_cast<InstanceLightData *>(E->base_data);
-					light->shadow_dirty = true;
-				}
+				_geometry_instance_dirty_light_shadows(p_instance, p_instance->transformed_aabb);
 
 				geom->can_cast_shadows = can_cast_shadows;
 			}
@@ -4147,6 +4533,8 @@ RendererSceneCull::RendererSceneCull() {
 	indexer_update_iterations = GLOBAL_GET("rendering/limits/spatial_indexer/update_iterations_per_frame");
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
+	cull_temporal_coherence = GLOBAL_GET("rendering/limits/spatial_indexer/use_temporal_coherence");
+	light_pairing_clustered = GLOBAL_GET("rendering/limits/spatial_indexer/use_clustered_light_pairing");
 
 	taa_jitter_array.resize(TAA_JITTER_COUNT);
 	for (int i = 0; i < TAA_JITTER_COUNT; i++) {
@@ -4154,7 +4542,8 @@ RendererSceneCull::RendererSceneCull() {
 		taa_jitter_array[i].y = get_halton_value(i, 3);
 	}
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Used unless a module (like raycast) replaces it.
+	raster_occlusion_culling = memnew(RasterOcclusionCull);
 }
 
 RendererSceneCull::~RendererSceneCull() {
@@ -4174,7 +4563,7 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (raster_occlusion_culling) {
+		memdelete(raster_occlusion_culling);
 	}
 }
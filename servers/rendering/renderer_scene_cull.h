@@ -59,6 +59,10 @@ public:
 
 	uint64_t render_pass;
 
+	// CPU time spent culling for cameras, in microseconds, until taken by take_stage_time_usec().
+	uint64_t scene_cull_usec = 0;
+	uint64_t light_setup_usec = 0;
+
 	static RendererSceneCull *singleton;
 
 	/* CAMERA API */
@@ -116,7 +120,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *raster_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -335,6 +339,33 @@ public:
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
+		// Temporal cull coherence. Each viewport remembers which instances passed the frustum and layer tests
+		// when it was last drawn, and only re-tests the array indices logged as changed since then.
+		struct CullCoherence {
+			LocalVector<Plane> planes;
+			LocalVector<uint32_t> plane_counts;
+			uint32_t visible_layers = 0;
+			uint64_t changes_read = 0;
+			bool valid = false;
+			LocalVector<uint8_t> candidates;
+		};
+
+		HashMap<RID, CullCoherence> cull_coherence;
+		LocalVector<uint32_t> cull_changes;
+		uint64_t cull_changes_offset = 0;
+
+		_FORCE_INLINE_ void cull_changed(int32_t p_array_index) {
+			if (cull_coherence.is_empty()) {
+				return;
+			}
+			if (cull_changes.size() >= MAX(instance_data.size(), 1024u)) {
+				// Too many changes to be worth replaying, caches that have not read them are rebuilt.
+				cull_changes_offset += cull_changes.size();
+				cull_changes.clear();
+			}
+			cull_changes.push_back(p_array_index);
+		}
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -610,6 +641,7 @@ public:
 		bool material_is_animated;
 		uint32_t projector_count = 0;
 		uint32_t softshadow_count = 0;
+		uint64_t light_pair_hash = 0; // Lights last sent to the renderer, when light pairing is clustered.
 
 		HashSet<Instance *> decals;
 		HashSet<Instance *> reflection_probes;
@@ -807,6 +839,19 @@ public:
 		}
 	};
 
+	struct DirtyLightShadows {
+		AABB aabb;
+
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+
+			if (p_instance->base_type == RS::INSTANCE_LIGHT && aabb.intersects(p_instance->transformed_aabb)) {
+				static_cast<InstanceLightData *>(p_instance->base_data)->shadow_dirty = true;
+			}
+			return false;
+		}
+	};
+
 	HashSet<Instance *> heightfield_particle_colliders_update_list;
 
 	PagedArrayPool<Instance *> instance_cull_page_pool;
@@ -818,6 +863,7 @@ public:
 
 	struct InstanceCullResult {
 		PagedArray<RenderGeometryInstance *> geometry_instances;
+		PagedArray<Instance *> light_pair_geometries; // Only filled when light pairing is clustered.
 		PagedArray<Instance *> lights;
 		PagedArray<RID> light_instances;
 		PagedArray<RID> lightmaps;
@@ -834,8 +880,14 @@ public:
 		PagedArray<RenderGeometryInstance *> sdfgi_region_geometry_instances[SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE];
 		PagedArray<RID> sdfgi_cascade_lights[SDFGI_MAX_CASCADES];
 
+		uint32_t instances_tested = 0;
+		uint32_t instances_skipped = 0;
+
 		void clear() {
+			instances_tested = 0;
+			instances_skipped = 0;
 			geometry_instances.clear();
+			light_pair_geometries.clear();
 			lights.clear();
 			light_instances.clear();
 			lightmaps.clear();
@@ -860,7 +912,10 @@ public:
 		}
 
 		void reset() {
+			instances_tested = 0;
+			instances_skipped = 0;
 			geometry_instances.reset();
+			light_pair_geometries.reset();
 			lights.reset();
 			light_instances.reset();
 			lightmaps.reset();
@@ -885,7 +940,10 @@ public:
 		}
 
 		void append_from(InstanceCullResult &p_cull_result) {
+			instances_tested += p_cull_result.instances_tested;
+			instances_skipped += p_cull_result.instances_skipped;
 			geometry_instances.merge_unordered(p_cull_result.geometry_instances);
+			light_pair_geometries.merge_unordered(p_cull_result.light_pair_geometries);
 			lights.merge_unordered(p_cull_result.lights);
 			light_instances.merge_unordered(p_cull_result.light_instances);
 			lightmaps.merge_unordered(p_cull_result.lightmaps);
@@ -912,6 +970,7 @@ public:
 
 		void init(PagedArrayPool<RID> *p_rid_pool, PagedArrayPool<RenderGeometryInstance *> *p_geometry_instance_pool, PagedArrayPool<Instance *> *p_instance_pool) {
 			geometry_instances.set_page_pool(p_geometry_instance_pool);
+			light_pair_geometries.set_page_pool(p_instance_pool);
 			light_instances.set_page_pool(p_rid_pool);
 			lights.set_page_pool(p_instance_pool);
 			lightmaps.set_page_pool(p_rid_pool);
@@ -946,6 +1005,82 @@ public:
 	RendererSceneRender::RenderSDFGIUpdateData sdfgi_update_data;
 
 	uint32_t thread_cull_threshold = 200;
+	bool cull_temporal_coherence = false;
+
+	// Instead of pairing every light with every geometry it touches in the spatial
+	// indexer, visible lights are binned into a uniform grid each frame and visible
+	// geometry gathers its lights from the cells it overlaps.
+	bool light_pairing_clustered = false;
+
+	struct LightPairGrid {
+		static const int32_t MAX_CELLS_PER_AXIS = 16;
+
+		struct Light {
+			AABB aabb;
+			RID instance;
+			uint32_t cull_mask = 0;
+			int32_t cell_from[3] = {};
+			bool uses_projector = false;
+			bool uses_softshadow = false;
+		};
+
+		LocalVector<Light> lights;
+		LocalVector<uint32_t> cell_offsets; // Per cell, start of its lights in cell_lights (one extra entry at the end).
+		LocalVector<uint32_t> cell_lights;
+		LocalVector<uint32_t> cell_fill;
+
+		AABB bounds;
+		Vector3 cell_size_inv;
+		int32_t size[3] = { 1, 1, 1 };
+
+		_FORCE_INLINE_ bool get_cell_range(const AABB &p_aabb, int32_t r_from[3], int32_t r_to[3]) const {
+			for (int i = 0; i < 3; i++) {
+				real_t from = (p_aabb.position[i] - bounds.position[i]) * cell_size_inv[i];
+				real_t to = (p_aabb.position[i] + p_aabb.size[i] - bounds.position[i]) * cell_size_inv[i];
+				if (to < 0 || from > size[i]) {
+					return false;
+				}
+				r_from[i] = CLAMP(int32_t(Math::floor(from)), 0, size[i] - 1);
+				r_to[i] = CLAMP(int32_t(Math::floor(to)), 0, size[i] - 1);
+			}
+			return true;
+		}
+
+		// Bins the lights into cells, call after filling the lights.
+		void build();
+
+		// Calls p_callback once with the index of every light that overlaps p_aabb and affects p_layer_mask, until it returns true.
+		template <class F>
+		_FORCE_INLINE_ void query(const AABB &p_aabb, uint32_t p_layer_mask, F &p_callback) const {
+			int32_t from[3], to[3];
+			if (lights.is_empty() || !get_cell_range(p_aabb, from, to)) {
+				return;
+			}
+			for (int32_t z = from[2]; z <= to[2]; z++) {
+				for (int32_t y = from[1]; y <= to[1]; y++) {
+					for (int32_t x = from[0]; x <= to[0]; x++) {
+						uint32_t cell = (z * size[1] + y) * size[0] + x;
+						for (uint32_t i = cell_offsets[cell]; i < cell_offsets[cell + 1]; i++) {
+							const Light &l = lights[cell_lights[i]];
+
+							// A light spanning several of these cells is only considered in the first cell both share.
+							if (x != MAX(l.cell_from[0], from[0]) || y != MAX(l.cell_from[1], from[1]) || z != MAX(l.cell_from[2], from[2])) {
+								continue;
+							}
+							if (!(l.cull_mask & p_layer_mask) || !l.aabb.intersects(p_aabb)) {
+								continue;
+							}
+							if (p_callback(cell_lights[i])) {
+								return;
+							}
+						}
+					}
+				}
+			}
+		}
+	};
+
+	LightPairGrid light_pair_grid;
 
 	RID_Owner<Instance, true> instance_owner;
 
@@ -978,6 +1113,10 @@ public:
 
 	virtual void instance_set_ignore_culling(RID p_instance, bool p_enabled);
 
+	virtual void instances_initialize(const Vector<RID> &p_instances, RID p_base, RID p_scenario, const Vector<Transform3D> &p_transforms);
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms);
+	virtual void instances_set_visible(const Vector<RID> &p_instances, const Vector<uint8_t> &p_visible);
+
 	bool _update_instance_visibility_depth(Instance *p_instance);
 	void _update_instance_visibility_dependencies(Instance *p_instance);
 
@@ -1076,11 +1215,19 @@ public:
 		const RendererSceneOcclusionCull::HZBuffer *occlusion_buffer;
 		const Projection *camera_matrix;
 		uint64_t visibility_viewport_mask;
+		uint8_t *cull_candidates = nullptr; // When set, instances whose byte is zero are skipped.
+		bool rebuild_cull_candidates = false; // When set, the candidate bytes are recomputed instead.
 	};
 
 	void _scene_cull_threaded(uint32_t p_thread, CullData *cull_data);
 	void _scene_cull(CullData &cull_data, InstanceCullResult &cull_result, uint64_t p_from, uint64_t p_to);
 	_FORCE_INLINE_ bool _visibility_parent_check(const CullData &p_cull_data, const InstanceData &p_instance_data);
+	_FORCE_INLINE_ bool _is_cull_candidate(const CullData &p_cull_data, uint64_t p_index) const;
+	void _update_cull_coherence(CullData &r_cull_data, RID p_viewport);
+
+	void _light_pair_grid_build(const PagedArray<Instance *> &p_lights);
+	void _light_pair_geometry(uint32_t p_index, PagedArray<Instance *> *p_geometries);
+	void _geometry_instance_dirty_light_shadows(Instance *p_instance, const AABB &p_aabb);
 
 	bool _render_reflection_probe_step(Instance *p_instance, int p_step);
 	void _render_scene(const RendererSceneRender::CameraData *p_camera_data, const Ref<RenderSceneBuffers> &p_render_buffers, RID p_environment, RID p_force_camera_attributes, uint32_t p_visible_layers, RID p_scenario, RID p_viewport, RID p_shadow_atlas, RID p_reflection_probe, int p_reflection_probe_pass, float p_screen_mesh_lod_threshold, bool p_using_shadows = true, RenderInfo *r_render_info = nullptr);
@@ -1091,6 +1238,7 @@ public:
 
 	void render_particle_colliders();
 	virtual void render_probes();
+	virtual uint64_t take_stage_time_usec(RS::FrameStage p_stage);
 
 	TypedArray<Image> bake_render_uv2(RID p_base, const TypedArray<RID> &p_material_overrides, const Size2i &p_image_size);
 
@@ -184,6 +184,9 @@ public:
 	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) { _print_warning(); }
 	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) { _print_warning(); }
 	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {}
+	virtual uint32_t buffer_get_ray_count(RID p_buffer) {
+		return 0;
+	}
 
 	virtual RID buffer_get_debug_texture(RID p_buffer) {
 		_print_warning();
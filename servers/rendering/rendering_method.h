@@ -89,6 +89,10 @@ public:
 
 	virtual void instance_set_ignore_culling(RID p_instance, bool p_enabled) = 0;
 
+	virtual void instances_initialize(const Vector<RID> &p_instances, RID p_base, RID p_scenario, const Vector<Transform3D> &p_transforms) = 0;
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) = 0;
+	virtual void instances_set_visible(const Vector<RID> &p_instances, const Vector<uint8_t> &p_visible) = 0;
+
 	// don't use these in a game!
 	virtual Vector<ObjectID> instances_cull_aabb(const AABB &p_aabb, RID p_scenario = RID()) const = 0;
 	virtual Vector<ObjectID> instances_cull_ray(const Vector3 &p_from, const Vector3 &p_to, RID p_scenario = RID()) const = 0;
@@ -305,6 +309,9 @@ public:
 
 	virtual void update() = 0;
 	virtual void render_probes() = 0;
+
+	// Returns the CPU time spent in RS::FRAME_STAGE_SCENE_CULL or RS::FRAME_STAGE_LIGHT_SETUP since the last call, in microseconds.
+	virtual uint64_t take_stage_time_usec(RS::FrameStage p_stage) = 0;
 	virtual void update_visibility_notifiers() = 0;
 
 	virtual void decals_set_filter(RS::DecalFilter p_filter) = 0;
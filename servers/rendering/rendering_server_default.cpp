@@ -78,18 +78,36 @@ void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
 
 	TIMESTAMP_BEGIN()
 
-	uint64_t time_usec = OS::get_singleton()->get_ticks_usec();
+	uint64_t stage_usec = OS::get_singleton()->get_ticks_usec();
+
+	// Time spent in each CPU-side stage of the frame, in milliseconds.
+	auto end_stage = [&](FrameStage p_stage) {
+		uint64_t now = OS::get_singleton()->get_ticks_usec();
+		frame_stage_time[p_stage] = double(now - stage_usec) / 1000.0;
+		stage_usec = now;
+	};
 
 	RSG::scene->update(); //update scenes stuff before updating instances
 
-	frame_setup_time = double(OS::get_singleton()->get_ticks_usec() - time_usec) / 1000.0;
+	end_stage(FRAME_STAGE_SCENE_UPDATE);
+	frame_setup_time = frame_stage_time[FRAME_STAGE_SCENE_UPDATE];
 
 	RSG::particles_storage->update_particles(); //need to be done after instances are updated (colliders and particle transforms), and colliders are rendered
+	end_stage(FRAME_STAGE_PARTICLES);
 
 	RSG::scene->render_probes();
+	end_stage(FRAME_STAGE_PROBES);
 
 	RSG::viewport->draw_viewports();
+	end_stage(FRAME_STAGE_VIEWPORTS);
+
+	// Parts of the viewports stage, accumulated over all viewports.
+	frame_stage_time[FRAME_STAGE_SCENE_CULL] = double(RSG::scene->take_stage_time_usec(FRAME_STAGE_SCENE_CULL)) / 1000.0;
+	frame_stage_time[FRAME_STAGE_LIGHT_SETUP] = double(RSG::scene->take_stage_time_usec(FRAME_STAGE_LIGHT_SETUP)) / 1000.0;
+	frame_stage_time[FRAME_STAGE_CANVAS_CULL] = double(RSG::canvas->take_cull_time_usec()) / 1000.0;
+
 	RSG::canvas_render->update();
+	end_stage(FRAME_STAGE_CANVAS);
 
 	if (OS::get_singleton()->get_current_rendering_driver_name() != "opengl3") {
 		// Already called for gl_compatibility renderer.
@@ -102,8 +120,10 @@ void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
 		xr_server->end_frame();
 	}
 
+	stage_usec = OS::get_singleton()->get_ticks_usec();
 	RSG::canvas->update_visibility_notifiers();
 	RSG::scene->update_visibility_notifiers();
+	end_stage(FRAME_STAGE_VISIBILITY_NOTIFIERS);
 
 	while (frame_drawn_callbacks.front()) {
 		Callable c = frame_drawn_callbacks.front()->get();
@@ -201,6 +221,11 @@ double RenderingServerDefault::get_frame_setup_time_cpu() const {
 	return frame_setup_time;
 }
 
+double RenderingServerDefault::get_frame_stage_time_cpu(FrameStage p_stage) const {
+	ERR_FAIL_INDEX_V(p_stage, FRAME_STAGE_MAX, 0);
+	return frame_stage_time[p_stage];
+}
+
 bool RenderingServerDefault::has_changed() const {
 	return changes > 0;
 }
@@ -254,6 +279,8 @@ uint64_t RenderingServerDefault::get_rendering_info(RenderingInfo p_info) {
 		return RSG::viewport->get_total_primitives_drawn();
 	} else if (p_info == RENDERING_INFO_TOTAL_DRAW_CALLS_IN_FRAME) {
 		return RSG::viewport->get_total_draw_calls_used();
+	} else if (p_info == RENDERING_INFO_TOTAL_OCCLUSION_RAYS_IN_FRAME) {
+		return RSG::viewport->get_total_occlusion_rays();
 	}
 	return RSG::utilities->get_rendering_info(p_info);
 }
@@ -66,6 +66,7 @@ class RenderingServerDefault : public RenderingServer {
 	Vector<FrameProfileArea> frame_profile;
 
 	double frame_setup_time = 0;
+	double frame_stage_time[FRAME_STAGE_MAX] = {};
 
 	//for printing
 	bool print_gpu_profile = false;
@@ -788,6 +789,24 @@ public:
 
 	FUNC2(instance_set_ignore_culling, RID, bool)
 
+	virtual Vector<RID> instances_create(RID p_base, RID p_scenario, const Vector<Transform3D> &p_transforms) override {
+		Vector<RID> ret;
+		ret.resize(p_transforms.size());
+		RID *ptrw = ret.ptrw();
+		for (int i = 0; i < ret.size(); i++) {
+			ptrw[i] = server_name->instance_allocate();
+		}
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(server_name, &ServerName::instances_initialize, ret, p_base, p_scenario, p_transforms);
+		} else {
+			server_name->instances_initialize(ret, p_base, p_scenario, p_transforms);
+		}
+		return ret;
+	}
+
+	FUNC2(instances_set_transforms, const Vector<RID> &, const Vector<Transform3D> &)
+	FUNC2(instances_set_visible, const Vector<RID> &, const Vector<uint8_t> &)
+
 	// don't use these in a game!
 	FUNC2RC(Vector<ObjectID>, instances_cull_aabb, const AABB &, RID)
 	FUNC3RC(Vector<ObjectID>, instances_cull_ray, const Vector3 &, const Vector3 &, RID)
@@ -824,6 +843,7 @@ public:
 	FUNC2(canvas_set_modulate, RID, const Color &)
 	FUNC3(canvas_set_parent, RID, RID, float)
 	FUNC1(canvas_set_disable_scale, bool)
+	FUNC2(canvas_set_use_spatial_index, RID, bool)
 
 	FUNCRIDSPLIT(canvas_texture)
 	FUNC3(canvas_texture_set_channel, RID, CanvasTextureChannel, RID)
@@ -1006,6 +1026,7 @@ public:
 	/* TESTING */
 
 	virtual double get_frame_setup_time_cpu() const override;
+	virtual double get_frame_stage_time_cpu(FrameStage p_stage) const override;
 
 	virtual void set_boot_image(const Ref<Image> &p_image, const Color &p_color, bool p_scale, bool p_use_filter = true) override;
 	virtual Color get_default_clear_color() override;
@@ -31,7 +31,13 @@
 #include "shader_compiler.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_builder.h"
+#include "core/version.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
 
@@ -1452,7 +1458,7 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
-Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+Error ShaderCompiler::_compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code, bool p_report_errors) {
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1461,6 +1467,10 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 
 	Error err = parser.compile(p_code, info);
 
+	if (err != OK && !p_report_errors) {
+		return err;
+	}
+
 	if (err != OK) {
 		Vector<ShaderLanguage::FilePosition> include_positions = parser.get_include_positions();
 
@@ -1560,9 +1570,522 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	return OK;
 }
 
+// Shaders arrive here already preprocessed, so the code covers included files too.
+String ShaderCompiler::_get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions) const {
+	StringBuilder hash_build;
+
+	hash_build.append("[version]");
+	hash_build.append(VERSION_FULL_BUILD);
+	hash_build.append(VERSION_HASH);
+	hash_build.append("[default_actions]");
+	hash_build.append(actions_sha256);
+	hash_build.append("[mode]");
+	hash_build.append(itos(p_mode));
+	hash_build.append("[entry_points]");
+	for (const KeyValue<StringName, Stage> &E : p_actions->entry_point_stages) {
+		hash_build.append(String(E.key) + ":" + itos(E.value) + ",");
+	}
+	hash_build.append("[render_modes]");
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions->render_mode_values) {
+		hash_build.append(String(E.key) + ":" + itos(E.value.second) + ",");
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->render_mode_flags) {
+		hash_build.append(String(E.key) + ",");
+	}
+	hash_build.append("[usage_flags]");
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		hash_build.append(String(E.key) + ",");
+	}
+	hash_build.append("[write_flags]");
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		hash_build.append(String(E.key) + ",");
+	}
+	hash_build.append("[code]");
+	hash_build.append(p_code);
+
+	return hash_build.as_string().sha256_text();
+}
+
+// Records the actions written by a compile, so they can be replayed later. Render
+// modes that share a value pointer can't be told apart here, but replaying any of
+// them writes the same value.
+void ShaderCompiler::_record_compiled_code(const IdentifierActions *p_actions, const GeneratedCode &p_gen_code, CompiledCode &r_compiled) {
+	r_compiled.gen_code = p_gen_code;
+
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions->render_mode_values) {
+		if (*E.value.first == E.value.second) {
+			r_compiled.render_mode_values.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->render_mode_flags) {
+		if (*E.value) {
+			r_compiled.render_mode_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		if (*E.value) {
+			r_compiled.usage_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		if (*E.value) {
+			r_compiled.write_flags.push_back(E.key);
+		}
+	}
+	if (p_actions->uniforms) {
+		r_compiled.uniforms = *p_actions->uniforms;
+	}
+}
+
+void ShaderCompiler::_replay_compiled_code(const CompiledCode &p_compiled, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	for (const StringName &E : p_compiled.render_mode_values) {
+		Pair<int *, int> *p = p_actions->render_mode_values.getptr(E);
+		if (p) {
+			*p->first = p->second;
+		}
+	}
+	for (const StringName &E : p_compiled.render_mode_flags) {
+		bool **flag = p_actions->render_mode_flags.getptr(E);
+		if (flag) {
+			**flag = true;
+		}
+	}
+	for (const StringName &E : p_compiled.usage_flags) {
+		bool **flag = p_actions->usage_flag_pointers.getptr(E);
+		if (flag) {
+			**flag = true;
+		}
+	}
+	for (const StringName &E : p_compiled.write_flags) {
+		bool **flag = p_actions->write_flag_pointers.getptr(E);
+		if (flag) {
+			**flag = true;
+		}
+	}
+	if (p_actions->uniforms) {
+		for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : p_compiled.uniforms) {
+			p_actions->uniforms->insert(E.key, E.value);
+		}
+	}
+
+	r_gen_code = p_compiled.gen_code;
+}
+
+static const char *shader_cache_file_header = "GDSF";
+static const uint32_t shader_cache_file_version = 1;
+
+static void _store_string_list(Ref<FileAccess> p_file, const Vector<StringName> &p_list) {
+	p_file->store_32(p_list.size());
+	for (const StringName &E : p_list) {
+		p_file->store_pascal_string(E);
+	}
+}
+
+static Vector<StringName> _get_string_list(Ref<FileAccess> p_file) {
+	Vector<StringName> list;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		list.push_back(p_file->get_pascal_string());
+	}
+	return list;
+}
+
+bool ShaderCompiler::_load_from_cache(const String &p_key, CompiledCode &r_compiled) const {
+	Ref<FileAccess> f = FileAccess::open(shader_cache_dir.path_join(p_key) + ".cache", FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V(header != String(shader_cache_file_header), false);
+
+	uint32_t file_version = f->get_32();
+	if (file_version != shader_cache_file_version) {
+		return false; // Wrong version.
+	}
+
+	GeneratedCode &gen_code = r_compiled.gen_code;
+
+	uint32_t define_count = f->get_32();
+	for (uint32_t i = 0; i < define_count && !f->eof_reached(); i++) {
+		gen_code.defines.push_back(f->get_pascal_string());
+	}
+
+	uint32_t texture_count = f->get_32();
+	for (uint32_t i = 0; i < texture_count && !f->eof_reached(); i++) {
+		GeneratedCode::Texture texture;
+		texture.name = f->get_pascal_string();
+		texture.type = ShaderLanguage::DataType(f->get_32());
+		texture.hint = ShaderLanguage::ShaderNode::Uniform::Hint(f->get_32());
+		texture.use_color = f->get_8();
+		texture.filter = ShaderLanguage::TextureFilter(f->get_32());
+		texture.repeat = ShaderLanguage::TextureRepeat(f->get_32());
+		texture.global = f->get_8();
+		texture.array_size = f->get_32();
+		gen_code.texture_uniforms.push_back(texture);
+	}
+
+	uint32_t offset_count = f->get_32();
+	for (uint32_t i = 0; i < offset_count && !f->eof_reached(); i++) {
+		gen_code.uniform_offsets.push_back(f->get_32());
+	}
+	gen_code.uniform_total_size = f->get_32();
+	gen_code.uniforms = f->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		gen_code.stage_globals[i] = f->get_pascal_string();
+	}
+
+	uint32_t code_count = f->get_32();
+	for (uint32_t i = 0; i < code_count && !f->eof_reached(); i++) {
+		String key = f->get_pascal_string();
+		gen_code.code[key] = f->get_pascal_string();
+	}
+
+	gen_code.uses_global_textures = f->get_8();
+	gen_code.uses_fragment_time = f->get_8();
+	gen_code.uses_vertex_time = f->get_8();
+	gen_code.uses_screen_texture_mipmaps = f->get_8();
+	gen_code.uses_screen_texture = f->get_8();
+	gen_code.uses_depth_texture = f->get_8();
+	gen_code.uses_normal_roughness_texture = f->get_8();
+
+	r_compiled.render_mode_values = _get_string_list(f);
+	r_compiled.render_mode_flags = _get_string_list(f);
+	r_compiled.usage_flags = _get_string_list(f);
+	r_compiled.write_flags = _get_string_list(f);
+
+	uint32_t uniform_count = f->get_32();
+	for (uint32_t i = 0; i < uniform_count && !f->eof_reached(); i++) {
+		StringName name = f->get_pascal_string();
+		ShaderLanguage::ShaderNode::Uniform uniform;
+		uniform.order = f->get_32();
+		uniform.texture_order = f->get_32();
+		uniform.texture_binding = f->get_32();
+		uniform.type = ShaderLanguage::DataType(f->get_32());
+		uniform.precision = ShaderLanguage::DataPrecision(f->get_32());
+		uniform.array_size = f->get_32();
+		uint32_t value_count = f->get_32();
+		for (uint32_t j = 0; j < value_count && !f->eof_reached(); j++) {
+			ShaderLanguage::ConstantNode::Value value;
+			value.uint = f->get_32();
+			uniform.default_value.push_back(value);
+		}
+		uniform.scope = ShaderLanguage::ShaderNode::Uniform::Scope(f->get_32());
+		uniform.hint = ShaderLanguage::ShaderNode::Uniform::Hint(f->get_32());
+		uniform.use_color = f->get_8();
+		uniform.filter = ShaderLanguage::TextureFilter(f->get_32());
+		uniform.repeat = ShaderLanguage::TextureRepeat(f->get_32());
+		for (int j = 0; j < 3; j++) {
+			uniform.hint_range[j] = f->get_float();
+		}
+		uniform.instance_index = f->get_32();
+		uniform.group = f->get_pascal_string();
+		uniform.subgroup = f->get_pascal_string();
+
+		// Global uniforms are type checked against the project when parsing.
+		if (uniform.scope == ShaderLanguage::ShaderNode::Uniform::SCOPE_GLOBAL && _get_global_shader_uniform_type(name) != uniform.type) {
+			return false;
+		}
+		r_compiled.uniforms.insert(name, uniform);
+	}
+
+	return !f->eof_reached(); // Truncated otherwise.
+}
+
+void ShaderCompiler::_save_to_cache(const String &p_key, const CompiledCode &p_compiled) const {
+	// Write to a file of our own and move it in place once complete, so that other threads
+	// or processes compiling the same shader never load a partially written cache file.
+	const String path = shader_cache_dir.path_join(p_key) + ".cache";
+	const String temp_path = path + "." + itos(Thread::get_caller_id()) + ".tmp";
+	Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+	ERR_FAIL_COND(f.is_null());
+	f->store_buffer((const uint8_t *)shader_cache_file_header, 4);
+	f->store_32(shader_cache_file_version);
+
+	const GeneratedCode &gen_code = p_compiled.gen_code;
+
+	f->store_32(gen_code.defines.size());
+	for (const String &E : gen_code.defines) {
+		f->store_pascal_string(E);
+	}
+
+	f->store_32(gen_code.texture_uniforms.size());
+	for (const GeneratedCode::Texture &E : gen_code.texture_uniforms) {
+		f->store_pascal_string(E.name);
+		f->store_32(E.type);
+		f->store_32(E.hint);
+		f->store_8(E.use_color);
+		f->store_32(E.filter);
+		f->store_32(E.repeat);
+		f->store_8(E.global);
+		f->store_32(E.array_size);
+	}
+
+	f->store_32(gen_code.uniform_offsets.size());
+	for (const uint32_t &E : gen_code.uniform_offsets) {
+		f->store_32(E);
+	}
+	f->store_32(gen_code.uniform_total_size);
+	f->store_pascal_string(gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(gen_code.stage_globals[i]);
+	}
+
+	f->store_32(gen_code.code.size());
+	for (const KeyValue<String, String> &E : gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+
+	f->store_8(gen_code.uses_global_textures);
+	f->store_8(gen_code.uses_fragment_time);
+	f->store_8(gen_code.uses_vertex_time);
+	f->store_8(gen_code.uses_screen_texture_mipmaps);
+	f->store_8(gen_code.uses_screen_texture);
+	f->store_8(gen_code.uses_depth_texture);
+	f->store_8(gen_code.uses_normal_roughness_texture);
+
+	_store_string_list(f, p_compiled.render_mode_values);
+	_store_string_list(f, p_compiled.render_mode_flags);
+	_store_string_list(f, p_compiled.usage_flags);
+	_store_string_list(f, p_compiled.write_flags);
+
+	f->store_32(p_compiled.uniforms.size());
+	for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : p_compiled.uniforms) {
+		const ShaderLanguage::ShaderNode::Uniform &uniform = E.value;
+		f->store_pascal_string(E.key);
+		f->store_32(uniform.order);
+		f->store_32(uniform.texture_order);
+		f->store_32(uniform.texture_binding);
+		f->store_32(uniform.type);
+		f->store_32(uniform.precision);
+		f->store_32(uniform.array_size);
+		f->store_32(uniform.default_value.size());
+		for (const ShaderLanguage::ConstantNode::Value &value : uniform.default_value) {
+			f->store_32(value.uint);
+		}
+		f->store_32(uniform.scope);
+		f->store_32(uniform.hint);
+		f->store_8(uniform.use_color);
+		f->store_32(uniform.filter);
+		f->store_32(uniform.repeat);
+		for (int j = 0; j < 3; j++) {
+			f->store_float(uniform.hint_range[j]);
+		}
+		f->store_32(uniform.instance_index);
+		f->store_pascal_string(uniform.group);
+		f->store_pascal_string(uniform.subgroup);
+	}
+
+	const bool failed = f->get_error() != OK;
+	f->close();
+	if (failed) {
+		DirAccess::remove_absolute(temp_path);
+		ERR_FAIL_MSG("Failed to write shader cache file: " + path);
+	}
+
+	if (DirAccess::rename_absolute(temp_path, path) != OK) {
+		// Another thread may have moved the same shader in place, in which case the existing file is just as good.
+		DirAccess::remove_absolute(temp_path);
+	}
+}
+
+// Keeps which actions the caller passed for this mode, and which of them alias
+// the same pointer, so precompile() can stand in for the caller.
+void ShaderCompiler::_store_actions_template(RS::ShaderMode p_mode, const IdentifierActions *p_actions) {
+	ActionsTemplate &t = action_templates[p_mode];
+	t = ActionsTemplate();
+
+	t.entry_point_stages = p_actions->entry_point_stages;
+
+	HashMap<int *, int> value_slots;
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions->render_mode_values) {
+		if (!value_slots.has(E.value.first)) {
+			value_slots.insert(E.value.first, t.value_defaults.size());
+			t.value_defaults.push_back(*E.value.first);
+		}
+		t.render_mode_values.insert(E.key, Pair<int, int>(value_slots[E.value.first], E.value.second));
+	}
+
+	HashMap<bool *, int> flag_slots;
+	const HashMap<StringName, bool *> *flag_maps[3] = { &p_actions->render_mode_flags, &p_actions->usage_flag_pointers, &p_actions->write_flag_pointers };
+	for (int i = 0; i < 3; i++) {
+		for (const KeyValue<StringName, bool *> &E : *flag_maps[i]) {
+			if (!flag_slots.has(E.value)) {
+				flag_slots.insert(E.value, t.flag_defaults.size());
+				t.flag_defaults.push_back(*E.value);
+			}
+			t.flags[i].insert(E.key, flag_slots[E.value]);
+		}
+	}
+
+	t.has_uniforms = p_actions->uniforms != nullptr;
+	t.valid = true;
+
+	mode_compilers[p_mode] = this;
+}
+
+void ShaderCompiler::_precompile_thread(uint32_t p_thread, PrecompileData *p_data) {
+	ShaderCompiler *compiler = precompilers[p_thread];
+	const ActionsTemplate &t = action_templates[p_data->mode];
+
+	for (uint32_t i = p_thread; i < (uint32_t)p_data->code.size(); i += p_data->thread_count) {
+		// Stand-ins for the caller's variables, the compile only needs somewhere to write.
+		LocalVector<int> values = t.value_defaults;
+		LocalVector<bool> flags = t.flag_defaults;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+
+		IdentifierActions actions;
+		actions.entry_point_stages = t.entry_point_stages;
+		for (const KeyValue<StringName, Pair<int, int>> &E : t.render_mode_values) {
+			actions.render_mode_values.insert(E.key, Pair<int *, int>(&values[E.value.first], E.value.second));
+		}
+		HashMap<StringName, bool *> *flag_maps[3] = { &actions.render_mode_flags, &actions.usage_flag_pointers, &actions.write_flag_pointers };
+		for (int j = 0; j < 3; j++) {
+			for (const KeyValue<StringName, int> &E : t.flags[j]) {
+				flag_maps[j]->insert(E.key, &flags[E.value]);
+			}
+		}
+		actions.uniforms = t.has_uniforms ? &uniforms : nullptr;
+
+		const String &code = p_data->code[i];
+		String key = compiler->_get_cache_key(p_data->mode, code, &actions);
+
+		CompiledCode compiled;
+		if (shader_cache_dir.is_empty() || !compiler->_load_from_cache(key, compiled)) {
+			GeneratedCode gen_code;
+			if (compiler->_compile(p_data->mode, code, &actions, String(), gen_code, false) != OK) {
+				continue; // Reported when the shader is compiled for real.
+			}
+			_record_compiled_code(&actions, gen_code, compiled);
+			if (!shader_cache_dir.is_empty()) {
+				compiler->_save_to_cache(key, compiled);
+			}
+		}
+
+		MutexLock lock(precompiled_mutex);
+		precompiled.insert(key, compiled);
+	}
+}
+
+// Runs the front end for several shaders of one mode on the worker threads. The
+// results are kept until compile() is called for the same code, which then only
+// has to replay them. Needs a previous compile of the mode to know the caller's actions.
+void ShaderCompiler::precompile(RS::ShaderMode p_mode, const Vector<String> &p_code) {
+	ERR_FAIL_INDEX(p_mode, RS::SHADER_MAX);
+	ShaderCompiler *self = mode_compilers[p_mode];
+	if (!self || p_code.size() < 2) {
+		return; // Nothing compiled for this mode yet, or nothing to gain.
+	}
+
+	{
+		MutexLock lock(self->precompiled_mutex);
+		self->precompiled.clear();
+	}
+
+	uint32_t thread_count = MIN((uint32_t)p_code.size(), (uint32_t)MAX(1, WorkerThreadPool::get_singleton()->get_thread_count()));
+	while (self->precompilers.size() < thread_count) {
+		ShaderCompiler *compiler = memnew(ShaderCompiler);
+		compiler->initialize(self->actions);
+		self->precompilers.push_back(compiler);
+	}
+
+	PrecompileData data;
+	data.mode = p_mode;
+	data.code = p_code;
+	data.thread_count = thread_count;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(self, &ShaderCompiler::_precompile_thread, &data, thread_count, -1, true, SNAME("ShaderPrecompile"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+bool ShaderCompiler::can_precompile(RS::ShaderMode p_mode) {
+	ERR_FAIL_INDEX_V(p_mode, RS::SHADER_MAX, false);
+	return mode_compilers[p_mode] != nullptr;
+}
+
+Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+
+	if (!action_templates[p_mode].valid) {
+		_store_actions_template(p_mode, p_actions);
+	}
+
+	String key;
+	CompiledCode compiled;
+	bool found = false;
+	Error err = OK;
+
+	if (!shader_cache_dir.is_empty() || !precompiled.is_empty()) {
+		key = _get_cache_key(p_mode, p_code, p_actions);
+
+		MutexLock lock(precompiled_mutex);
+		HashMap<String, CompiledCode>::Iterator E = precompiled.find(key);
+		if (E) {
+			compiled = E->value;
+			precompiled.remove(E);
+			found = true;
+		}
+	}
+
+	if (!found && !shader_cache_dir.is_empty()) {
+		found = _load_from_cache(key, compiled);
+	}
+
+	if (found) {
+		_replay_compiled_code(compiled, p_actions, r_gen_code);
+	} else {
+		err = _compile(p_mode, p_code, p_actions, p_path, r_gen_code);
+		if (err == OK && !shader_cache_dir.is_empty()) {
+			CompiledCode to_save;
+			_record_compiled_code(p_actions, r_gen_code, to_save);
+			_save_to_cache(key, to_save);
+		}
+	}
+
+	print_verbose(vformat("Shader front end: %s compiled in %.2f ms%s.", p_path.is_empty() ? String("(built-in)") : p_path, (OS::get_singleton()->get_ticks_usec() - begin_usec) / 1000.0, found ? " (from cache)" : ""));
+
+	return err;
+}
+
+void ShaderCompiler::set_shader_cache_dir(const String &p_dir) {
+	if (p_dir.is_empty()) {
+		shader_cache_dir = String();
+		return;
+	}
+
+	Ref<DirAccess> d = DirAccess::open(p_dir);
+	ERR_FAIL_COND(d.is_null());
+	if (d->change_dir("ShaderCompiler") != OK) {
+		Error err = d->make_dir("ShaderCompiler");
+		ERR_FAIL_COND(err != OK);
+	}
+	shader_cache_dir = p_dir.path_join("ShaderCompiler");
+}
+
+String ShaderCompiler::shader_cache_dir;
+ShaderCompiler *ShaderCompiler::mode_compilers[RS::SHADER_MAX] = {};
+
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
 
+	StringBuilder hash_build;
+	for (const KeyValue<StringName, String> &E : actions.renames) {
+		hash_build.append(String(E.key) + "=" + E.value + ";");
+	}
+	for (const KeyValue<StringName, String> &E : actions.render_mode_defines) {
+		hash_build.append(String(E.key) + "=" + E.value + ";");
+	}
+	for (const KeyValue<StringName, String> &E : actions.usage_defines) {
+		hash_build.append(String(E.key) + "=" + E.value + ";");
+	}
+	for (const KeyValue<StringName, String> &E : actions.custom_samplers) {
+		hash_build.append(String(E.key) + "=" + E.value + ";");
+	}
+	hash_build.append(vformat("%d,%d,%d,%d,%s,%s,%s,%d,%d,%d", actions.default_filter, actions.default_repeat, actions.base_texture_binding_index, actions.texture_layout_set, actions.base_uniform_string, actions.global_buffer_array_variable, actions.instance_uniform_index_variable, actions.base_varying_index, actions.apply_luminance_multiplier, actions.check_multiview_samplers));
+	actions_sha256 = hash_build.as_string().sha256_text();
+
 	time_name = "TIME";
 
 	List<String> func_list;
@@ -1587,3 +2110,14 @@ void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 
 ShaderCompiler::ShaderCompiler() {
 }
+
+ShaderCompiler::~ShaderCompiler() {
+	for (int i = 0; i < RS::SHADER_MAX; i++) {
+		if (mode_compilers[i] == this) {
+			mode_compilers[i] = nullptr;
+		}
+	}
+	for (ShaderCompiler *compiler : precompilers) {
+		memdelete(compiler);
+	}
+}
@@ -124,14 +124,67 @@ private:
 	HashSet<StringName> fragment_varyings;
 
 	DefaultIdentifierActions actions;
+	String actions_sha256;
 
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
+	Error _compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code, bool p_report_errors = true);
+
+	// The generated code plus what the compile wrote through the identifier actions.
+	struct CompiledCode {
+		GeneratedCode gen_code;
+		Vector<StringName> render_mode_values;
+		Vector<StringName> render_mode_flags;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	};
+
+	static String shader_cache_dir;
+
+	String _get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions) const;
+	static void _record_compiled_code(const IdentifierActions *p_actions, const GeneratedCode &p_gen_code, CompiledCode &r_compiled);
+	static void _replay_compiled_code(const CompiledCode &p_compiled, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	bool _load_from_cache(const String &p_key, CompiledCode &r_compiled) const;
+	void _save_to_cache(const String &p_key, const CompiledCode &p_compiled) const;
+
+	// Actions are stored as slots, actions that share a pointer share a slot.
+	struct ActionsTemplate {
+		bool valid = false;
+		HashMap<StringName, Stage> entry_point_stages;
+		HashMap<StringName, Pair<int, int>> render_mode_values; // Slot and value.
+		LocalVector<int> value_defaults;
+		HashMap<StringName, int> flags[3]; // Render mode, usage and write flags.
+		LocalVector<bool> flag_defaults;
+		bool has_uniforms = false;
+	};
+
+	struct PrecompileData {
+		RS::ShaderMode mode;
+		Vector<String> code;
+		uint32_t thread_count = 1;
+	};
+
+	static ShaderCompiler *mode_compilers[RS::SHADER_MAX];
+	ActionsTemplate action_templates[RS::SHADER_MAX];
+	LocalVector<ShaderCompiler *> precompilers;
+	Mutex precompiled_mutex;
+	HashMap<String, CompiledCode> precompiled; // By cache key, taken by compile().
+
+	void _store_actions_template(RS::ShaderMode p_mode, const IdentifierActions *p_actions);
+	void _precompile_thread(uint32_t p_thread, PrecompileData *p_data);
+
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
+	static bool can_precompile(RS::ShaderMode p_mode);
+	static void precompile(RS::ShaderMode p_mode, const Vector<String> &p_code);
+
+	static void set_shader_cache_dir(const String &p_dir);
+
 	void initialize(DefaultIdentifierActions p_actions);
 	ShaderCompiler();
+	~ShaderCompiler();
 };
 
 #endif // SHADER_COMPILER_H
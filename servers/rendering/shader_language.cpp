@@ -652,9 +652,7 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 
 					static bool suffix_lut[CASE_MAX][127];
 
-					if (!is_const_suffix_lut_initialized) {
-						is_const_suffix_lut_initialized = true;
-
+					if (!is_const_suffix_lut_initialized.is_set()) {
 						for (int i = 0; i < 127; i++) {
 							char t = char(i);
 
@@ -664,6 +662,9 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 							suffix_lut[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
 							suffix_lut[CASE_NONE][i] = false;
 						}
+
+						// Set after filling, parsers on other threads may get here at the same time.
+						is_const_suffix_lut_initialized.set();
 					}
 
 					String str;
@@ -3061,7 +3062,7 @@ const ShaderLanguage::BuiltinFuncConstArgs ShaderLanguage::builtin_func_const_ar
 	{ nullptr, 0, 0, 0 }
 };
 
-bool ShaderLanguage::is_const_suffix_lut_initialized = false;
+SafeFlag ShaderLanguage::is_const_suffix_lut_initialized;
 
 bool ShaderLanguage::_validate_function_call(BlockNode *p_block, const FunctionInfo &p_function_info, OperatorNode *p_func, DataType *r_ret_type, StringName *r_ret_type_str, bool *r_is_custom_function) {
 	ERR_FAIL_COND_V(p_func->op != OP_CALL && p_func->op != OP_CONSTRUCT, false);
@@ -112,6 +112,52 @@ PackedInt64Array RenderingServer::_instances_cull_convex_bind(const TypedArray<P
 	return to_int_array(ids);
 }
 
+static Vector<RID> _rids_from_array(const TypedArray<RID> &p_array) {
+	Vector<RID> rids;
+	rids.resize(p_array.size());
+	RID *w = rids.ptrw();
+	for (int i = 0; i < p_array.size(); i++) {
+		w[i] = p_array[i];
+	}
+	return rids;
+}
+
+// Same layout as a MultiMesh buffer without colors or custom data: 12 floats per transform.
+static Vector<Transform3D> _transforms_from_buffer(const PackedFloat32Array &p_buffer) {
+	Vector<Transform3D> transforms;
+	ERR_FAIL_COND_V_MSG(p_buffer.size() % 12 != 0, transforms, "Transform buffer size must be a multiple of 12.");
+
+	transforms.resize(p_buffer.size() / 12);
+	Transform3D *w = transforms.ptrw();
+	const float *r = p_buffer.ptr();
+	for (int i = 0; i < transforms.size(); i++) {
+		const float *data = r + i * 12;
+		w[i].basis.rows[0] = Vector3(data[0], data[1], data[2]);
+		w[i].basis.rows[1] = Vector3(data[4], data[5], data[6]);
+		w[i].basis.rows[2] = Vector3(data[8], data[9], data[10]);
+		w[i].origin = Vector3(data[3], data[7], data[11]);
+	}
+	return transforms;
+}
+
+TypedArray<RID> RenderingServer::_instances_create_bind(RID p_base, RID p_scenario, const PackedFloat32Array &p_transforms) {
+	Vector<RID> instances = instances_create(p_base, p_scenario, _transforms_from_buffer(p_transforms));
+	TypedArray<RID> ret;
+	ret.resize(instances.size());
+	for (int i = 0; i < instances.size(); i++) {
+		ret[i] = instances[i];
+	}
+	return ret;
+}
+
+void RenderingServer::_instances_set_transforms_bind(const TypedArray<RID> &p_instances, const PackedFloat32Array &p_transforms) {
+	instances_set_transforms(_rids_from_array(p_instances), _transforms_from_buffer(p_transforms));
+}
+
+void RenderingServer::_instances_set_visible_bind(const TypedArray<RID> &p_instances, const PackedByteArray &p_visible) {
+	instances_set_visible(_rids_from_array(p_instances), p_visible);
+}
+
 RID RenderingServer::get_test_texture() {
 	if (test_texture.is_valid()) {
 		return test_texture;
@@ -2297,6 +2343,9 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME);
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME);
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME);
+	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_INSTANCES_TESTED);
+	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_INSTANCES_SKIPPED);
+	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_OCCLUSION_RAYS_IN_FRAME);
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_MAX);
 
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_TYPE_VISIBLE);
@@ -2524,6 +2573,10 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_geometry_get_shader_parameter_default_value", "instance", "parameter"), &RenderingServer::instance_geometry_get_shader_parameter_default_value);
 	ClassDB::bind_method(D_METHOD("instance_geometry_get_shader_parameter_list", "instance"), &RenderingServer::_instance_geometry_get_shader_parameter_list);
 
+	ClassDB::bind_method(D_METHOD("instances_create", "base", "scenario", "transforms"), &RenderingServer::_instances_create_bind);
+	ClassDB::bind_method(D_METHOD("instances_set_transforms", "instances", "transforms"), &RenderingServer::_instances_set_transforms_bind);
+	ClassDB::bind_method(D_METHOD("instances_set_visible", "instances", "visible"), &RenderingServer::_instances_set_visible_bind);
+
 	ClassDB::bind_method(D_METHOD("instances_cull_aabb", "aabb", "scenario"), &RenderingServer::_instances_cull_aabb_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_ray", "from", "to", "scenario"), &RenderingServer::_instances_cull_ray_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_convex", "convex", "scenario"), &RenderingServer::_instances_cull_convex_bind, DEFVAL(RID()));
@@ -2575,6 +2628,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("canvas_set_item_mirroring", "canvas", "item", "mirroring"), &RenderingServer::canvas_set_item_mirroring);
 	ClassDB::bind_method(D_METHOD("canvas_set_modulate", "canvas", "color"), &RenderingServer::canvas_set_modulate);
 	ClassDB::bind_method(D_METHOD("canvas_set_disable_scale", "disable"), &RenderingServer::canvas_set_disable_scale);
+	ClassDB::bind_method(D_METHOD("canvas_set_use_spatial_index", "canvas", "enable"), &RenderingServer::canvas_set_use_spatial_index);
 
 	/* CANVAS TEXTURE */
 
@@ -2792,6 +2846,7 @@ void RenderingServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_render_loop_enabled", "enabled"), &RenderingServer::set_render_loop_enabled);
 
 	ClassDB::bind_method(D_METHOD("get_frame_setup_time_cpu"), &RenderingServer::get_frame_setup_time_cpu);
+	ClassDB::bind_method(D_METHOD("get_frame_stage_time_cpu", "stage"), &RenderingServer::get_frame_stage_time_cpu);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "render_loop_enabled"), "set_render_loop_enabled", "is_render_loop_enabled");
 
@@ -2801,6 +2856,18 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(RENDERING_INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_BUFFER_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_VIDEO_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_TOTAL_OCCLUSION_RAYS_IN_FRAME);
+
+	BIND_ENUM_CONSTANT(FRAME_STAGE_SCENE_UPDATE);
+	BIND_ENUM_CONSTANT(FRAME_STAGE_PARTICLES);
+	BIND_ENUM_CONSTANT(FRAME_STAGE_PROBES);
+	BIND_ENUM_CONSTANT(FRAME_STAGE_VIEWPORTS);
+	BIND_ENUM_CONSTANT(FRAME_STAGE_CANVAS);
+	BIND_ENUM_CONSTANT(FRAME_STAGE_VISIBILITY_NOTIFIERS);
+	BIND_ENUM_CONSTANT(FRAME_STAGE_SCENE_CULL);
+	BIND_ENUM_CONSTANT(FRAME_STAGE_LIGHT_SETUP);
+	BIND_ENUM_CONSTANT(FRAME_STAGE_CANVAS_CULL);
+	BIND_ENUM_CONSTANT(FRAME_STAGE_MAX);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -2992,6 +3059,8 @@ void RenderingServer::init() {
 
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/update_iterations_per_frame", PROPERTY_HINT_RANGE, "0,1024,1"), 10);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/spatial_indexer/threaded_cull_minimum_instances", PROPERTY_HINT_RANGE, "32,65536,1"), 1000);
+	GLOBAL_DEF_RST("rendering/limits/spatial_indexer/use_clustered_light_pairing", false);
+	GLOBAL_DEF_RST("rendering/limits/spatial_indexer/use_temporal_coherence", false);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/limits/forward_renderer/threaded_render_minimum_instances", PROPERTY_HINT_RANGE, "32,65536,1"), 500);
 
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "rendering/limits/cluster_builder/max_clustered_elements", PROPERTY_HINT_RANGE, "32,8192,1"), 512);
@@ -933,6 +933,9 @@ public:
 		VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME,
 		VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME,
 		VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME,
+		VIEWPORT_RENDER_INFO_INSTANCES_TESTED,
+		VIEWPORT_RENDER_INFO_INSTANCES_SKIPPED,
+		VIEWPORT_RENDER_INFO_OCCLUSION_RAYS_IN_FRAME,
 		VIEWPORT_RENDER_INFO_MAX,
 	};
 
@@ -1240,6 +1243,15 @@ public:
 
 	virtual void instance_set_ignore_culling(RID p_instance, bool p_enabled) = 0;
 
+	// Batched versions of the above, each applied to every instance in a single command.
+	virtual Vector<RID> instances_create(RID p_base, RID p_scenario, const Vector<Transform3D> &p_transforms) = 0;
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) = 0;
+	virtual void instances_set_visible(const Vector<RID> &p_instances, const Vector<uint8_t> &p_visible) = 0;
+
+	TypedArray<RID> _instances_create_bind(RID p_base, RID p_scenario, const PackedFloat32Array &p_transforms);
+	void _instances_set_transforms_bind(const TypedArray<RID> &p_instances, const PackedFloat32Array &p_transforms);
+	void _instances_set_visible_bind(const TypedArray<RID> &p_instances, const PackedByteArray &p_visible);
+
 	// Don't use these in a game!
 	virtual Vector<ObjectID> instances_cull_aabb(const AABB &p_aabb, RID p_scenario = RID()) const = 0;
 	virtual Vector<ObjectID> instances_cull_ray(const Vector3 &p_from, const Vector3 &p_to, RID p_scenario = RID()) const = 0;
@@ -1303,6 +1315,7 @@ public:
 	virtual void canvas_set_parent(RID p_canvas, RID p_parent, float p_scale) = 0;
 
 	virtual void canvas_set_disable_scale(bool p_disable) = 0;
+	virtual void canvas_set_use_spatial_index(RID p_canvas, bool p_enable) = 0;
 
 	/* CANVAS TEXTURE */
 	virtual RID canvas_texture_create() = 0;
@@ -1537,6 +1550,7 @@ public:
 		RENDERING_INFO_TEXTURE_MEM_USED,
 		RENDERING_INFO_BUFFER_MEM_USED,
 		RENDERING_INFO_VIDEO_MEM_USED,
+		RENDERING_INFO_TOTAL_OCCLUSION_RAYS_IN_FRAME,
 		RENDERING_INFO_MAX
 	};
 
@@ -1558,6 +1572,21 @@ public:
 
 	virtual double get_frame_setup_time_cpu() const = 0;
 
+	enum FrameStage {
+		FRAME_STAGE_SCENE_UPDATE,
+		FRAME_STAGE_PARTICLES,
+		FRAME_STAGE_PROBES,
+		FRAME_STAGE_VIEWPORTS,
+		FRAME_STAGE_CANVAS,
+		FRAME_STAGE_VISIBILITY_NOTIFIERS,
+		FRAME_STAGE_SCENE_CULL,
+		FRAME_STAGE_LIGHT_SETUP,
+		FRAME_STAGE_CANVAS_CULL,
+		FRAME_STAGE_MAX
+	};
+
+	virtual double get_frame_stage_time_cpu(FrameStage p_stage) const = 0;
+
 	virtual void gi_set_use_half_resolution(bool p_enable) = 0;
 
 	/* TESTING */
@@ -1696,6 +1725,7 @@ VARIANT_ENUM_CAST(RenderingServer::CanvasLightShadowFilter);
 VARIANT_ENUM_CAST(RenderingServer::CanvasOccluderPolygonCullMode);
 VARIANT_ENUM_CAST(RenderingServer::GlobalShaderParameterType);
 VARIANT_ENUM_CAST(RenderingServer::RenderingInfo);
+VARIANT_ENUM_CAST(RenderingServer::FrameStage);
 VARIANT_ENUM_CAST(RenderingServer::Features);
 VARIANT_ENUM_CAST(RenderingServer::CanvasTextureChannel);
 VARIANT_ENUM_CAST(RenderingServer::BakeChannels);
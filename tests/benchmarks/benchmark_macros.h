@@ -0,0 +1,63 @@
+/**************************************************************************/
+/*  benchmark_macros.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef BENCHMARK_MACROS_H
+#define BENCHMARK_MACROS_H
+
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+// Benchmarks are skipped with the rest of the pending tests.
+// Run them with `--test --test-case="*[Benchmark]*" --no-skip`.
+#define TEST_BENCHMARK(name) TEST_CASE_PENDING(name)
+
+// Returns the time taken by p_function, in microseconds.
+template <class F>
+uint64_t benchmark_usec(F p_function) {
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	p_function();
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+// Prints "<description>: <time> ms." When p_count is given, it also prints how many of p_unit were processed per millisecond.
+inline void benchmark_print(const String &p_description, uint64_t p_usec, double p_count = 0.0, const String &p_unit = String()) {
+	double msec = p_usec / 1000.0;
+	if (p_count > 0.0) {
+		print_line(vformat("%s: %.3f ms, %.1f %s per ms.", p_description, msec, p_count / MAX(msec, 0.001), p_unit));
+	} else {
+		print_line(vformat("%s: %.3f ms.", p_description, msec));
+	}
+}
+
+#endif // BENCHMARK_MACROS_H
@@ -0,0 +1,157 @@
+/**************************************************************************/
+/*  benchmark_navigation_server_3d.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef BENCHMARK_NAVIGATION_SERVER_3D_H
+#define BENCHMARK_NAVIGATION_SERVER_3D_H
+
+#include "scene/resources/primitive_meshes.h"
+#include "servers/navigation_server_3d.h"
+
+#include "tests/benchmarks/benchmark_macros.h"
+
+namespace BenchmarkNavigationServer3D {
+
+TEST_SUITE("[Navigation]") {
+	TEST_BENCHMARK("[NavigationServer3D][Benchmark] Avoidance of a large crowd") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int steps = 20;
+
+		for (int crowd_size : { 1000, 10000 }) {
+			RID map = navigation_server->map_create();
+			navigation_server->map_set_active(map, true);
+
+			// Agents on a jittered grid walking towards the center, so they keep moving between grid cells.
+			const int side = Math::ceil(Math::sqrt(double(crowd_size)));
+			LocalVector<RID> crowd;
+			LocalVector<Vector3> positions;
+			for (int i = 0; i < crowd_size; i++) {
+				const Vector3 position = Vector3((i % side) * 2.0 + (i % 3) * 0.3, 0.0, (i / side) * 2.0 + (i % 5) * 0.2);
+				RID crowd_agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(crowd_agent, map);
+				navigation_server->agent_set_avoidance_enabled(crowd_agent, true);
+				navigation_server->agent_set_radius(crowd_agent, 0.5);
+				navigation_server->agent_set_neighbor_distance(crowd_agent, 5.0);
+				navigation_server->agent_set_max_neighbors(crowd_agent, 10);
+				navigation_server->agent_set_position(crowd_agent, position);
+				crowd.push_back(crowd_agent);
+				positions.push_back(position);
+			}
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			const Vector3 center = Vector3(side, 0.0, side);
+			uint64_t usec = benchmark_usec([&]() {
+				for (int step = 0; step < steps; step++) {
+					for (uint32_t i = 0; i < crowd.size(); i++) {
+						const Vector3 velocity = (center - positions[i]).normalized() * 2.0;
+						positions[i] += velocity * 0.1;
+						navigation_server->agent_set_position(crowd[i], positions[i]);
+						navigation_server->agent_set_velocity(crowd[i], velocity);
+					}
+					navigation_server->process(0.1);
+				}
+			});
+			benchmark_print(vformat("Avoidance of %d agents over %d steps", crowd_size, steps), usec, double(crowd_size) * steps, "agents");
+
+			for (const RID &crowd_agent : crowd) {
+				navigation_server->free(crowd_agent);
+			}
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+	}
+
+	TEST_BENCHMARK("[NavigationServer3D][Benchmark] Bake large procedurally generated level") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const real_t level_size = 256.0;
+		const int pillar_spacing = 4;
+
+		// Floor with a grid of pillars and walls, the pillar at the origin is moved between rebakes.
+		Array floor_arr;
+		floor_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(floor_arr, Vector3(level_size, 0.001, level_size));
+		Array pillar_arr;
+		pillar_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(pillar_arr, Vector3(1.0, 2.0, 1.0));
+		Array wall_arr;
+		wall_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(wall_arr, Vector3(pillar_spacing * 3.0, 2.0, 0.5));
+
+		const int half_count = int(level_size / 2.0) / pillar_spacing - 1;
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry[2];
+		for (int variant = 0; variant < 2; variant++) {
+			source_geometry[variant].instantiate();
+			source_geometry[variant]->add_mesh_array(floor_arr, Transform3D());
+			for (int x = -half_count; x <= half_count; x++) {
+				for (int z = -half_count; z <= half_count; z++) {
+					const Vector3 position = Vector3(x * pillar_spacing, 1.0, z * pillar_spacing);
+					if (x == 0 && z == 0) {
+						source_geometry[variant]->add_mesh_array(pillar_arr, Transform3D(Basis(), position + Vector3(variant, 0.0, 0.0)));
+					} else if ((x * 7 + z * 13) % 11 == 0) {
+						source_geometry[variant]->add_mesh_array(wall_arr, Transform3D(Basis(Vector3(0.0, 1.0, 0.0), (x + z) % 2 ? Math_PI * 0.5 : 0.0), position));
+					} else if ((x + z) % 2 == 0) {
+						source_geometry[variant]->add_mesh_array(pillar_arr, Transform3D(Basis(), position));
+					}
+				}
+			}
+		}
+
+		Ref<NavigationMesh> single_pass_mesh;
+		single_pass_mesh.instantiate();
+		uint64_t single_pass_usec = benchmark_usec([&]() {
+			navigation_server->bake_from_source_geometry_data(single_pass_mesh, source_geometry[0], Callable());
+		});
+		CHECK_NE(single_pass_mesh->get_polygon_count(), 0);
+		benchmark_print(vformat("Single pass bake of a %dx%d level, %d polygons", int(level_size), int(level_size), single_pass_mesh->get_polygon_count()), single_pass_usec);
+
+		for (int tile_size : { 64, 128, 256 }) {
+			Ref<NavigationMesh> tiled_mesh;
+			tiled_mesh.instantiate();
+			tiled_mesh->set_tile_size(tile_size);
+
+			uint64_t full_usec = benchmark_usec([&]() {
+				navigation_server->bake_from_source_geometry_data(tiled_mesh, source_geometry[0], Callable());
+			});
+			CHECK_NE(tiled_mesh->get_polygon_count(), 0);
+			benchmark_print(vformat("Tiled bake with tile size %d, %d polygons", tile_size, tiled_mesh->get_polygon_count()), full_usec);
+
+			// Only the tiles around the moved pillar have to be baked again.
+			uint64_t rebake_usec = benchmark_usec([&]() {
+				navigation_server->bake_from_source_geometry_data(tiled_mesh, source_geometry[1], Callable());
+			});
+			CHECK_NE(tiled_mesh->get_polygon_count(), 0);
+			benchmark_print(vformat("Rebake with tile size %d after moving one pillar", tile_size), rebake_usec);
+		}
+	}
+}
+
+} // namespace BenchmarkNavigationServer3D
+
+#endif // BENCHMARK_NAVIGATION_SERVER_3D_H
@@ -0,0 +1,173 @@
+/**************************************************************************/
+/*  benchmark_object.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_OBJECT_H
+#define BENCHMARK_OBJECT_H
+
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+#include "core/os/thread.h"
+
+#include "tests/benchmarks/benchmark_macros.h"
+#include "tests/core/object/test_object.h"
+
+namespace BenchmarkObject {
+
+using TestObject::ObjectDBLookupTask;
+using TestObject::SignalReceiver;
+
+TEST_BENCHMARK("[Object][Benchmark] Signal emission") {
+	const int emissions = 1000000;
+	const int connections = 4;
+
+	Object emitter;
+	SignalReceiver receivers[connections];
+	Variant arg = 1;
+
+	for (int argc = 0; argc <= 5; argc++) {
+		StringName signal_name = vformat("signal_%d", argc);
+		emitter.add_user_signal(MethodInfo(signal_name));
+
+		for (SignalReceiver &receiver : receivers) {
+			switch (argc) {
+				case 0:
+					emitter.connect(signal_name, callable_mp(&receiver, &SignalReceiver::receive_0));
+					break;
+				case 1:
+					emitter.connect(signal_name, callable_mp(&receiver, &SignalReceiver::receive_1));
+					break;
+				case 2:
+					emitter.connect(signal_name, callable_mp(&receiver, &SignalReceiver::receive_2));
+					break;
+				case 3:
+					emitter.connect(signal_name, callable_mp(&receiver, &SignalReceiver::receive_3));
+					break;
+				case 4:
+					emitter.connect(signal_name, callable_mp(&receiver, &SignalReceiver::receive_4));
+					break;
+				case 5:
+					emitter.connect(signal_name, callable_mp(&receiver, &SignalReceiver::receive_5));
+					break;
+			}
+		}
+
+		const Variant *args[5] = { &arg, &arg, &arg, &arg, &arg };
+		uint64_t usec = benchmark_usec([&]() {
+			for (int i = 0; i < emissions; i++) {
+				emitter.emit_signalp(signal_name, args, argc);
+			}
+		});
+
+		CHECK(receivers[0].calls == emissions);
+		for (SignalReceiver &receiver : receivers) {
+			receiver.calls = 0;
+		}
+
+		benchmark_print(vformat("Signal with %d arguments and %d connections", argc, connections), usec, double(emissions), "emissions");
+	}
+}
+
+TEST_BENCHMARK("[Object][Benchmark] ObjectDB lookups from several threads") {
+	const int lookups_per_thread = 10000000;
+	const int objects = 1024;
+
+	LocalVector<Object *> live_objects;
+	for (int i = 0; i < objects; i++) {
+		live_objects.push_back(memnew(Object));
+	}
+
+	for (int thread_count = 1; thread_count <= OS::get_singleton()->get_processor_count(); thread_count *= 2) {
+		LocalVector<ObjectDBLookupTask> tasks;
+		tasks.resize(thread_count);
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+
+		for (ObjectDBLookupTask &task : tasks) {
+			for (Object *E : live_objects) {
+				task.live_ids.push_back(E->get_instance_id());
+				task.live_objects.push_back(E);
+			}
+			task.iterations = lookups_per_thread / objects;
+		}
+
+		uint64_t usec = benchmark_usec([&]() {
+			for (int i = 0; i < thread_count; i++) {
+				threads[i].start(&ObjectDBLookupTask::lookup, &tasks[i]);
+			}
+			for (int i = 0; i < thread_count; i++) {
+				threads[i].wait_to_finish();
+			}
+		});
+
+		uint64_t lookups = 0;
+		for (const ObjectDBLookupTask &task : tasks) {
+			CHECK(task.mismatches == 0);
+			lookups += task.lookups;
+		}
+
+		benchmark_print(vformat("ObjectDB lookups with %d threads", thread_count), usec, double(lookups), "lookups");
+	}
+
+	for (Object *E : live_objects) {
+		memdelete(E);
+	}
+}
+
+TEST_BENCHMARK("[Object][Benchmark] Built-in property access") {
+	const int accesses = 1000000;
+
+	GDREGISTER_CLASS(_TestDerivedObject);
+	GDREGISTER_CLASS(_TestAccessorObject);
+	_TestAccessorObject object;
+
+	const char *properties[] = { "property", "first_value", "anything" };
+	for (const char *property : properties) {
+		StringName name = property;
+		Variant value = object.get(name);
+
+		uint64_t set_usec = benchmark_usec([&]() {
+			for (int i = 0; i < accesses; i++) {
+				object.set(name, value);
+			}
+		});
+		uint64_t get_usec = benchmark_usec([&]() {
+			for (int i = 0; i < accesses; i++) {
+				value = object.get(name);
+			}
+		});
+
+		benchmark_print(vformat("Setting property '%s'", name), set_usec, double(accesses), "sets");
+		benchmark_print(vformat("Getting property '%s'", name), get_usec, double(accesses), "gets");
+	}
+}
+
+} // namespace BenchmarkObject
+
+#endif // BENCHMARK_OBJECT_H
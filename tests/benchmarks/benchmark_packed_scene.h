@@ -0,0 +1,61 @@
+/**************************************************************************/
+/*  benchmark_packed_scene.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_PACKED_SCENE_H
+#define BENCHMARK_PACKED_SCENE_H
+
+#include "scene/resources/packed_scene.h"
+
+#include "tests/benchmarks/benchmark_macros.h"
+#include "tests/scene/test_packed_scene.h"
+
+namespace BenchmarkPackedScene {
+
+TEST_BENCHMARK("[PackedScene][Benchmark] Instantiate 200 node scene 10000 times") {
+	Node *scene = TestPackedScene::_make_test_scene(200);
+
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+	memdelete(scene);
+
+	const int iterations = 10000;
+	uint64_t usec = benchmark_usec([&]() {
+		for (int i = 0; i < iterations; i++) {
+			Node *instance = packed_scene.instantiate();
+			memdelete(instance);
+		}
+	});
+
+	benchmark_print(vformat("Instantiating a 200 node scene %d times", iterations), usec, double(iterations), "instances");
+}
+
+} // namespace BenchmarkPackedScene
+
+#endif // BENCHMARK_PACKED_SCENE_H
@@ -0,0 +1,170 @@
+/**************************************************************************/
+/*  benchmark_renderer_canvas_cull.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_RENDERER_CANVAS_CULL_H
+#define BENCHMARK_RENDERER_CANVAS_CULL_H
+
+#include "tests/benchmarks/benchmark_macros.h"
+#include "tests/servers/rendering/test_renderer_canvas_cull.h"
+
+namespace BenchmarkRendererCanvasCull {
+
+TEST_BENCHMARK("[SceneTree][RendererCanvasCull][Benchmark] Cull a large canvas") {
+	// A canvas with 100,000 static sprites where a 1280x720 view pans across.
+	const int COUNT = 100000;
+	const int FRAMES = 50;
+	RS *rs = RS::get_singleton();
+	Math::seed(0);
+
+	RID canvas = rs->canvas_create();
+	RID parent = rs->canvas_item_create();
+	rs->canvas_item_set_parent(parent, canvas);
+
+	LocalVector<RID> items;
+	items.push_back(parent);
+	for (int i = 0; i < COUNT; i++) {
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, parent);
+		rs->canvas_item_set_draw_index(item, i);
+		rs->canvas_item_set_transform(item, Transform2D(0, Vector2(Math::random(0.0, 20000.0), Math::random(0.0, 20000.0))));
+		TestRendererCanvasCull::draw_sprite(item);
+		items.push_back(item);
+	}
+
+	uint64_t time[2] = {};
+	for (int mode = 0; mode < 2; mode++) {
+		rs->canvas_set_use_spatial_index(canvas, mode == 1);
+		time[mode] = benchmark_usec([&]() {
+			for (int frame = 0; frame < FRAMES; frame++) {
+				Transform2D camera = Transform2D(0, Vector2(-frame * 200, -frame * 200));
+				RSG::canvas->render_canvas(RID(), RSG::canvas->canvas_owner.get_or_null(canvas), camera, nullptr, nullptr, Rect2(0, 0, 1280, 720), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xffffffff);
+			}
+		});
+	}
+
+	benchmark_print(vformat("Canvas culling of %d items over %d frames, full walk", COUNT, FRAMES), time[0], double(FRAMES), "frames");
+	benchmark_print(vformat("Canvas culling of %d items over %d frames, spatial index", COUNT, FRAMES), time[1], double(FRAMES), "frames");
+
+	// The spatial index must attach the same items as the full walk.
+	for (int frame = 0; frame < FRAMES; frame += 10) {
+		Transform2D camera = Transform2D(0, Vector2(-frame * 200, -frame * 200));
+		LocalVector<TestRendererCanvasCull::DrawState> states[2];
+		for (int mode = 0; mode < 2; mode++) {
+			rs->canvas_set_use_spatial_index(canvas, mode == 1);
+			states[mode] = TestRendererCanvasCull::render_canvas(canvas, items, camera, Size2(1280, 720));
+		}
+		bool match = true;
+		int drawn = 0;
+		for (uint32_t i = 0; i < items.size(); i++) {
+			match = match && states[1][i] == states[0][i];
+			drawn += states[0][i].drawn ? 1 : 0;
+		}
+		CHECK_MESSAGE(match, vformat("Drawn items should match in frame %d.", frame));
+		CHECK(drawn > 1);
+		CHECK(drawn < COUNT);
+	}
+
+	for (const RID &rid : items) {
+		rs->free(rid);
+	}
+	rs->free(canvas);
+}
+
+TEST_BENCHMARK("[SceneTree][RendererCanvasCull][Benchmark] Y-sort a large canvas") {
+	// 40,000 y-sorted sprites where one in a hundred moves every frame.
+	const int COUNT = 40000;
+	const int FRAMES = 50;
+	RS *rs = RS::get_singleton();
+	Math::seed(0);
+
+	RID canvas = rs->canvas_create();
+	RID ysort = rs->canvas_item_create();
+	rs->canvas_item_set_parent(ysort, canvas);
+	rs->canvas_item_set_sort_children_by_y(ysort, true);
+
+	// Whole pixel Y positions, so ties are broken by the draw index instead of an approximate comparison.
+	LocalVector<RID> items;
+	LocalVector<int> item_y;
+	items.push_back(ysort);
+	item_y.push_back(0);
+	for (int i = 0; i < COUNT; i++) {
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, ysort);
+		rs->canvas_item_set_draw_index(item, i);
+		item_y.push_back(Math::rand() % 720);
+		rs->canvas_item_set_transform(item, Transform2D(0, Vector2(Math::random(0.0, 1280.0), item_y[i + 1])));
+		TestRendererCanvasCull::draw_sprite(item);
+		items.push_back(item);
+	}
+
+	uint64_t time = benchmark_usec([&]() {
+		for (int frame = 0; frame < FRAMES; frame++) {
+			for (int i = 0; i < COUNT / 100; i++) {
+				int idx = 1 + Math::rand() % COUNT;
+				item_y[idx] = Math::rand() % 720;
+				rs->canvas_item_set_transform(items[idx], Transform2D(0, Vector2(Math::random(0.0, 1280.0), item_y[idx])));
+			}
+			RSG::canvas->render_canvas(RID(), RSG::canvas->canvas_owner.get_or_null(canvas), Transform2D(), nullptr, nullptr, Rect2(0, 0, 1280, 720), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xffffffff);
+		}
+	});
+
+	benchmark_print(vformat("Y-sorted culling of %d items over %d frames", COUNT, FRAMES), time, double(FRAMES), "frames");
+
+	// The incrementally kept order must match sorting all items again.
+	LocalVector<int> expected;
+	for (int i = 1; i <= COUNT; i++) {
+		expected.push_back(i);
+	}
+	struct ExpectedSort {
+		const LocalVector<int> *item_y;
+		bool operator()(int p_left, int p_right) const {
+			return (*item_y)[p_left] == (*item_y)[p_right] ? p_left < p_right : (*item_y)[p_left] < (*item_y)[p_right];
+		}
+	};
+	SortArray<int, ExpectedSort> sorter;
+	sorter.compare.item_y = &item_y;
+	sorter.sort(expected.ptr(), expected.size());
+
+	LocalVector<TestRendererCanvasCull::DrawState> states = TestRendererCanvasCull::render_canvas(canvas, items, Transform2D(), Size2(1280, 720));
+	bool sorted = true;
+	for (int i = 0; i < COUNT; i++) {
+		sorted = sorted && states[expected[i]].drawn && (i == COUNT - 1 || states[expected[i]].next == expected[i + 1]);
+	}
+	CHECK_MESSAGE(sorted, "Items should be drawn in the same order as after a full sort.");
+
+	for (const RID &rid : items) {
+		rs->free(rid);
+	}
+	rs->free(canvas);
+}
+
+} // namespace BenchmarkRendererCanvasCull
+
+#endif // BENCHMARK_RENDERER_CANVAS_CULL_H
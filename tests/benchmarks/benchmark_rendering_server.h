@@ -0,0 +1,243 @@
+/**************************************************************************/
+/*  benchmark_rendering_server.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BENCHMARK_RENDERING_SERVER_H
+#define BENCHMARK_RENDERING_SERVER_H
+
+#include "core/math/random_pcg.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering_server.h"
+
+#include "tests/benchmarks/benchmark_macros.h"
+
+// Frame timing benchmarks for the CPU side of the rendering server.
+// They run on top of the dummy rasterizer so they need no GPU.
+
+namespace BenchmarkRenderingServer {
+
+// The dummy rasterizer creates neither render targets nor render buffers, so its viewports are never drawn.
+// These buffers let the scene be culled for a camera directly, the dummy scene renderer ignores them.
+class BenchmarkRenderSceneBuffers : public RenderSceneBuffers {
+	GDCLASS(BenchmarkRenderSceneBuffers, RenderSceneBuffers);
+
+public:
+	virtual void configure(const RenderSceneBuffersConfiguration *p_config) override {}
+	virtual void set_fsr_sharpness(float p_fsr_sharpness) override {}
+	virtual void set_texture_mipmap_bias(float p_texture_mipmap_bias) override {}
+	virtual void set_use_debanding(bool p_use_debanding) override {}
+};
+
+struct BenchmarkScene {
+	int instances = 0;
+	int lights = 0;
+	int canvas_items = 0;
+	int moving = 0;
+};
+
+class BenchmarkRunner {
+	RID scenario;
+	RID camera;
+	RID canvas;
+	RID mesh;
+
+	LocalVector<RID> instances;
+	LocalVector<RID> lights;
+	LocalVector<RID> light_instances;
+	LocalVector<RID> canvas_items;
+
+	RandomPCG rng;
+
+	Vector3 _random_position(real_t p_extent) {
+		return Vector3(rng.random(-p_extent, p_extent), rng.random(-p_extent, p_extent), rng.random(-p_extent, p_extent));
+	}
+
+public:
+	static const int FRAME_COUNT = 60;
+	static const int WARMUP_FRAMES = 5;
+
+	void setup(const BenchmarkScene &p_scene) {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		rng.seed(12345);
+
+		scenario = rs->scenario_create();
+
+		camera = rs->camera_create();
+		rs->camera_set_perspective(camera, 75.0, 0.05, 500.0);
+		rs->camera_set_transform(camera, Transform3D(Basis(), Vector3(0, 0, 150)));
+
+		canvas = rs->canvas_create();
+
+		mesh = rs->mesh_create();
+
+		for (int i = 0; i < p_scene.instances; i++) {
+			RID instance = rs->instance_create2(mesh, scenario);
+			rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+			rs->instance_set_transform(instance, Transform3D(Basis(), _random_position(100.0)));
+			instances.push_back(instance);
+		}
+
+		for (int i = 0; i < p_scene.lights; i++) {
+			RID light = rs->omni_light_create();
+			rs->light_set_param(light, RS::LIGHT_PARAM_RANGE, 10.0);
+			RID instance = rs->instance_create2(light, scenario);
+			rs->instance_set_transform(instance, Transform3D(Basis(), _random_position(100.0)));
+			lights.push_back(light);
+			light_instances.push_back(instance);
+		}
+
+		for (int i = 0; i < p_scene.canvas_items; i++) {
+			RID item = rs->canvas_item_create();
+			rs->canvas_item_set_parent(item, canvas);
+			rs->canvas_item_set_transform(item, Transform2D(0, Vector2(rng.random(0.0f, 1280.0f), rng.random(0.0f, 720.0f))));
+			rs->canvas_item_add_rect(item, Rect2(0, 0, 16, 16), Color(1, 1, 1));
+			canvas_items.push_back(item);
+		}
+	}
+
+	// Moves the first `p_scene.moving` instances and canvas items every frame.
+	void _move(const BenchmarkScene &p_scene, int p_frame) {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		real_t offset = Math::sin(p_frame * 0.1) * 2.0;
+		for (int i = 0; i < MIN(p_scene.moving, (int)instances.size()); i++) {
+			rs->instance_set_transform(instances[i], Transform3D(Basis(), _random_position(100.0) + Vector3(offset, 0, 0)));
+		}
+		for (int i = 0; i < MIN(p_scene.moving, (int)canvas_items.size()); i++) {
+			rs->canvas_item_set_transform(canvas_items[i], Transform2D(p_frame * 0.01, Vector2(rng.random(0.0f, 1280.0f), rng.random(0.0f, 720.0f))));
+		}
+	}
+
+	// Updates, culls and draws the scene and the canvas the way a viewport does, but without a render target.
+	void run(const String &p_name, const BenchmarkScene &p_scene) {
+		enum Stage {
+			STAGE_SCENE_UPDATE,
+			STAGE_SCENE_CULL,
+			STAGE_LIGHT_SETUP,
+			STAGE_CANVAS_CULL,
+			STAGE_MAX
+		};
+
+		static const char *stage_names[STAGE_MAX] = {
+			"scene_update",
+			"scene_cull",
+			"light_setup",
+			"canvas_cull",
+		};
+
+		const Size2 size = Size2(1280, 720);
+		Ref<RenderSceneBuffers> render_buffers = memnew(BenchmarkRenderSceneBuffers);
+		Ref<XRInterface> xr_interface;
+		RendererCanvasCull::Canvas *canvas_ptr = RSG::canvas->canvas_owner.get_or_null(canvas);
+
+		uint64_t stage_usec[STAGE_MAX] = {};
+		uint64_t frame_usec = 0;
+
+		for (int frame = 0; frame < WARMUP_FRAMES + FRAME_COUNT; frame++) {
+			_move(p_scene, frame);
+
+			uint64_t update_usec = benchmark_usec([&]() {
+				RSG::scene->update();
+			});
+			uint64_t draw_usec = benchmark_usec([&]() {
+				RenderingMethod::RenderInfo render_info;
+				RSG::scene->render_camera(render_buffers, camera, scenario, RID(), size, false, 1.0, RID(), xr_interface, &render_info);
+				RSG::canvas->render_canvas(RID(), canvas_ptr, Transform2D(), nullptr, nullptr, Rect2(Point2(), size), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xffffffff);
+			});
+
+			uint64_t scene_cull = RSG::scene->take_stage_time_usec(RS::FRAME_STAGE_SCENE_CULL);
+			uint64_t light_setup = RSG::scene->take_stage_time_usec(RS::FRAME_STAGE_LIGHT_SETUP);
+			uint64_t canvas_cull = RSG::canvas->take_cull_time_usec();
+			if (frame < WARMUP_FRAMES) {
+				continue;
+			}
+
+			frame_usec += update_usec + draw_usec;
+			stage_usec[STAGE_SCENE_UPDATE] += update_usec;
+			stage_usec[STAGE_SCENE_CULL] += scene_cull;
+			stage_usec[STAGE_LIGHT_SETUP] += light_setup;
+			stage_usec[STAGE_CANVAS_CULL] += canvas_cull;
+		}
+
+		print_line(vformat("Benchmark \"%s\" (%d instances, %d lights, %d canvas items, %d moving), %d frames:", p_name, p_scene.instances, p_scene.lights, p_scene.canvas_items, p_scene.moving, FRAME_COUNT));
+		benchmark_print("  frame", frame_usec / FRAME_COUNT);
+		for (int i = 0; i < STAGE_MAX; i++) {
+			benchmark_print(vformat("  %s", stage_names[i]), stage_usec[i] / FRAME_COUNT);
+		}
+	}
+
+	void teardown() {
+		RenderingServer *rs = RenderingServer::get_singleton();
+		for (const RID &rid : canvas_items) {
+			rs->free(rid);
+		}
+		for (const RID &rid : light_instances) {
+			rs->free(rid);
+		}
+		for (const RID &rid : lights) {
+			rs->free(rid);
+		}
+		for (const RID &rid : instances) {
+			rs->free(rid);
+		}
+		rs->free(mesh);
+		rs->free(canvas);
+		rs->free(camera);
+		rs->free(scenario);
+		canvas_items.clear();
+		light_instances.clear();
+		lights.clear();
+		instances.clear();
+	}
+};
+
+TEST_BENCHMARK("[SceneTree][RenderingServer][Benchmark] CPU frame timings on synthetic scenes") {
+	const struct {
+		const char *name;
+		BenchmarkScene scene;
+	} scenes[] = {
+		{ "empty", { 0, 0, 0, 0 } },
+		{ "static_3d", { 10000, 0, 0, 0 } },
+		{ "lit_3d", { 10000, 256, 0, 0 } },
+		{ "dynamic_3d", { 10000, 256, 0, 2000 } },
+		{ "canvas", { 0, 0, 10000, 2000 } },
+		{ "mixed", { 5000, 128, 5000, 1000 } },
+	};
+
+	for (const auto &entry : scenes) {
+		BenchmarkRunner runner;
+		runner.setup(entry.scene);
+		runner.run(entry.name, entry.scene);
+		runner.teardown();
+	}
+}
+
+} // namespace BenchmarkRenderingServer
+
+#endif // BENCHMARK_RENDERING_SERVER_H
@@ -105,6 +105,13 @@ TEST_CASE("[ProjectSettings] Set value should be returned when retrieved") {
 	CHECK(ProjectSettings::get_singleton()->has_setting("my_custom_setting"));
 }
 
+TEST_CASE("[ProjectSettings] Occlusion culling settings are defined without the rendering server") {
+	// The occlusion culling backends read these when they are created, before RenderingServer::init() runs.
+	CHECK(ProjectSettings::get_singleton()->has_setting("rendering/occlusion_culling/bvh_build_quality"));
+	CHECK(ProjectSettings::get_singleton()->has_setting("rendering/occlusion_culling/use_temporal_reprojection"));
+	CHECK_EQ(true, bool(GLOBAL_GET("rendering/occlusion_culling/use_temporal_reprojection")));
+}
+
 TEST_CASE("[ProjectSettings] localize_path") {
 	String old_resource_path = TestProjectSettingsInternalsAccessor::resource_path();
 	TestProjectSettingsInternalsAccessor::resource_path() = DirAccess::create(DirAccess::ACCESS_FILESYSTEM)->get_current_dir();
@@ -32,6 +32,8 @@
 #define TEST_ASTAR_H
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -357,6 +359,413 @@ TEST_CASE("[Stress][AStar3D] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+
+static real_t get_astar_path_cost(const AStar3D &p_astar, const Vector<int64_t> &p_path) {
+	real_t cost = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		cost += p_astar.get_point_position(p_path[i - 1]).distance_to(p_astar.get_point_position(p_path[i])) * p_astar.get_point_weight_scale(p_path[i]);
+	}
+	return cost;
+}
+
+static bool is_astar_path_valid(const AStar3D &p_astar, const Vector<int64_t> &p_path) {
+	for (int i = 1; i < p_path.size(); i++) {
+		if (p_astar.is_point_disabled(p_path[i]) || !p_astar.are_points_connected(p_path[i - 1], p_path[i], false)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[AStar3D] Batch paths") {
+	Ref<AStar3D> a;
+	a.instantiate();
+	for (int i = 0; i < 6; i++) {
+		a->add_point(i, Vector3(i, i % 2, 0));
+	}
+	for (int i = 0; i < 5; i++) {
+		a->connect_points(i, i + 1);
+	}
+	a->add_point(6, Vector3(10, 0, 0));
+
+	PackedInt64Array from_ids = { 0, 5, 2, 0 };
+	PackedInt64Array to_ids = { 5, 0, 2, 6 };
+	TypedArray<PackedInt64Array> paths = a->get_id_paths(from_ids, to_ids);
+	REQUIRE(paths.size() == 4);
+	for (int i = 0; i < paths.size(); i++) {
+		CHECK(PackedInt64Array(paths[i]) == a->get_id_path(from_ids[i], to_ids[i]));
+	}
+	CHECK(PackedInt64Array(paths[1]).size() == 6);
+	CHECK(PackedInt64Array(paths[2]).size() == 1);
+	CHECK(PackedInt64Array(paths[3]).is_empty());
+
+	ERR_PRINT_OFF;
+	CHECK(a->get_id_paths(from_ids, PackedInt64Array()).is_empty());
+	paths = a->get_id_paths({ 0, 42 }, { 5, 0 });
+	ERR_PRINT_ON;
+	REQUIRE(paths.size() == 2);
+	CHECK(PackedInt64Array(paths[0]).size() == 6);
+	CHECK(PackedInt64Array(paths[1]).is_empty());
+
+	Ref<AStar2D> a2d;
+	a2d.instantiate();
+	a2d->add_point(0, Vector2(0, 0));
+	a2d->add_point(1, Vector2(1, 0));
+	a2d->add_point(2, Vector2(2, 0));
+	a2d->connect_points(0, 1);
+	a2d->connect_points(1, 2, false);
+	paths = a2d->get_id_paths({ 0, 2 }, { 2, 0 });
+	REQUIRE(paths.size() == 2);
+	CHECK(PackedInt64Array(paths[0]) == PackedInt64Array({ 0, 1, 2 }));
+	CHECK(PackedInt64Array(paths[1]).is_empty());
+}
+
+TEST_CASE("[AStar3D] Incremental search") {
+	// Apply the same random changes to two graphs, and compare incremental searches with regular ones.
+	const int N = 40;
+	Math::seed(1);
+
+	AStar3D regular;
+	AStar3D incremental;
+	incremental.set_incremental_search_enabled(true);
+	CHECK(incremental.is_incremental_search_enabled());
+
+	for (int u = 0; u < N; u++) {
+		const Vector3 pos = Vector3(Math::rand() % 100, Math::rand() % 100, Math::rand() % 100);
+		regular.add_point(u, pos);
+		incremental.add_point(u, pos);
+	}
+
+	int64_t to = 0;
+	bool match = true;
+	for (int i = 0; i < 3000 && match; i++) {
+		const int u = Math::rand() % N;
+		const int v = (u + 1 + Math::rand() % (N - 1)) % N;
+		const int op = Math::rand();
+		switch (op % 10) {
+			case 0:
+			case 1:
+			case 2:
+			case 3:
+				regular.connect_points(u, v, op % 2);
+				incremental.connect_points(u, v, op % 2);
+				break;
+			case 4:
+			case 5:
+				regular.disconnect_points(u, v, op % 2);
+				incremental.disconnect_points(u, v, op % 2);
+				break;
+			case 6:
+				regular.set_point_disabled(u, !regular.is_point_disabled(u));
+				incremental.set_point_disabled(u, !incremental.is_point_disabled(u));
+				break;
+			case 7:
+				regular.set_point_weight_scale(u, 1 + Math::rand() % 4);
+				incremental.set_point_weight_scale(u, regular.get_point_weight_scale(u));
+				break;
+			case 8: {
+				// Remove the point and add it back somewhere else.
+				const Vector3 pos = Vector3(Math::rand() % 100, Math::rand() % 100, Math::rand() % 100);
+				regular.remove_point(u);
+				regular.add_point(u, pos);
+				incremental.remove_point(u);
+				incremental.add_point(u, pos);
+			} break;
+			case 9:
+				if (op % 7 == 0) {
+					to = u; // Occasionally search towards another point.
+				}
+				break;
+		}
+
+		// The begin point moves every query, the end point rarely does.
+		const int64_t from = Math::rand() % N;
+		const Vector<int64_t> expected = regular.get_id_path(from, to);
+		const Vector<int64_t> path = incremental.get_id_path(from, to);
+		if (expected.is_empty() != path.is_empty()) {
+			match = false;
+		} else if (!path.is_empty()) {
+			match = path[0] == from && path[path.size() - 1] == to && is_astar_path_valid(incremental, path) &&
+					Math::is_equal_approx(get_astar_path_cost(regular, expected), get_astar_path_cost(incremental, path));
+		}
+		if (!match) {
+			print_verbose(vformat("Step %d: incremental search from %d to %d gives %s, regular search gives %s.", i, from, to, Variant(path), Variant(expected)));
+		}
+	}
+	CHECK_MESSAGE(match, "Incremental search should find paths as short as the regular search.");
+
+	incremental.set_incremental_search_enabled(false);
+	CHECK_FALSE(incremental.is_incremental_search_enabled());
+	CHECK(incremental.get_id_path(0, to) == regular.get_id_path(0, to));
+}
+
+TEST_CASE("[Stress][AStar3D] Replan on a large graph") {
+	// A 300x300 lattice where a wall is opened and closed while the begin point moves towards the end point.
+	const int SIZE = 300;
+	const int STEPS = 20;
+	AStar3D regular;
+	AStar3D incremental;
+	incremental.set_incremental_search_enabled(true);
+	regular.reserve_space(SIZE * SIZE);
+	incremental.reserve_space(SIZE * SIZE);
+
+	for (AStar3D *a : { &regular, &incremental }) {
+		for (int y = 0; y < SIZE; y++) {
+			for (int x = 0; x < SIZE; x++) {
+				a->add_point(y * SIZE + x, Vector3(x, y, 0));
+				if (x > 0) {
+					a->connect_points(y * SIZE + x, y * SIZE + x - 1);
+				}
+				if (y > 0) {
+					a->connect_points(y * SIZE + x, (y - 1) * SIZE + x);
+				}
+			}
+		}
+	}
+
+	const int64_t to = SIZE * SIZE - 1;
+	uint64_t usecs[2] = {};
+	bool match = true;
+	for (int i = 0; i < STEPS; i++) {
+		// Toggle a part of a wall in the middle of the lattice.
+		for (int y = 0; y < SIZE * 3 / 4; y++) {
+			const int64_t id = (i % 2 ? y : SIZE - 1 - y) * SIZE + SIZE / 2;
+			regular.set_point_disabled(id, y < SIZE / 2);
+			incremental.set_point_disabled(id, y < SIZE / 2);
+		}
+
+		const int64_t from = (i * SIZE / (STEPS * 2)) * (SIZE + 1);
+		Vector<int64_t> paths[2];
+		AStar3D *astars[2] = { &regular, &incremental };
+		for (int mode = 0; mode < 2; mode++) {
+			const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+			paths[mode] = astars[mode]->get_id_path(from, to);
+			usecs[mode] += OS::get_singleton()->get_ticks_usec() - begin_usec;
+		}
+
+		REQUIRE(!paths[0].is_empty());
+		match = match && !paths[1].is_empty() && Math::is_equal_approx(get_astar_path_cost(regular, paths[0]), get_astar_path_cost(incremental, paths[1]));
+	}
+
+	print_verbose(vformat("AStar3D %d points, %d replans: A* %d usec, incremental %d usec.", SIZE * SIZE, STEPS, usecs[0], usecs[1]));
+	CHECK_MESSAGE(match, "Incremental search should find paths as short as the regular search.");
+}
+
+static bool is_grid_path_valid(const AStarGrid2D &p_grid, const TypedArray<Vector2i> &p_path) {
+	for (int i = 0; i < p_path.size(); i++) {
+		const Vector2i id = p_path[i];
+		if (p_grid.is_point_solid(id)) {
+			return false;
+		}
+		if (i > 0) {
+			const Vector2i step = id - Vector2i(p_path[i - 1]);
+			if (step == Vector2i() || ABS(step.x) > 1 || ABS(step.y) > 1) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static double get_grid_path_length(const TypedArray<Vector2i> &p_path) {
+	double length = 0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += Vector2(Vector2i(p_path[i - 1])).distance_to(Vector2(Vector2i(p_path[i])));
+	}
+	return length;
+}
+
+TEST_CASE("[AStarGrid2D] Point data") {
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_region(Rect2i(-4, -4, 70, 10));
+	grid->update();
+
+	CHECK_FALSE(grid->is_point_solid(Vector2i(65, 5)));
+	CHECK(grid->get_point_weight_scale(Vector2i(65, 5)) == doctest::Approx(1.0));
+
+	// Solidity is stored per bit, check neighbors across a word boundary.
+	grid->set_point_solid(Vector2i(59, 0));
+	CHECK(grid->is_point_solid(Vector2i(59, 0)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(58, 0)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(60, 0)));
+	grid->set_point_solid(Vector2i(59, 0), false);
+	CHECK_FALSE(grid->is_point_solid(Vector2i(59, 0)));
+
+	grid->fill_solid_region(Rect2i(0, 0, 3, 2));
+	CHECK(grid->is_point_solid(Vector2i(2, 1)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(3, 1)));
+
+	grid->set_point_weight_scale(Vector2i(1, 4), 3.0);
+	CHECK(grid->get_point_weight_scale(Vector2i(1, 4)) == doctest::Approx(3.0));
+	CHECK(grid->get_point_weight_scale(Vector2i(1, 5)) == doctest::Approx(1.0));
+	grid->fill_weight_scale_region(Rect2i(10, 0, 2, 2), 0.5);
+	CHECK(grid->get_point_weight_scale(Vector2i(11, 1)) == doctest::Approx(0.5));
+
+	grid->set_cell_size(Vector2(2, 3));
+	grid->set_offset(Vector2(1, 1));
+	grid->update();
+	CHECK(grid->get_point_position(Vector2i(2, 2)).is_equal_approx(Vector2(5, 7)));
+	CHECK_FALSE(grid->is_point_solid(Vector2i(2, 1)));
+	CHECK(grid->get_point_weight_scale(Vector2i(1, 4)) == doctest::Approx(1.0));
+}
+
+TEST_CASE("[AStarGrid2D] Find paths around obstacles") {
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_region(Rect2i(0, 0, 12, 12));
+	grid->set_cluster_size(4);
+	grid->update();
+	grid->fill_solid_region(Rect2i(5, 0, 1, 10));
+
+	TypedArray<Vector2i> path = grid->get_id_path(Vector2i(0, 0), Vector2i(11, 0));
+	REQUIRE(path.size() > 0);
+	CHECK(Vector2i(path[0]) == Vector2i(0, 0));
+	CHECK(Vector2i(path[path.size() - 1]) == Vector2i(11, 0));
+	CHECK(is_grid_path_valid(**grid, path));
+	const double length = get_grid_path_length(path);
+
+	SUBCASE("Jumping should give a path of the same length") {
+		grid->set_jumping_enabled(true);
+		TypedArray<Vector2i> jump_path = grid->get_id_path(Vector2i(0, 0), Vector2i(11, 0));
+		REQUIRE(jump_path.size() > 0);
+		CHECK(jump_path.size() <= path.size());
+		CHECK(Vector2i(jump_path[jump_path.size() - 1]) == Vector2i(11, 0));
+		CHECK(get_grid_path_length(jump_path) == doctest::Approx(length));
+	}
+
+	SUBCASE("Hierarchical search should give a valid path through the clusters") {
+		grid->set_hierarchical_enabled(true);
+		TypedArray<Vector2i> hierarchical_path = grid->get_id_path(Vector2i(0, 0), Vector2i(11, 0));
+		REQUIRE(hierarchical_path.size() > 0);
+		CHECK(Vector2i(hierarchical_path[0]) == Vector2i(0, 0));
+		CHECK(Vector2i(hierarchical_path[hierarchical_path.size() - 1]) == Vector2i(11, 0));
+		CHECK(is_grid_path_valid(**grid, hierarchical_path));
+		CHECK(get_grid_path_length(hierarchical_path) >= length - CMP_EPSILON);
+
+		// Changing the grid updates the clusters.
+		grid->set_point_solid(Vector2i(5, 10));
+		grid->set_point_solid(Vector2i(5, 11));
+		CHECK(grid->get_id_path(Vector2i(0, 0), Vector2i(11, 0)).is_empty());
+		grid->set_point_solid(Vector2i(5, 11), false);
+		hierarchical_path = grid->get_id_path(Vector2i(0, 0), Vector2i(11, 0));
+		CHECK(hierarchical_path.has(Vector2i(5, 11)));
+		CHECK(is_grid_path_valid(**grid, hierarchical_path));
+	}
+
+	SUBCASE("Blocked paths should be empty") {
+		grid->fill_solid_region(Rect2i(5, 10, 1, 2));
+		CHECK(grid->get_id_path(Vector2i(0, 0), Vector2i(11, 0)).is_empty());
+		grid->set_jumping_enabled(true);
+		CHECK(grid->get_id_path(Vector2i(0, 0), Vector2i(11, 0)).is_empty());
+		grid->set_jumping_enabled(false);
+		grid->set_hierarchical_enabled(true);
+		CHECK(grid->get_id_path(Vector2i(0, 0), Vector2i(11, 0)).is_empty());
+	}
+}
+
+TEST_CASE("[Stress][AStarGrid2D] Compare search modes on maze and open maps") {
+	const int SIZE = 129;
+	const int QUERIES = 20;
+	Math::seed(0);
+
+	Ref<AStarGrid2D> maze;
+	maze.instantiate();
+	maze->set_region(Rect2i(0, 0, SIZE, SIZE));
+	maze->update();
+	maze->fill_solid_region(maze->get_region());
+
+	// Carve a perfect maze, rooms are the points with odd coordinates.
+	LocalVector<Vector2i> stack;
+	stack.push_back(Vector2i(1, 1));
+	maze->set_point_solid(Vector2i(1, 1), false);
+	const Vector2i directions[4] = { Vector2i(2, 0), Vector2i(-2, 0), Vector2i(0, 2), Vector2i(0, -2) };
+	while (!stack.is_empty()) {
+		const Vector2i room = stack[stack.size() - 1];
+		Vector2i unvisited[4];
+		int unvisited_count = 0;
+		for (const Vector2i &direction : directions) {
+			const Vector2i next = room + direction;
+			if (next.x > 0 && next.y > 0 && next.x < SIZE - 1 && next.y < SIZE - 1 && maze->is_point_solid(next)) {
+				unvisited[unvisited_count++] = next;
+			}
+		}
+		if (unvisited_count == 0) {
+			stack.remove_at(stack.size() - 1);
+			continue;
+		}
+		const Vector2i next = unvisited[Math::rand() % unvisited_count];
+		maze->set_point_solid((room + next) / 2, false);
+		maze->set_point_solid(next, false);
+		stack.push_back(next);
+	}
+
+	Ref<AStarGrid2D> open;
+	open.instantiate();
+	open->set_region(Rect2i(0, 0, SIZE, SIZE));
+	open->update();
+	for (int i = 0; i < SIZE * SIZE / 5; i++) {
+		open->set_point_solid(Vector2i(Math::rand() % SIZE, Math::rand() % SIZE));
+	}
+
+	const Ref<AStarGrid2D> maps[2] = { maze, open };
+	const char *map_names[2] = { "maze", "open" };
+	const AStarGrid2D::DiagonalMode diagonal_modes[2] = { AStarGrid2D::DIAGONAL_MODE_NEVER, AStarGrid2D::DIAGONAL_MODE_ALWAYS };
+
+	for (int map_index = 0; map_index < 2; map_index++) {
+		const Ref<AStarGrid2D> &map = maps[map_index];
+		for (const AStarGrid2D::DiagonalMode diagonal_mode : diagonal_modes) {
+			map->set_diagonal_mode(diagonal_mode);
+
+			Vector2i from[QUERIES];
+			Vector2i to[QUERIES];
+			for (int i = 0; i < QUERIES; i++) {
+				do {
+					from[i] = Vector2i(Math::rand() % SIZE, Math::rand() % SIZE);
+				} while (map->is_point_solid(from[i]));
+				do {
+					to[i] = Vector2i(Math::rand() % SIZE, Math::rand() % SIZE);
+				} while (map->is_point_solid(to[i]));
+			}
+
+			double lengths[3][QUERIES];
+			uint64_t usecs[3];
+			const char *mode_names[3] = { "A*", "jump point search", "hierarchical" };
+			for (int mode = 0; mode < 3; mode++) {
+				map->set_jumping_enabled(mode == 1);
+				map->set_hierarchical_enabled(mode == 2);
+				if (mode == 2) {
+					// Build the clusters outside of the measured queries.
+					map->get_id_path(from[0], to[0]);
+				}
+
+				const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+				for (int i = 0; i < QUERIES; i++) {
+					TypedArray<Vector2i> path = map->get_id_path(from[i], to[i]);
+					lengths[mode][i] = path.is_empty() ? -1 : get_grid_path_length(path);
+					if (mode != 1 && !path.is_empty()) {
+						CHECK_MESSAGE(is_grid_path_valid(**map, path), vformat("%s path from %s to %s should be valid.", mode_names[mode], from[i], to[i]));
+					}
+				}
+				usecs[mode] = OS::get_singleton()->get_ticks_usec() - begin_usec;
+			}
+			map->set_jumping_enabled(false);
+			map->set_hierarchical_enabled(false);
+
+			print_verbose(vformat("AStarGrid2D %s map, diagonal mode %d, %d queries: A* %d usec, jump point search %d usec, hierarchical %d usec.", map_names[map_index], diagonal_mode, QUERIES, usecs[0], usecs[1], usecs[2]));
+
+			for (int i = 0; i < QUERIES; i++) {
+				const bool reachable = lengths[0][i] >= 0;
+				CHECK_MESSAGE((lengths[1][i] >= 0) == reachable, vformat("Jump point search should agree with A* on reaching %s from %s.", to[i], from[i]));
+				CHECK_MESSAGE((lengths[2][i] >= 0) == reachable, vformat("Hierarchical search should agree with A* on reaching %s from %s.", to[i], from[i]));
+				if (reachable) {
+					CHECK(lengths[1][i] >= lengths[0][i] * (1.0 - CMP_EPSILON));
+					CHECK(lengths[2][i] >= lengths[0][i] * (1.0 - CMP_EPSILON));
+				}
+			}
+		}
+	}
+}
 } // namespace TestAStar
 
 #endif // TEST_ASTAR_H
@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class MessageReceiver : public Object {
+public:
+	int calls = 0;
+	bool in_order = true;
+	LocalVector<int> last_sequence;
+
+	void receive() {
+		calls++;
+	}
+
+	void receive_sequence(int p_thread, int p_sequence) {
+		calls++;
+		if (last_sequence[p_thread] + 1 != p_sequence) {
+			in_order = false;
+		}
+		last_sequence[p_thread] = p_sequence;
+	}
+};
+
+class MessagePusher {
+public:
+	MessageReceiver *receiver = nullptr;
+
+	void push(uint32_t p_index, int p_count) {
+		for (int i = 0; i < p_count; i++) {
+			MessageQueue::get_singleton()->push_callable(callable_mp(receiver, &MessageReceiver::receive_sequence), p_index, i);
+		}
+	}
+};
+
+TEST_CASE("[MessageQueue] Calls deferred from other threads keep their order") {
+	const int thread_count = 8;
+	const int messages_per_thread = 2000;
+
+	MessageReceiver receiver;
+	receiver.last_sequence.resize(thread_count);
+	for (int i = 0; i < thread_count; i++) {
+		receiver.last_sequence[i] = -1;
+	}
+
+	MessagePusher pusher;
+	pusher.receiver = &receiver;
+
+	// Only tests tagged with [SceneTree] get a message queue from the test runner.
+	MessageQueue *message_queue = memnew(MessageQueue);
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&pusher, &MessagePusher::push, messages_per_thread, thread_count, true, SNAME("MessageQueueTest"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK_MESSAGE(receiver.calls == 0, "Calls deferred from other threads should wait for the queue to be flushed.");
+
+	MessageQueue::get_singleton()->flush();
+
+	CHECK(receiver.calls == thread_count * messages_per_thread);
+	CHECK_MESSAGE(receiver.in_order, "Calls deferred from the same thread should run in the order they were pushed.");
+
+	memdelete(message_queue);
+}
+
+class ThreadedMessagePusher : public Object {
+public:
+	MessagePusher pusher;
+	int thread_count = 0;
+	int messages_per_thread = 0;
+
+	void push_from_threads() {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&pusher, &MessagePusher::push, messages_per_thread, thread_count, true, SNAME("MessageQueueTest"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+};
+
+TEST_CASE("[MessageQueue] Calls deferred from other threads during a flush run in the same flush") {
+	MessageReceiver receiver;
+	ThreadedMessagePusher threaded_pusher;
+	threaded_pusher.pusher.receiver = &receiver;
+	// Enough messages to need new pages while the queue is being flushed.
+	threaded_pusher.thread_count = 8;
+	threaded_pusher.messages_per_thread = 2000;
+
+	receiver.last_sequence.resize(threaded_pusher.thread_count);
+	for (int i = 0; i < threaded_pusher.thread_count; i++) {
+		receiver.last_sequence[i] = -1;
+	}
+
+	MessageQueue *message_queue = memnew(MessageQueue);
+
+	MessageQueue::get_singleton()->push_callable(callable_mp(&threaded_pusher, &ThreadedMessagePusher::push_from_threads));
+	MessageQueue::get_singleton()->flush();
+
+	CHECK(receiver.calls == threaded_pusher.thread_count * threaded_pusher.messages_per_thread);
+	CHECK(receiver.in_order);
+	CHECK_FALSE(MessageQueue::get_singleton()->has_messages());
+
+	memdelete(message_queue);
+}
+
+TEST_CASE("[MessageQueue] Queue grows past its size limit") {
+	MessageReceiver receiver;
+	CallQueue queue(nullptr, 1);
+
+	const int message_count = 1000;
+	ERR_PRINT_OFF;
+	for (int i = 0; i < message_count; i++) {
+		CHECK(queue.push_callable(callable_mp(&receiver, &MessageReceiver::receive)) == OK);
+	}
+	ERR_PRINT_ON;
+
+	CHECK(queue.get_max_buffer_usage() > CallQueue::PAGE_SIZE_BYTES);
+
+	queue.flush();
+	CHECK(receiver.calls == message_count);
+	CHECK_FALSE(queue.has_messages());
+}
+
+TEST_CASE("[MessageQueue] Frame statistics") {
+	MessageReceiver receiver;
+	CallQueue queue;
+
+	for (int i = 0; i < 10; i++) {
+		queue.push_callable(callable_mp(&receiver, &MessageReceiver::receive));
+	}
+	queue.flush();
+	queue.push_callable(callable_mp(&receiver, &MessageReceiver::receive));
+	queue.flush();
+
+	CHECK_MESSAGE(queue.get_frame_flushed_messages() == 0, "Statistics should only be updated at the end of a frame.");
+
+	queue.end_frame_statistics();
+	CHECK(queue.get_frame_flushed_messages() == 11);
+
+	queue.end_frame_statistics();
+	CHECK(queue.get_frame_flushed_messages() == 0);
+	CHECK(queue.get_frame_flush_time_usec() == 0);
+}
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
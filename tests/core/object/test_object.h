@@ -33,8 +33,10 @@
 
 #include "core/core_string_names.h"
 #include "core/object/class_db.h"
+#include "core/object/message_queue.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
 
 #include "tests/test_macros.h"
 
@@ -58,8 +60,63 @@ public:
 	int get_property() const { return property_value; }
 };
 
+class _TestAccessorObject : public _TestDerivedObject {
+	GDCLASS(_TestAccessorObject, _TestDerivedObject);
+
+	float values[2] = {};
+	Variant anything;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_value", "index", "value"), &_TestAccessorObject::set_value);
+		ClassDB::bind_method(D_METHOD("get_value", "index"), &_TestAccessorObject::get_value);
+		ClassDB::bind_method(D_METHOD("set_anything", "anything"), &_TestAccessorObject::set_anything);
+		ClassDB::bind_method(D_METHOD("get_anything"), &_TestAccessorObject::get_anything);
+		ADD_PROPERTYI(PropertyInfo(Variant::FLOAT, "first_value"), "set_value", "get_value", 0);
+		ADD_PROPERTYI(PropertyInfo(Variant::FLOAT, "second_value"), "set_value", "get_value", 1);
+		ADD_PROPERTY(PropertyInfo(Variant::NIL, "anything", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_NIL_IS_VARIANT), "set_anything", "get_anything");
+	}
+
+public:
+	void set_value(int p_index, float p_value) { values[p_index] = p_value; }
+	float get_value(int p_index) const { return values[p_index]; }
+	void set_anything(const Variant &p_anything) { anything = p_anything; }
+	Variant get_anything() const { return anything; }
+};
+
 namespace TestObject {
 
+class SignalReceiver : public Object {
+public:
+	int calls = 0;
+
+	void receive_0() { calls++; }
+	void receive_1(int p_a) { calls++; }
+	void receive_2(int p_a, int p_b) { calls++; }
+	void receive_3(int p_a, int p_b, int p_c) { calls++; }
+	void receive_4(int p_a, int p_b, int p_c, int p_d) { calls++; }
+	void receive_5(int p_a, int p_b, int p_c, int p_d, int p_e) { calls++; }
+
+	int64_t last_int = 0;
+	String last_string;
+	int last_reference_count = 0;
+
+	void receive_typed(int p_a, const String &p_b) {
+		calls++;
+		last_int = p_a;
+		last_string = p_b;
+	}
+	void receive_converted(int64_t p_a, String p_b) {
+		calls++;
+		last_int = p_a;
+		last_string = p_b;
+	}
+	void receive_ref(const Ref<RefCounted> &p_ref) {
+		calls++;
+		last_reference_count = p_ref->get_reference_count();
+	}
+};
+
 class _MockScriptInstance : public ScriptInstance {
 	StringName property_name = "NO_NAME";
 	Variant property_value;
@@ -238,6 +295,66 @@ TEST_CASE("[Object] Built-in property getter") {
 			"The returned value should equal the one which was set with built-in setter.");
 }
 
+TEST_CASE("[Object] Built-in property accessors") {
+	GDREGISTER_CLASS(_TestDerivedObject);
+	GDREGISTER_CLASS(_TestAccessorObject);
+	_TestAccessorObject object;
+
+	SUBCASE("Inherited properties should be resolved") {
+		bool valid = false;
+		object.set("property", 5, &valid);
+		CHECK(valid);
+		CHECK(object.get_property() == 5);
+		CHECK(object.get("property") == Variant(5));
+	}
+
+	SUBCASE("Values of another type should be converted or rejected") {
+		bool valid = false;
+		object.set("property", 2.5, &valid);
+		CHECK(valid);
+		CHECK(object.get_property() == 2);
+
+		object.set("first_value", 3, &valid);
+		CHECK(valid);
+		CHECK(object.get("first_value").get_type() == Variant::FLOAT);
+		CHECK(object.get_value(0) == 3.0);
+
+		ERR_PRINT_OFF;
+		object.set("property", "text", &valid);
+		ERR_PRINT_ON;
+		CHECK_FALSE(valid);
+	}
+
+	SUBCASE("Indexed properties should pass their index") {
+		object.set("first_value", 1.5);
+		object.set("second_value", 2.5);
+		CHECK(object.get_value(0) == 1.5);
+		CHECK(object.get_value(1) == 2.5);
+		CHECK(object.get("second_value") == Variant(2.5));
+	}
+
+	SUBCASE("Variant properties should accept any type") {
+		object.set("anything", "text");
+		CHECK(object.get("anything") == Variant("text"));
+		object.set("anything", Vector2(1, 2));
+		CHECK(object.get("anything") == Variant(Vector2(1, 2)));
+	}
+
+	SUBCASE("Constants bound after lookups should shadow inherited properties") {
+		object.set("property", 5);
+		CHECK(object.get("property") == Variant(5));
+
+		if (!ClassDB::has_integer_constant("_TestAccessorObject", "property", true)) {
+			ClassDB::bind_integer_constant("_TestAccessorObject", "", "property", 42);
+		}
+		CHECK(object.get("property") == Variant(42));
+
+		// Setting still reaches the inherited property.
+		object.set("property", 7);
+		CHECK(object.get_property() == 7);
+	}
+}
+
 TEST_CASE("[Object] Script property setter") {
 	Object object;
 	Variant script;
@@ -282,6 +399,111 @@ TEST_CASE("[Object] Absent name getter") {
 			"The returned value should equal nil variant.");
 }
 
+struct ObjectDBLookupTask {
+	LocalVector<ObjectID> live_ids;
+	LocalVector<Object *> live_objects;
+	LocalVector<ObjectID> dead_ids;
+	int iterations = 0;
+	SafeFlag *stop = nullptr;
+	uint64_t mismatches = 0;
+	uint64_t lookups = 0;
+
+	static void lookup(void *p_userdata) {
+		ObjectDBLookupTask *task = static_cast<ObjectDBLookupTask *>(p_userdata);
+		for (int i = 0; i < task->iterations || (task->stop && !task->stop->is_set()); i++) {
+			for (uint32_t j = 0; j < task->live_ids.size(); j++) {
+				if (ObjectDB::get_instance(task->live_ids[j]) != task->live_objects[j]) {
+					task->mismatches++;
+				}
+			}
+			for (const ObjectID &id : task->dead_ids) {
+				if (ObjectDB::get_instance(id) != nullptr) {
+					task->mismatches++;
+				}
+			}
+			task->lookups += task->live_ids.size() + task->dead_ids.size();
+		}
+	}
+};
+
+TEST_CASE("[Object] ObjectDB lookups") {
+	Object *object = memnew(Object);
+	ObjectID id = object->get_instance_id();
+	CHECK(ObjectDB::get_instance(id) == object);
+	memdelete(object);
+	CHECK(ObjectDB::get_instance(id) == nullptr);
+
+	// Enough objects to need more than one block of slots.
+	LocalVector<Object *> objects;
+	for (uint32_t i = 0; i < OBJECTDB_SLOT_BLOCK_SIZE * 2; i++) {
+		objects.push_back(memnew(Object));
+	}
+	bool all_found = true;
+	for (Object *E : objects) {
+		all_found = all_found && ObjectDB::get_instance(E->get_instance_id()) == E;
+	}
+	CHECK(all_found);
+
+	// A reused slot doesn't make stale IDs valid again.
+	ObjectID stale_id = objects[0]->get_instance_id();
+	memdelete(objects[0]);
+	objects[0] = memnew(Object);
+	CHECK(ObjectDB::get_instance(stale_id) == nullptr);
+	CHECK(ObjectDB::get_instance(objects[0]->get_instance_id()) == objects[0]);
+
+	for (Object *E : objects) {
+		memdelete(E);
+	}
+}
+
+TEST_CASE("[Object] ObjectDB lookups from several threads while objects are created and freed") {
+	const int thread_count = 4;
+
+	LocalVector<Object *> live_objects;
+	LocalVector<ObjectID> dead_ids;
+	for (int i = 0; i < 64; i++) {
+		live_objects.push_back(memnew(Object));
+		Object *dead = memnew(Object);
+		dead_ids.push_back(dead->get_instance_id());
+		memdelete(dead);
+	}
+
+	SafeFlag stop;
+	ObjectDBLookupTask tasks[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		for (Object *E : live_objects) {
+			tasks[i].live_ids.push_back(E->get_instance_id());
+			tasks[i].live_objects.push_back(E);
+		}
+		tasks[i].dead_ids = dead_ids;
+		tasks[i].iterations = 100;
+		tasks[i].stop = &stop;
+		threads[i].start(&ObjectDBLookupTask::lookup, &tasks[i]);
+	}
+
+	// Churn slots, so freed slots of the dead IDs get reused and new blocks get allocated.
+	for (int round = 0; round < 20; round++) {
+		LocalVector<Object *> churn;
+		for (uint32_t i = 0; i < OBJECTDB_SLOT_BLOCK_SIZE / 4; i++) {
+			churn.push_back(memnew(Object));
+		}
+		for (Object *E : churn) {
+			memdelete(E);
+		}
+	}
+	stop.set();
+
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+		CHECK_MESSAGE(tasks[i].mismatches == 0, "Lookups should only find the live objects.");
+	}
+
+	for (Object *E : live_objects) {
+		memdelete(E);
+	}
+}
+
 TEST_CASE("[Object] Signals") {
 	Object object;
 
@@ -422,6 +644,75 @@ TEST_CASE("[Object] Signals") {
 		object.get_all_signal_connections(&signal_connections);
 		CHECK(signal_connections.size() == 0);
 	}
+
+	SUBCASE("Emitting to many connections, including one shot ones, should call all of them") {
+		// More connections than are copied on the stack during emission.
+		SignalReceiver receivers[100];
+		for (int i = 0; i < 100; i++) {
+			object.connect("my_custom_signal", callable_mp(&receivers[i], &SignalReceiver::receive_0), i % 2 ? (uint32_t)Object::CONNECT_ONE_SHOT : 0u);
+		}
+
+		CHECK(object.emit_signal("my_custom_signal") == OK);
+		CHECK(object.emit_signal("my_custom_signal") == OK);
+
+		for (int i = 0; i < 100; i++) {
+			CHECK(receivers[i].calls == (i % 2 ? 1 : 2));
+		}
+
+		List<Object::Connection> signal_connections;
+		object.get_all_signal_connections(&signal_connections);
+		CHECK(signal_connections.size() == 50);
+
+		for (int i = 0; i < 100; i += 2) {
+			object.disconnect("my_custom_signal", callable_mp(&receivers[i], &SignalReceiver::receive_0));
+		}
+	}
+}
+
+TEST_CASE("[Object] Signals emitted with native arguments") {
+	Object object;
+	object.add_user_signal(MethodInfo("my_custom_signal"));
+
+	SUBCASE("Callables taking the emitted types and callables taking other types should both be called") {
+		// Only tests tagged with [SceneTree] get a message queue from the test runner.
+		MessageQueue *message_queue = memnew(MessageQueue);
+
+		SignalReceiver typed_receiver;
+		SignalReceiver converted_receiver;
+		SignalReceiver deferred_receiver;
+		object.connect("my_custom_signal", callable_mp(&typed_receiver, &SignalReceiver::receive_typed));
+		object.connect("my_custom_signal", callable_mp(&converted_receiver, &SignalReceiver::receive_converted));
+		object.connect("my_custom_signal", callable_mp(&deferred_receiver, &SignalReceiver::receive_typed), Object::CONNECT_DEFERRED);
+
+		CHECK(object.emit_signal("my_custom_signal", 7, String("seven")) == OK);
+		CHECK(typed_receiver.calls == 1);
+		CHECK(typed_receiver.last_int == 7);
+		CHECK(typed_receiver.last_string == "seven");
+		CHECK(converted_receiver.calls == 1);
+		CHECK(converted_receiver.last_int == 7);
+		CHECK(converted_receiver.last_string == "seven");
+
+		// Deferred calls always get boxed arguments.
+		CHECK(deferred_receiver.calls == 0);
+		MessageQueue::get_singleton()->flush();
+		CHECK(deferred_receiver.calls == 1);
+		CHECK(deferred_receiver.last_int == 7);
+		CHECK(deferred_receiver.last_string == "seven");
+
+		memdelete(message_queue);
+	}
+
+	SUBCASE("Arguments should not be boxed for callables taking the emitted types") {
+		SignalReceiver receiver;
+		object.connect("my_custom_signal", callable_mp(&receiver, &SignalReceiver::receive_ref));
+
+		Ref<RefCounted> ref;
+		ref.instantiate();
+		CHECK(object.emit_signal("my_custom_signal", ref) == OK);
+		CHECK(receiver.calls == 1);
+		// Referenced by the caller and by the argument of emit_signal(), but not by a Variant.
+		CHECK(receiver.last_reference_count == 2);
+	}
 }
 
 } // namespace TestObject
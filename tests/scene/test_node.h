@@ -31,6 +31,7 @@
 #ifndef TEST_NODE_H
 #define TEST_NODE_H
 
+#include "core/os/thread.h"
 #include "scene/main/node.h"
 
 #include "tests/test_macros.h"
@@ -78,6 +79,72 @@ public:
 	List<Node *> *callback_list = nullptr;
 };
 
+class TestDuplicateNode : public Node {
+	GDCLASS(TestDuplicateNode, Node);
+
+	Ref<Resource> unique_resource;
+
+protected:
+	bool _set(const StringName &p_name, const Variant &p_value) {
+		if (p_name == "dynamic_value") {
+			dynamic_value = p_value;
+			return true;
+		}
+		return false;
+	}
+
+	bool _get(const StringName &p_name, Variant &r_ret) const {
+		if (p_name == "dynamic_value") {
+			r_ret = dynamic_value;
+			return true;
+		}
+		return false;
+	}
+
+	void _get_property_list(List<PropertyInfo> *p_list) const {
+		p_list->push_back(PropertyInfo(Variant::INT, "dynamic_value"));
+	}
+
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_unique_resource", "resource"), &TestDuplicateNode::set_unique_resource);
+		ClassDB::bind_method(D_METHOD("get_unique_resource"), &TestDuplicateNode::get_unique_resource);
+		ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "unique_resource", PROPERTY_HINT_RESOURCE_TYPE, "Resource", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_ALWAYS_DUPLICATE), "set_unique_resource", "get_unique_resource");
+	}
+
+public:
+	int dynamic_value = 0;
+
+	void set_unique_resource(const Ref<Resource> &p_resource) { unique_resource = p_resource; }
+	Ref<Resource> get_unique_resource() const { return unique_resource; }
+};
+
+class TestDuplicateLateNode : public Node {
+	GDCLASS(TestDuplicateLateNode, Node);
+
+protected:
+	static void _bind_methods() {
+		// The property is added by the test, after the class was first duplicated.
+		ClassDB::bind_method(D_METHOD("set_late_value", "value"), &TestDuplicateLateNode::set_late_value);
+		ClassDB::bind_method(D_METHOD("get_late_value"), &TestDuplicateLateNode::get_late_value);
+	}
+
+public:
+	int late_value = 0;
+
+	void set_late_value(int p_value) { late_value = p_value; }
+	int get_late_value() const { return late_value; }
+};
+
+struct DuplicateOnThread {
+	const Node *source = nullptr;
+	Node *result = nullptr;
+
+	static void duplicate(void *p_userdata) {
+		DuplicateOnThread *task = static_cast<DuplicateOnThread *>(p_userdata);
+		task->result = task->source->duplicate();
+	}
+};
+
 TEST_CASE("[SceneTree][Node] Testing node operations with a very simple scene tree") {
 	Node *node = memnew(Node);
 
@@ -756,12 +823,190 @@ TEST_CASE("[SceneTree][Node] Test the process priority") {
 		CHECK_EQ(E->get(), node3);
 	}
 
+	SUBCASE("Process priority after changes between frames") {
+		node->set_process(true);
+		node->set_process_priority(20);
+		node2->set_process(true);
+		node2->set_process_priority(10);
+
+		SceneTree::get_singleton()->process(0);
+		process_order.clear();
+
+		// Nodes added and priorities changed since the last frame are merged with the already sorted ones.
+		node3->set_process(true);
+		node3->set_process_priority(15);
+		node4->set_process(true);
+		node4->set_process_priority(5);
+		node->set_process_priority(0);
+
+		SceneTree::get_singleton()->process(0);
+
+		CHECK_EQ(4, process_order.size());
+		List<Node *>::Element *E = process_order.front();
+		CHECK_EQ(E->get(), node);
+		E = E->next();
+		CHECK_EQ(E->get(), node4);
+		E = E->next();
+		CHECK_EQ(E->get(), node2);
+		E = E->next();
+		CHECK_EQ(E->get(), node3);
+	}
+
 	memdelete(node);
 	memdelete(node2);
 	memdelete(node3);
 	memdelete(node4);
 }
 
+TEST_CASE("[SceneTree][Node] Group calls") {
+	Node *node1 = memnew(Node);
+	Node *node2 = memnew(Node);
+	TestNode *node3 = memnew(TestNode);
+	SceneTree::get_singleton()->get_root()->add_child(node1);
+	SceneTree::get_singleton()->get_root()->add_child(node2);
+	SceneTree::get_singleton()->get_root()->add_child(node3);
+	node1->add_to_group("nodes");
+	node2->add_to_group("nodes");
+	node3->add_to_group("nodes");
+
+	SUBCASE("Calling a group should call the method on every node of every class") {
+		SceneTree::get_singleton()->call_group("nodes", "set_process_priority", 5);
+		CHECK_EQ(node1->get_process_priority(), 5);
+		CHECK_EQ(node2->get_process_priority(), 5);
+		CHECK_EQ(node3->get_process_priority(), 5);
+
+		SceneTree::get_singleton()->call_group_flags(SceneTree::GROUP_CALL_REVERSE, "nodes", "set_process_priority", 6);
+		CHECK_EQ(node1->get_process_priority(), 6);
+		CHECK_EQ(node2->get_process_priority(), 6);
+		CHECK_EQ(node3->get_process_priority(), 6);
+	}
+
+	SUBCASE("Calling a group on threads should call the method on every node") {
+		SceneTree::get_singleton()->call_group_flags(SceneTree::GROUP_CALL_THREADED, "nodes", "set_meta", "visited", true);
+		CHECK(node1->has_meta("visited"));
+		CHECK(node2->has_meta("visited"));
+		CHECK(node3->has_meta("visited"));
+	}
+
+	SUBCASE("Setting a property on a group should set it on every node of every class") {
+		SceneTree::get_singleton()->set_group("nodes", "process_priority", 7);
+		CHECK_EQ(node1->get_process_priority(), 7);
+		CHECK_EQ(node2->get_process_priority(), 7);
+		CHECK_EQ(node3->get_process_priority(), 7);
+
+		// Properties without a bound setter still go through Object::set().
+		SceneTree::get_singleton()->set_group("nodes", "metadata/tag", 1);
+		CHECK_EQ(int(node1->get_meta("tag")), 1);
+		CHECK_EQ(int(node3->get_meta("tag")), 1);
+	}
+
+	memdelete(node1);
+	memdelete(node2);
+	memdelete(node3);
+}
+
+TEST_CASE("[SceneTree][Node] Duplication") {
+	GDREGISTER_CLASS(TestDuplicateNode);
+
+	Ref<Resource> resource;
+	resource.instantiate();
+	resource->set_name("shared");
+
+	Node *node = memnew(Node);
+	node->set_name("Root");
+	node->set_process_priority(3);
+	node->set_editor_description("template");
+	Array items;
+	items.push_back(1);
+	node->set_meta("items", items);
+
+	TestDuplicateNode *child1 = memnew(TestDuplicateNode);
+	child1->set_name("Child1");
+	child1->dynamic_value = 5;
+	child1->set_unique_resource(resource);
+	node->add_child(child1);
+
+	TestDuplicateNode *child2 = memnew(TestDuplicateNode);
+	child2->set_name("Child2");
+	child2->dynamic_value = 7;
+	child2->set_unique_resource(resource);
+	node->add_child(child2);
+
+	SUBCASE("Stored properties and metadata should be copied") {
+		Node *duplicate = node->duplicate();
+		CHECK_EQ(duplicate->get_name(), node->get_name());
+		CHECK_EQ(duplicate->get_process_priority(), 3);
+		CHECK_EQ(duplicate->get_editor_description(), "template");
+
+		// Metadata containers are deep copies.
+		items.push_back(2);
+		Array duplicate_items = duplicate->get_meta("items");
+		CHECK_EQ(duplicate_items.size(), 1);
+
+		memdelete(duplicate);
+	}
+
+	SUBCASE("Dynamic properties and always duplicated resources should be copied") {
+		Node *duplicate = node->duplicate();
+		REQUIRE_EQ(duplicate->get_child_count(), 2);
+		TestDuplicateNode *duplicate1 = Object::cast_to<TestDuplicateNode>(duplicate->get_child(0));
+		TestDuplicateNode *duplicate2 = Object::cast_to<TestDuplicateNode>(duplicate->get_child(1));
+		REQUIRE(duplicate1);
+		REQUIRE(duplicate2);
+
+		CHECK_EQ(duplicate1->dynamic_value, 5);
+		CHECK_EQ(duplicate2->dynamic_value, 7);
+
+		CHECK(duplicate1->get_unique_resource().is_valid());
+		CHECK(duplicate2->get_unique_resource().is_valid());
+		CHECK(duplicate1->get_unique_resource() != resource);
+		CHECK(duplicate1->get_unique_resource() != duplicate2->get_unique_resource());
+		CHECK_EQ(duplicate1->get_unique_resource()->get_name(), "shared");
+
+		memdelete(duplicate);
+	}
+
+	SUBCASE("Detached subtrees should be possible to duplicate from another thread") {
+		DuplicateOnThread task;
+		task.source = node;
+
+		Thread thread;
+		thread.start(&DuplicateOnThread::duplicate, &task);
+		thread.wait_to_finish();
+
+		REQUIRE(task.result);
+		CHECK_EQ(task.result->get_process_priority(), 3);
+		CHECK_EQ(task.result->get_child_count(), 2);
+		TestDuplicateNode *duplicate1 = Object::cast_to<TestDuplicateNode>(task.result->get_child(0));
+		REQUIRE(duplicate1);
+		CHECK_EQ(duplicate1->dynamic_value, 5);
+		CHECK(duplicate1->get_unique_resource() != resource);
+
+		memdelete(task.result);
+	}
+
+	memdelete(node);
+}
+
+TEST_CASE("[SceneTree][Node] Duplication sees properties added to a class later") {
+	GDREGISTER_CLASS(TestDuplicateLateNode);
+
+	TestDuplicateLateNode *node = memnew(TestDuplicateLateNode);
+	node->set_late_value(5);
+
+	Node *duplicate = node->duplicate();
+	CHECK(Object::cast_to<TestDuplicateLateNode>(duplicate)->get_late_value() == 0);
+	memdelete(duplicate);
+
+	ClassDB::add_property("TestDuplicateLateNode", PropertyInfo(Variant::INT, "late_value"), "set_late_value", "get_late_value");
+
+	duplicate = node->duplicate();
+	CHECK_MESSAGE(Object::cast_to<TestDuplicateLateNode>(duplicate)->get_late_value() == 5, "The cached property list of the class should be rebuilt.");
+	memdelete(duplicate);
+
+	memdelete(node);
+}
+
 } // namespace TestNode
 
 #endif // TEST_NODE_H
@@ -0,0 +1,270 @@
+/**************************************************************************/
+/*  test_node_3d.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NODE_3D_H
+#define TEST_NODE_3D_H
+
+#include "scene/3d/node_3d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+class TestNode3DInternalsAccessor {
+public:
+	static bool is_global_transform_dirty(const Node3D *p_node) {
+		return p_node->_test_dirty_bits(Node3D::DIRTY_GLOBAL_TRANSFORM);
+	}
+
+	static Transform3D get_cached_global_transform(const Node3D *p_node) {
+		return p_node->data.global_transform;
+	}
+
+	static bool &batch_transform_updates() {
+		return SceneTree::get_singleton()->batch_transform_updates;
+	}
+};
+
+namespace TestNode3D {
+
+class TestTransformNode : public Node3D {
+	GDCLASS(TestTransformNode, Node3D);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what != NOTIFICATION_TRANSFORM_CHANGED) {
+			return;
+		}
+		notifications++;
+		dirty_when_notified = TestNode3DInternalsAccessor::is_global_transform_dirty(this);
+		if (to_free) {
+			memdelete(to_free);
+			to_free = nullptr;
+		}
+	}
+
+public:
+	int notifications = 0;
+	bool dirty_when_notified = false;
+	Node *to_free = nullptr;
+
+	TestTransformNode() {
+		set_notify_transform(true);
+	}
+};
+
+static Transform3D compute_global_transform(const Node3D *p_node) {
+	Transform3D xform = p_node->get_transform();
+	const Node3D *parent = p_node->is_set_as_top_level() ? nullptr : p_node->get_parent_node_3d();
+	while (parent) {
+		xform = parent->get_transform() * xform;
+		parent = parent->is_set_as_top_level() ? nullptr : parent->get_parent_node_3d();
+	}
+	return xform;
+}
+
+TEST_CASE("[SceneTree][Node3D] Batched global transform update") {
+	// Two chains hanging from the same root, plus a top level node.
+	Node3D *root = memnew(Node3D);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+
+	LocalVector<Node3D *> nodes;
+	nodes.push_back(root);
+	for (int chain = 0; chain < 2; chain++) {
+		Node3D *parent = root;
+		for (int i = 0; i < 4; i++) {
+			Node3D *child = memnew(Node3D);
+			child->set_position(Vector3(chain + 1, i, 0));
+			child->rotate_y(0.25);
+			parent->add_child(child);
+			nodes.push_back(child);
+			parent = child;
+		}
+	}
+	Node3D *top_level = memnew(Node3D);
+	top_level->set_as_top_level(true);
+	top_level->set_position(Vector3(0, 0, 5));
+	nodes[3]->add_child(top_level);
+	nodes.push_back(top_level);
+
+	root->set_position(Vector3(10, 0, 0));
+	root->rotate_x(0.5);
+
+	// Expected values, computed by hand from the local transforms.
+	LocalVector<Transform3D> expected;
+	for (Node3D *node : nodes) {
+		expected.push_back(compute_global_transform(node));
+	}
+
+	// Dirty everything again before running the batched update.
+	root->set_transform(root->get_transform());
+	for (Node3D *node : nodes) {
+		if (node != top_level) {
+			CHECK(TestNode3DInternalsAccessor::is_global_transform_dirty(node));
+		}
+	}
+
+	Node3D::update_global_transforms(nodes.ptr(), nodes.size());
+
+	// The cached transforms are read directly, get_global_transform() would recompute dirty ones.
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		CHECK_FALSE(TestNode3DInternalsAccessor::is_global_transform_dirty(nodes[i]));
+		CHECK(TestNode3DInternalsAccessor::get_cached_global_transform(nodes[i]).is_equal_approx(expected[i]));
+	}
+
+	memdelete(root);
+}
+
+TEST_CASE("[SceneTree][Node3D] Batched transform notifications") {
+	ClassDB::register_class<TestTransformNode>();
+
+	bool &batch_transform_updates = TestNode3DInternalsAccessor::batch_transform_updates();
+	bool old_batch_transform_updates = batch_transform_updates;
+	batch_transform_updates = true;
+
+	SceneTree *tree = SceneTree::get_singleton();
+	tree->flush_transform_notifications();
+
+	Node3D *root = memnew(Node3D);
+	tree->get_root()->add_child(root);
+
+	SUBCASE("Nodes are notified once per flush, with their global transform resolved") {
+		TestTransformNode *child = memnew(TestTransformNode);
+		child->set_position(Vector3(1, 2, 3));
+		root->add_child(child);
+		TestTransformNode *grandchild = memnew(TestTransformNode);
+		grandchild->rotate_y(0.5);
+		child->add_child(grandchild);
+		tree->flush_transform_notifications();
+		child->notifications = 0;
+		grandchild->notifications = 0;
+
+		// The second change finds the subtree dirty and queued already.
+		root->set_position(Vector3(5, 0, 0));
+		root->rotate_x(0.25);
+		CHECK(TestNode3DInternalsAccessor::is_global_transform_dirty(grandchild));
+
+		tree->flush_transform_notifications();
+		CHECK_EQ(child->notifications, 1);
+		CHECK_EQ(grandchild->notifications, 1);
+		CHECK_FALSE(child->dirty_when_notified);
+		CHECK_FALSE(grandchild->dirty_when_notified);
+		CHECK(TestNode3DInternalsAccessor::get_cached_global_transform(grandchild).is_equal_approx(compute_global_transform(grandchild)));
+
+		// A new pass starts after flushing.
+		root->rotate_z(0.25);
+		tree->flush_transform_notifications();
+		CHECK_EQ(grandchild->notifications, 2);
+		CHECK(TestNode3DInternalsAccessor::get_cached_global_transform(grandchild).is_equal_approx(compute_global_transform(grandchild)));
+	}
+
+	SUBCASE("Nodes that are no longer queued are queued again") {
+		TestTransformNode *child = memnew(TestTransformNode);
+		root->add_child(child);
+		TestTransformNode *silent = memnew(TestTransformNode);
+		silent->set_notify_transform(false);
+		root->add_child(silent);
+		tree->flush_transform_notifications();
+		child->notifications = 0;
+
+		root->set_position(Vector3(1, 0, 0));
+		child->force_update_transform();
+		CHECK_EQ(child->notifications, 1);
+		silent->set_notify_transform(true);
+
+		root->set_position(Vector3(2, 0, 0));
+		tree->flush_transform_notifications();
+		CHECK_EQ(child->notifications, 2);
+		CHECK_EQ(silent->notifications, 1);
+	}
+
+	SUBCASE("Nodes freed while notifying are skipped") {
+		TestTransformNode *child = memnew(TestTransformNode);
+		root->add_child(child);
+		TestTransformNode *grandchild = memnew(TestTransformNode);
+		child->add_child(grandchild);
+		TestTransformNode *other = memnew(TestTransformNode);
+		root->add_child(other);
+		tree->flush_transform_notifications();
+
+		// Parents are notified first, so the grandchild is freed before its turn.
+		child->notifications = 0;
+		other->notifications = 0;
+		child->to_free = grandchild;
+		root->set_position(Vector3(1, 0, 0));
+		tree->flush_transform_notifications();
+		CHECK_EQ(child->notifications, 1);
+		CHECK_EQ(child->get_child_count(), 0);
+		CHECK_EQ(other->notifications, 1);
+	}
+
+	SUBCASE("Large batches are resolved on worker threads") {
+		// Enough subtrees and nodes for update_global_transforms() to use the WorkerThreadPool.
+		LocalVector<Node3D *> subtree_roots;
+		LocalVector<TestTransformNode *> nodes;
+		for (int i = 0; i < 8; i++) {
+			TestTransformNode *subtree_root = memnew(TestTransformNode);
+			subtree_root->set_position(Vector3(i, 0, 0));
+			root->add_child(subtree_root);
+			subtree_roots.push_back(subtree_root);
+			uint32_t subtree_start = nodes.size();
+			nodes.push_back(subtree_root);
+			for (int j = 0; j < 80; j++) {
+				TestTransformNode *node = memnew(TestTransformNode);
+				node->set_position(Vector3(0, j, 0));
+				node->rotate_y(0.01 * j);
+				nodes[subtree_start + j / 2]->add_child(node);
+				nodes.push_back(node);
+			}
+		}
+		CHECK_GE(nodes.size(), 512u);
+		tree->flush_transform_notifications();
+		for (TestTransformNode *node : nodes) {
+			node->notifications = 0;
+		}
+
+		for (Node3D *subtree_root : subtree_roots) {
+			subtree_root->rotate_z(0.5);
+		}
+		tree->flush_transform_notifications();
+
+		for (TestTransformNode *node : nodes) {
+			CHECK_EQ(node->notifications, 1);
+			CHECK_FALSE(node->dirty_when_notified);
+			CHECK(TestNode3DInternalsAccessor::get_cached_global_transform(node).is_equal_approx(compute_global_transform(node)));
+		}
+	}
+
+	memdelete(root);
+	batch_transform_updates = old_batch_transform_updates;
+}
+
+} // namespace TestNode3D
+
+#endif // TEST_NODE_3D_H
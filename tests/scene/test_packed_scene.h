@@ -31,12 +31,46 @@
 #ifndef TEST_PACKED_SCENE_H
 #define TEST_PACKED_SCENE_H
 
+#include "scene/2d/node_2d.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
 
 namespace TestPackedScene {
 
+class TestReturningSetterNode : public Node {
+	GDCLASS(TestReturningSetterNode, Node);
+
+	String label;
+	int counter = 0;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_label", "label"), &TestReturningSetterNode::set_label);
+		ClassDB::bind_method(D_METHOD("get_label"), &TestReturningSetterNode::get_label);
+		ClassDB::bind_method(D_METHOD("set_counter", "counter"), &TestReturningSetterNode::set_counter);
+		ClassDB::bind_method(D_METHOD("get_counter"), &TestReturningSetterNode::get_counter);
+		ADD_PROPERTY(PropertyInfo(Variant::STRING, "label"), "set_label", "get_label");
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "counter"), "set_counter", "get_counter");
+	}
+
+public:
+	// Setters that return the previous value.
+	String set_label(const String &p_label) {
+		String previous = label;
+		label = p_label;
+		return previous;
+	}
+	String get_label() const { return label; }
+
+	int set_counter(int p_counter) {
+		int previous = counter;
+		counter = p_counter;
+		return previous;
+	}
+	int get_counter() const { return counter; }
+};
+
 TEST_CASE("[PackedScene] Pack Scene and Retrieve State") {
 	// Create a scene to pack.
 	Node *scene = memnew(Node);
@@ -150,6 +184,97 @@ TEST_CASE("[PackedScene] Instantiate Packed Scene With Children") {
 	memdelete(instance);
 }
 
+static Node *_make_test_scene(int p_node_count) {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("TestScene");
+
+	for (int i = 1; i < p_node_count; i++) {
+		Node2D *child = memnew(Node2D);
+		child->set_name(vformat("Child%d", i));
+		child->set_position(Vector2(i, -i));
+		child->set_rotation(0.5);
+		child->set_z_index(i % 10);
+		child->set_process_priority(i);
+		scene->add_child(child);
+		child->set_owner(scene);
+	}
+
+	return scene;
+}
+
+TEST_CASE("[PackedScene] Repeated Instantiation Keeps Properties") {
+	Node *scene = _make_test_scene(10);
+
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+
+	// The first instantiation resolves the plan, the following ones reuse it.
+	for (int i = 0; i < 3; i++) {
+		Node *instance = packed_scene.instantiate();
+		CHECK(instance != nullptr);
+		CHECK(instance->get_child_count() == 9);
+
+		Node2D *child = Object::cast_to<Node2D>(instance->get_child(4));
+		CHECK(child != nullptr);
+		CHECK(child->get_name() == "Child5");
+		CHECK(child->get_position() == Vector2(5, -5));
+		CHECK(child->get_rotation() == doctest::Approx(0.5));
+		CHECK(child->get_z_index() == 5);
+		CHECK(child->get_process_priority() == 5);
+		CHECK(child->get_owner() == instance);
+
+		memdelete(instance);
+	}
+
+	// Packing again must not reuse the plan of the previous contents.
+	Node2D *root = Object::cast_to<Node2D>(scene);
+	root->set_position(Vector2(10, 20));
+	memdelete(root->get_child(0));
+	packed_scene.pack(scene);
+
+	Node *instance = packed_scene.instantiate();
+	CHECK(instance->get_child_count() == 8);
+	CHECK(Object::cast_to<Node2D>(instance)->get_position() == Vector2(10, 20));
+	CHECK(Object::cast_to<Node2D>(instance->get_child(0))->get_position() == Vector2(2, -2));
+
+	memdelete(instance);
+	memdelete(scene);
+}
+
+TEST_CASE("[PackedScene] Instantiation Calls Setters That Return A Value") {
+	GDREGISTER_CLASS(TestReturningSetterNode);
+
+	TestReturningSetterNode *scene = memnew(TestReturningSetterNode);
+	scene->set_name("Root");
+	scene->set_label("root label");
+	scene->set_counter(7);
+	TestReturningSetterNode *child = memnew(TestReturningSetterNode);
+	child->set_name("Child");
+	child->set_label("child label");
+	child->set_counter(-3);
+	scene->add_child(child);
+	child->set_owner(scene);
+
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+	memdelete(scene);
+
+	// The first instantiation resolves the plan, the following ones reuse it.
+	for (int i = 0; i < 3; i++) {
+		TestReturningSetterNode *instance = Object::cast_to<TestReturningSetterNode>(packed_scene.instantiate());
+		REQUIRE(instance != nullptr);
+		CHECK(instance->get_label() == "root label");
+		CHECK(instance->get_counter() == 7);
+
+		TestReturningSetterNode *instance_child = Object::cast_to<TestReturningSetterNode>(instance->get_child(0));
+		REQUIRE(instance_child != nullptr);
+		CHECK(instance_child->get_label() == "child label");
+		CHECK(instance_child->get_counter() == -3);
+
+		memdelete(instance);
+	}
+}
+
 } // namespace TestPackedScene
 
 #endif // TEST_PACKED_SCENE_H
@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*  test_scene_pool.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_POOL_H
+#define TEST_SCENE_POOL_H
+
+#include "scene/main/scene_pool.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestScenePool {
+
+static Ref<PackedScene> _make_scene() {
+	Node *root = memnew(Node);
+	root->set_name("Pooled");
+	Node *child = memnew(Node);
+	child->set_name("Child");
+	root->add_child(child);
+	child->set_owner(root);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(root);
+	memdelete(root);
+	return packed_scene;
+}
+
+TEST_CASE("[SceneTree][ScenePool] Acquire and release") {
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(_make_scene());
+
+	Node *node = pool->acquire();
+	REQUIRE(node != nullptr);
+	CHECK(node->get_name() == "Pooled");
+	CHECK(node->get_child_count() == 1);
+	CHECK(pool->get_miss_count() == 1);
+	CHECK(pool->get_hit_count() == 0);
+
+	SceneTree::get_singleton()->get_root()->add_child(node);
+	CHECK(node->is_inside_tree());
+
+	pool->release(node);
+	CHECK_FALSE(node->is_inside_tree());
+	CHECK(node->get_parent() == nullptr);
+	CHECK(pool->get_available_count() == 1);
+
+	Node *reused = pool->acquire();
+	CHECK(reused == node);
+	CHECK(pool->get_hit_count() == 1);
+	CHECK(pool->get_miss_count() == 1);
+	CHECK(pool->get_available_count() == 0);
+
+	pool->reset_statistics();
+	CHECK(pool->get_hit_count() == 0);
+	CHECK(pool->get_miss_count() == 0);
+
+	memdelete(reused);
+}
+
+TEST_CASE("[SceneTree][ScenePool] Prewarm and maximum size") {
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(_make_scene());
+	pool->set_max_size(2);
+
+	pool->prewarm(5);
+	CHECK(pool->get_available_count() == 2);
+
+	Node *a = pool->acquire();
+	Node *b = pool->acquire();
+	Node *c = pool->acquire();
+	CHECK(pool->get_hit_count() == 2);
+	CHECK(pool->get_miss_count() == 1);
+
+	pool->release(a);
+	pool->release(b);
+	// The pool is full, so this one is queued for deletion instead.
+	pool->release(c);
+	CHECK(pool->get_available_count() == 2);
+	CHECK(c->is_queued_for_deletion());
+
+	pool->set_max_size(1);
+	CHECK(pool->get_available_count() == 1);
+
+	pool->clear();
+	CHECK(pool->get_available_count() == 0);
+}
+
+TEST_CASE("[SceneTree][ScenePool] Only acquired instances can be released") {
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(_make_scene());
+
+	Node *parent = memnew(Node);
+	Node *foreign = memnew(Node);
+	parent->add_child(foreign);
+
+	ERR_PRINT_OFF;
+	pool->release(foreign);
+	ERR_PRINT_ON;
+	CHECK(pool->get_available_count() == 0);
+	CHECK(foreign->get_parent() == parent);
+
+	Node *node = pool->acquire();
+	pool->release(node);
+	CHECK(pool->get_available_count() == 1);
+
+	// Released twice.
+	ERR_PRINT_OFF;
+	pool->release(node);
+	ERR_PRINT_ON;
+	CHECK(pool->get_available_count() == 1);
+
+	// Acquired from the previous scene.
+	Node *old_node = pool->acquire();
+	pool->set_scene(_make_scene());
+	ERR_PRINT_OFF;
+	pool->release(old_node);
+	ERR_PRINT_ON;
+	CHECK(pool->get_available_count() == 0);
+
+	memdelete(old_node);
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][ScenePool] Freed instances are forgotten") {
+	Ref<ScenePool> pool;
+	pool.instantiate();
+	pool->set_scene(_make_scene());
+
+	// Freed by a script that kept a reference from before it was released.
+	Node *node = pool->acquire();
+	pool->release(node);
+	CHECK(pool->get_available_count() == 1);
+	memdelete(node);
+	CHECK(pool->get_available_count() == 0);
+
+	Node *fresh = pool->acquire();
+	REQUIRE(fresh != nullptr);
+	CHECK(fresh != node);
+	CHECK(pool->get_hit_count() == 0);
+	CHECK(pool->get_miss_count() == 2);
+	CHECK(pool->get_acquired_count() == 1);
+	memdelete(fresh);
+	CHECK(pool->get_acquired_count() == 0);
+
+	// Acquired instances freed instead of released, e.g. with queue_free().
+	for (int i = 0; i < 200; i++) {
+		Node *freed = pool->acquire();
+		SceneTree::get_singleton()->get_root()->add_child(freed);
+		freed->queue_free();
+		SceneTree::get_singleton()->process(0);
+	}
+	CHECK(pool->get_acquired_count() == 0);
+
+	Node *kept = pool->acquire();
+	CHECK(pool->get_acquired_count() == 1);
+	pool->release(kept);
+	CHECK(pool->get_acquired_count() == 0);
+	CHECK(pool->get_available_count() == 1);
+}
+
+} // namespace TestScenePool
+
+#endif // TEST_SCENE_POOL_H
@@ -0,0 +1,205 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "core/math/geometry_3d.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+struct TestMesh {
+	LocalVector<Vector3> vertices;
+	LocalVector<int32_t> indices;
+	Transform3D xform;
+
+	RasterOcclusionCull::Mesh get_mesh() const {
+		RasterOcclusionCull::Mesh mesh;
+		mesh.vertices = vertices.ptr();
+		mesh.vertex_count = vertices.size();
+		mesh.indices = indices.ptr();
+		mesh.index_count = indices.size();
+		mesh.xform = xform;
+		return mesh;
+	}
+};
+
+TestMesh make_box(const Vector3 &p_size, const Transform3D &p_xform) {
+	TestMesh box;
+	for (int i = 0; i < 8; i++) {
+		box.vertices.push_back(Vector3(i & 1 ? 0.5 : -0.5, i & 2 ? 0.5 : -0.5, i & 4 ? 0.5 : -0.5) * p_size);
+	}
+	const int32_t faces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+	for (int i = 0; i < 6; i++) {
+		box.indices.push_back(faces[i][0]);
+		box.indices.push_back(faces[i][1]);
+		box.indices.push_back(faces[i][2]);
+		box.indices.push_back(faces[i][0]);
+		box.indices.push_back(faces[i][2]);
+		box.indices.push_back(faces[i][3]);
+	}
+	box.xform = p_xform;
+	return box;
+}
+
+TestMesh make_quad(const Vector2 &p_size, const Transform3D &p_xform) {
+	TestMesh quad;
+	quad.vertices.push_back(Vector3(-p_size.x, -p_size.y, 0) * 0.5);
+	quad.vertices.push_back(Vector3(p_size.x, -p_size.y, 0) * 0.5);
+	quad.vertices.push_back(Vector3(p_size.x, p_size.y, 0) * 0.5);
+	quad.vertices.push_back(Vector3(-p_size.x, p_size.y, 0) * 0.5);
+	const int32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+	for (int i = 0; i < 6; i++) {
+		quad.indices.push_back(indices[i]);
+	}
+	quad.xform = p_xform;
+	return quad;
+}
+
+// Traces a ray through every pixel center, the same way the raycast backend does, and compares
+// the resulting depth image with the rasterized one.
+void check_against_reference(const LocalVector<TestMesh> &p_meshes, const Size2i &p_size, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	LocalVector<RasterOcclusionCull::Mesh> meshes;
+	for (const TestMesh &mesh : p_meshes) {
+		meshes.push_back(mesh.get_mesh());
+	}
+
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(p_size);
+	buffer.rasterize(meshes.ptr(), meshes.size(), p_cam_transform, p_cam_projection, p_cam_orthogonal);
+
+	Projection inv_projection = p_cam_projection.inverse();
+	Transform3D inv_transform = p_cam_transform.affine_inverse();
+	int covered = 0;
+	int coverage_mismatches = 0;
+	int depth_mismatches = 0;
+
+	for (int y = 0; y < p_size.y; y++) {
+		for (int x = 0; x < p_size.x; x++) {
+			Vector2 ndc = Vector2((x + 0.5) / p_size.x * 2.0 - 1.0, (y + 0.5) / p_size.y * 2.0 - 1.0);
+			Vector3 from = p_cam_transform.xform(inv_projection.xform(Vector3(ndc.x, ndc.y, -1.0)));
+			Vector3 to = p_cam_transform.xform(inv_projection.xform(Vector3(ndc.x, ndc.y, 1.0)));
+
+			real_t expected = FLT_MAX;
+			for (const TestMesh &mesh : p_meshes) {
+				for (uint32_t i = 0; i < mesh.indices.size(); i += 3) {
+					Vector3 hit;
+					if (Geometry3D::ray_intersects_triangle(from, (to - from).normalized(), mesh.xform.xform(mesh.vertices[mesh.indices[i]]), mesh.xform.xform(mesh.vertices[mesh.indices[i + 1]]), mesh.xform.xform(mesh.vertices[mesh.indices[i + 2]]), &hit)) {
+						expected = MIN(expected, -inv_transform.xform(hit).z);
+					}
+				}
+			}
+
+			float depth = buffer.get_depth(x, y);
+			if ((expected == FLT_MAX) != (depth == FLT_MAX)) {
+				coverage_mismatches++;
+			} else if (expected != FLT_MAX) {
+				covered++;
+				if (Math::abs(depth - expected) > expected * 0.001) {
+					depth_mismatches++;
+				}
+			}
+		}
+	}
+
+	CHECK_MESSAGE(covered > p_size.x * p_size.y / 4, "The occluders should cover a good part of the buffer.");
+	// Pixel centers lying exactly on an edge may go either way.
+	CHECK_MESSAGE(coverage_mismatches <= p_size.x * p_size.y / 200, vformat("Coverage should match the reference, %d pixels differ.", coverage_mismatches));
+	CHECK_MESSAGE(depth_mismatches == 0, vformat("Depth should match the reference, %d pixels differ.", depth_mismatches));
+}
+
+LocalVector<TestMesh> make_scene() {
+	LocalVector<TestMesh> meshes;
+	// A floor going behind the camera, clipped by the near plane and the guard band.
+	meshes.push_back(make_quad(Vector2(200, 200), Transform3D(Basis(Vector3(1, 0, 0), -Math_PI / 2), Vector3(0, -1, 0))));
+	meshes.push_back(make_box(Vector3(1, 2, 1), Transform3D(Basis(Vector3(0, 1, 0), 0.5), Vector3(-1, 0, -5))));
+	meshes.push_back(make_box(Vector3(3, 1, 0.5), Transform3D(Basis(Vector3(1, 1, 0).normalized(), 0.3), Vector3(1.5, 0.5, -8))));
+	// Partially hidden behind the first box.
+	meshes.push_back(make_quad(Vector2(4, 3), Transform3D(Basis(), Vector3(-2, 0.5, -12))));
+	return meshes;
+}
+
+TEST_CASE("[RasterOcclusionCull] Perspective depth matches ray traced reference") {
+	Projection projection;
+	projection.set_perspective(75, 4.0 / 3.0, 0.05, 100);
+	Transform3D camera = Transform3D(Basis(Vector3(0, 1, 0), 0.1), Vector3(0, 0.5, 0));
+
+	SUBCASE("Tile aligned size") {
+		check_against_reference(make_scene(), Size2i(64, 48), camera, projection, false);
+	}
+	SUBCASE("Partial tiles") {
+		check_against_reference(make_scene(), Size2i(70, 37), camera, projection, false);
+	}
+}
+
+TEST_CASE("[RasterOcclusionCull] Orthogonal depth matches ray traced reference") {
+	Projection projection;
+	projection.set_orthogonal(12, 4.0 / 3.0, 0.05, 100, false);
+	Transform3D camera = Transform3D(Basis(Vector3(1, 0, 0), -0.3), Vector3(0, 2, 0));
+
+	check_against_reference(make_scene(), Size2i(64, 48), camera, projection, true);
+}
+
+TEST_CASE("[RasterOcclusionCull] Occluded bounds") {
+	Projection projection;
+	projection.set_perspective(75, 4.0 / 3.0, 0.05, 100);
+	Transform3D camera;
+
+	LocalVector<TestMesh> meshes;
+	meshes.push_back(make_quad(Vector2(4, 4), Transform3D(Basis(), Vector3(0, 0, -5))));
+	RasterOcclusionCull::Mesh mesh = meshes[0].get_mesh();
+
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 48));
+	buffer.rasterize(&mesh, 1, camera, projection, false);
+	CHECK(buffer.triangle_count == 2);
+
+	Transform3D inv_camera = camera.affine_inverse();
+	const real_t behind[6] = { -0.5, -0.5, -10.5, 0.5, 0.5, -9.5 };
+	const real_t in_front[6] = { -0.5, -0.5, -3.5, 0.5, 0.5, -2.5 };
+	const real_t beside[6] = { 5.0, -0.5, -10.5, 6.0, 0.5, -9.5 };
+	CHECK(buffer.is_occluded(behind, camera.origin, inv_camera, projection, 0.05));
+	CHECK_FALSE(buffer.is_occluded(in_front, camera.origin, inv_camera, projection, 0.05));
+	CHECK_FALSE(buffer.is_occluded(beside, camera.origin, inv_camera, projection, 0.05));
+
+	// Nothing is drawn once the occluder is behind the camera.
+	meshes[0].xform.origin.z = 5;
+	mesh = meshes[0].get_mesh();
+	buffer.rasterize(&mesh, 1, camera, projection, false);
+	CHECK(buffer.triangle_count == 0);
+	CHECK_FALSE(buffer.is_occluded(behind, camera.origin, inv_camera, projection, 0.05));
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
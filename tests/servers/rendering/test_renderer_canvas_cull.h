@@ -0,0 +1,288 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+struct DrawState {
+	bool drawn = false;
+	int next = -1;
+
+	bool operator==(const DrawState &p_other) const {
+		return drawn == p_other.drawn && (!drawn || next == p_other.next);
+	}
+};
+
+// Culls and draws the canvas, returning which items were attached for drawing and the item drawn after each.
+LocalVector<DrawState> render_canvas(RID p_canvas, const LocalVector<RID> &p_items, const Transform2D &p_transform, const Size2 &p_size) {
+	RendererCanvasCull *canvas_cull = RSG::canvas;
+	HashMap<RendererCanvasRender::Item *, int> item_indices;
+
+	for (uint32_t i = 0; i < p_items.size(); i++) {
+		RendererCanvasCull::Item *ci = canvas_cull->canvas_item_owner.get_or_null(p_items[i]);
+		ci->final_modulate = Color(0, 0, 0, 0);
+		item_indices[ci] = i;
+	}
+
+	canvas_cull->render_canvas(RID(), canvas_cull->canvas_owner.get_or_null(p_canvas), p_transform, nullptr, nullptr, Rect2(Point2(), p_size), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xffffffff);
+
+	LocalVector<DrawState> states;
+	states.resize(p_items.size());
+	for (uint32_t i = 0; i < p_items.size(); i++) {
+		RendererCanvasCull::Item *ci = canvas_cull->canvas_item_owner.get_or_null(p_items[i]);
+		states[i].drawn = ci->final_modulate.a > 0;
+		states[i].next = ci->next ? item_indices[ci->next] : -1;
+	}
+	return states;
+}
+
+void draw_sprite(RID p_item) {
+	RS::get_singleton()->canvas_item_clear(p_item);
+	RS::get_singleton()->canvas_item_add_rect(p_item, Rect2(-8, -8, 16, 16), Color(1, 1, 1));
+}
+
+Transform2D random_transform(real_t p_range) {
+	return Transform2D(Math::random(-Math_PI, Math_PI), Size2(Math::random(0.5, 2.0), Math::random(0.5, 2.0)), 0, Vector2(Math::random(-p_range, p_range), Math::random(-p_range, p_range)));
+}
+
+// Whether p_rect, placed with p_xform, overlaps p_view. Two parallelograms only overlap if they overlap along
+// the axes of both, so the bounding rects are compared in the space of the view and in the space of the rect.
+bool rect_overlaps_view(const Rect2 &p_rect, const Transform2D &p_xform, const Rect2 &p_view) {
+	return p_view.intersects(p_xform.xform(p_rect)) && p_rect.intersects(p_xform.affine_inverse().xform(p_view));
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Spatial index culls like a full walk") {
+	const int COUNT = 1000;
+	RS *rs = RS::get_singleton();
+	Math::seed(0);
+
+	// Two identical canvases, culled without and with the spatial index.
+	RID canvas[2];
+	RID parent[2];
+	LocalVector<RID> items[2];
+	for (int c = 0; c < 2; c++) {
+		canvas[c] = rs->canvas_create();
+		rs->canvas_set_use_spatial_index(canvas[c], c == 1);
+		parent[c] = rs->canvas_item_create();
+		rs->canvas_item_set_parent(parent[c], canvas[c]);
+		items[c].push_back(parent[c]);
+	}
+
+	for (int i = 0; i < COUNT; i++) {
+		Transform2D xform = random_transform(2000);
+		for (int c = 0; c < 2; c++) {
+			RID item = rs->canvas_item_create();
+			rs->canvas_item_set_parent(item, parent[c]);
+			rs->canvas_item_set_draw_index(item, i);
+			rs->canvas_item_set_transform(item, xform);
+			rs->canvas_item_set_draw_behind_parent(item, i % 7 == 0);
+			draw_sprite(item);
+			items[c].push_back(item);
+		}
+	}
+
+	// Items that can't be indexed must still be culled and drawn in order.
+	for (int c = 0; c < 2; c++) {
+		RID grandchild = rs->canvas_item_create();
+		rs->canvas_item_set_parent(grandchild, items[c][1]);
+		draw_sprite(grandchild);
+		items[c].push_back(grandchild);
+		rs->canvas_item_set_update_when_visible(items[c][2], true);
+	}
+
+	for (int frame = 0; frame < 50; frame++) {
+		// Bounding rects are only exact without rotation. With rotation, both culls are conservative: the full walk
+		// draws every item whose bounding rect overlaps the view in global space, the index only those that also
+		// overlap it in the local space of their parent. Neither may skip an item that overlaps the view.
+		bool rotated = frame % 2 == 1;
+		Transform2D parent_xform = rotated ? Transform2D(Math::random(-Math_PI, Math_PI), Vector2(400, 300)) : Transform2D(0, Size2(Math::random(0.5, 2.0), Math::random(0.5, 2.0)), 0, Vector2(400, 300));
+		Transform2D camera = Transform2D(0, Vector2(Math::random(-1500.0, 1500.0), Math::random(-1500.0, 1500.0)));
+		for (int c = 0; c < 2; c++) {
+			rs->canvas_item_set_transform(parent[c], parent_xform);
+		}
+
+		LocalVector<DrawState> expected = render_canvas(canvas[0], items[0], camera, Size2(1280, 720));
+		LocalVector<DrawState> result = render_canvas(canvas[1], items[1], camera, Size2(1280, 720));
+
+		bool match = true;
+		int drawn = 0;
+		for (uint32_t i = 0; i < items[0].size(); i++) {
+			if (rotated) {
+				match = match && (!result[i].drawn || expected[i].drawn);
+			} else {
+				match = match && result[i] == expected[i];
+			}
+			drawn += expected[i].drawn ? 1 : 0;
+		}
+		CHECK_MESSAGE(match, vformat("Drawn items should match in frame %d.", frame));
+		CHECK(drawn > 0);
+		CHECK(drawn < COUNT);
+
+		if (rotated) {
+			// The index must draw every item that overlaps the view. Items drawn in excess must lie within the size
+			// of their bounding rect from the view, as their bounding rect overlaps it.
+			const Rect2 view = Rect2(Point2(), Size2(1280, 720));
+			bool conservative = true;
+			bool bounded = true;
+			int visible = 0;
+			int extra = 0;
+			for (int i = 1; i <= COUNT; i++) {
+				RendererCanvasCull::Item *ci = RSG::canvas->canvas_item_owner.get_or_null(items[1][i]);
+				if (ci->parent != parent[1]) {
+					continue;
+				}
+				Transform2D xform = camera * parent_xform * ci->xform;
+				Rect2 rect = ci->get_rect();
+				if (rect_overlaps_view(rect, xform, view)) {
+					visible++;
+					conservative = conservative && result[i].drawn;
+				} else if (result[i].drawn) {
+					extra++;
+					bounded = bounded && rect_overlaps_view(rect, xform, view.grow(xform.xform(rect).size.length()));
+				}
+			}
+			CHECK_MESSAGE(conservative, vformat("Items overlapping the view should be drawn in frame %d.", frame));
+			CHECK_MESSAGE(bounded, vformat("Items drawn in excess should be next to the view in frame %d (%d visible, %d extra).", frame, visible, extra));
+		}
+
+		// Move, redraw and reparent some of the items between frames.
+		for (int i = 0; i < 20; i++) {
+			int idx = 3 + Math::rand() % (COUNT - 2);
+			int op = Math::rand() % 4;
+			Transform2D xform = random_transform(2000);
+			real_t radius = Math::random(1.0, 200.0);
+
+			for (int c = 0; c < 2; c++) {
+				switch (op) {
+					case 0: {
+						rs->canvas_item_set_transform(items[c][idx], xform);
+					} break;
+					case 1: {
+						rs->canvas_item_clear(items[c][idx]);
+						rs->canvas_item_add_circle(items[c][idx], Vector2(), radius, Color(1, 1, 1));
+					} break;
+					case 2: {
+						rs->canvas_item_set_parent(items[c][idx], RID());
+					} break;
+					case 3: {
+						rs->canvas_item_set_parent(items[c][idx], parent[c]);
+					} break;
+				}
+			}
+		}
+	}
+
+	for (int c = 0; c < 2; c++) {
+		for (const RID &rid : items[c]) {
+			rs->free(rid);
+		}
+		rs->free(canvas[c]);
+	}
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Y-sort order is kept between frames") {
+	// Enough items to collect the subtrees of the y-sorted item on multiple threads.
+	const int COUNT = 5000;
+	RS *rs = RS::get_singleton();
+	Math::seed(0);
+
+	RID canvas = rs->canvas_create();
+	RID ysort = rs->canvas_item_create();
+	rs->canvas_item_set_parent(ysort, canvas);
+	rs->canvas_item_set_sort_children_by_y(ysort, true);
+
+	LocalVector<RID> items;
+	items.push_back(ysort);
+	RID group;
+	for (int i = 0; i < COUNT; i++) {
+		RID item = rs->canvas_item_create();
+		// Every tenth item is a nested y-sorted item, whose children are sorted along with the others.
+		if (i % 10 == 0) {
+			rs->canvas_item_set_parent(item, ysort);
+			rs->canvas_item_set_sort_children_by_y(item, true);
+			group = item;
+		} else {
+			rs->canvas_item_set_parent(item, group);
+		}
+		rs->canvas_item_set_draw_index(item, i);
+		rs->canvas_item_set_transform(item, Transform2D(0, Vector2(Math::random(0.0, 1000.0), Math::random(0.0, 1000.0))));
+		draw_sprite(item);
+		items.push_back(item);
+	}
+
+	for (int frame = 0; frame < 20; frame++) {
+		// Most frames move a few items a little, some shuffle everything.
+		bool shuffle = frame % 5 == 4;
+		for (uint32_t i = 1; i < items.size(); i++) {
+			if (shuffle || Math::rand() % 100 == 0) {
+				Transform2D xform = Transform2D(0, Vector2(Math::random(0.0, 1000.0), shuffle ? Math::random(0.0, 1000.0) : Math::random(-5.0, 5.0)));
+				rs->canvas_item_set_transform(items[i], xform);
+			}
+		}
+		if (frame == 10) {
+			rs->canvas_item_set_visible(items[1], false);
+		}
+
+		LocalVector<DrawState> states = render_canvas(canvas, items, Transform2D(0, Vector2(100, 100)), Size2(3000, 3000));
+
+		bool sorted = true;
+		int drawn = 0;
+		for (uint32_t i = 1; i < items.size(); i++) {
+			if (!states[i].drawn) {
+				continue;
+			}
+			drawn++;
+			if (states[i].next != -1) {
+				RendererCanvasCull::Item *item = RSG::canvas->canvas_item_owner.get_or_null(items[i]);
+				RendererCanvasCull::Item *next = RSG::canvas->canvas_item_owner.get_or_null(items[states[i].next]);
+				sorted = sorted && !RendererCanvasCull::ItemPtrSort()(next, item);
+			}
+		}
+		CHECK_MESSAGE(sorted, vformat("Items should be drawn in Y order in frame %d.", frame));
+		CHECK(drawn == (frame < 10 ? COUNT : COUNT - 10));
+	}
+
+	for (const RID &rid : items) {
+		rs->free(rid);
+	}
+	rs->free(canvas);
+}
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
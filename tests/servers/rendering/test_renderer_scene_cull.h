@@ -0,0 +1,409 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering/storage/render_scene_buffers.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+// Culls the scenario for the camera, returning the geometry that would be sent to the renderer.
+// Viewports are never drawn with the dummy rasterizer, so the camera is rendered directly.
+HashSet<RenderGeometryInstance *> cull_camera(RID p_camera, RID p_scenario, RID p_viewport, RenderingMethod::RenderInfo *r_render_info = nullptr) {
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	Ref<RenderSceneBuffers> render_buffers = memnew(RenderSceneBuffersExtension);
+	Ref<XRInterface> xr_interface;
+
+	scene_cull->update_dirty_instances();
+	scene_cull->render_camera(render_buffers, p_camera, p_scenario, p_viewport, Size2(1280, 720), false, 1.0, RID(), xr_interface, r_render_info);
+
+	HashSet<RenderGeometryInstance *> visible;
+	for (uint64_t i = 0; i < scene_cull->scene_cull_result.geometry_instances.size(); i++) {
+		visible.insert(scene_cull->scene_cull_result.geometry_instances[i]);
+	}
+	return visible;
+}
+
+Vector3 random_position(real_t p_extent) {
+	return Vector3(Math::random(-p_extent, p_extent), Math::random(-p_extent, p_extent), Math::random(-p_extent, p_extent));
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Temporal coherence culls like a full scan") {
+	const int COUNT = 2000;
+	RS *rs = RS::get_singleton();
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	const bool temporal_coherence = scene_cull->cull_temporal_coherence;
+	Math::seed(0);
+
+	RID viewport = rs->viewport_create();
+	RID scenario = rs->scenario_create();
+	RID camera = rs->camera_create();
+	rs->camera_set_perspective(camera, 75.0, 0.05, 500.0);
+	rs->camera_set_cull_mask(camera, 1);
+	RID mesh = rs->mesh_create();
+
+	LocalVector<RID> instances;
+	for (int i = 0; i < COUNT; i++) {
+		RID instance = rs->instance_create2(mesh, scenario);
+		rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+		rs->instance_set_transform(instance, Transform3D(Basis(), random_position(100.0)));
+		instances.push_back(instance);
+	}
+
+	for (int frame = 0; frame < 30; frame++) {
+		// The camera only moves every few frames, in between the cached candidates are used.
+		bool camera_moved = frame % 5 == 0;
+		if (camera_moved) {
+			rs->camera_set_transform(camera, Transform3D(Basis(Vector3(0, 1, 0), Math::random(-Math_PI, Math_PI)), random_position(50.0)));
+		}
+
+		// Move, hide by layer, stop culling, add and remove some of the instances between frames.
+		for (int i = 0; i < 10; i++) {
+			rs->instance_set_transform(instances[Math::rand() % instances.size()], Transform3D(Basis(), random_position(100.0)));
+		}
+		for (int i = 0; i < 5; i++) {
+			rs->instance_set_layer_mask(instances[Math::rand() % instances.size()], Math::rand() % 2 ? 1 : 2);
+		}
+		rs->instance_set_ignore_culling(instances[Math::rand() % instances.size()], frame % 2 == 0);
+		for (int i = 0; i < 2; i++) {
+			uint32_t idx = Math::rand() % instances.size();
+			rs->free(instances[idx]);
+			instances.remove_at_unordered(idx);
+
+			RID instance = rs->instance_create2(mesh, scenario);
+			rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+			rs->instance_set_transform(instance, Transform3D(Basis(), random_position(100.0)));
+			instances.push_back(instance);
+		}
+
+		scene_cull->cull_temporal_coherence = false;
+		RenderingMethod::RenderInfo full_info;
+		HashSet<RenderGeometryInstance *> expected = cull_camera(camera, scenario, viewport, &full_info);
+
+		scene_cull->cull_temporal_coherence = true;
+		RenderingMethod::RenderInfo coherent_info;
+		HashSet<RenderGeometryInstance *> result = cull_camera(camera, scenario, viewport, &coherent_info);
+
+		bool match = result.size() == expected.size();
+		for (RenderGeometryInstance *E : expected) {
+			match = match && result.has(E);
+		}
+		CHECK_MESSAGE(match, vformat("Culled instances should match in frame %d.", frame));
+		CHECK(expected.size() > 0);
+		CHECK(int(expected.size()) < COUNT);
+
+		const int *full = full_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE];
+		const int *coherent = coherent_info.info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE];
+		CHECK(full[RS::VIEWPORT_RENDER_INFO_INSTANCES_TESTED] == COUNT);
+		CHECK(full[RS::VIEWPORT_RENDER_INFO_INSTANCES_SKIPPED] == 0);
+		CHECK(coherent[RS::VIEWPORT_RENDER_INFO_INSTANCES_TESTED] + coherent[RS::VIEWPORT_RENDER_INFO_INSTANCES_SKIPPED] == COUNT);
+		if (camera_moved) {
+			CHECK_MESSAGE(coherent[RS::VIEWPORT_RENDER_INFO_INSTANCES_SKIPPED] == 0, "Moving the camera should test every instance again.");
+		} else {
+			CHECK_MESSAGE(coherent[RS::VIEWPORT_RENDER_INFO_INSTANCES_SKIPPED] > 0, "Instances out of view should be skipped while the camera stays still.");
+		}
+	}
+
+	scene_cull->cull_temporal_coherence = temporal_coherence;
+	for (const RID &rid : instances) {
+		rs->free(rid);
+	}
+	rs->free(mesh);
+	rs->free(camera);
+	rs->free(viewport);
+	rs->free(scenario);
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Batched instance calls match single calls") {
+	const int COUNT = 500;
+	RS *rs = RS::get_singleton();
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	Math::seed(0);
+
+	RID viewport = rs->viewport_create();
+	RID camera = rs->camera_create();
+	rs->camera_set_perspective(camera, 75.0, 0.05, 500.0);
+	rs->camera_set_transform(camera, Transform3D(Basis(), Vector3(0, 0, 150)));
+	RID mesh = rs->mesh_create();
+
+	// The same instances created in one scenario with batched calls and in another with single calls.
+	RID scenario[2] = { rs->scenario_create(), rs->scenario_create() };
+	Vector<Transform3D> transforms;
+	PackedFloat32Array buffer;
+	for (int i = 0; i < COUNT; i++) {
+		Transform3D xform = Transform3D(Basis(Vector3(0, 1, 0), Math::random(-Math_PI, Math_PI)), random_position(100.0));
+		transforms.push_back(xform);
+		for (int j = 0; j < 3; j++) {
+			buffer.push_back(xform.basis.rows[j][0]);
+			buffer.push_back(xform.basis.rows[j][1]);
+			buffer.push_back(xform.basis.rows[j][2]);
+			buffer.push_back(xform.origin[j]);
+		}
+	}
+
+	Vector<RID> instances[2];
+	instances[0] = rs->instances_create(mesh, scenario[0], transforms);
+	for (int i = 0; i < COUNT; i++) {
+		RID instance = rs->instance_create2(mesh, scenario[1]);
+		rs->instance_set_transform(instance, transforms[i]);
+		instances[1].push_back(instance);
+	}
+	REQUIRE(instances[0].size() == COUNT);
+	for (int c = 0; c < 2; c++) {
+		for (const RID &instance : instances[c]) {
+			rs->instance_set_custom_aabb(instance, AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+		}
+	}
+
+	// Compares both sets of instances and whether they are culled alike.
+	auto check_instances = [&](const String &p_step) {
+		HashSet<RenderGeometryInstance *> visible[2];
+		for (int c = 0; c < 2; c++) {
+			visible[c] = cull_camera(camera, scenario[c], viewport);
+		}
+
+		bool match = true;
+		int drawn = 0;
+		for (int i = 0; i < COUNT; i++) {
+			RendererSceneCull::Instance *instance[2];
+			bool instance_visible[2];
+			for (int c = 0; c < 2; c++) {
+				instance[c] = scene_cull->instance_owner.get_or_null(instances[c][i]);
+				RenderGeometryInstance *geometry_instance = static_cast<RendererSceneCull::InstanceGeometryData *>(instance[c]->base_data)->geometry_instance;
+				instance_visible[c] = visible[c].has(geometry_instance);
+			}
+			match = match && instance[0]->transform.is_equal_approx(instance[1]->transform);
+			match = match && instance[0]->transformed_aabb.is_equal_approx(instance[1]->transformed_aabb);
+			match = match && instance[0]->visible == instance[1]->visible;
+			match = match && instance_visible[0] == instance_visible[1];
+			drawn += instance_visible[0] ? 1 : 0;
+		}
+		CHECK_MESSAGE(match, vformat("Batched and single calls should give the same instances after %s.", p_step));
+		CHECK(drawn > 0);
+		CHECK(drawn < COUNT);
+	};
+
+	check_instances("creating them");
+
+	// Move every other instance, the batch given through the script binding to check the buffer layout.
+	PackedFloat32Array moved_buffer;
+	TypedArray<RID> moved_array;
+	for (int i = 0; i < COUNT; i += 2) {
+		Transform3D xform = Transform3D(Basis(Vector3(1, 0, 0), Math::random(-Math_PI, Math_PI)), random_position(100.0));
+		rs->instance_set_transform(instances[1][i], xform);
+		moved_array.push_back(instances[0][i]);
+		for (int j = 0; j < 3; j++) {
+			moved_buffer.push_back(xform.basis.rows[j][0]);
+			moved_buffer.push_back(xform.basis.rows[j][1]);
+			moved_buffer.push_back(xform.basis.rows[j][2]);
+			moved_buffer.push_back(xform.origin[j]);
+		}
+	}
+	rs->call("instances_set_transforms", moved_array, moved_buffer);
+	check_instances("moving them");
+
+	Vector<uint8_t> visible_flags;
+	for (int i = 0; i < COUNT; i++) {
+		visible_flags.push_back(Math::rand() % 3 == 0 ? 0 : 1);
+		rs->instance_set_visible(instances[1][i], visible_flags[i]);
+	}
+	rs->instances_set_visible(instances[0], visible_flags);
+	check_instances("hiding some of them");
+
+	// The buffer passed to instances_create() must be read in the MultiMesh layout as well.
+	TypedArray<RID> created = rs->call("instances_create", mesh, scenario[0], buffer);
+	REQUIRE(created.size() == COUNT);
+	bool created_match = true;
+	for (int i = 0; i < COUNT; i++) {
+		RendererSceneCull::Instance *instance = scene_cull->instance_owner.get_or_null(created[i]);
+		created_match = created_match && instance && instance->transform.is_equal_approx(transforms[i]);
+		rs->free(created[i]);
+	}
+	CHECK_MESSAGE(created_match, "Instances created through the script binding should have the given transforms.");
+
+	for (int c = 0; c < 2; c++) {
+		for (const RID &rid : instances[c]) {
+			rs->free(rid);
+		}
+		rs->free(scenario[c]);
+	}
+	rs->free(mesh);
+	rs->free(camera);
+	rs->free(viewport);
+}
+
+TEST_CASE("[RendererSceneCull] Light pair grid finds the same lights as a brute force search") {
+	Math::seed(0);
+
+	// Lights spread through a volume, lights on a flat floor, and a single light.
+	for (int layout = 0; layout < 3; layout++) {
+		RendererSceneCull::LightPairGrid grid;
+		const int light_count = layout == 2 ? 1 : 300;
+		for (int i = 0; i < light_count; i++) {
+			Vector3 position = random_position(100.0);
+			Vector3 size = Vector3(1, 1, 1) * Math::random(1.0, 30.0);
+			if (layout == 1) {
+				position.y = 0.0;
+				size.y = 0.0;
+			}
+
+			RendererSceneCull::LightPairGrid::Light light;
+			light.aabb = AABB(position, size);
+			light.instance = RID::from_uint64(i + 1);
+			light.cull_mask = i % 4 == 0 ? 2 : 3;
+			grid.lights.push_back(light);
+		}
+		grid.build();
+
+		struct CollectLights {
+			LocalVector<uint32_t> found;
+			bool operator()(uint32_t p_light) {
+				found.push_back(p_light);
+				return false;
+			}
+		};
+
+		bool match = true;
+		bool unique = true;
+		int paired = 0;
+		for (int i = 0; i < 500; i++) {
+			// Some queries reach past the bounds of all lights.
+			AABB aabb = AABB(random_position(130.0), Vector3(Math::random(0.0, 20.0), Math::random(0.0, 20.0), Math::random(0.0, 20.0)));
+			uint32_t layer_mask = i % 3 == 0 ? 1 : 3;
+
+			CollectLights collect;
+			grid.query(aabb, layer_mask, collect);
+
+			HashSet<uint32_t> found;
+			for (uint32_t light : collect.found) {
+				unique = unique && !found.has(light);
+				found.insert(light);
+			}
+
+			uint32_t expected_count = 0;
+			for (uint32_t j = 0; j < grid.lights.size(); j++) {
+				const RendererSceneCull::LightPairGrid::Light &light = grid.lights[j];
+				if ((light.cull_mask & layer_mask) && light.aabb.intersects(aabb)) {
+					match = match && found.has(j);
+					expected_count++;
+				}
+			}
+			match = match && found.size() == expected_count;
+			paired += expected_count;
+		}
+		CHECK_MESSAGE(match, vformat("The grid should find every overlapping light in layout %d.", layout));
+		CHECK_MESSAGE(unique, vformat("The grid should report each light once in layout %d.", layout));
+		if (layout != 2) {
+			CHECK(paired > 0);
+		}
+	}
+}
+
+TEST_CASE("[SceneTree][RendererSceneCull] Clustered light pairing dirties the shadows a shadow caster moves through") {
+	RS *rs = RS::get_singleton();
+	RendererSceneCull *scene_cull = static_cast<RendererSceneCull *>(RSG::scene);
+	const bool light_pairing_clustered = scene_cull->light_pairing_clustered;
+	scene_cull->light_pairing_clustered = true;
+	Math::seed(0);
+
+	RID scenario_rid = rs->scenario_create();
+	RendererSceneCull::Scenario *scenario = scene_cull->scenario_owner.get_or_null(scenario_rid);
+	RID mesh = rs->mesh_create();
+
+	// The dummy rasterizer has no lights, so stand-ins are put in the volume indexer that lights are kept in.
+	LocalVector<RendererSceneCull::Instance *> lights;
+	LocalVector<DynamicBVH::ID> light_ids;
+	for (int i = 0; i < 200; i++) {
+		RendererSceneCull::Instance *light = memnew(RendererSceneCull::Instance);
+		light->base_type = RS::INSTANCE_LIGHT;
+		light->base_data = memnew(RendererSceneCull::InstanceLightData);
+		light->transformed_aabb = AABB(random_position(50.0), Vector3(1, 1, 1) * Math::random(2.0, 15.0));
+		light_ids.push_back(scenario->indexers[RendererSceneCull::Scenario::INDEXER_VOLUMES].insert(light->transformed_aabb, light));
+		lights.push_back(light);
+	}
+
+	const AABB local_aabb = AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2));
+	Vector3 position = random_position(50.0);
+	RID instance = rs->instance_create2(mesh, scenario_rid);
+	rs->instance_set_custom_aabb(instance, local_aabb);
+	rs->instance_set_transform(instance, Transform3D(Basis(), position));
+	scene_cull->update_dirty_instances();
+
+	int dirtied = 0;
+	for (int step = 0; step < 30; step++) {
+		for (RendererSceneCull::Instance *light : lights) {
+			static_cast<RendererSceneCull::InstanceLightData *>(light->base_data)->shadow_dirty = false;
+		}
+
+		// Moving or hiding the shadow caster should dirty the lights it was in range of and is now in range of.
+		const AABB old_aabb = AABB(local_aabb.position + position, local_aabb.size);
+		const bool hide = step % 5 == 4;
+		if (hide) {
+			rs->instance_set_visible(instance, false);
+		} else {
+			position = random_position(50.0);
+			rs->instance_set_transform(instance, Transform3D(Basis(), position));
+		}
+		scene_cull->update_dirty_instances();
+		const AABB new_aabb = AABB(local_aabb.position + position, local_aabb.size);
+
+		bool match = true;
+		for (RendererSceneCull::Instance *light : lights) {
+			bool expected = light->transformed_aabb.intersects(old_aabb) || light->transformed_aabb.intersects(new_aabb);
+			match = match && static_cast<RendererSceneCull::InstanceLightData *>(light->base_data)->shadow_dirty == expected;
+			dirtied += expected ? 1 : 0;
+		}
+		CHECK_MESSAGE(match, vformat("The lights around the shadow caster should be dirty in step %d.", step));
+
+		if (hide) {
+			rs->instance_set_visible(instance, true);
+			scene_cull->update_dirty_instances();
+		}
+	}
+	CHECK(dirtied > 0);
+
+	rs->free(instance);
+	for (uint32_t i = 0; i < lights.size(); i++) {
+		scenario->indexers[RendererSceneCull::Scenario::INDEXER_VOLUMES].remove(light_ids[i]);
+		memdelete(lights[i]);
+	}
+	rs->free(mesh);
+	rs->free(scenario_rid);
+	scene_cull->light_pairing_clustered = light_pairing_clustered;
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
@@ -0,0 +1,59 @@
+/**************************************************************************/
+/*  test_rendering_server.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERING_SERVER_H
+#define TEST_RENDERING_SERVER_H
+
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRenderingServer {
+
+TEST_CASE("[SceneTree][RenderingServer] Frame stage timings") {
+	RS::get_singleton()->sync();
+	RS::get_singleton()->draw(false, 1.0 / 60.0);
+
+	for (int i = 0; i < RS::FRAME_STAGE_MAX; i++) {
+		CHECK(RS::get_singleton()->get_frame_stage_time_cpu(RS::FrameStage(i)) >= 0.0);
+	}
+	CHECK(RS::get_singleton()->get_frame_stage_time_cpu(RS::FRAME_STAGE_SCENE_UPDATE) == RS::get_singleton()->get_frame_setup_time_cpu());
+	// Culling is timed within the viewports stage.
+	double cull_time = RS::get_singleton()->get_frame_stage_time_cpu(RS::FRAME_STAGE_SCENE_CULL) + RS::get_singleton()->get_frame_stage_time_cpu(RS::FRAME_STAGE_LIGHT_SETUP) + RS::get_singleton()->get_frame_stage_time_cpu(RS::FRAME_STAGE_CANVAS_CULL);
+	CHECK(cull_time <= RS::get_singleton()->get_frame_stage_time_cpu(RS::FRAME_STAGE_VIEWPORTS));
+
+	ERR_PRINT_OFF;
+	CHECK(RS::get_singleton()->get_frame_stage_time_cpu(RS::FRAME_STAGE_MAX) == 0.0);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestRenderingServer
+
+#endif // TEST_RENDERING_SERVER_H
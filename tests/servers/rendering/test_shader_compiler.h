@@ -0,0 +1,214 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderCompiler {
+
+// Passes the same actions as the canvas item shader data of the RenderingDevice renderer.
+struct CanvasShader {
+	int blend_mode = 0;
+	bool uses_sdf = false;
+	bool uses_time = false;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	ShaderCompiler::GeneratedCode gen_code;
+
+	Error compile(ShaderCompiler &p_compiler, const String &p_code) {
+		ShaderCompiler::IdentifierActions actions;
+		actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+		actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+		actions.entry_point_stages["light"] = ShaderCompiler::STAGE_FRAGMENT;
+
+		actions.render_mode_values["blend_add"] = Pair<int *, int>(&blend_mode, 1);
+		actions.render_mode_values["blend_mix"] = Pair<int *, int>(&blend_mode, 0);
+		actions.render_mode_values["blend_sub"] = Pair<int *, int>(&blend_mode, 2);
+		actions.render_mode_values["blend_mul"] = Pair<int *, int>(&blend_mode, 3);
+
+		actions.usage_flag_pointers["texture_sdf"] = &uses_sdf;
+		actions.usage_flag_pointers["TIME"] = &uses_time;
+
+		actions.uniforms = &uniforms;
+
+		return p_compiler.compile(RS::SHADER_CANVAS_ITEM, p_code, &actions, String(), gen_code);
+	}
+
+	// Built the way the material storage lists a shader's parameters.
+	List<PropertyInfo> get_parameter_list() const {
+		SortArray<Pair<StringName, int>, ShaderLanguage::UniformOrderComparator> sorter;
+		LocalVector<Pair<StringName, int>> filtered_uniforms;
+		for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : uniforms) {
+			if (E.value.texture_order >= 0) {
+				filtered_uniforms.push_back(Pair<StringName, int>(E.key, E.value.texture_order + 100000));
+			} else {
+				filtered_uniforms.push_back(Pair<StringName, int>(E.key, E.value.order));
+			}
+		}
+		sorter.sort(filtered_uniforms.ptr(), filtered_uniforms.size());
+
+		List<PropertyInfo> parameters;
+		String last_group;
+		for (const Pair<StringName, int> &E : filtered_uniforms) {
+			const ShaderLanguage::ShaderNode::Uniform &uniform = uniforms[E.first];
+			if (uniform.group != last_group) {
+				PropertyInfo pi;
+				pi.usage = PROPERTY_USAGE_GROUP;
+				pi.name = uniform.group;
+				parameters.push_back(pi);
+				last_group = uniform.group;
+			}
+
+			PropertyInfo pi = ShaderLanguage::uniform_to_property_info(uniform);
+			pi.name = E.first;
+			parameters.push_back(pi);
+		}
+		return parameters;
+	}
+
+	Variant get_default(const StringName &p_name) const {
+		const ShaderLanguage::ShaderNode::Uniform &uniform = uniforms[p_name];
+		return ShaderLanguage::constant_value_to_variant(uniform.default_value, uniform.type, uniform.array_size, uniform.hint);
+	}
+};
+
+ShaderCompiler::DefaultIdentifierActions get_default_actions() {
+	ShaderCompiler::DefaultIdentifierActions actions;
+	actions.renames["COLOR"] = "color";
+	actions.renames["UV"] = "uv";
+	actions.renames["TIME"] = "global_time";
+	actions.usage_defines["COLOR"] = "#define COLOR_USED\n";
+	actions.render_mode_defines["unshaded"] = "#define MODE_UNSHADED\n";
+	actions.default_filter = ShaderLanguage::FILTER_LINEAR;
+	actions.default_repeat = ShaderLanguage::REPEAT_DISABLE;
+	actions.base_texture_binding_index = 1;
+	actions.texture_layout_set = 3;
+	actions.base_uniform_string = "material.";
+	return actions;
+}
+
+String make_shader(int p_index) {
+	const char *blend_modes[] = { "blend_mix", "blend_add", "blend_sub", "blend_mul" };
+	String code = vformat("shader_type canvas_item;\nrender_mode %s;\n\n", blend_modes[p_index % 4]);
+	code += "group_uniforms tint;\n";
+	code += vformat("uniform vec4 tint_%d : source_color = vec4(%d.0, 0.5, 0.25, 1.0);\n", p_index, p_index);
+	code += vformat("uniform float strength : hint_range(0.0, %d.0, 0.5) = %d.0;\n", p_index + 1, p_index);
+	code += "group_uniforms;\n";
+	code += vformat("uniform int steps[%d] = { %s };\n", p_index + 1, String(", ").join(Vector<String>({ "1", "2", "3", "4", "5", "6", "7", "8" }).slice(0, p_index + 1)));
+	code += "uniform sampler2D mask : hint_default_white, filter_nearest;\n\n";
+	code += "void fragment() {\n";
+	code += vformat("\tCOLOR = tint_%d * texture(mask, UV) * strength * float(steps[0]);\n", p_index);
+	if (p_index % 2) {
+		code += "\tCOLOR.a *= sin(TIME);\n";
+	}
+	code += "}\n";
+	return code;
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Precompiled shaders match a serial compile") {
+	Vector<String> code;
+	for (int i = 0; i < 8; i++) {
+		code.push_back(make_shader(i));
+	}
+
+	ShaderCompiler serial_compiler;
+	serial_compiler.initialize(get_default_actions());
+	LocalVector<CanvasShader> serial;
+	serial.resize(code.size());
+	for (int i = 0; i < code.size(); i++) {
+		REQUIRE(serial[i].compile(serial_compiler, code[i]) == OK);
+	}
+
+	// Like a material storage queue flush: the first shader teaches the compiler
+	// which actions are passed, the rest are parsed on the worker threads.
+	ShaderCompiler batch_compiler;
+	batch_compiler.initialize(get_default_actions());
+	LocalVector<CanvasShader> batch;
+	batch.resize(code.size());
+	REQUIRE(batch[0].compile(batch_compiler, code[0]) == OK);
+	CHECK(ShaderCompiler::can_precompile(RS::SHADER_CANVAS_ITEM));
+	ShaderCompiler::precompile(RS::SHADER_CANVAS_ITEM, code.slice(1));
+	for (int i = 1; i < code.size(); i++) {
+		REQUIRE(batch[i].compile(batch_compiler, code[i]) == OK);
+	}
+
+	for (int i = 0; i < code.size(); i++) {
+		const CanvasShader &a = serial[i];
+		const CanvasShader &b = batch[i];
+
+		CHECK_MESSAGE(a.blend_mode == b.blend_mode, vformat("Shader %d should have the same blend mode.", i));
+		CHECK_MESSAGE(a.uses_time == b.uses_time, vformat("Shader %d should have the same TIME usage.", i));
+		CHECK(a.uses_time == bool(i % 2));
+
+		List<PropertyInfo> a_parameters = a.get_parameter_list();
+		List<PropertyInfo> b_parameters = b.get_parameter_list();
+		REQUIRE_MESSAGE(a_parameters.size() == b_parameters.size(), vformat("Shader %d should have the same number of parameters.", i));
+		for (const List<PropertyInfo>::Element *a_e = a_parameters.front(), *b_e = b_parameters.front(); a_e; a_e = a_e->next(), b_e = b_e->next()) {
+			const PropertyInfo &a_pi = a_e->get();
+			const PropertyInfo &b_pi = b_e->get();
+			CHECK(a_pi.name == b_pi.name);
+			CHECK(a_pi.type == b_pi.type);
+			CHECK(a_pi.hint == b_pi.hint);
+			CHECK(a_pi.hint_string == b_pi.hint_string);
+			CHECK(a_pi.usage == b_pi.usage);
+			if (!(a_pi.usage & PROPERTY_USAGE_GROUP)) {
+				CHECK_MESSAGE(a.get_default(a_pi.name) == b.get_default(b_pi.name), vformat("Parameter %s of shader %d should have the same default.", a_pi.name, i));
+			}
+		}
+		CHECK(b.get_default(vformat("tint_%d", i)) == Variant(Color(i, 0.5, 0.25, 1.0)));
+
+		for (const KeyValue<StringName, ShaderLanguage::ShaderNode::Uniform> &E : a.uniforms) {
+			REQUIRE(b.uniforms.has(E.key));
+			const ShaderLanguage::ShaderNode::Uniform &uniform = b.uniforms[E.key];
+			CHECK(E.value.group == uniform.group);
+			CHECK(E.value.texture_order == uniform.texture_order);
+			CHECK(E.value.filter == uniform.filter);
+		}
+
+		CHECK(a.gen_code.uniforms == b.gen_code.uniforms);
+		CHECK(a.gen_code.uniform_total_size == b.gen_code.uniform_total_size);
+		CHECK(a.gen_code.uniform_offsets == b.gen_code.uniform_offsets);
+		CHECK(a.gen_code.texture_uniforms.size() == b.gen_code.texture_uniforms.size());
+		CHECK(a.gen_code.defines == b.gen_code.defines);
+		REQUIRE(a.gen_code.code.size() == b.gen_code.code.size());
+		for (const KeyValue<String, String> &E : a.gen_code.code) {
+			REQUIRE(b.gen_code.code.has(E.key));
+			CHECK_MESSAGE(E.value == b.gen_code.code[E.key], vformat("Shader %d should generate the same %s code.", i, E.key));
+		}
+	}
+}
+
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H
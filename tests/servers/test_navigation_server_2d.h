@@ -31,7 +31,9 @@
 #ifndef TEST_NAVIGATION_SERVER_2D_H
 #define TEST_NAVIGATION_SERVER_2D_H
 
+#include "scene/resources/navigation_polygon.h"
 #include "servers/navigation_server_2d.h"
+#include "servers/navigation_server_3d.h"
 
 #include "tests/test_macros.h"
 
@@ -41,6 +43,179 @@ TEST_SUITE("[Navigation]") {
 		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
 		CHECK_EQ(navigation_server->get_maps().size(), 0);
 	}
+
+	TEST_CASE("[NavigationServer2D] Flow field should lead towards its target") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+
+		Ref<NavigationPolygon> navigation_polygon = memnew(NavigationPolygon);
+		PackedVector2Array vertices;
+		vertices.push_back(Vector2(0.0, 0.0));
+		vertices.push_back(Vector2(100.0, 0.0));
+		vertices.push_back(Vector2(100.0, 100.0));
+		vertices.push_back(Vector2(0.0, 100.0));
+		navigation_polygon->set_vertices(vertices);
+		PackedInt32Array polygon;
+		polygon.push_back(0);
+		polygon.push_back(1);
+		polygon.push_back(2);
+		polygon.push_back(3);
+		navigation_polygon->add_polygon(polygon);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_polygon(region, navigation_polygon);
+
+		RID flow_field = navigation_server->flow_field_create();
+		navigation_server->flow_field_set_map(flow_field, map);
+		navigation_server->flow_field_set_cell_size(flow_field, 5.0);
+		navigation_server->flow_field_set_target_position(flow_field, Vector2(92.5, 52.5));
+		NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->flow_field_get_map(flow_field), map);
+		CHECK_EQ(navigation_server->flow_field_get_cell_size(flow_field), doctest::Approx(5.0));
+		CHECK(navigation_server->flow_field_get_direction(flow_field, Vector2(12.5, 52.5)).is_equal_approx(Vector2(1.0, 0.0)));
+		CHECK_EQ(navigation_server->flow_field_get_direction(flow_field, Vector2(-50.0, 52.5)), Vector2());
+		const real_t free_distance = navigation_server->flow_field_get_distance(flow_field, Vector2(12.5, 52.5));
+		CHECK_GT(free_distance, 0.0);
+
+		SUBCASE("Obstacles should reroute the field and release it when removed") {
+			RID obstacle = navigation_server->obstacle_create();
+			navigation_server->obstacle_set_map(obstacle, map);
+			navigation_server->obstacle_set_position(obstacle, Vector2(50.0, 0.0));
+			PackedVector2Array obstacle_vertices;
+			obstacle_vertices.push_back(Vector2(-5.0, -10.0));
+			obstacle_vertices.push_back(Vector2(5.0, -10.0));
+			obstacle_vertices.push_back(Vector2(5.0, 80.0));
+			obstacle_vertices.push_back(Vector2(-5.0, 80.0));
+			navigation_server->obstacle_set_vertices(obstacle, obstacle_vertices);
+			NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+
+			CHECK_GT(navigation_server->flow_field_get_distance(flow_field, Vector2(12.5, 52.5)), free_distance);
+			CHECK_GT(navigation_server->flow_field_get_direction(flow_field, Vector2(37.5, 52.5)).y, 0.0);
+
+			navigation_server->free(obstacle);
+			NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->flow_field_get_distance(flow_field, Vector2(12.5, 52.5)), doctest::Approx(free_distance));
+		}
+
+		SUBCASE("Repairing the field should match building it from scratch") {
+			// Route along the diagonal from the bottom left cells to the target.
+			navigation_server->flow_field_set_target_position(flow_field, Vector2(77.5, 77.5));
+			NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+
+			// Block a single cell next to the diagonal, the diagonal step past its corner is not allowed anymore.
+			RID obstacle = navigation_server->obstacle_create();
+			navigation_server->obstacle_set_map(obstacle, map);
+			navigation_server->obstacle_set_position(obstacle, Vector2(32.5, 27.5));
+			PackedVector2Array obstacle_vertices;
+			obstacle_vertices.push_back(Vector2(-2.0, -2.0));
+			obstacle_vertices.push_back(Vector2(2.0, -2.0));
+			obstacle_vertices.push_back(Vector2(2.0, 2.0));
+			obstacle_vertices.push_back(Vector2(-2.0, 2.0));
+			navigation_server->obstacle_set_vertices(obstacle, obstacle_vertices);
+
+			RID fresh_flow_field = navigation_server->flow_field_create();
+			navigation_server->flow_field_set_map(fresh_flow_field, map);
+			navigation_server->flow_field_set_cell_size(fresh_flow_field, 5.0);
+			navigation_server->flow_field_set_target_position(fresh_flow_field, Vector2(77.5, 77.5));
+			NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+
+			CHECK_EQ(navigation_server->flow_field_get_distance(flow_field, Vector2(32.5, 27.5)), -1.0);
+			CHECK_GT(navigation_server->flow_field_get_distance(flow_field, Vector2(27.5, 27.5)), navigation_server->flow_field_get_distance(flow_field, Vector2(32.5, 32.5)) + 5.0 * Math_SQRT2);
+			int mismatches = 0;
+			for (int x = 0; x < 20; x++) {
+				for (int z = 0; z < 20; z++) {
+					const Vector2 position = Vector2(x * 5.0 + 2.5, z * 5.0 + 2.5);
+					if (!Math::is_equal_approx(navigation_server->flow_field_get_distance(flow_field, position), navigation_server->flow_field_get_distance(fresh_flow_field, position))) {
+						mismatches++;
+					}
+				}
+			}
+			CHECK_EQ(mismatches, 0);
+
+			navigation_server->free(fresh_flow_field);
+			navigation_server->free(obstacle);
+			NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+		}
+
+		navigation_server->free(flow_field);
+		navigation_server->free(region);
+		navigation_server->free(map);
+		NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer2D] Flow field should only cross between connected polygons") {
+		NavigationServer2D *navigation_server = NavigationServer2D::get_singleton();
+
+		// Two regions with a gap between them that is narrower than a cell, but wider than the edge connection margin.
+		Ref<NavigationPolygon> navigation_polygons[2];
+		const real_t region_begin[2] = { 0.0, 42.0 };
+		const real_t region_end[2] = { 40.0, 100.0 };
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_edge_connection_margin(map, 1.0);
+		RID regions[2];
+		for (int i = 0; i < 2; i++) {
+			navigation_polygons[i].instantiate();
+			PackedVector2Array vertices;
+			vertices.push_back(Vector2(region_begin[i], 0.0));
+			vertices.push_back(Vector2(region_end[i], 0.0));
+			vertices.push_back(Vector2(region_end[i], 100.0));
+			vertices.push_back(Vector2(region_begin[i], 100.0));
+			navigation_polygons[i]->set_vertices(vertices);
+			PackedInt32Array polygon;
+			polygon.push_back(0);
+			polygon.push_back(1);
+			polygon.push_back(2);
+			polygon.push_back(3);
+			navigation_polygons[i]->add_polygon(polygon);
+
+			regions[i] = navigation_server->region_create();
+			navigation_server->region_set_map(regions[i], map);
+			navigation_server->region_set_navigation_polygon(regions[i], navigation_polygons[i]);
+		}
+
+		RID flow_field = navigation_server->flow_field_create();
+		navigation_server->flow_field_set_map(flow_field, map);
+		navigation_server->flow_field_set_cell_size(flow_field, 5.0);
+		navigation_server->flow_field_set_target_position(flow_field, Vector2(92.5, 52.5));
+		NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+
+		// The cells on both sides of the gap are neighbors, but their polygons are not connected.
+		CHECK_GT(navigation_server->flow_field_get_distance(flow_field, Vector2(47.5, 52.5)), 0.0);
+		CHECK_EQ(navigation_server->flow_field_get_distance(flow_field, Vector2(37.5, 52.5)), -1.0);
+		CHECK_EQ(navigation_server->flow_field_get_direction(flow_field, Vector2(12.5, 52.5)), Vector2());
+
+		SUBCASE("Navigation links should connect the regions") {
+			RID link = navigation_server->link_create();
+			navigation_server->link_set_map(link, map);
+			navigation_server->link_set_start_position(link, Vector2(37.5, 52.5));
+			navigation_server->link_set_end_position(link, Vector2(47.5, 52.5));
+			navigation_server->link_set_bidirectional(link, false);
+			NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+
+			CHECK_GT(navigation_server->flow_field_get_distance(flow_field, Vector2(37.5, 52.5)), navigation_server->flow_field_get_distance(flow_field, Vector2(47.5, 52.5)));
+			CHECK(navigation_server->flow_field_get_direction(flow_field, Vector2(12.5, 52.5)).is_equal_approx(Vector2(1.0, 0.0)));
+
+			// The link only leads from the first region into the second one.
+			navigation_server->flow_field_set_target_position(flow_field, Vector2(12.5, 52.5));
+			NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->flow_field_get_distance(flow_field, Vector2(92.5, 52.5)), -1.0);
+
+			navigation_server->free(link);
+			NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+		}
+
+		navigation_server->free(flow_field);
+		for (int i = 0; i < 2; i++) {
+			navigation_server->free(regions[i]);
+		}
+		navigation_server->free(map);
+		NavigationServer3D::get_singleton()->process(0.0); // Give server some cycles to commit.
+	}
 }
 } //namespace TestNavigationServer2D
 
@@ -31,6 +31,7 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/math/geometry_3d.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -423,6 +424,60 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->free(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should find avoidance neighbors of agents moving across the map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		// A crowd of agents walking in place, spread over an area much larger than their neighbor distance.
+		LocalVector<RID> crowd;
+		for (int i = 0; i < 10; i++) {
+			for (int j = 0; j < 10; j++) {
+				RID crowd_agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(crowd_agent, map);
+				navigation_server->agent_set_avoidance_enabled(crowd_agent, true);
+				navigation_server->agent_set_position(crowd_agent, Vector3(100 + i * 50, 0, 100 + j * 50));
+				navigation_server->agent_set_neighbor_distance(crowd_agent, 10);
+				crowd.push_back(crowd_agent);
+			}
+		}
+
+		RID agent = navigation_server->agent_create();
+		navigation_server->agent_set_map(agent, map);
+		navigation_server->agent_set_avoidance_enabled(agent, true);
+		navigation_server->agent_set_position(agent, Vector3(0, 0, 0));
+		navigation_server->agent_set_radius(agent, 1);
+		navigation_server->agent_set_neighbor_distance(agent, 10);
+		navigation_server->agent_set_velocity(agent, Vector3(1, 0, 0));
+		CallableMock agent_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent, callable_mp(&agent_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(agent_avoidance_callback_mock.function1_calls, 1);
+		CHECK_MESSAGE(Vector3(agent_avoidance_callback_mock.function1_latest_arg0).is_equal_approx(Vector3(1, 0, 0)), "agent without neighbors should keep its desired velocity");
+
+		// Walk straight into a crowd agent far away from where the agent started.
+		navigation_server->agent_set_position(agent, Vector3(347.5, 0, 349.5));
+		navigation_server->process(0.0);
+		CHECK_EQ(agent_avoidance_callback_mock.function1_calls, 2);
+		CHECK_MESSAGE(Vector3(agent_avoidance_callback_mock.function1_latest_arg0).z < 0, "agent should move to the side so that it avoids the crowd agent in front of it");
+
+		// Removing the crowd from avoidance leaves the agent alone again.
+		for (const RID &crowd_agent : crowd) {
+			navigation_server->agent_set_avoidance_enabled(crowd_agent, false);
+		}
+		navigation_server->process(0.0);
+		CHECK_EQ(agent_avoidance_callback_mock.function1_calls, 3);
+		CHECK_MESSAGE(Vector3(agent_avoidance_callback_mock.function1_latest_arg0).is_equal_approx(Vector3(1, 0, 0)), "agent without neighbors should keep its desired velocity");
+
+		for (const RID &crowd_agent : crowd) {
+			navigation_server->free(crowd_agent);
+		}
+		navigation_server->free(agent);
+		navigation_server->free(map);
+	}
+
 #ifndef DISABLE_DEPRECATED
 	// This test case uses only public APIs on purpose - other test cases use simplified baking.
 	// FIXME: Remove once deprecated `region_bake_navigation_mesh()` is removed.
@@ -522,6 +577,119 @@ TEST_SUITE("[Navigation]") {
 		memdelete(node_3d);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should bake tiled navigation mesh of procedurally generated level") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(32);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		// Floor spanning several tiles with a grid of pillars on top.
+		Array floor_arr;
+		floor_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(floor_arr, Vector3(40.0, 0.001, 40.0));
+		source_geometry->add_mesh_array(floor_arr, Transform3D());
+		Array pillar_arr;
+		pillar_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(pillar_arr, Vector3(1.0, 2.0, 1.0));
+		for (int x = -3; x <= 3; x++) {
+			for (int z = -3; z <= 3; z++) {
+				if ((x + z) % 2 == 0) {
+					source_geometry->add_mesh_array(pillar_arr, Transform3D(Basis(), Vector3(x * 5.0, 1.0, z * 5.0)));
+				}
+			}
+		}
+
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+		CHECK_NE(navigation_mesh->get_vertices().size(), 0);
+
+		SUBCASE("Rebaking unchanged geometry should reproduce the same navigation mesh") {
+			const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+			const int polygon_count = navigation_mesh->get_polygon_count();
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_EQ(navigation_mesh->get_vertices(), vertices);
+			CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+		}
+
+		SUBCASE("Tiles should stitch into a connected navigation mesh") {
+			RID map = navigation_server->map_create();
+			RID region = navigation_server->region_create();
+			navigation_server->map_set_active(map, true);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			const Vector3 start = navigation_server->map_get_closest_point(map, Vector3(-18.0, 0.0, -18.0));
+			const Vector3 end = navigation_server->map_get_closest_point(map, Vector3(18.0, 0.0, 18.0));
+			const Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+			CHECK_NE(path.size(), 0);
+			CHECK(path[path.size() - 1].is_equal_approx(end));
+
+			navigation_server->free(region);
+			navigation_server->free(map);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+		}
+	}
+
+	TEST_CASE("[NavigationServer3D] Tiled navigation mesh should connect polygons across tile seams with mismatched vertices") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(32); // 8 meters with the default cell size, tiles meet at x = 0.
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		// A corridor crossing the seam, with pillars only on one side so both tiles place different vertices on it.
+		Array floor_arr;
+		floor_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(floor_arr, Vector3(14.0, 0.001, 5.0));
+		source_geometry->add_mesh_array(floor_arr, Transform3D());
+		Array pillar_arr;
+		pillar_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(pillar_arr, Vector3(0.5, 2.0, 0.5));
+		source_geometry->add_mesh_array(pillar_arr, Transform3D(Basis(), Vector3(2.0, 1.0, -1.2)));
+		source_geometry->add_mesh_array(pillar_arr, Transform3D(Basis(), Vector3(3.5, 1.0, 1.0)));
+		source_geometry->add_mesh_array(pillar_arr, Transform3D(Basis(), Vector3(5.0, 1.0, -0.3)));
+
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		REQUIRE_NE(navigation_mesh->get_polygon_count(), 0);
+
+		// No vertex may lie inside the edge of another polygon, NavMap would not connect the edges.
+		const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+		int t_junctions = 0;
+		for (int i = 0; i < navigation_mesh->get_polygon_count(); i++) {
+			const Vector<int> polygon = navigation_mesh->get_polygon(i);
+			for (int j = 0; j < polygon.size(); j++) {
+				const Vector3 edge[2] = { vertices[polygon[j]], vertices[polygon[(j + 1) % polygon.size()]] };
+				for (const Vector3 &vertex : vertices) {
+					if (vertex.is_equal_approx(edge[0]) || vertex.is_equal_approx(edge[1])) {
+						continue;
+					}
+					if (Geometry3D::get_closest_point_to_segment(vertex, edge).distance_to(vertex) < 0.001) {
+						t_junctions++;
+					}
+				}
+			}
+		}
+		CHECK_EQ(t_junctions, 0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Polygons of one region are only linked through shared edges, so the path has to cross the seam through them.
+		const Vector3 start = navigation_server->map_get_closest_point(map, Vector3(-6.0, 0.0, 0.0));
+		const Vector3 end = navigation_server->map_get_closest_point(map, Vector3(6.0, 0.0, 0.0));
+		const Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE_NE(path.size(), 0);
+		CHECK(path[path.size() - 1].is_equal_approx(end));
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	// This test case does not check precise values on purpose - to not be too sensitivte.
 	TEST_CASE("[NavigationServer3D] Server should respond to queries against valid map properly") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
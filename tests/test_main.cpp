@@ -30,6 +30,11 @@
 
 #include "test_main.h"
 
+#include "tests/benchmarks/benchmark_navigation_server_3d.h"
+#include "tests/benchmarks/benchmark_object.h"
+#include "tests/benchmarks/benchmark_packed_scene.h"
+#include "tests/benchmarks/benchmark_renderer_canvas_cull.h"
+#include "tests/benchmarks/benchmark_rendering_server.h"
 #include "tests/core/config/test_project_settings.h"
 #include "tests/core/input/test_input_event.h"
 #include "tests/core/input/test_input_event_key.h"
@@ -66,6 +71,7 @@
 #include "tests/core/math/test_vector4.h"
 #include "tests/core/math/test_vector4i.h"
 #include "tests/core/object/test_class_db.h"
+#include "tests/core/object/test_message_queue.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/os/test_os.h"
@@ -106,15 +112,22 @@
 #include "tests/scene/test_navigation_region_2d.h"
 #include "tests/scene/test_navigation_region_3d.h"
 #include "tests/scene/test_node.h"
+#include "tests/scene/test_node_3d.h"
 #include "tests/scene/test_packed_scene.h"
 #include "tests/scene/test_path_2d.h"
 #include "tests/scene/test_path_3d.h"
 #include "tests/scene/test_primitives.h"
+#include "tests/scene/test_scene_pool.h"
 #include "tests/scene/test_sprite_frames.h"
 #include "tests/scene/test_text_edit.h"
 #include "tests/scene/test_theme.h"
 #include "tests/scene/test_viewport.h"
 #include "tests/scene/test_visual_shader.h"
+#include "tests/servers/rendering/test_raster_occlusion_cull.h"
+#include "tests/servers/rendering/test_renderer_canvas_cull.h"
+#include "tests/servers/rendering/test_renderer_scene_cull.h"
+#include "tests/servers/rendering/test_rendering_server.h"
+#include "tests/servers/rendering/test_shader_compiler.h"
 #include "tests/servers/rendering/test_shader_preprocessor.h"
 #include "tests/servers/test_navigation_server_2d.h"
 #include "tests/servers/test_navigation_server_3d.h"